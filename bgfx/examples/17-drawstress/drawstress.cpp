@@ -119,6 +119,7 @@ public:
 		m_dim        = 16;
 		m_maxDim     = 40;
 		m_transform  = 0;
+		m_autoInstancing = false;
 
 		m_timeOffset = bx::getHPCounter();
 
@@ -160,6 +161,16 @@ public:
 			, true /* destroy shaders when program is destroyed */
 			);
 
+		// Auto instancing routes each draw's transforms into instance data,
+		// so it needs a shader that reads the model matrix from i_data0-3
+		// and the color modulation from i_data4.
+		m_instancingSupported = 0 != (caps->supported & BGFX_CAPS_INSTANCING);
+		m_instancingProgram   = BGFX_INVALID_HANDLE;
+		if (m_instancingSupported)
+		{
+			m_instancingProgram = loadProgram("vs_instancing", "fs_instancing");
+		}
+
 		// Create static vertex buffer.
 		m_vbh = bgfx::createVertexBuffer(
 			  bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) )
@@ -195,6 +206,11 @@ public:
 		bgfx::destroy(m_vbh);
 		bgfx::destroy(m_program);
 
+		if (bgfx::isValid(m_instancingProgram) )
+		{
+			bgfx::destroy(m_instancingProgram);
+		}
+
 		// Shutdown bgfx.
 		bgfx::shutdown();
 
@@ -245,6 +261,15 @@ public:
 
 			const float* mod = s_mod[_tid%BX_COUNTOF(s_mod)];
 
+			const bool autoInstancing = m_autoInstancing && bgfx::isValid(m_instancingProgram);
+			const bgfx::ProgramHandle program = autoInstancing ? m_instancingProgram : m_program;
+
+			if (autoInstancing)
+			{
+				// 4x4 model matrix followed by RGBA color modulation.
+				encoder->setAutoInstancing(true, 80);
+			}
+
 			float mtxS[16];
 			const float scale = 0 == m_transform ? 0.25f : 0.0f;
 			bx::mtxScale(mtxS, scale, scale, scale);
@@ -268,18 +293,30 @@ public:
 							, (time + zz*0.13f)*mod[2]
 							);
 
-						float mtx[16];
+						float mtx[32];
 						bx::mtxMul(mtx, mtxS, mtxR);
 
 						mtx[12] = pos[0] + float(xx)*step;
 						mtx[13] = pos[1] + float(yy)*step;
 						mtx[14] = pos[2] + float(zz)*step;
 
-						encoder->setTransform(mtx);
+						if (autoInstancing)
+						{
+							mtx[16] = 1.0f;
+							mtx[17] = 1.0f;
+							mtx[18] = 1.0f;
+							mtx[19] = 1.0f;
+							encoder->setTransform(mtx, 2);
+						}
+						else
+						{
+							encoder->setTransform(mtx);
+						}
+
 						encoder->setVertexBuffer(0, m_vbh);
 						encoder->setIndexBuffer(m_ibh);
 						encoder->setState(BGFX_STATE_DEFAULT);
-						encoder->submit(0, m_program);
+						encoder->submit(0, program);
 					}
 				}
 			}
@@ -357,6 +394,11 @@ public:
 
 			ImGui::Checkbox("Auto adjust", &m_autoAdjust);
 
+			if (m_instancingSupported)
+			{
+				ImGui::Checkbox("Auto instancing", &m_autoInstancing);
+			}
+
 			ImGui::SliderInt("Num threads", &m_numThreads, 1, m_maxThreads);
 			const uint32_t numThreads = m_numThreads;
 
@@ -371,6 +413,13 @@ public:
 			ImGui::Text("Waiting for render thread %0.6f [ms]", double(stats->waitRender) * toMs);
 			ImGui::Text("Waiting for submit thread %0.6f [ms]", double(stats->waitSubmit) * toMs);
 
+			const uint32_t numDrawn = stats->numDraw - stats->numBatchedDraws + stats->numBatches;
+			ImGui::Text("Submitted %d, drawn %d (%0.1fx)"
+				, stats->numDraw
+				, numDrawn
+				, double(stats->numDraw)/double(bx::max<uint32_t>(1, numDrawn) )
+				);
+
 			ImGui::End();
 
 			imguiEndFrame();
@@ -430,6 +479,8 @@ public:
 	uint32_t m_reset;
 
 	bool     m_autoAdjust;
+	bool     m_autoInstancing;
+	bool     m_instancingSupported;
 	int32_t  m_scrollArea;
 	int32_t  m_dim;
 	int32_t  m_maxDim;
@@ -447,6 +498,7 @@ public:
 	bx::Semaphore m_sync;
 
 	bgfx::ProgramHandle m_program;
+	bgfx::ProgramHandle m_instancingProgram;
 	bgfx::VertexBufferHandle m_vbh;
 	bgfx::IndexBufferHandle  m_ibh;
 };
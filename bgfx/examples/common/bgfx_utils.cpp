@@ -13,6 +13,7 @@ namespace stl = tinystl;
 #include <bgfx/bgfx.h>
 #include <bx/commandline.h>
 #include <bx/endian.h>
+#include <bx/filepath.h>
 #include <bx/math.h>
 #include <bx/readerwriter.h>
 #include <bx/string.h>
@@ -246,7 +247,38 @@ bgfx::TextureHandle loadTexture(bx::FileReaderI* _reader, const char* _filePath,
 
 bgfx::TextureHandle loadTexture(const char* _name, uint32_t _flags, uint8_t _skip, bgfx::TextureInfo* _info, bimg::Orientation::Enum* _orientation)
 {
-	return loadTexture(entry::getFileReader(), _name, _flags, _skip, _info, _orientation);
+	char filePath[bx::kMaxFilePath];
+	bx::snprintf(filePath, BX_COUNTOF(filePath), "%s%s", entry::getCurrentDir(), _name);
+
+	// DDS, KTX, and PVR3 files are mapped, and renderer uploads mips straight from mapped pages.
+	// Everything else is read into memory and decoded.
+	bimg::ImageContainer* imageContainer = bimg::imageMapFile(entry::getAllocator(), filePath);
+
+	if (NULL == imageContainer)
+	{
+		return loadTexture(entry::getFileReader(), _name, _flags, _skip, _info, _orientation);
+	}
+
+	if (NULL != _orientation)
+	{
+		*_orientation = imageContainer->m_orientation;
+	}
+
+	const bgfx::Memory* mem = bgfx::makeRef(
+		  imageContainer->m_data
+		, imageContainer->m_size
+		, imageReleaseCb
+		, imageContainer
+		);
+
+	bgfx::TextureHandle handle = bgfx::createTexture(mem, _flags, _skip, _info);
+
+	if (bgfx::isValid(handle) )
+	{
+		bgfx::setName(handle, _name);
+	}
+
+	return handle;
 }
 
 bimg::ImageContainer* imageLoad(const char* _filePath, bgfx::TextureFormat::Enum _dstFormat)
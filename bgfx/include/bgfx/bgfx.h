@@ -389,6 +389,29 @@ namespace bgfx
 		};
 	};
 
+	/// Frame stage recorded in frame timeline.
+	///
+	/// @attention C99 equivalent is `bgfx_timeline_stage_t`.
+	///
+	struct TimelineStage
+	{
+		/// Frame stages:
+		enum Enum
+		{
+			Encoder,    //!< Encoder recording, from encoder begin to end (encoder thread).
+			WaitRender, //!< Waiting for render thread to finish previous frame (API thread).
+			Swap,       //!< Frame swap in `bgfx::frame` (API thread).
+			WaitSubmit, //!< Waiting for API thread to submit frame (render thread).
+			ExecPre,    //!< Executing pre-submit commands, resource creation (render thread).
+			Sort,       //!< Sorting draw calls (render thread).
+			Submit,     //!< Renderer submit, includes sort (render thread).
+			ExecPost,   //!< Executing post-submit commands, resource destruction (render thread).
+			Flip,       //!< Presenting back buffer (render thread).
+
+			Count
+		};
+	};
+
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
 	BGFX_HANDLE(DynamicIndexBufferHandle)
@@ -671,10 +694,22 @@ namespace bgfx
 			uint16_t maxEncoders;     //!< Maximum number of encoder threads.
 			uint32_t transientVbSize; //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize; //!< Maximum transient index buffer size.
+			uint32_t maxDrawCalls;    //!< Maximum number of draw calls per frame.
+			uint32_t maxUploadSize;   //!< Maximum number of bytes of asynchronous uploads passed
+			                          //!  to renderer per frame.
+			uint32_t maxCacheSize;    //!< Maximum size of cache directory in bytes.
 		};
 
 		Limits limits;
 
+		/// When set, every frame passed to renderer is written into this file. Recording
+		/// can be replayed with `bgfx::replayBegin` by the same bgfx build.
+		const char* recordFilePath;
+
+		/// When set and application doesn't provide `callback`, program and pipeline binaries
+		/// created by renderer are cached in this directory, and reused on next run.
+		const char* cacheDirPath;
+
 		/// Provide application specific callback interface.
 		/// See: `bgfx::CallbackI`
 		CallbackI* callback;
@@ -907,6 +942,34 @@ namespace bgfx
 		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.
 	};
 
+	/// CPU profiler scope stats.
+	///
+	/// @attention C99 equivalent is `bgfx_profiler_scope_stats_t`.
+	///
+	/// @remarks Scopes are ordered depth first, children follow their parent.
+	///
+	struct ProfilerScopeStats
+	{
+		const char* name;           //!< Scope name.
+		const char* threadName;     //!< Name of thread scope was recorded on.
+		int64_t     cpuTimeElapsed; //!< CPU time spent in scope during frame, including child scopes.
+		uint32_t    count;          //!< Number of times scope was entered during frame.
+		uint16_t    depth;          //!< Scope nesting depth, 0 for top level scope.
+	};
+
+	/// Frame timeline event.
+	///
+	/// @attention C99 equivalent is `bgfx_timeline_event_t`.
+	///
+	struct TimelineEvent
+	{
+		int64_t  cpuTimeBegin;      //!< Stage begin time, in `Stats::cpuTimerFreq` units.
+		int64_t  cpuTimeEnd;        //!< Stage end time.
+		uint32_t frame;             //!< Frame number, as returned by `bgfx::frame` that submitted frame.
+		uint16_t encoder;           //!< Encoder index, only for `TimelineStage::Encoder`.
+		TimelineStage::Enum stage;  //!< Frame stage.
+	};
+
 	/// Renderer statistics data.
 	///
 	/// @attention C99 equivalent is `bgfx_stats_t`.
@@ -931,6 +994,9 @@ namespace bgfx
 		uint32_t numDraw;                   //!< Number of draw calls submitted.
 		uint32_t numCompute;                //!< Number of compute calls submitted.
 		uint32_t numBlit;                   //!< Number of blit calls submitted.
+		uint32_t numBatches;                //!< Number of auto-instanced batches passed to renderer.
+		uint32_t numBatchedDraws;           //!< Number of draw calls merged into auto-instanced batches,
+		                                    //!  included in `numDraw`.
 		uint32_t maxGpuLatency;             //!< GPU driver latency.
 
 		uint16_t numDynamicIndexBuffers;    //!< Number of used dynamic index buffers.
@@ -949,6 +1015,16 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int32_t transientVbWasted;          //!< Amount of transient vertex buffer left unused in encoder blocks.
+		int32_t transientIbWasted;          //!< Amount of transient index buffer left unused in encoder blocks.
+
+		uint32_t uniformBytesSaved;         //!< Uniform data not written because it matched encoder's previous
+		                                    //!  value for the same uniform.
+		uint32_t uniformUpdatesSkipped;     //!< Uniform updates skipped by renderer because uniform already
+		                                    //!  had the same value.
+
+		uint32_t uploadSize;                //!< Asynchronous upload bytes passed to renderer.
+		uint32_t numUploadsPending;         //!< Number of queued asynchronous uploads.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
@@ -965,8 +1041,13 @@ namespace bgfx
 
 		uint8_t       numEncoders;          //!< Number of encoders used during frame.
 		EncoderStats* encoderStats;         //!< Array of encoder stats.
+
+		uint16_t            numProfilerScopes; //!< Number of CPU profiler scopes.
+		ProfilerScopeStats* profilerScopes;    //!< Array of CPU profiler scope stats.
 	};
 
+	struct VertexDecl;
+
 	/// Encoders are used for submitting draw calls from multiple threads. Only one encoder
 	/// per thread should be used. Use `bgfx::begin()` to obtain an encoder for a thread.
 	///
@@ -1073,7 +1154,8 @@ namespace bgfx
 		/// @param[in] _mtx Pointer to first matrix in array.
 		/// @param[in] _num Number of matrices in array.
 		/// @returns Index into matrix cache in case the same model matrix has
-		///   to be used for other draw primitive call.
+		///   to be used for other draw primitive call. Returns UINT32_MAX when
+		///   matrix cache is full, and draw primitive is dropped.
 		///
 		/// @attention C99 equivalent is `bgfx_set_transform`.
 		///
@@ -1086,7 +1168,8 @@ namespace bgfx
 		///
 		/// @param[in] _transform Pointer to `Transform` structure.
 		/// @param[in] _num Number of matrices.
-		/// @returns Index into matrix cache.
+		/// @returns Index into matrix cache. Returns UINT32_MAX when matrix cache
+		///   is full, `_transform` is set to NULL data and 0 matrices.
 		///
 		/// @attention Pointer returned can be modifed until `bgfx::frame` is called.
 		/// @attention C99 equivalent is `bgfx_alloc_transform`.
@@ -1123,6 +1206,56 @@ namespace bgfx
 			, uint16_t _num = 1
 			);
 
+		/// Allocate transient index buffer from encoder's own block of
+		/// transient index buffer. Unlike `bgfx::allocTransientIndexBuffer`
+		/// it doesn't lock, and it can be called from encoder thread.
+		///
+		/// @param[out] _tib TransientIndexBuffer structure is filled and is valid
+		///   for the duration of frame. Number of allocated indices can be
+		///   less than requested when transient index buffer is full.
+		/// @param[in] _num Number of indices to allocate.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transient_index_buffer`.
+		///
+		void allocTransientIndexBuffer(
+			  TransientIndexBuffer* _tib
+			, uint32_t _num
+			);
+
+		/// Allocate transient vertex buffer from encoder's own block of
+		/// transient vertex buffer. Vertex declaration is looked up only the
+		/// first time it's used by encoder during frame.
+		///
+		/// @param[out] _tvb TransientVertexBuffer structure is filled and is valid
+		///   for the duration of frame. Number of allocated vertices can be
+		///   less than requested when transient vertex buffer is full.
+		/// @param[in] _num Number of vertices to allocate.
+		/// @param[in] _decl Vertex declaration.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transient_vertex_buffer`.
+		///
+		void allocTransientVertexBuffer(
+			  TransientVertexBuffer* _tvb
+			, uint32_t _num
+			, const VertexDecl& _decl
+			);
+
+		/// Allocate instance data buffer from encoder's own block of transient
+		/// vertex buffer.
+		///
+		/// @param[out] _idb InstanceDataBuffer structure is filled and is valid
+		///   for duration of frame.
+		/// @param[in] _num Number of instances.
+		/// @param[in] _stride Instance stride. Must be multiple of 16.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_instance_data_buffer`.
+		///
+		void allocInstanceDataBuffer(
+			  InstanceDataBuffer* _idb
+			, uint32_t _num
+			, uint16_t _stride
+			);
+
 		/// Set index buffer for draw primitive.
 		///
 		/// @param[in] _handle Index buffer.
@@ -1333,6 +1466,28 @@ namespace bgfx
 			, uint32_t _num
 			);
 
+		/// Enable merging of consecutive draws into single instanced draw.
+		/// Draws in the same view, with the same program, state, bindings
+		/// and vertex/index buffers, that differ only in transform, are
+		/// submitted as one draw call. First `_stride` bytes of each draw's
+		/// transform are passed to vertex shader as instance data
+		/// (`i_data0`, `i_data1`, ...), and shader must read model matrix
+		/// from instance data instead of `u_model`.
+		///
+		/// @param[in] _enabled Enable auto instancing. It's disabled at the
+		///   beginning of each frame.
+		/// @param[in] _stride Instance data stride. Must be multiple of 16,
+		///   and draws with fewer transform matrices than needed to fill
+		///   stride are not merged.
+		///
+		/// @attention Availability depends on: `BGFX_CAPS_INSTANCING`.
+		/// @attention C99 equivalent is `bgfx_set_auto_instancing`.
+		///
+		void setAutoInstancing(
+			  bool _enabled
+			, uint16_t _stride = 64
+			);
+
 		/// Set number of instances for auto generated instances use in conjuction
 		/// with gl_InstanceID.
 		///
@@ -1899,6 +2054,41 @@ namespace bgfx
 	///
 	void shutdown();
 
+	/// Start replay of frames recorded with `Init::recordFilePath`. Frames are executed
+	/// by renderer on calling thread, without API thread. Must not be called while bgfx
+	/// is initialized.
+	///
+	/// @param[in] _filePath Recording file path.
+	/// @param[in] _init Renderer type, device, platform data, callback, and allocator
+	///   used for replay. Resolution and limits are taken from recording.
+	///
+	/// @returns `true` if recording was opened successfully.
+	///
+	/// @remarks
+	///   Recording contains backend specific shader binaries, it can be replayed only
+	///   by renderer it was recorded with, or by `RendererType::Noop`.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_begin`.
+	///
+	bool replayBegin(const char* _filePath, const Init& _init = {});
+
+	/// Replay next recorded frame.
+	///
+	/// @returns Stats of replayed frame, or NULL when there are no more frames.
+	///   `Stats::cpuTimeFrame` is time spent executing frame on renderer. Frames
+	///   recorded while renderer wasn't initialized (before init or during shutdown)
+	///   are not submitted, and report zero draw, compute and blit counts.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_frame`.
+	///
+	const Stats* replayFrame();
+
+	/// End replay started with `bgfx::replayBegin`.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_end`.
+	///
+	void replayEnd();
+
 	/// Reset graphic settings and back-buffer size.
 	///
 	/// @param[in] _width Back-buffer width.
@@ -1980,6 +2170,34 @@ namespace bgfx
 	///
 	const Stats* getStats();
 
+	/// Returns frame stage timeline of the most recent frames.
+	///
+	/// @param[out] _events Events, oldest first. When NULL only number of available
+	///   events is returned.
+	/// @param[in] _max Maximum number of events to write into `_events`. When there
+	///   are more events available, the most recent ones are returned.
+	///
+	/// @returns Number of events.
+	///
+	/// @remarks
+	///   Timeline keeps last `BGFX_CONFIG_MAX_TIMELINE_EVENTS` events. Events for a
+	///   frame still in flight might be incomplete.
+	///
+	/// @attention C99 equivalent is `bgfx_get_timeline`.
+	///
+	uint32_t getTimeline(TimelineEvent* _events, uint32_t _max);
+
+	/// Write frame stage timeline as Chrome trace event JSON. File can be opened with
+	/// `chrome://tracing` or Perfetto.
+	///
+	/// @param[in] _filePath Output file path.
+	///
+	/// @returns `true` if file was written.
+	///
+	/// @attention C99 equivalent is `bgfx_dump_timeline`.
+	///
+	bool dumpTimeline(const char* _filePath);
+
 	/// Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
 	///
 	/// @param[in] _size Size to allocate.
@@ -2230,6 +2448,27 @@ namespace bgfx
 		, const Memory* _mem
 		);
 
+	/// Queue asynchronous dynamic index buffer update.
+	///
+	/// @param[in] _handle Dynamic index buffer handle.
+	/// @param[in] _startIndex Start index.
+	/// @param[in] _mem Index buffer data.
+	///
+	/// @returns Upload ticket. See: `bgfx::isUploadComplete`.
+	///
+	/// @remarks
+	///   Uploads are passed to renderer in order, at the start of following frames, at most
+	///   `Init::limits.maxUploadSize` bytes per frame. Data referenced with `bgfx::makeRef` is
+	///   copied by upload thread, and release callback is called from that thread.
+	///
+	/// @attention C99 equivalent is `bgfx_update_dynamic_index_buffer_async`.
+	///
+	uint32_t updateAsync(
+		  DynamicIndexBufferHandle _handle
+		, uint32_t _startIndex
+		, const Memory* _mem
+		);
+
 	/// Destroy dynamic index buffer.
 	///
 	/// @param[in] _handle Dynamic index buffer handle.
@@ -2304,6 +2543,25 @@ namespace bgfx
 		, const Memory* _mem
 		);
 
+	/// Queue asynchronous dynamic vertex buffer update.
+	///
+	/// @param[in] _handle Dynamic vertex buffer handle.
+	/// @param[in] _startVertex Start vertex.
+	/// @param[in] _mem Vertex buffer data.
+	///
+	/// @returns Upload ticket. See: `bgfx::isUploadComplete`.
+	///
+	/// @remarks
+	///   See: `bgfx::updateAsync` for dynamic index buffers.
+	///
+	/// @attention C99 equivalent is `bgfx_update_dynamic_vertex_buffer_async`.
+	///
+	uint32_t updateAsync(
+		  DynamicVertexBufferHandle _handle
+		, uint32_t _startVertex
+		, const Memory* _mem
+		);
+
 	/// Destroy dynamic vertex buffer.
 	///
 	/// @param[in] _handle Dynamic vertex buffer handle.
@@ -2722,6 +2980,62 @@ namespace bgfx
 		, uint16_t _pitch = UINT16_MAX
 		);
 
+	/// Queue asynchronous 2D texture update.
+	///
+	/// @param[in] _handle Texture handle.
+	/// @param[in] _layer Layers in texture array.
+	/// @param[in] _mip Mip level.
+	/// @param[in] _x X offset in texture.
+	/// @param[in] _y Y offset in texture.
+	/// @param[in] _width Width of texture block.
+	/// @param[in] _height Height of texture block.
+	/// @param[in] _mem Texture update data.
+	/// @param[in] _pitch Pitch of input image (bytes). When _pitch is set to
+	///   UINT16_MAX, it will be calculated internally based on _width.
+	///
+	/// @returns Upload ticket. See: `bgfx::isUploadComplete`.
+	///
+	/// @remarks
+	///   See: `bgfx::updateAsync`.
+	///
+	/// @attention C99 equivalent is `bgfx_update_texture_2d_async`.
+	///
+	uint32_t updateTexture2DAsync(
+		  TextureHandle _handle
+		, uint16_t _layer
+		, uint8_t _mip
+		, uint16_t _x
+		, uint16_t _y
+		, uint16_t _width
+		, uint16_t _height
+		, const Memory* _mem
+		, uint16_t _pitch = UINT16_MAX
+		);
+
+	/// Returns true when asynchronous upload was executed by renderer.
+	///
+	/// @param[in] _ticket Upload ticket returned by `bgfx::updateAsync` or
+	///   `bgfx::updateTexture2DAsync`.
+	///
+	/// @remarks
+	///   Uploads cancelled by destroying resource are complete too.
+	///
+	/// @attention C99 equivalent is `bgfx_is_upload_complete`.
+	///
+	bool isUploadComplete(uint32_t _ticket);
+
+	/// Pass asynchronous upload, and all uploads queued before it, to renderer in current
+	/// frame regardless of `Init::limits.maxUploadSize`. Blocks until upload thread is done
+	/// with their data.
+	///
+	/// @param[in] _ticket Upload ticket.
+	///
+	/// @returns Frame number when upload will be complete. See: `bgfx::frame`.
+	///
+	/// @attention C99 equivalent is `bgfx_flush_upload`.
+	///
+	uint32_t flushUpload(uint32_t _ticket);
+
 	/// Update 3D texture.
 	///
 	/// @param[in] _handle Texture handle.
@@ -3415,7 +3729,8 @@ namespace bgfx
 	/// @param[in] _mtx Pointer to first matrix in array.
 	/// @param[in] _num Number of matrices in array.
 	/// @returns index into matrix cache in case the same model matrix has
-	///   to be used for other draw primitive call.
+	///   to be used for other draw primitive call. Returns UINT32_MAX when
+	///   matrix cache is full, and draw primitive is dropped.
 	///
 	/// @attention C99 equivalent is `bgfx_set_transform`.
 	///
@@ -3428,7 +3743,8 @@ namespace bgfx
 	///
 	/// @param[in] _transform Pointer to `Transform` structure.
 	/// @param[in] _num Number of matrices.
-	/// @returns index into matrix cache.
+	/// @returns index into matrix cache. Returns UINT32_MAX when matrix cache
+	///   is full, `_transform` is set to NULL data and 0 matrices.
 	///
 	/// @attention Pointer returned can be modifed until `bgfx::frame` is called.
 	/// @attention C99 equivalent is `bgfx_alloc_transform`.
@@ -3675,6 +3991,28 @@ namespace bgfx
 		, uint32_t _num
 		);
 
+	/// Enable merging of consecutive draws into single instanced draw.
+	/// Draws in the same view, with the same program, state, bindings
+	/// and vertex/index buffers, that differ only in transform, are
+	/// submitted as one draw call. First `_stride` bytes of each draw's
+	/// transform are passed to vertex shader as instance data
+	/// (`i_data0`, `i_data1`, ...), and shader must read model matrix
+	/// from instance data instead of `u_model`.
+	///
+	/// @param[in] _enabled Enable auto instancing. It's disabled at the
+	///   beginning of each frame.
+	/// @param[in] _stride Instance data stride. Must be multiple of 16,
+	///   and draws with fewer transform matrices than needed to fill
+	///   stride are not merged.
+	///
+	/// @attention Availability depends on: `BGFX_CAPS_INSTANCING`.
+	/// @attention C99 equivalent is `bgfx_set_auto_instancing`.
+	///
+	void setAutoInstancing(
+		  bool _enabled
+		, uint16_t _stride = 64
+		);
+
 	/// Set number of instances for auto generated instances use in conjuction
 	/// with gl_InstanceID.
 	///
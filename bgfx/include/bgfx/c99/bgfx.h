@@ -300,6 +300,22 @@ typedef enum bgfx_view_mode
 
 } bgfx_view_mode_t;
 
+typedef enum bgfx_timeline_stage
+{
+    BGFX_TIMELINE_STAGE_ENCODER,
+    BGFX_TIMELINE_STAGE_WAIT_RENDER,
+    BGFX_TIMELINE_STAGE_SWAP,
+    BGFX_TIMELINE_STAGE_WAIT_SUBMIT,
+    BGFX_TIMELINE_STAGE_EXEC_PRE,
+    BGFX_TIMELINE_STAGE_SORT,
+    BGFX_TIMELINE_STAGE_SUBMIT,
+    BGFX_TIMELINE_STAGE_EXEC_POST,
+    BGFX_TIMELINE_STAGE_FLIP,
+
+    BGFX_TIMELINE_STAGE_COUNT
+
+} bgfx_timeline_stage_t;
+
 #define BGFX_HANDLE_T(_name) \
     typedef struct _name##_s { uint16_t idx; } _name##_t
 
@@ -357,6 +373,27 @@ typedef struct bgfx_encoder_stats_s
 
 } bgfx_encoder_stats_t;
 
+typedef struct bgfx_profiler_scope_stats_s
+{
+    const char* name;
+    const char* threadName;
+    int64_t     cpuTimeElapsed;
+    uint32_t    count;
+    uint16_t    depth;
+
+} bgfx_profiler_scope_stats_t;
+
+/**/
+typedef struct bgfx_timeline_event_s
+{
+    int64_t  cpuTimeBegin;
+    int64_t  cpuTimeEnd;
+    uint32_t frame;
+    uint16_t encoder;
+    bgfx_timeline_stage_t stage;
+
+} bgfx_timeline_event_t;
+
 /**/
 typedef struct bgfx_stats_s
 {
@@ -375,6 +412,8 @@ typedef struct bgfx_stats_s
     uint32_t numDraw;
     uint32_t numCompute;
     uint32_t numBlit;
+    uint32_t numBatches;
+    uint32_t numBatchedDraws;
     uint32_t maxGpuLatency;
 
     uint16_t numDynamicIndexBuffers;
@@ -393,6 +432,14 @@ typedef struct bgfx_stats_s
     int64_t rtMemoryUsed;
     int32_t transientVbUsed;
     int32_t transientIbUsed;
+    int32_t transientVbWasted;
+    int32_t transientIbWasted;
+
+    uint32_t uniformBytesSaved;
+    uint32_t uniformUpdatesSkipped;
+
+    uint32_t uploadSize;
+    uint32_t numUploadsPending;
 
     uint32_t numPrims[BGFX_TOPOLOGY_COUNT];
 
@@ -410,6 +457,9 @@ typedef struct bgfx_stats_s
     uint8_t               numEncoders;
     bgfx_encoder_stats_t* encoderStats;
 
+    uint16_t                     numProfilerScopes;
+    bgfx_profiler_scope_stats_t* profilerScopes;
+
 } bgfx_stats_t;
 
 /**/
@@ -627,6 +677,9 @@ typedef struct bgfx_init_limits_s
     uint16_t maxEncoders;
     uint32_t transientVbSize;
     uint32_t transientIbSize;
+    uint32_t maxDrawCalls;
+    uint32_t maxUploadSize;
+    uint32_t maxCacheSize;
 
 } bgfx_init_limits_t;
 
@@ -642,6 +695,8 @@ typedef struct bgfx_init_s
     bgfx_platform_data_t platformData;
     bgfx_resolution_t    resolution;
     bgfx_init_limits_t   limits;
+    const char*          recordFilePath;
+    const char*          cacheDirPath;
 
     bgfx_callback_interface_t*  callback;
     bgfx_allocator_interface_t* allocator;
@@ -699,6 +754,15 @@ BGFX_C_API bool bgfx_init(const bgfx_init_t* _init);
 /**/
 BGFX_C_API void bgfx_shutdown(void);
 
+/**/
+BGFX_C_API bool bgfx_replay_begin(const char* _filePath, const bgfx_init_t* _init);
+
+/**/
+BGFX_C_API const bgfx_stats_t* bgfx_replay_frame(void);
+
+/**/
+BGFX_C_API void bgfx_replay_end(void);
+
 /**/
 BGFX_C_API void bgfx_reset(uint32_t _width, uint32_t _height, uint32_t _flags, bgfx_texture_format_t _format);
 
@@ -720,6 +784,12 @@ BGFX_C_API const bgfx_caps_t* bgfx_get_caps(void);
 /**/
 BGFX_C_API const bgfx_stats_t* bgfx_get_stats(void);
 
+/**/
+BGFX_C_API uint32_t bgfx_get_timeline(bgfx_timeline_event_t* _events, uint32_t _max);
+
+/**/
+BGFX_C_API bool bgfx_dump_timeline(const char* _filePath);
+
 /**/
 BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size);
 
@@ -768,6 +838,9 @@ BGFX_C_API bgfx_dynamic_index_buffer_handle_t bgfx_create_dynamic_index_buffer_m
 /**/
 BGFX_C_API void bgfx_update_dynamic_index_buffer(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _startIndex, const bgfx_memory_t* _mem);
 
+/**/
+BGFX_C_API uint32_t bgfx_update_dynamic_index_buffer_async(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _startIndex, const bgfx_memory_t* _mem);
+
 /**/
 BGFX_C_API void bgfx_destroy_dynamic_index_buffer(bgfx_dynamic_index_buffer_handle_t _handle);
 
@@ -780,6 +853,9 @@ BGFX_C_API bgfx_dynamic_vertex_buffer_handle_t bgfx_create_dynamic_vertex_buffer
 /**/
 BGFX_C_API void bgfx_update_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
 
+/**/
+BGFX_C_API uint32_t bgfx_update_dynamic_vertex_buffer_async(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
+
 /**/
 BGFX_C_API void bgfx_destroy_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle);
 
@@ -858,6 +934,15 @@ BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_cube(uint16_t _size, bool _
 /**/
 BGFX_C_API void bgfx_update_texture_2d(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
 
+/**/
+BGFX_C_API uint32_t bgfx_update_texture_2d_async(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
+
+/**/
+BGFX_C_API bool bgfx_is_upload_complete(uint32_t _ticket);
+
+/**/
+BGFX_C_API uint32_t bgfx_flush_upload(uint32_t _ticket);
+
 /**/
 BGFX_C_API void bgfx_update_texture_3d(bgfx_texture_handle_t _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const bgfx_memory_t* _mem);
 
@@ -1008,6 +1093,9 @@ BGFX_C_API void bgfx_set_instance_data_from_vertex_buffer(bgfx_vertex_buffer_han
 /**/
 BGFX_C_API void bgfx_set_instance_data_from_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, uint32_t _num);
 
+/**/
+BGFX_C_API void bgfx_set_auto_instancing(bool _enabled, uint16_t _stride);
+
 /**/
 BGFX_C_API void bgfx_set_instance_count(uint32_t _numInstances);
 
@@ -1110,6 +1198,18 @@ BGFX_C_API void bgfx_encoder_set_vertex_count(struct bgfx_encoder_s* _encoder, u
 /**/
 BGFX_C_API void bgfx_encoder_set_instance_data_buffer(struct bgfx_encoder_s* _encoder, const bgfx_instance_data_buffer_t* _idb, uint32_t _start, uint32_t _num);
 
+/**/
+BGFX_C_API void bgfx_encoder_set_auto_instancing(struct bgfx_encoder_s* _encoder, bool _enabled, uint16_t _stride);
+
+/**/
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(struct bgfx_encoder_s* _encoder, bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+
+/**/
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(struct bgfx_encoder_s* _encoder, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_decl_t* _decl);
+
+/**/
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(struct bgfx_encoder_s* _encoder, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
+
 /**/
 BGFX_C_API void bgfx_encoder_set_instance_data_from_vertex_buffer(struct bgfx_encoder_s* _encoder, bgfx_vertex_buffer_handle_t _handle, uint32_t _startVertex, uint32_t _num);
 
@@ -193,6 +193,21 @@ typedef struct bgfx_interface_vtbl
     void (*encoder_discard)(struct bgfx_encoder_s* _encoder);
     void (*encoder_blit)(struct bgfx_encoder_s* _encoder, bgfx_view_id_t _id, bgfx_texture_handle_t _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, bgfx_texture_handle_t _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
     void (*request_screen_shot)(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
+    void (*encoder_alloc_transient_index_buffer)(struct bgfx_encoder_s* _encoder, bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+    void (*encoder_alloc_transient_vertex_buffer)(struct bgfx_encoder_s* _encoder, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_decl_t* _decl);
+    void (*encoder_alloc_instance_data_buffer)(struct bgfx_encoder_s* _encoder, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
+    void (*set_auto_instancing)(bool _enabled, uint16_t _stride);
+    void (*encoder_set_auto_instancing)(struct bgfx_encoder_s* _encoder, bool _enabled, uint16_t _stride);
+    uint32_t (*update_dynamic_index_buffer_async)(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _startIndex, const bgfx_memory_t* _mem);
+    uint32_t (*update_dynamic_vertex_buffer_async)(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem);
+    uint32_t (*update_texture_2d_async)(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch);
+    bool (*is_upload_complete)(uint32_t _ticket);
+    uint32_t (*flush_upload)(uint32_t _ticket);
+    bool (*replay_begin)(const char* _filePath, const bgfx_init_t* _init);
+    const bgfx_stats_t* (*replay_frame)();
+    void (*replay_end)();
+    uint32_t (*get_timeline)(bgfx_timeline_event_t* _events, uint32_t _max);
+    bool (*dump_timeline)(const char* _filePath);
 
 } bgfx_interface_vtbl_t;
 
@@ -6,7 +6,7 @@
 #ifndef BGFX_DEFINES_H_HEADER_GUARD
 #define BGFX_DEFINES_H_HEADER_GUARD
 
-#define BGFX_API_VERSION UINT32_C(89)
+#define BGFX_API_VERSION UINT32_C(98)
 
 /// Color RGB/alpha/depth write. When it's not specified write will be disabled.
 #define BGFX_STATE_WRITE_R                 UINT64_C(0x0000000000000001) //!< Enable R write.
@@ -311,6 +311,7 @@
 #define BGFX_DEBUG_STATS                 UINT32_C(0x00000004) //!< Enable statistics display.
 #define BGFX_DEBUG_TEXT                  UINT32_C(0x00000008) //!< Enable debug text display.
 #define BGFX_DEBUG_PROFILER              UINT32_C(0x00000010) //!< Enable profiler.
+#define BGFX_DEBUG_PROFILER_TEXT         UINT32_C(0x00000020) //!< Enable profiler, and display CPU profiler scopes with debug text.
 
 ///
 #define BGFX_BUFFER_NONE                 UINT16_C(0x0000) //!<
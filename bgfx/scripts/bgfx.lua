@@ -167,12 +167,15 @@ function bgfxProjectBase(_kind, _defines)
 		if _OPTIONS["with-amalgamated"] then
 			excludes {
 				path.join(BGFX_DIR, "src/bgfx.cpp"),
+				path.join(BGFX_DIR, "src/cache.cpp"),
 				path.join(BGFX_DIR, "src/debug_**.cpp"),
 				path.join(BGFX_DIR, "src/dxgi.cpp"),
 				path.join(BGFX_DIR, "src/glcontext_**.cpp"),
 				path.join(BGFX_DIR, "src/hmd**.cpp"),
 				path.join(BGFX_DIR, "src/image.cpp"),
 				path.join(BGFX_DIR, "src/nvapi.cpp"),
+				path.join(BGFX_DIR, "src/profiler.cpp"),
+				path.join(BGFX_DIR, "src/record.cpp"),
 				path.join(BGFX_DIR, "src/renderer_**.cpp"),
 				path.join(BGFX_DIR, "src/shader**.cpp"),
 				path.join(BGFX_DIR, "src/topology.cpp"),
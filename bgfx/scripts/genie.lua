@@ -48,6 +48,11 @@ newoption {
 	description = "Enable building examples.",
 }
 
+newoption {
+	trigger = "with-tests",
+	description = "Enable building tests.",
+}
+
 solution "bgfx"
 	configurations {
 		"Debug",
@@ -467,4 +472,10 @@ if _OPTIONS["with-tools"] then
 	dofile "texturec.lua"
 	dofile "texturev.lua"
 	dofile "geometryc.lua"
+	dofile "replay.lua"
+end
+
+if _OPTIONS["with-tests"] then
+	group "tests"
+	dofile "test.lua"
 end
@@ -0,0 +1,56 @@
+--
+-- Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+-- License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+--
+
+project "replay"
+	uuid (os.uuid("replay"))
+	kind "ConsoleApp"
+
+	includedirs {
+		path.join(BX_DIR,   "include"),
+		path.join(BIMG_DIR, "include"),
+		path.join(BGFX_DIR, "include"),
+	}
+
+	files {
+		path.join(BGFX_DIR, "tools/replay/**.cpp"),
+	}
+
+	links {
+		"bgfx",
+		"bimg",
+		"bx",
+	}
+
+	configuration { "mingw-*" }
+		targetextension ".exe"
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "vs20*" }
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "linux-* or freebsd" }
+		links {
+			"X11",
+			"GL",
+			"pthread",
+		}
+
+	configuration { "osx" }
+		linkoptions {
+			"-framework Cocoa",
+			"-framework QuartzCore",
+			"-framework OpenGL",
+			"-weak_framework Metal",
+		}
+
+	configuration {}
+
+	strip()
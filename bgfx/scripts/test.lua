@@ -0,0 +1,72 @@
+--
+-- Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+-- License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+--
+
+project "bgfx.test"
+	uuid (os.uuid("bgfx.test"))
+	kind "ConsoleApp"
+
+	debugdir (path.join(BGFX_DIR, "tests"))
+
+	removeflags {
+		"NoExceptions",
+	}
+
+	includedirs {
+		path.join(BX_DIR,   "include"),
+		path.join(BX_DIR,   "3rdparty"),
+		path.join(BIMG_DIR, "include"),
+		path.join(BGFX_DIR, "include"),
+		path.join(BGFX_DIR, "3rdparty"),
+		path.join(BGFX_DIR, "3rdparty/khronos"),
+	}
+
+	files {
+		path.join(BGFX_DIR, "tests/*_test.cpp"),
+		path.join(BGFX_DIR, "tests/*.h"),
+	}
+
+	links {
+		"bgfx",
+		"bimg",
+		"bx",
+	}
+
+	-- Tests include src/bgfx_p.h, it must be configured the same way as library.
+	configuration { "Debug" }
+		defines {
+			"BGFX_CONFIG_DEBUG=1",
+		}
+
+	configuration { "mingw-*" }
+		targetextension ".exe"
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "vs20*" }
+		links {
+			"gdi32",
+			"psapi",
+		}
+
+	configuration { "linux-* or freebsd" }
+		links {
+			"X11",
+			"GL",
+			"pthread",
+		}
+
+	configuration { "osx" }
+		linkoptions {
+			"-framework Cocoa",
+			"-framework QuartzCore",
+			"-framework OpenGL",
+			"-weak_framework Metal",
+		}
+
+	configuration {}
+
+	strip()
@@ -4,12 +4,15 @@
  */
 
 #include "bgfx.cpp"
+#include "cache.cpp"
 #include "debug_renderdoc.cpp"
 #include "dxgi.cpp"
 #include "glcontext_egl.cpp"
 #include "glcontext_glx.cpp"
 #include "glcontext_wgl.cpp"
 #include "nvapi.cpp"
+#include "profiler.cpp"
+#include "record.cpp"
 #include "renderer_d3d9.cpp"
 #include "renderer_d3d11.cpp"
 #include "renderer_d3d12.cpp"
@@ -10,6 +10,9 @@
 #include <bx/file.h>
 #include <bx/mutex.h>
 
+#include "cache.h"
+#include "profiler.h"
+#include "record.h"
 #include "topology.h"
 
 BX_ERROR_RESULT(BGFX_ERROR_TEXTURE_VALIDATION,  BX_MAKEFOURCC('b', 'g', 0, 1) );
@@ -50,8 +53,38 @@ namespace bgfx
 
 	struct CallbackStub : public CallbackI
 	{
+		CallbackStub()
+			: m_cache(NULL)
+		{
+		}
+
 		virtual ~CallbackStub()
 		{
+			closeCache();
+		}
+
+		// Cache is allocated only when used, and freed on shutdown before leak check.
+		bool openCache(const char* _dirPath, uint32_t _maxSize)
+		{
+			closeCache();
+
+			m_cache = BX_NEW(g_allocator, DiskCache);
+			if (!m_cache->open(_dirPath, _maxSize) )
+			{
+				closeCache();
+				return false;
+			}
+
+			return true;
+		}
+
+		void closeCache()
+		{
+			if (NULL != m_cache)
+			{
+				BX_DELETE(g_allocator, m_cache);
+				m_cache = NULL;
+			}
 		}
 
 		virtual void fatal(const char* _filePath, uint16_t _line, Fatal::Enum _code, const char* _str) override
@@ -99,18 +132,22 @@ namespace bgfx
 		{
 		}
 
-		virtual uint32_t cacheReadSize(uint64_t /*_id*/) override
+		virtual uint32_t cacheReadSize(uint64_t _id) override
 		{
-			return 0;
+			return NULL != m_cache ? m_cache->readSize(_id) : 0;
 		}
 
-		virtual bool cacheRead(uint64_t /*_id*/, void* /*_data*/, uint32_t /*_size*/) override
+		virtual bool cacheRead(uint64_t _id, void* _data, uint32_t _size) override
 		{
-			return false;
+			return NULL != m_cache && m_cache->read(_id, _data, _size);
 		}
 
-		virtual void cacheWrite(uint64_t /*_id*/, const void* /*_data*/, uint32_t /*_size*/) override
+		virtual void cacheWrite(uint64_t _id, const void* _data, uint32_t _size) override
 		{
+			if (NULL != m_cache)
+			{
+				m_cache->write(_id, _data, _size);
+			}
 		}
 
 		virtual void screenShot(const char* _filePath, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _data, uint32_t _size, bool _yflip) override
@@ -142,6 +179,8 @@ namespace bgfx
 		virtual void captureFrame(const void* /*_data*/, uint32_t /*_size*/) override
 		{
 		}
+
+		DiskCache* m_cache;
 	};
 
 #ifndef BGFX_CONFIG_MEMORY_TRACKING
@@ -1083,6 +1122,272 @@ namespace bgfx
 		}
 	}
 
+	uint32_t EncoderImpl::getNumVertices() const
+	{
+		if (UINT8_MAX != m_draw.m_streamMask)
+		{
+			uint32_t numVertices = UINT32_MAX;
+			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
+				; 0 != streamMask
+				; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
+				)
+			{
+				streamMask >>= ntz;
+				idx         += ntz;
+				numVertices = bx::min(numVertices, m_numVertices[idx]);
+			}
+
+			return numVertices;
+		}
+
+		return m_numVertices[0];
+	}
+
+	uint64_t EncoderImpl::encodeDrawKey(ViewId _id, ProgramHandle _program, uint32_t _depth)
+	{
+		m_key.m_program = kInvalidHandle == _program.idx
+			? 0
+			: _program.idx
+			;
+
+		m_key.m_view = _id;
+
+		SortKey::Enum type = SortKey::SortProgram;
+		switch (s_ctx->m_view[_id].m_mode)
+		{
+		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
+		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
+		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
+		default: break;
+		}
+
+		return m_key.encodeDraw(type);
+	}
+
+	void EncoderImpl::writeUniform(UniformType::Enum _type, UniformHandle _handle, const void* _value, uint16_t _num)
+	{
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+
+		// When value is the same as the last one written for this uniform by this encoder,
+		// reference already written data instead of copying it again. Opcode is still
+		// written since draws might be reordered by sort.
+		const uint32_t size = g_uniformTypeSize[_type]*_num;
+		const uint32_t hash = bx::hash<bx::HashMurmur2A>(_value, size);
+
+		UniformCacheEntry& entry = m_uniformCache[_handle.idx];
+		if (entry.m_epoch == m_uniformCacheEpoch
+		&&  entry.m_hash  == hash
+		&&  entry.m_size  == size
+		&&  0 == bx::memCmp(uniformBuffer->getData(entry.m_pos), _value, size) )
+		{
+			uniformBuffer->writeUniformRef(_type, _handle.idx, entry.m_pos, _num);
+			m_uniformBytesSaved += size - sizeof(uint32_t);
+			return;
+		}
+
+		uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
+
+		entry.m_epoch = m_uniformCacheEpoch;
+		entry.m_hash  = hash;
+		entry.m_size  = size;
+		entry.m_pos   = uniformBuffer->getPos() - size;
+	}
+
+	static bool isBindingEqual(const Binding& _a, const Binding& _b)
+	{
+		if (_a.m_idx  != _b.m_idx
+		||  _a.m_type != _b.m_type)
+		{
+			return false;
+		}
+
+		if (kInvalidHandle == _a.m_idx)
+		{
+			return true;
+		}
+
+		switch (_a.m_type)
+		{
+		case Binding::Texture:
+			return _a.m_un.m_draw.m_textureFlags == _b.m_un.m_draw.m_textureFlags;
+
+		case Binding::Image:
+			return _a.m_un.m_compute.m_format == _b.m_un.m_compute.m_format
+				&& _a.m_un.m_compute.m_access == _b.m_un.m_compute.m_access
+				&& _a.m_un.m_compute.m_mip    == _b.m_un.m_compute.m_mip
+				;
+
+		default:
+			return _a.m_un.m_compute.m_access == _b.m_un.m_compute.m_access;
+		}
+	}
+
+	static bool isBindEqual(const RenderBind& _a, const RenderBind& _b)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
+		{
+			if (!isBindingEqual(_a.m_bind[ii], _b.m_bind[ii]) )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool isStreamEqual(const RenderDraw& _a, const RenderDraw& _b)
+	{
+		if (_a.m_streamMask != _b.m_streamMask)
+		{
+			return false;
+		}
+
+		// UINT8_MAX stream mask is used for draws without vertex buffers (setVertexCount),
+		// only first stream carries vertex count, others are not initialized.
+		const uint8_t mask = UINT8_MAX == _a.m_streamMask ? 1 : _a.m_streamMask;
+
+		for (uint32_t idx = 0, streamMask = mask, ntz = bx::uint32_cnttz(streamMask)
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
+			)
+		{
+			streamMask >>= ntz;
+			idx         += ntz;
+
+			const Stream& a = _a.m_stream[idx];
+			const Stream& b = _b.m_stream[idx];
+			if (a.m_handle.idx  != b.m_handle.idx
+			||  a.m_decl.idx    != b.m_decl.idx
+			||  a.m_startVertex != b.m_startVertex)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool isBatchCompatible(const RenderDraw& _a, const RenderBind& _aBind, const RenderDraw& _b, const RenderBind& _bBind)
+	{
+		return _a.m_stateFlags      == _b.m_stateFlags
+			&& _a.m_stencil         == _b.m_stencil
+			&& _a.m_rgba            == _b.m_rgba
+			&& _a.m_startIndex      == _b.m_startIndex
+			&& _a.m_numIndices      == _b.m_numIndices
+			&& _a.m_numVertices     == _b.m_numVertices
+			&& _a.m_scissor         == _b.m_scissor
+			&& _a.m_submitFlags     == _b.m_submitFlags
+			&& _a.m_indexBuffer.idx == _b.m_indexBuffer.idx
+			&& isStreamEqual(_a, _b)
+			&& isBindEqual(_aBind, _bBind)
+			;
+	}
+
+	bool EncoderImpl::batch(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState)
+	{
+		// Only draws that differ from previous one by transform can be merged. Draw's own
+		// uniforms, instance data or indirect arguments can't be expressed per instance.
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		if (isValid(_occlusionQuery)
+		||  isValid(m_draw.m_instanceDataBuffer)
+		||  isValid(m_draw.m_indirectBuffer)
+		||  1 != m_draw.m_numInstances
+		||  kInvalidHandle == _program.idx
+		||  m_uniformBegin != uniformBuffer->getPos()
+		||  uint32_t(m_draw.m_numMatrices)*sizeof(Matrix4) < m_autoInstancingStride)
+		{
+			flushBatch();
+			return false;
+		}
+
+		m_draw.m_numVertices = getNumVertices();
+
+		if (0 != m_batchNum)
+		{
+			// Depth is part of sort key only in depth sorted views.
+			const uint8_t mode = s_ctx->m_view[_id].m_mode;
+			const bool depthSorted = ViewMode::DepthAscending == mode || ViewMode::DepthDescending == mode;
+
+			if (BGFX_CONFIG_MAX_AUTO_INSTANCING_BATCH == m_batchNum
+			||  m_batchView        != _id
+			||  m_batchProgram.idx != _program.idx
+			|| (m_batchDepth       != _depth && depthSorted)
+			||  !isBatchCompatible(m_batchDraw, m_batchBind, m_draw, m_bind) )
+			{
+				flushBatch();
+			}
+		}
+
+		if (0 == m_batchNum)
+		{
+			m_batchKey     = encodeDrawKey(_id, _program, _depth);
+			m_batchDraw    = m_draw;
+			m_batchBind    = m_bind;
+			m_batchProgram = _program;
+			m_batchView    = _id;
+			m_batchDepth   = _depth;
+		}
+
+		m_batchMatrix[m_batchNum++] = m_draw.m_startMatrix;
+
+		if (!_preserveState)
+		{
+			m_draw.clear();
+			m_bind.clear();
+		}
+
+		return true;
+	}
+
+	void EncoderImpl::flushBatch()
+	{
+		if (0 == m_batchNum)
+		{
+			return;
+		}
+
+		const uint32_t num = m_batchNum;
+		m_batchNum = 0;
+
+		InstanceDataBuffer idb;
+		allocInstanceDataBuffer(&idb, num, m_autoInstancingStride);
+
+		const uint32_t renderItemIdx = 0 < idb.num
+			? allocRenderItem()
+			: UINT32_MAX
+			;
+		if (UINT32_MAX == renderItemIdx)
+		{
+			m_numDropped += num;
+			return;
+		}
+
+		m_numDropped      += num - idb.num;
+		m_numSubmitted    += idb.num;
+		m_numBatches      += 1;
+		m_numBatchedDraws += idb.num;
+
+		// Instance data is draw's transform, first matrix is passed in i_data0-i_data3.
+		MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+		for (uint32_t ii = 0; ii < idb.num; ++ii)
+		{
+			bx::memCopy(&idb.data[ii*idb.stride], matrixCache.toPtr(m_batchMatrix[ii]), idb.stride);
+		}
+
+		setSortKey(renderItemIdx, m_batchKey);
+
+		m_batchDraw.m_uniformIdx   = m_uniformIdx;
+		m_batchDraw.m_uniformBegin = m_uniformBegin;
+		m_batchDraw.m_uniformEnd   = m_uniformBegin;
+		m_batchDraw.m_instanceDataOffset = idb.offset;
+		m_batchDraw.m_instanceDataStride = idb.stride;
+		m_batchDraw.m_numInstances       = idb.num;
+		m_batchDraw.m_instanceDataBuffer = idb.handle;
+
+		m_frame->getRenderItem(renderItemIdx).draw = m_batchDraw;
+		m_frame->getRenderItemBind(renderItemIdx)  = m_batchBind;
+	}
+
 	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState)
 	{
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM)
@@ -1115,8 +1420,14 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		if (0 != m_autoInstancingStride
+		&&  batch(_id, _program, _occlusionQuery, _depth, _preserveState) )
+		{
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard();
 			++m_numDropped;
@@ -1128,50 +1439,14 @@ namespace bgfx
 		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 		m_uniformEnd = uniformBuffer->getPos();
 
-		m_key.m_program = kInvalidHandle == _program.idx
-			? 0
-			: _program.idx
-			;
-
-		m_key.m_view = _id;
-
-		SortKey::Enum type = SortKey::SortProgram;
-		switch (s_ctx->m_view[_id].m_mode)
-		{
-		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
-		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
-		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
-		default: break;
-		}
-
-		uint64_t key = m_key.encodeDraw(type);
+		uint64_t key = encodeDrawKey(_id, _program, _depth);
 
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		setSortKey(renderItemIdx, key);
 
 		m_draw.m_uniformIdx   = m_uniformIdx;
 		m_draw.m_uniformBegin = m_uniformBegin;
 		m_draw.m_uniformEnd   = m_uniformEnd;
-
-		if (UINT8_MAX != m_draw.m_streamMask)
-		{
-			uint32_t numVertices = UINT32_MAX;
-			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
-				; 0 != streamMask
-				; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
-				)
-			{
-				streamMask >>= ntz;
-				idx         += ntz;
-				numVertices = bx::min(numVertices, m_numVertices[idx]);
-			}
-
-			m_draw.m_numVertices = numVertices;
-		}
-		else
-		{
-			m_draw.m_numVertices = m_numVertices[0];
-		}
+		m_draw.m_numVertices  = getNumVertices();
 
 		if (isValid(_occlusionQuery) )
 		{
@@ -1179,8 +1454,8 @@ namespace bgfx
 			m_draw.m_occlusionQuery = _occlusionQuery;
 		}
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+		m_frame->getRenderItem(renderItemIdx).draw = m_draw;
+		m_frame->getRenderItemBind(renderItemIdx)  = m_bind;
 
 		if (!_preserveState)
 		{
@@ -1192,6 +1467,8 @@ namespace bgfx
 
 	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ, uint8_t _flags)
 	{
+		flushBatch();
+
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
 		{
 			m_uniformSet.clear();
@@ -1203,8 +1480,8 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
 		{
 			discard();
 			++m_numDropped;
@@ -1229,14 +1506,13 @@ namespace bgfx
 		m_key.m_seq     = s_ctx->getSeqIncr(_id);
 
 		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		setSortKey(renderItemIdx, key);
 
 		m_compute.m_uniformIdx   = m_uniformIdx;
 		m_compute.m_uniformBegin = m_uniformBegin;
 		m_compute.m_uniformEnd   = m_uniformEnd;
-		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
-		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+		m_frame->getRenderItem(renderItemIdx).compute = m_compute;
+		m_frame->getRenderItemBind(renderItemIdx)     = m_bind;
 
 		m_compute.clear();
 		m_bind.clear();
@@ -1275,71 +1551,743 @@ namespace bgfx
 		}
 	}
 
-	void Frame::sort()
+	VertexDeclHandle EncoderImpl::findVertexDecl(const VertexDecl& _decl)
 	{
-		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
-
-		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		for (uint32_t ii = 0, num = m_numDeclCache; ii < num; ++ii)
 		{
-			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+			if (m_declCacheHash[ii] == _decl.m_hash)
+			{
+				return m_declCache[ii];
+			}
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		VertexDeclHandle declHandle;
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+			declHandle = s_ctx->findTransientVertexDecl(_decl);
 		}
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
 
-		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
-		{
-			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
-		}
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+		// Handles can't be released before end of frame, cache is reset on begin.
+		const uint32_t idx = m_numDeclCache < BX_COUNTOF(m_declCache)
+			? m_numDeclCache++
+			: _decl.m_hash % BX_COUNTOF(m_declCache)
+			;
+		m_declCacheHash[idx] = _decl.m_hash;
+		m_declCache[idx]     = declHandle;
+
+		return declHandle;
 	}
 
-	RenderFrame::Enum renderFrame(int32_t _msecs)
+	void EncoderImpl::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
 	{
-		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
-		{
-			if (s_renderFrameCalled)
-			{
-				BGFX_CHECK_RENDER_THREAD();
-			}
+		uint32_t size = _num*sizeof(uint16_t);
+		const uint32_t offset = allocTransient(m_tibBlock
+			, &m_frame->m_iboffset
+			, g_caps.limits.transientIbSize
+			, &m_frame->m_ibwasted
+			, size
+			, sizeof(uint16_t)
+			);
 
-			if (NULL == s_ctx)
-			{
-				s_renderFrameCalled = true;
-				s_threadIndex = ~BGFX_API_THREAD_MAGIC;
-				return RenderFrame::NoContext;
-			}
+		TransientIndexBuffer& tib = *m_frame->m_transientIb;
 
-			int32_t msecs = -1 == _msecs
-				? BGFX_CONFIG_API_SEMAPHORE_TIMEOUT
-				: _msecs
-				;
-			RenderFrame::Enum result = s_ctx->renderFrame(msecs);
-			if (RenderFrame::Exiting == result)
-			{
-				Context* ctx = s_ctx;
-				ctx->apiSemWait();
-				s_ctx = NULL;
-				ctx->renderSemPost();
-			}
+		_tib->data       = &tib.data[offset];
+		_tib->size       = size/sizeof(uint16_t)*sizeof(uint16_t);
+		_tib->handle     = tib.handle;
+		_tib->startIndex = offset/sizeof(uint16_t);
+	}
 
-			return result;
-		}
+	void EncoderImpl::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl)
+	{
+		const VertexDeclHandle declHandle = findVertexDecl(_decl);
 
-		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");
-		return RenderFrame::NoContext;
+		uint32_t size = _num*_decl.m_stride;
+		const uint32_t offset = allocTransient(m_tvbBlock
+			, &m_frame->m_vboffset
+			, g_caps.limits.transientVbSize
+			, &m_frame->m_vbwasted
+			, size
+			, _decl.m_stride
+			);
+
+		TransientVertexBuffer& dvb = *m_frame->m_transientVb;
+
+		_tvb->data        = &dvb.data[offset];
+		_tvb->size        = size/_decl.m_stride*_decl.m_stride;
+		_tvb->startVertex = offset/_decl.m_stride;
+		_tvb->stride      = _decl.m_stride;
+		_tvb->handle      = dvb.handle;
+		_tvb->decl        = declHandle;
 	}
 
-	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
+	void EncoderImpl::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
 	{
-		sizeof(int32_t),
-		0,
-		4*sizeof(float),
-		3*3*sizeof(float),
+		const uint16_t stride = BX_ALIGN_16(_stride);
+
+		uint32_t size = _num*stride;
+		const uint32_t offset = allocTransient(m_tvbBlock
+			, &m_frame->m_vboffset
+			, g_caps.limits.transientVbSize
+			, &m_frame->m_vbwasted
+			, size
+			, stride
+			);
+
+		TransientVertexBuffer& dvb = *m_frame->m_transientVb;
+
+		_idb->data   = &dvb.data[offset];
+		_idb->num    = size/stride;
+		_idb->size   = _idb->num*stride;
+		_idb->offset = offset;
+		_idb->stride = stride;
+		_idb->handle = dvb.handle;
+	}
+
+	void Frame::moveRenderItems(uint32_t _dst, uint32_t _src, uint32_t _num)
+	{
+		// Destination is always before source, copying forward span by span, where span
+		// doesn't cross render item chunk on either side, is safe for overlapping ranges.
+		while (0 < _num)
+		{
+			const uint32_t dstChunk = _dst%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+			const uint32_t srcChunk = _src%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE;
+			const uint32_t size = bx::min(_num, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE - bx::max(dstChunk, srcChunk) );
+
+			RenderItemChunk& dst = m_renderItemChunk[_dst/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+			const RenderItemChunk& src = m_renderItemChunk[_src/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+
+			bx::memMove(&dst.m_sortKey[dstChunk],        &src.m_sortKey[srcChunk],        size*sizeof(uint64_t) );
+			bx::memMove(&dst.m_renderItem[dstChunk],     &src.m_renderItem[srcChunk],     size*sizeof(RenderItem) );
+			bx::memMove(&dst.m_renderItemBind[dstChunk], &src.m_renderItemBind[srcChunk], size*sizeof(RenderBind) );
+
+			for (uint32_t ii = 0; ii < size; ++ii)
+			{
+				dst.m_sortValue[dstChunk+ii] = RenderItemCount(_dst+ii);
+			}
+
+			_dst += size;
+			_src += size;
+			_num -= size;
+		}
+	}
+
+	void Frame::compact()
+	{
+		// Each encoder returns unused tail of its last render item slab. Close those gaps by
+		// moving later items down, preserving submission order, so that draws with equal sort
+		// keys are still rendered in the order they were submitted.
+		const uint32_t maxEncoders = g_caps.limits.maxEncoders;
+		RenderItemSlab* slab = (RenderItemSlab*)alloca(sizeof(RenderItemSlab)*maxEncoders);
+		uint32_t numSlabs = 0;
+
+		for (uint32_t ii = 0; ii < maxEncoders; ++ii)
+		{
+			if (m_unusedSlab[ii].m_begin != m_unusedSlab[ii].m_end)
+			{
+				slab[numSlabs++] = m_unusedSlab[ii];
+			}
+
+			m_unusedSlab[ii].clear();
+		}
+
+		if (0 == numSlabs)
+		{
+			return;
+		}
+
+		// Insertion sort, there is at most one slab per encoder.
+		for (uint32_t ii = 1; ii < numSlabs; ++ii)
+		{
+			const RenderItemSlab tmp = slab[ii];
+			uint32_t jj = ii;
+			for (; 0 < jj && slab[jj-1].m_begin > tmp.m_begin; --jj)
+			{
+				slab[jj] = slab[jj-1];
+			}
+			slab[jj] = tmp;
+		}
+
+		const uint32_t numRenderItems = m_numRenderItems;
+		uint32_t dst = slab[0].m_begin;
+
+		for (uint32_t ii = 0; ii < numSlabs; ++ii)
+		{
+			const uint32_t begin = bx::min(slab[ii].m_end, numRenderItems);
+			const uint32_t end   = ii+1 < numSlabs
+				? bx::min(slab[ii+1].m_begin, numRenderItems)
+				: numRenderItems
+				;
+
+			if (begin < end)
+			{
+				moveRenderItems(dst, begin, end-begin);
+				dst += end-begin;
+			}
+		}
+
+		m_numRenderItems = dst;
+	}
+
+	void Frame::reserveSortKeys(uint32_t _num)
+	{
+		// One extra entry for terminator key.
+		if (m_sortCapacity < _num+1)
+		{
+			m_sortCapacity = bx::min(bx::max(_num+1, m_sortCapacity + m_sortCapacity/2), g_caps.limits.maxDrawCalls+1);
+			m_sortKeys     = (uint64_t*)BX_REALLOC(g_allocator, m_sortKeys, m_sortCapacity*sizeof(uint64_t) );
+			m_sortValues   = (RenderItemCount*)BX_REALLOC(g_allocator, m_sortValues, m_sortCapacity*sizeof(RenderItemCount) );
+			m_drawChanged  = (uint8_t*)BX_REALLOC(g_allocator, m_drawChanged, m_sortCapacity*sizeof(uint8_t) );
+
+			if (0 != BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE)
+			{
+				m_modelView     = (Matrix4*)BX_ALIGNED_REALLOC(g_allocator, m_modelView, m_sortCapacity*sizeof(Matrix4), 16);
+				m_modelViewProj = (Matrix4*)BX_ALIGNED_REALLOC(g_allocator, m_modelViewProj, m_sortCapacity*sizeof(Matrix4), 16);
+			}
+		}
+
+		if (s_ctx->m_tempCapacity < _num)
+		{
+			s_ctx->m_tempCapacity = m_sortCapacity;
+			s_ctx->m_tempKeys     = (uint64_t*)BX_REALLOC(g_allocator, s_ctx->m_tempKeys, s_ctx->m_tempCapacity*sizeof(uint64_t) );
+			s_ctx->m_tempValues   = (RenderItemCount*)BX_REALLOC(g_allocator, s_ctx->m_tempValues, s_ctx->m_tempCapacity*sizeof(RenderItemCount) );
+		}
+	}
+
+	void Frame::gatherRenderItems(ViewId* _viewRemap)
+	{
+		// Copy sort keys out of render item chunks into contiguous array.
+		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ii += BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+		{
+			const RenderItemChunk& chunk = m_renderItemChunk[ii/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+			const uint32_t size = bx::min<uint32_t>(num-ii, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+
+			for (uint32_t jj = 0; jj < size; ++jj)
+			{
+				m_sortKeys[ii+jj] = SortKey::remapView(chunk.m_sortKey[jj], _viewRemap);
+			}
+
+			bx::memCopy(&m_sortValues[ii], chunk.m_sortValue, size*sizeof(RenderItemCount) );
+		}
+	}
+
+	static int32_t compareRunBegin(const void* _lhs, const void* _rhs)
+	{
+		const RenderItemSlab& lhs = *(const RenderItemSlab*)_lhs;
+		const RenderItemSlab& rhs = *(const RenderItemSlab*)_rhs;
+		return lhs.m_begin < rhs.m_begin ? -1 : (lhs.m_begin > rhs.m_begin ? 1 : 0);
+	}
+
+	void Frame::gatherRuns(ViewId* _viewRemap)
+	{
+		// Runs are registered in order encoders finish them. Order them by position, so that
+		// stable sort keeps equal keys in the same order regardless of thread timing.
+		bx::quickSort(m_run, m_numRuns, sizeof(RenderItemSlab), compareRunBegin);
+
+		// Runs are not compacted, copy them to the beginning of sort keys.
+		uint32_t num = 0;
+		for (uint32_t ii = 0, numRuns = m_numRuns; ii < numRuns; ++ii)
+		{
+			const RenderItemSlab& run = m_run[ii];
+			const uint32_t size = run.m_end - run.m_begin;
+			const uint64_t* keys = &getSortKey(run.m_begin);
+
+			for (uint32_t jj = 0; jj < size; ++jj)
+			{
+				m_sortKeys[num+jj] = SortKey::remapView(keys[jj], _viewRemap);
+			}
+
+			bx::memCopy(&m_sortValues[num], &getSortValue(run.m_begin), size*sizeof(RenderItemCount) );
+			num += size;
+		}
+
+		m_numRenderItems = num;
+	}
+
+	static bool runLess(const RenderItemSlab& _a, const RenderItemSlab& _b, Frame* _frame)
+	{
+		// Equal keys are ordered by position, so that items from earlier run are merged first,
+		// and result doesn't depend on order in which encoders registered their runs.
+		const uint64_t keyA = _frame->getSortKey(_a.m_begin);
+		const uint64_t keyB = _frame->getSortKey(_b.m_begin);
+		return keyA < keyB
+			|| (keyA == keyB && _a.m_begin < _b.m_begin)
+			;
+	}
+
+	static void siftDown(uint32_t* _heap, uint32_t _idx, uint32_t _num, const RenderItemSlab* _run, Frame* _frame)
+	{
+		const uint32_t top = _heap[_idx];
+
+		uint32_t ii = _idx;
+		for (uint32_t child = ii*2+1; child < _num; child = ii*2+1)
+		{
+			if (child+1 < _num
+			&&  runLess(_run[_heap[child+1] ], _run[_heap[child] ], _frame) )
+			{
+				++child;
+			}
+
+			if (!runLess(_run[_heap[child] ], _run[top], _frame) )
+			{
+				break;
+			}
+
+			_heap[ii] = _heap[child];
+			ii = child;
+		}
+
+		_heap[ii] = top;
+	}
+
+	void Frame::mergeRuns()
+	{
+		// K-way merge of runs sorted by encoders.
+		RenderItemSlab* run = m_run;
+		uint32_t numHeap = m_numRuns;
+
+		uint32_t* heap = m_runHeap;
+		for (uint32_t ii = 0; ii < numHeap; ++ii)
+		{
+			heap[ii] = ii;
+		}
+
+		for (uint32_t ii = numHeap/2; 0 < ii--;)
+		{
+			siftDown(heap, ii, numHeap, run, this);
+		}
+
+		uint32_t num = 0;
+		while (0 < numHeap)
+		{
+			RenderItemSlab& top = run[heap[0] ];
+
+			// Keep taking items from the top run, as long as they are not greater than
+			// first item of the next smallest run. Items equal to it are taken only when
+			// top run precedes next run.
+			uint64_t limit     = UINT64_MAX;
+			bool     inclusive = true;
+			if (1 < numHeap)
+			{
+				const RenderItemSlab* next = &run[heap[1] ];
+				if (2 < numHeap
+				&&  runLess(run[heap[2] ], *next, this) )
+				{
+					next = &run[heap[2] ];
+				}
+
+				limit     = getSortKey(next->m_begin);
+				inclusive = top.m_begin < next->m_begin;
+			}
+
+			// Run never crosses render item chunk.
+			const uint64_t* keys = &getSortKey(top.m_begin);
+			const RenderItemCount* values = &getSortValue(top.m_begin);
+			const uint32_t size = top.m_end - top.m_begin;
+
+			uint32_t jj = 0;
+			do
+			{
+				m_sortKeys[num]   = keys[jj];
+				m_sortValues[num] = values[jj];
+				++num;
+				++jj;
+
+			} while (jj < size
+				&&  (keys[jj] < limit || (inclusive && keys[jj] == limit) ) );
+
+			top.m_begin += jj;
+
+			if (top.m_begin == top.m_end)
+			{
+				heap[0] = heap[--numHeap];
+			}
+
+			if (1 < numHeap)
+			{
+				siftDown(heap, 0, numHeap, run, this);
+			}
+		}
+
+		m_numRenderItems = num;
+	}
+
+	static uint8_t diffDraw(const RenderDraw& _prev, const RenderBind& _prevBind, const RenderDraw& _draw, const RenderBind& _bind)
+	{
+		uint8_t changed = 0;
+		changed |= _prev.m_stateFlags != _draw.m_stateFlags ? BGFX_DRAW_CHANGED_STATE        : 0;
+		changed |= _prev.m_stencil    != _draw.m_stencil    ? BGFX_DRAW_CHANGED_STENCIL      : 0;
+		changed |= _prev.m_scissor    != _draw.m_scissor    ? BGFX_DRAW_CHANGED_SCISSOR      : 0;
+		changed |= _prev.m_rgba       != _draw.m_rgba       ? BGFX_DRAW_CHANGED_BLEND_FACTOR : 0;
+		changed |= _draw.m_uniformBegin < _draw.m_uniformEnd ? BGFX_DRAW_CHANGED_UNIFORMS    : 0;
+
+		if (_prev.m_indexBuffer.idx        != _draw.m_indexBuffer.idx
+		||  _prev.m_instanceDataBuffer.idx != _draw.m_instanceDataBuffer.idx
+		||  _prev.m_instanceDataOffset     != _draw.m_instanceDataOffset
+		||  _prev.m_instanceDataStride     != _draw.m_instanceDataStride
+		||  !isStreamEqual(_prev, _draw) )
+		{
+			changed |= BGFX_DRAW_CHANGED_STREAMS;
+		}
+
+		changed |= !isBindEqual(_prevBind, _bind) ? BGFX_DRAW_CHANGED_BINDINGS : 0;
+
+		return changed;
+	}
+
+	void Frame::diffRenderItems()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Diff", 0xff2040ff);
+
+		// Precompute what changed between consecutive sorted draws, so that backends
+		// don't have to compare draw state field by field. First draw in view, and
+		// draw following compute are marked as completely changed since backends
+		// reset their state there.
+		uint64_t prevKey = 0;
+		const RenderItem* prev = NULL;
+		const RenderBind* prevBind = NULL;
+
+		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		{
+			const uint64_t key = m_sortKeys[ii];
+			const uint32_t itemIdx = m_sortValues[ii];
+			const RenderItem& renderItem = getRenderItem(itemIdx);
+			const RenderBind& renderBind = getRenderItemBind(itemIdx);
+
+			if (0 == (key & SORT_KEY_DRAW_BIT) )
+			{
+				m_drawChanged[ii] = BGFX_DRAW_CHANGED_ALL;
+				prev = NULL;
+				continue;
+			}
+
+			if (NULL == prev
+			||  SortKey::decodeView(prevKey) != SortKey::decodeView(key) )
+			{
+				m_drawChanged[ii] = BGFX_DRAW_CHANGED_ALL;
+			}
+			else
+			{
+				m_drawChanged[ii] = diffDraw(prev->draw, *prevBind, renderItem.draw, renderBind);
+			}
+
+			prevKey  = key;
+			prev     = &renderItem;
+			prevBind = &renderBind;
+		}
+
+		m_drawChanged[m_numRenderItems] = BGFX_DRAW_CHANGED_ALL;
+	}
+
+	void Frame::computeModelMatrices(uint32_t _begin, uint32_t _end)
+	{
+		ViewId view = UINT16_MAX;
+		Matrix4 viewProj;
+		viewProj.setIdentity();
+
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const uint64_t key = m_sortKeys[ii];
+			if (0 == (key & SORT_KEY_DRAW_BIT) )
+			{
+				continue;
+			}
+
+			// Same as ViewState, view and projection are looked up by view id before
+			// remap.
+			const ViewId id = m_viewRemap[SortKey::decodeView(key)];
+			if (id != view)
+			{
+				view = id;
+				bx::float4x4_mul(&viewProj.un.f4x4
+					, &m_view[view].m_view.un.f4x4
+					, &m_view[view].m_proj[0].un.f4x4
+					);
+			}
+
+			const RenderDraw& draw = getRenderItem(m_sortValues[ii]).draw;
+			const Matrix4& model = m_frameCache.m_matrixCache.get(draw.m_startMatrix);
+			bx::float4x4_mul(&m_modelView[ii].un.f4x4, &model.un.f4x4, &m_view[view].m_view.un.f4x4);
+			bx::float4x4_mul(&m_modelViewProj[ii].un.f4x4, &model.un.f4x4, &viewProj.un.f4x4);
+		}
+	}
+
+	struct ModelMatricesJob
+	{
+		static void execute(void* _userData, uint32_t _idx)
+		{
+			const ModelMatricesJob& job = *(const ModelMatricesJob*)_userData;
+			const uint32_t begin = _idx*job.m_batchSize;
+			const uint32_t end   = bx::min(begin+job.m_batchSize, job.m_num);
+			job.m_frame->computeModelMatrices(begin, end);
+		}
+
+		Frame*   m_frame;
+		uint32_t m_num;
+		uint32_t m_batchSize;
+	};
+
+	void Frame::computeModelMatrices()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Model matrices", 0xff2040ff);
+
+		const uint32_t num        = m_numRenderItems;
+		const uint32_t batchSize  = bx::max<uint32_t>(BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE, 1);
+		const uint32_t numBatches = (num + batchSize-1)/batchSize;
+
+#if BGFX_CONFIG_MULTITHREADED
+		if (1 < numBatches)
+		{
+			ModelMatricesJob job;
+			job.m_frame = this;
+			job.m_num   = num;
+			job.m_batchSize = batchSize;
+			s_ctx->m_jobScheduler.run(ModelMatricesJob::execute, &job, numBatches);
+		}
+		else
+#endif // BGFX_CONFIG_MULTITHREADED
+		{
+			BX_UNUSED(numBatches);
+			computeModelMatrices(0, num);
+		}
+	}
+
+	void Frame::sort()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+		const int64_t timeBegin = bx::getHPCounter();
+
+		bool identity = true;
+		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+			identity &= m_viewRemap[ii] == ii;
+		}
+
+		reserveSortKeys(m_numRenderItems);
+
+		bool sortRenderItems = true;
+
+		if (BX_ENABLED(BGFX_CONFIG_SORT_ENCODER_RUNS) )
+		{
+			// Runs are sorted with view order at the time of submit. View remap
+			// changes order of views, runs need to be sorted again.
+			if (identity)
+			{
+				mergeRuns();
+				sortRenderItems = false;
+			}
+			else
+			{
+				gatherRuns(viewRemap);
+			}
+		}
+		else
+		{
+			gatherRenderItems(viewRemap);
+		}
+
+		if (sortRenderItems)
+		{
+#if BGFX_CONFIG_MULTITHREADED
+			if (BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS <= m_numRenderItems)
+			{
+				bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems, &s_ctx->m_jobScheduler);
+			}
+			else
+#endif // BGFX_CONFIG_MULTITHREADED
+			{
+				bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
+			}
+		}
+
+		SortKey term;
+		term.reset();
+		term.m_program = kInvalidHandle;
+		m_sortKeys[m_numRenderItems]   = term.encodeDraw(SortKey::SortProgram);
+		m_sortValues[m_numRenderItems] = 0;
+
+		diffRenderItems();
+
+		if (0 != BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE)
+		{
+			computeModelMatrices();
+		}
+
+		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		{
+			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+		}
+
+		uint32_t tempBlitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS];
+		bx::radixSort(m_blitKeys, tempBlitKeys, m_numBlitItems);
+
+		s_ctx->m_timeline.push(TimelineStage::Sort, m_frameNum, 0, timeBegin, bx::getHPCounter() );
+	}
+
+	// Returns first sorted render item in `[_begin, _end)` whose view and compute/draw bit are
+	// not less than `_segment`, or `_end`.
+	static uint32_t lowerBoundSegment(const uint64_t* _keys, uint32_t _begin, uint32_t _end, uint64_t _segment)
+	{
+		while (_begin < _end)
+		{
+			const uint32_t mid = _begin + (_end-_begin)/2;
+			if ( (_keys[mid]>>SORT_KEY_DRAW_BIT_SHIFT) < _segment)
+			{
+				_begin = mid+1;
+			}
+			else
+			{
+				_end = mid;
+			}
+		}
+
+		return _begin;
+	}
+
+	uint32_t Frame::splitRenderItems(RenderItemRange* _outRange, uint32_t _maxRanges, uint32_t _minItems) const
+	{
+		BX_CHECK(0 < _maxRanges, "At least one range is required.");
+
+		const uint32_t num   = m_numRenderItems;
+		const uint32_t size  = bx::max<uint32_t>( (num + _maxRanges-1)/_maxRanges, _minItems, 1);
+		const uint32_t slack = size/4;
+
+		uint32_t numRanges = 0;
+		for (uint32_t begin = 0; begin < num; ++numRanges)
+		{
+			uint32_t end = begin + size;
+
+			if (numRanges+1 == _maxRanges
+			||  end + slack >= num)
+			{
+				end = num;
+			}
+			else
+			{
+				// Backends reset state at view change, splitting there makes range start
+				// cheaper and keeps views in single range when possible.
+				const uint64_t segment = m_sortKeys[end]>>SORT_KEY_DRAW_BIT_SHIFT;
+				const uint32_t before  = lowerBoundSegment(m_sortKeys, end-slack, end, segment);
+				const uint32_t after   = lowerBoundSegment(m_sortKeys, end, end+slack, segment+1);
+				const bool hasBefore   = end-slack < before;
+				const bool hasAfter    = end+slack > after;
+
+				if (hasBefore
+				&& (!hasAfter || end-before <= after-end) )
+				{
+					end = before;
+				}
+				else if (hasAfter)
+				{
+					end = after;
+				}
+			}
+
+			_outRange[numRanges].m_begin = begin;
+			_outRange[numRanges].m_end   = end;
+			begin = end;
+		}
+
+		return numRanges;
+	}
+
+	static void updateUniformState(UniformState& _state, const Frame* _frame, const RenderItemRange& _range)
+	{
+		for (uint32_t ii = _range.m_begin; ii < _range.m_end; ++ii)
+		{
+			const RenderItem& renderItem = _frame->getRenderItem(_frame->m_sortValues[ii]);
+
+			if (0 != (_frame->m_sortKeys[ii] & SORT_KEY_DRAW_BIT) )
+			{
+				const RenderDraw& draw = renderItem.draw;
+				_state.update(_frame->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+			}
+			else
+			{
+				const RenderCompute& compute = renderItem.compute;
+				_state.update(_frame->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+			}
+		}
+	}
+
+	struct UniformStateJob
+	{
+		static void execute(void* _userData, uint32_t _idx)
+		{
+			const UniformStateJob& job = *(const UniformStateJob*)_userData;
+			UniformState& state = job.m_state[_idx+1];
+			state.reset();
+			updateUniformState(state, job.m_frame, job.m_range[_idx]);
+		}
+
+		const Frame* m_frame;
+		const RenderItemRange* m_range;
+		UniformState* m_state;
+	};
+
+	void Frame::gatherUniformStates(UniformState* _outState, const RenderItemRange* _range, uint32_t _numRanges) const
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Gather uniforms", 0xff2040ff);
+
+		// Each range collects last value of uniforms it updates, then values at range start
+		// are values at start of previous range overridden by updates in previous range.
+		UniformStateJob job;
+		job.m_frame = this;
+		job.m_range = _range;
+		job.m_state = _outState;
+
+		_outState[0].reset();
+		rendererRunJobs(UniformStateJob::execute, &job, _numRanges);
+
+		for (uint32_t ii = 1; ii <= _numRanges; ++ii)
+		{
+			_outState[ii].inherit(_outState[ii-1]);
+		}
+	}
+
+	RenderFrame::Enum renderFrame(int32_t _msecs)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_MULTITHREADED) )
+		{
+			if (s_renderFrameCalled)
+			{
+				BGFX_CHECK_RENDER_THREAD();
+			}
+
+			if (NULL == s_ctx)
+			{
+				s_renderFrameCalled = true;
+				s_threadIndex = ~BGFX_API_THREAD_MAGIC;
+				return RenderFrame::NoContext;
+			}
+
+			int32_t msecs = -1 == _msecs
+				? BGFX_CONFIG_API_SEMAPHORE_TIMEOUT
+				: _msecs
+				;
+			RenderFrame::Enum result = s_ctx->renderFrame(msecs);
+			if (RenderFrame::Exiting == result)
+			{
+				Context* ctx = s_ctx;
+				ctx->apiSemWait();
+				s_ctx = NULL;
+				ctx->renderSemPost();
+			}
+
+			return result;
+		}
+
+		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");
+		return RenderFrame::NoContext;
+	}
+
+	const uint32_t g_uniformTypeSize[UniformType::Count+1] =
+	{
+		sizeof(int32_t),
+		0,
+		4*sizeof(float),
+		3*3*sizeof(float),
 		4*4*sizeof(float),
 		1,
 	};
@@ -1351,6 +2299,13 @@ namespace bgfx
 		write(_value, g_uniformTypeSize[_type]*_num);
 	}
 
+	void UniformBuffer::writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(_pos);
+	}
+
 	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
 	{
 		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
@@ -1613,55 +2568,311 @@ namespace bgfx
 		return s_topologyName[bx::min(_topology, Topology::PointList)];
 	}
 
-	const char* getShaderTypeName(uint32_t _magic)
+	const char* getShaderTypeName(uint32_t _magic)
+	{
+		if (isShaderType(_magic, 'C') )
+		{
+			return "Compute";
+		}
+		else if (isShaderType(_magic, 'F') )
+		{
+			return "Fragment";
+		}
+		else if (isShaderType(_magic, 'V') )
+		{
+			return "Vertex";
+		}
+
+		BX_CHECK(false, "Invalid shader type!");
+
+		return NULL;
+	}
+
+	static TextureFormat::Enum s_emulatedFormats[] =
+	{
+		TextureFormat::BC1,
+		TextureFormat::BC2,
+		TextureFormat::BC3,
+		TextureFormat::BC4,
+		TextureFormat::BC5,
+		TextureFormat::ETC1,
+		TextureFormat::ETC2,
+		TextureFormat::ETC2A,
+		TextureFormat::ETC2A1,
+		TextureFormat::PTC12,
+		TextureFormat::PTC14,
+		TextureFormat::PTC12A,
+		TextureFormat::PTC14A,
+		TextureFormat::PTC22,
+		TextureFormat::PTC24,
+		TextureFormat::ATC,
+		TextureFormat::ATCE,
+		TextureFormat::ATCI,
+		TextureFormat::ASTC4x4,
+		TextureFormat::ASTC5x5,
+		TextureFormat::ASTC6x6,
+		TextureFormat::ASTC8x5,
+		TextureFormat::ASTC8x6,
+		TextureFormat::ASTC10x5,
+		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
+		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
+	};
+
+	UploadQueue::UploadQueue()
+		: m_read(0)
+		, m_staged(0)
+		, m_write(0)
+		, m_ticket(0)
+		, m_exit(false)
+	{
+	}
+
+	UploadQueue::~UploadQueue()
+	{
+		// Thread waits on semaphore, it must be woken up before bx::Thread destructor joins it.
+		stopThread();
+	}
+
+	void UploadQueue::init()
+	{
+		m_exit = false;
+
+#if BGFX_CONFIG_MULTITHREADED
+		m_thread.init(threadFunc, this, 0, "bgfx - upload thread");
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	void UploadQueue::shutdown()
+	{
+		stopThread();
+
+		for (; m_read != m_write; ++m_read)
+		{
+			release(m_item[m_read % BGFX_CONFIG_MAX_UPLOADS].m_mem);
+		}
+
+		m_staged = m_write;
+	}
+
+	uint32_t UploadQueue::push(UploadItem& _item)
+	{
+		BX_CHECK(!isFull(), "Upload queue is full.");
+
+		_item.m_ticket    = ++m_ticket;
+		_item.m_cancelled = false;
+
+#if BGFX_CONFIG_MULTITHREADED
+		{
+			bx::MutexScope scope(m_lock);
+
+			m_item[m_write % BGFX_CONFIG_MAX_UPLOADS] = _item;
+			++m_write;
+
+			// Memory owned by bgfx doesn't need staging, unless it has to wait for uploads
+			// queued before it.
+			if (m_staged+1 == m_write
+			&&  !isMemoryRef(_item.m_mem) )
+			{
+				m_staged = m_write;
+				return _item.m_ticket;
+			}
+		}
+
+		m_sem.post();
+#else
+		m_item[m_write % BGFX_CONFIG_MAX_UPLOADS] = _item;
+		++m_write;
+		m_staged = m_write;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return _item.m_ticket;
+	}
+
+	bool UploadQueue::peek(UploadItem& _item, uint32_t _waitTicket)
+	{
+		BGFX_MUTEX_SCOPE(m_lock);
+
+		if (m_read == m_write)
+		{
+			return false;
+		}
+
+		const UploadItem& item = m_item[m_read % BGFX_CONFIG_MAX_UPLOADS];
+
+#if BGFX_CONFIG_MULTITHREADED
+		if (m_read == m_staged)
+		{
+			if (0 < int32_t(item.m_ticket - _waitTicket) )
+			{
+				return false;
+			}
+
+			while (m_read == m_staged)
+			{
+				m_lock.unlock();
+				m_stagedSem.wait();
+				m_lock.lock();
+			}
+		}
+#else
+		BX_UNUSED(_waitTicket);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		_item = item;
+		return true;
+	}
+
+	void UploadQueue::pop()
+	{
+		BX_CHECK(m_read != m_staged, "Popping upload that is not staged.");
+		++m_read;
+	}
+
+	void UploadQueue::cancel(UploadItem::Type::Enum _type, uint16_t _handle)
+	{
+		BGFX_MUTEX_SCOPE(m_lock);
+
+		for (uint32_t ii = m_read; ii != m_write; ++ii)
+		{
+			UploadItem& item = m_item[ii % BGFX_CONFIG_MAX_UPLOADS];
+			if (item.m_type   == _type
+			&&  item.m_handle == _handle)
+			{
+				item.m_cancelled = true;
+			}
+		}
+	}
+
+	void UploadQueue::stopThread()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		if (m_thread.isRunning() )
+		{
+			m_exit = true;
+			m_sem.post();
+			m_thread.shutdown();
+		}
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	int32_t UploadQueue::threadFunc(bx::Thread* /*_thread*/, void* _userData)
+	{
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Upload Thread");
+
+#if BGFX_CONFIG_MULTITHREADED
+		UploadQueue* queue = (UploadQueue*)_userData;
+		for (;;)
+		{
+			queue->m_sem.wait();
+			if (queue->m_exit)
+			{
+				break;
+			}
+
+			queue->stage();
+		}
+#else
+		BX_UNUSED(_userData);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return bx::kExitSuccess;
+	}
+
+	void UploadQueue::stage()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		m_lock.lock();
+
+		while (m_staged != m_write)
+		{
+			UploadItem& item = m_item[m_staged % BGFX_CONFIG_MAX_UPLOADS];
+			const Memory* mem = item.m_mem;
+
+			if (!item.m_cancelled
+			&&  isMemoryRef(mem)
+			&&  0 != mem->size)
+			{
+				// Slot can't be popped or reused until it's staged, only cancel flag can
+				// change while copying.
+				m_lock.unlock();
+
+				BGFX_PROFILER_SCOPE("bgfx/Upload copy", 0xff2040ff);
+				const Memory* copy = alloc(mem->size);
+				bx::memCopy(copy->data, mem->data, mem->size);
+				release(mem);
+
+				m_lock.lock();
+				item.m_mem = copy;
+			}
+
+			++m_staged;
+			m_stagedSem.post();
+		}
+
+		m_lock.unlock();
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	FrameTimeline::FrameTimeline()
+	{
+		reset();
+	}
+
+	void FrameTimeline::reset()
+	{
+		bx::memSet(m_slot, 0, sizeof(m_slot) );
+		m_head = 0;
+	}
+
+	void FrameTimeline::push(TimelineStage::Enum _stage, uint32_t _frame, uint16_t _encoder, int64_t _begin, int64_t _end)
+	{
+		const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_head, 1);
+		Slot& slot = m_slot[idx & (BGFX_CONFIG_MAX_TIMELINE_EVENTS-1)];
+
+		slot.m_seq = 0;
+		bx::memoryBarrier();
+
+		slot.m_event.cpuTimeBegin = _begin;
+		slot.m_event.cpuTimeEnd   = _end;
+		slot.m_event.frame        = _frame;
+		slot.m_event.encoder      = _encoder;
+		slot.m_event.stage        = _stage;
+
+		bx::memoryBarrier();
+		slot.m_seq = idx+1;
+	}
+
+	uint32_t FrameTimeline::read(TimelineEvent* _events, uint32_t _max) const
 	{
-		if (isShaderType(_magic, 'C') )
-		{
-			return "Compute";
-		}
-		else if (isShaderType(_magic, 'F') )
+		const uint32_t head = m_head;
+		const uint32_t num  = bx::min<uint32_t>(head, BGFX_CONFIG_MAX_TIMELINE_EVENTS);
+
+		if (NULL == _events)
 		{
-			return "Fragment";
+			return num;
 		}
-		else if (isShaderType(_magic, 'V') )
+
+		uint32_t count = 0;
+
+		for (uint32_t idx = head - bx::min(num, _max); idx != head; ++idx)
 		{
-			return "Vertex";
-		}
+			const Slot& slot = m_slot[idx & (BGFX_CONFIG_MAX_TIMELINE_EVENTS-1)];
 
-		BX_CHECK(false, "Invalid shader type!");
+			const uint32_t seq = slot.m_seq;
+			bx::memoryBarrier();
+			_events[count] = slot.m_event;
+			bx::memoryBarrier();
 
-		return NULL;
-	}
+			// Skip slot that is being written, or was reused by newer event while copying.
+			if (idx+1 == seq
+			&&  seq   == slot.m_seq)
+			{
+				++count;
+			}
+		}
 
-	static TextureFormat::Enum s_emulatedFormats[] =
-	{
-		TextureFormat::BC1,
-		TextureFormat::BC2,
-		TextureFormat::BC3,
-		TextureFormat::BC4,
-		TextureFormat::BC5,
-		TextureFormat::ETC1,
-		TextureFormat::ETC2,
-		TextureFormat::ETC2A,
-		TextureFormat::ETC2A1,
-		TextureFormat::PTC12,
-		TextureFormat::PTC14,
-		TextureFormat::PTC12A,
-		TextureFormat::PTC14A,
-		TextureFormat::PTC22,
-		TextureFormat::PTC24,
-		TextureFormat::ATC,
-		TextureFormat::ATCE,
-		TextureFormat::ATCI,
-		TextureFormat::ASTC4x4,
-		TextureFormat::ASTC5x5,
-		TextureFormat::ASTC6x6,
-		TextureFormat::ASTC8x5,
-		TextureFormat::ASTC8x6,
-		TextureFormat::ASTC10x5,
-		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
-		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
-	};
+		return count;
+	}
 
 	bool Context::init(const Init& _init)
 	{
@@ -1689,6 +2900,14 @@ namespace bgfx
 		m_debug   = BGFX_DEBUG_NONE;
 		m_frameTimeLast = bx::getHPCounter();
 
+		m_timeline.reset();
+		m_timelineFrame = 0;
+
+		g_cpuProfiler.init();
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - API Thread");
+		m_profilerScopes    = (ProfilerScopeStats*)BX_ALLOC(g_allocator, sizeof(ProfilerScopeStats)*BGFX_CONFIG_MAX_PROFILER_SCOPES);
+		m_numProfilerScopes = 0;
+
 		m_submit->create();
 
 #if BGFX_CONFIG_MULTITHREADED
@@ -1709,6 +2928,8 @@ namespace bgfx
 			m_thread.init(renderThread, this, 0, "bgfx - renderer backend thread");
 			m_singleThreaded = false;
 		}
+
+		m_jobScheduler.init(BGFX_CONFIG_SORT_NUM_THREADS);
 #else
 		BX_TRACE("Multithreaded renderer is disabled.");
 		m_singleThreaded = true;
@@ -1738,6 +2959,20 @@ namespace bgfx
 
 		m_declRef.init();
 
+		if (NULL != _init.recordFilePath)
+		{
+			// Limits as they are used by this build.
+			Init::Limits limits = _init.limits;
+			limits.maxEncoders = uint16_t(g_caps.limits.maxEncoders);
+
+			m_recorder = BX_NEW(g_allocator, FrameRecorder);
+			if (!m_recorder->open(_init.recordFilePath, limits) )
+			{
+				BX_DELETE(g_allocator, m_recorder);
+				m_recorder = NULL;
+			}
+		}
+
 		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
 		cmdbuf.write(_init);
 
@@ -1770,9 +3005,19 @@ namespace bgfx
 #if BGFX_CONFIG_MULTITHREADED
 			m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
+
+			if (NULL != m_recorder)
+			{
+				BX_DELETE(g_allocator, m_recorder);
+				m_recorder = NULL;
+			}
+
 			return false;
 		}
 
+		// Started only once renderer is created, failed init above has no upload thread to stop.
+		m_uploadQueue.init();
+
 		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
 		{
 			const uint32_t fmt = s_emulatedFormats[ii];
@@ -1820,6 +3065,8 @@ namespace bgfx
 
 	void Context::shutdown()
 	{
+		m_uploadQueue.shutdown();
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
@@ -1876,14 +3123,36 @@ namespace bgfx
 			m_thread.shutdown();
 		}
 
+		m_jobScheduler.shutdown();
+
 		m_render->destroy();
 #endif // BGFX_CONFIG_MULTITHREADED
 
+		if (NULL != m_recorder)
+		{
+			BX_DELETE(g_allocator, m_recorder);
+			m_recorder = NULL;
+		}
+
+		g_cpuProfiler.shutdown();
+		BX_FREE(g_allocator, m_profilerScopes);
+		m_profilerScopes    = NULL;
+		m_numProfilerScopes = 0;
+
 		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
 		s_ctx = NULL;
 
 		m_submit->destroy();
 
+		m_textureUpdateBatch.destroy();
+		m_textureUpdateStaging.destroy();
+
+		BX_FREE(g_allocator, m_tempKeys);
+		BX_FREE(g_allocator, m_tempValues);
+		m_tempKeys     = NULL;
+		m_tempValues   = NULL;
+		m_tempCapacity = 0;
+
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		{
 #define CHECK_HANDLE_LEAK(_handleAlloc)                                               \
@@ -2075,8 +3344,60 @@ namespace bgfx
 		apiSemPost();
 	}
 
+	static void profilerText(TextVideoMem& _tvm, const ProfilerScopeStats* _scopes, uint16_t _num)
+	{
+		// Profiler is printed at the right side of debug text, over previous content of that
+		// area, so it doesn't depend on application clearing debug text every frame.
+		const uint16_t width = bx::min<uint16_t>(_tvm.m_width, 56);
+		const uint16_t x     = _tvm.m_width - width;
+		const int32_t  nameWidth = bx::max<int32_t>(width - 17, 1);
+
+		const double toMs = 1000.0/double(bx::getHPFrequency() );
+		const char* threadName = NULL;
+
+		uint16_t yy = 0;
+		_tvm.printf(x, yy++, 0x8f, " %-*s %8s %6s", nameWidth, "CPU profiler", "[ms]", "count");
+
+		for (uint16_t ii = 0; ii < _num && yy < _tvm.m_height; ++ii)
+		{
+			const ProfilerScopeStats& scope = _scopes[ii];
+
+			if (threadName != scope.threadName)
+			{
+				threadName = scope.threadName;
+				_tvm.printf(x, yy++, 0x8b, " %-*s", width-1, threadName);
+
+				if (yy >= _tvm.m_height)
+				{
+					break;
+				}
+			}
+
+			const int32_t indent = bx::min<int32_t>(scope.depth*2 + 1, nameWidth/2);
+			_tvm.printf(x, yy++, 0x0f, " %*s%-*.*s %8.3f %6d"
+				, indent
+				, ""
+				, nameWidth - indent
+				, nameWidth - indent
+				, scope.name
+				, double(scope.cpuTimeElapsed)*toMs
+				, scope.count
+				);
+		}
+
+		for (; yy < _tvm.m_height; ++yy)
+		{
+			_tvm.printf(x, yy, 0, "%*s", width, "");
+		}
+	}
+
 	void Context::swap()
 	{
+		const int64_t timeBegin = bx::getHPCounter();
+
+		commitUploads(m_uploadTicketCommitted);
+		m_submit->m_uploadTicket = m_uploadTicketCommitted;
+
 		freeDynamicBuffers();
 		m_submit->m_resolution = m_init.resolution;
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
@@ -2097,14 +3418,34 @@ namespace bgfx
 
 		m_submit->finish();
 
+		// Previous render frame is done at this point.
+		m_uploadTicketComplete = m_render->m_uploadTicket;
+
 		bx::xchg(m_render, m_submit);
 
 		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
 
+		m_render->m_frameNum = m_frames+1;
+
+		m_numProfilerScopes = 0;
+		if (g_profilerEnabled)
+		{
+			m_numProfilerScopes = g_cpuProfiler.collect(m_profilerScopes, BGFX_CONFIG_MAX_PROFILER_SCOPES);
+
+			if (0 != (m_render->m_debug & BGFX_DEBUG_PROFILER_TEXT) )
+			{
+				m_render->m_debug |= BGFX_DEBUG_TEXT;
+				profilerText(*m_render->m_textVideoMem, m_profilerScopes, m_numProfilerScopes);
+			}
+		}
+
+		m_timeline.push(TimelineStage::Swap, m_render->m_frameNum, 0, timeBegin, bx::getHPCounter() );
+
 		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
 		||  m_singleThreaded)
 		{
 			renderFrame();
+			m_uploadTicketComplete = m_render->m_uploadTicket;
 		}
 
 		m_frames++;
@@ -2134,8 +3475,10 @@ namespace bgfx
 		if (m_rendererInitialized
 		&& !m_flipped)
 		{
+			const int64_t timeBegin = bx::getHPCounter();
 			m_renderCtx->flip();
 			m_flipped = true;
+			m_timeline.push(TimelineStage::Flip, m_timelineFrame, 0, timeBegin, bx::getHPCounter() );
 
 			if (m_renderCtx->isDeviceRemoved() )
 			{
@@ -2162,78 +3505,368 @@ namespace bgfx
 
 		if (apiSemWait(_msecs) )
 		{
+			rendererExecFrame();
+
+			renderSemPost();
+
+			if (m_flipAfterRender)
+			{
+				BGFX_PROFILER_SCOPE("bgfx/flip", 0xff2040ff);
+				flip();
+			}
+		}
+		else
+		{
+			return RenderFrame::Timeout;
+		}
+
+		return m_exit
+			? RenderFrame::Exiting
+			: RenderFrame::Render
+			;
+	}
+
+	void Context::rendererExecFrame()
+	{
+		m_timelineFrame = m_render->m_frameNum;
+
+		if (NULL != m_recorder)
+		{
+			m_recorder->beginFrame();
+		}
+
+		int64_t timeBegin = bx::getHPCounter();
+
+		{
+			BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
+			rendererExecCommands(m_render->m_cmdPre);
+		}
+
+		m_timeline.push(TimelineStage::ExecPre, m_timelineFrame, 0, timeBegin, bx::getHPCounter() );
+
+		if (NULL != m_recorder)
+		{
+			m_recorder->writeCommands(m_render->m_cmdPre);
+			m_recorder->writeFrame(m_render, m_rendererInitialized, m_clearQuad, m_textVideoMemBlitter);
+		}
+
+		if (m_rendererInitialized)
+		{
+			BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
+
+			// Uniform buffers are reused between frames, uniform writes from previous
+			// frame can't be matched.
+			bx::memSet(m_uniformWrite, 0, sizeof(m_uniformWrite) );
+			m_uniformUpdatesSkipped = 0;
+
+			timeBegin = bx::getHPCounter();
+			m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
+			m_timeline.push(TimelineStage::Submit, m_timelineFrame, 0, timeBegin, bx::getHPCounter() );
+
+			m_render->m_perfStats.uniformUpdatesSkipped = m_uniformUpdatesSkipped;
+
+			// Renderers count render items, auto-instanced batch is single render item but
+			// each draw merged into it is still counted as submitted draw call.
+			m_render->m_perfStats.numDraw        += m_render->m_numBatchedDraws - m_render->m_numBatches;
+			m_render->m_perfStats.numBatches      = m_render->m_numBatches;
+			m_render->m_perfStats.numBatchedDraws = m_render->m_numBatchedDraws;
+			m_flipped = false;
+		}
+
+		timeBegin = bx::getHPCounter();
+
+		{
+			BGFX_PROFILER_SCOPE("bgfx/Exec commands post", 0xff2040ff);
+			rendererExecCommands(m_render->m_cmdPost);
+		}
+
+		m_timeline.push(TimelineStage::ExecPost, m_timelineFrame, 0, timeBegin, bx::getHPCounter() );
+
+		if (NULL != m_recorder)
+		{
+			m_recorder->writeCommands(m_render->m_cmdPost);
+		}
+	}
+
+	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	{
+		_uniformBuffer->reset(_begin);
+		while (_uniformBuffer->getPos() < _end)
+		{
+			uint32_t opcode = _uniformBuffer->read();
+
+			if (UniformType::End == opcode)
 			{
-				BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
-				rendererExecCommands(m_render->m_cmdPre);
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			uint32_t size = g_uniformTypeSize[type]*num;
+			if (UniformType::Count > type)
+			{
+				// Not copied uniform references data previously written to the same buffer.
+				const uint32_t pos = copy ? _uniformBuffer->getPos() : _uniformBuffer->read();
+				const char* data   = copy ? _uniformBuffer->read(size) : _uniformBuffer->getData(pos);
+
+				// Skip update if uniform already holds exactly this data.
+				Context::UniformWrite& last = s_ctx->m_uniformWrite[loc];
+				if (last.m_buffer == _uniformBuffer
+				&&  last.m_pos    == pos)
+				{
+					++s_ctx->m_uniformUpdatesSkipped;
+					continue;
+				}
+
+				last.m_buffer = _uniformBuffer;
+				last.m_pos    = pos;
+				_renderCtx->updateUniform(loc, data, size);
+			}
+			else
+			{
+				const char* data = _uniformBuffer->read(size);
+				_renderCtx->setMarker(data, size);
 			}
+		}
+	}
+
+	uint32_t rendererGetNumThreads()
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		return s_ctx->m_jobScheduler.getNumThreads();
+#else
+		return 1;
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
 
-			if (m_rendererInitialized)
+	void rendererRunJobs(bx::JobFn _fn, void* _userData, uint32_t _num)
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		if (1 < _num)
+		{
+			s_ctx->m_jobScheduler.run(_fn, _userData, _num);
+		}
+		else
+#endif // BGFX_CONFIG_MULTITHREADED
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
 			{
-				BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
-				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
-				m_flipped = false;
+				_fn(_userData, ii);
 			}
+		}
+	}
 
+	void UniformState::update(const UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	{
+		for (uint32_t pos = _begin; pos < _end;)
+		{
+			uint32_t opcode = _uniformBuffer->readAt(pos);
+
+			if (UniformType::End == opcode)
 			{
-				BGFX_PROFILER_SCOPE("bgfx/Exec commands post", 0xff2040ff);
-				rendererExecCommands(m_render->m_cmdPost);
+				break;
 			}
 
-			renderSemPost();
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
 
-			if (m_flipAfterRender)
+			uint32_t size = g_uniformTypeSize[type]*num;
+			if (UniformType::Count > type)
 			{
-				BGFX_PROFILER_SCOPE("bgfx/flip", 0xff2040ff);
-				flip();
+				m_data[loc] = copy
+					? _uniformBuffer->readAt(pos, size)
+					: _uniformBuffer->getData(_uniformBuffer->readAt(pos) )
+					;
+				m_size[loc] = size;
+			}
+			else
+			{
+				pos += size;
 			}
 		}
-		else
+	}
+
+	void UniformState::inherit(const UniformState& _prev)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_UNIFORMS; ++ii)
+		{
+			if (NULL == m_data[ii])
+			{
+				m_data[ii] = _prev.m_data[ii];
+				m_size[ii] = _prev.m_size[ii];
+			}
+		}
+	}
+
+	void writeTextureUpdate(CommandBuffer& _cmdbuf, const TextureUpdate& _update)
+	{
+		_cmdbuf.write(_update.handle);
+		_cmdbuf.write(_update.side);
+		_cmdbuf.write(_update.mip);
+		_cmdbuf.write(_update.rect);
+		_cmdbuf.write(_update.zz);
+		_cmdbuf.write(_update.depth);
+		_cmdbuf.write(_update.pitch);
+		_cmdbuf.write(_update.format);
+		_cmdbuf.write(_update.mem);
+	}
+
+	void readTextureUpdate(CommandBuffer& _cmdbuf, uint32_t _pos, TextureUpdate& _update)
+	{
+		_cmdbuf.m_pos = _pos;
+		_cmdbuf.read(_update.handle);
+		_cmdbuf.read(_update.side);
+		_cmdbuf.read(_update.mip);
+		_cmdbuf.read(_update.rect);
+		_cmdbuf.read(_update.zz);
+		_cmdbuf.read(_update.depth);
+		_cmdbuf.read(_update.pitch);
+		_cmdbuf.read(_update.format);
+		_cmdbuf.read(_update.mem);
+	}
+
+	// Returns bytes per pixel if update is single slice of uncompressed data that can be merged
+	// with other updates, otherwise 0.
+	static uint32_t getMergeBytesPerPixel(const TextureUpdate& _update)
+	{
+		const bimg::TextureFormat::Enum format = bimg::TextureFormat::Enum(_update.format);
+		const uint32_t bpp = bimg::getBitsPerPixel(format);
+
+		if (bimg::isCompressed(format)
+		||  0 == bpp
+		||  0 != bpp%8
+		||  1 != _update.depth
+		||  _update.rect.isZeroArea() )
+		{
+			return 0;
+		}
+
+		const uint32_t rowSize = _update.rect.m_width*bpp/8;
+		const uint32_t pitch   = UINT16_MAX == _update.pitch ? rowSize : _update.pitch;
+
+		if (pitch < rowSize
+		||  _update.mem->size < pitch*(_update.rect.m_height-1) + rowSize)
+		{
+			return 0;
+		}
+
+		return bpp/8;
+	}
+
+	// Grows _bounds to include _rect, only if together they cover rectangle exactly. Later
+	// updates overwrite earlier ones, so overlap is fine.
+	static bool mergeRect(Rect& _bounds, const Rect& _rect)
+	{
+		const uint32_t bx0 = _bounds.m_x;
+		const uint32_t by0 = _bounds.m_y;
+		const uint32_t bx1 = bx0 + _bounds.m_width;
+		const uint32_t by1 = by0 + _bounds.m_height;
+		const uint32_t rx0 = _rect.m_x;
+		const uint32_t ry0 = _rect.m_y;
+		const uint32_t rx1 = rx0 + _rect.m_width;
+		const uint32_t ry1 = ry0 + _rect.m_height;
+
+		if (rx0 <= bx0 && ry0 <= by0 && bx1 <= rx1 && by1 <= ry1)
+		{
+			_bounds = _rect;
+			return true;
+		}
+
+		if (bx0 <= rx0 && by0 <= ry0 && rx1 <= bx1 && ry1 <= by1)
+		{
+			return true;
+		}
+
+		if (by0 == ry0 && by1 == ry1 && rx0 <= bx1 && bx0 <= rx1)
+		{
+			_bounds.m_x     = uint16_t(bx::min(bx0, rx0) );
+			_bounds.m_width = uint16_t(bx::max(bx1, rx1) - _bounds.m_x);
+			return true;
+		}
+
+		if (bx0 == rx0 && bx1 == rx1 && ry0 <= by1 && by0 <= ry1)
 		{
-			return RenderFrame::Timeout;
+			_bounds.m_y      = uint16_t(bx::min(by0, ry0) );
+			_bounds.m_height = uint16_t(bx::max(by1, ry1) - _bounds.m_y);
+			return true;
 		}
 
-		return m_exit
-			? RenderFrame::Exiting
-			: RenderFrame::Render
-			;
+		return false;
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	uint32_t mergeTextureUpdates(CommandBuffer& _cmdbuf, const uint32_t* _pos, uint32_t _num, TextureUpdate& _update, TextureUpdateStaging& _staging)
 	{
-		_uniformBuffer->reset(_begin);
-		while (_uniformBuffer->getPos() < _end)
+		readTextureUpdate(_cmdbuf, _pos[0], _update);
+
+		const uint32_t bytesPerPixel = getMergeBytesPerPixel(_update);
+		if (0 == bytesPerPixel)
 		{
-			uint32_t opcode = _uniformBuffer->read();
+			return 1;
+		}
 
-			if (UniformType::End == opcode)
+		Rect bounds = _update.rect;
+		uint32_t num = 1;
+
+		for (; num < _num; ++num)
+		{
+			TextureUpdate next;
+			readTextureUpdate(_cmdbuf, _pos[num], next);
+
+			if (next.zz != _update.zz
+			||  0 == getMergeBytesPerPixel(next)
+			||  !mergeRect(bounds, next.rect) )
 			{
 				break;
 			}
+		}
 
-			UniformType::Enum type;
-			uint16_t loc;
-			uint16_t num;
-			uint16_t copy;
-			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+		if (1 == num)
+		{
+			return 1;
+		}
 
-			uint32_t size = g_uniformTypeSize[type]*num;
-			const char* data = _uniformBuffer->read(size);
-			if (UniformType::Count > type)
-			{
-				if (copy)
-				{
-					_renderCtx->updateUniform(loc, data, size);
-				}
-				else
-				{
-					_renderCtx->updateUniform(loc, *(const char**)(data), size);
-				}
-			}
-			else
-			{
-				_renderCtx->setMarker(data, size);
-			}
+		const uint32_t dstPitch = bounds.m_width*bytesPerPixel;
+		const uint32_t size     = dstPitch*bounds.m_height;
+
+		if (_staging.m_size < size)
+		{
+			_staging.m_size = bx::max(size, _staging.m_size*2);
+			_staging.m_data = (uint8_t*)BX_REALLOC(g_allocator, _staging.m_data, _staging.m_size);
+		}
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			TextureUpdate src;
+			readTextureUpdate(_cmdbuf, _pos[ii], src);
+
+			const uint32_t rowSize  = src.rect.m_width*bytesPerPixel;
+			const uint32_t srcPitch = UINT16_MAX == src.pitch ? rowSize : src.pitch;
+
+			uint8_t* dst = _staging.m_data
+				+ (src.rect.m_y - bounds.m_y)*dstPitch
+				+ (src.rect.m_x - bounds.m_x)*bytesPerPixel
+				;
+			bx::memCopy(dst, src.mem->data, rowSize, src.rect.m_height, srcPitch, dstPitch);
+
+			release(src.mem);
 		}
+
+		_staging.m_mem.data = _staging.m_data;
+		_staging.m_mem.size = size;
+
+		_update.rect  = bounds;
+		_update.depth = 1;
+		_update.pitch = UINT16_MAX;
+		_update.mem   = &_staging.m_mem;
+
+		return num;
 	}
 
 	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
@@ -2242,54 +3875,37 @@ namespace bgfx
 		{
 			const uint32_t pos = _cmdbuf.m_pos;
 
-			uint32_t currentKey = UINT32_MAX;
+			const uint32_t* keys   = m_textureUpdateBatch.m_keys;
+			const uint32_t* values = m_textureUpdateBatch.m_values;
 
-			for (uint32_t ii = 0, num = m_textureUpdateBatch.m_num; ii < num; ++ii)
+			for (uint32_t ii = 0, num = m_textureUpdateBatch.m_num; ii < num;)
 			{
-				_cmdbuf.m_pos = m_textureUpdateBatch.m_values[ii];
-
-				TextureHandle handle;
-				_cmdbuf.read(handle);
+				const uint32_t key = keys[ii];
 
-				uint8_t side;
-				_cmdbuf.read(side);
+				uint32_t end = ii+1;
+				for (; end < num && key == keys[end]; ++end) {}
 
-				uint8_t mip;
-				_cmdbuf.read(mip);
+				TextureUpdate update;
+				readTextureUpdate(_cmdbuf, values[ii], update);
 
-				Rect rect;
-				_cmdbuf.read(rect);
+				m_renderCtx->updateTextureBegin(update.handle, update.side, update.mip);
 
-				uint16_t zz;
-				_cmdbuf.read(zz);
-
-				uint16_t depth;
-				_cmdbuf.read(depth);
-
-				uint16_t pitch;
-				_cmdbuf.read(pitch);
+				while (ii < end)
+				{
+					// Consecutive updates of the same texture side and mip, which together cover
+					// rectangle, are composed in staging memory and uploaded at once.
+					const uint32_t merged = mergeTextureUpdates(_cmdbuf, &values[ii], end-ii, update, m_textureUpdateStaging);
 
-				const Memory* mem;
-				_cmdbuf.read(mem);
+					m_renderCtx->updateTexture(update.handle, update.side, update.mip, update.rect, update.zz, update.depth, update.pitch, update.mem);
 
-				uint32_t key = m_textureUpdateBatch.m_keys[ii];
-				if (key != currentKey)
-				{
-					if (currentKey != UINT32_MAX)
+					if (1 == merged)
 					{
-						m_renderCtx->updateTextureEnd();
+						release(update.mem);
 					}
-					currentKey = key;
-					m_renderCtx->updateTextureBegin(handle, side, mip);
-				}
-
-				m_renderCtx->updateTexture(handle, side, mip, rect, zz, depth, pitch, mem);
 
-				release(mem);
-			}
+					ii += merged;
+				}
 
-			if (currentKey != UINT32_MAX)
-			{
 				m_renderCtx->updateTextureEnd();
 			}
 
@@ -2481,6 +4097,14 @@ namespace bgfx
 		}
 	}
 
+	void Context::recordPatch(const CommandBuffer& _cmdbuf, RecordPatch::Enum _type, const void* _ptr)
+	{
+		if (NULL != m_recorder)
+		{
+			m_recorder->patch(_cmdbuf, _type, _ptr);
+		}
+	}
+
 	void Context::rendererExecCommands(CommandBuffer& _cmdbuf)
 	{
 		_cmdbuf.reset();
@@ -2565,6 +4189,7 @@ namespace bgfx
 
 					const Memory* mem;
 					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Memory, mem);
 
 					uint16_t flags;
 					_cmdbuf.read(flags);
@@ -2612,6 +4237,7 @@ namespace bgfx
 
 					const Memory* mem;
 					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Memory, mem);
 
 					VertexDeclHandle declHandle;
 					_cmdbuf.read(declHandle);
@@ -2662,6 +4288,7 @@ namespace bgfx
 
 					const Memory* mem;
 					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Memory, mem);
 
 					m_renderCtx->updateDynamicIndexBuffer(handle, offset, size, mem);
 
@@ -2706,6 +4333,7 @@ namespace bgfx
 
 					const Memory* mem;
 					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Memory, mem);
 
 					m_renderCtx->updateDynamicVertexBuffer(handle, offset, size, mem);
 
@@ -2729,6 +4357,7 @@ namespace bgfx
 
 					const Memory* mem;
 					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Memory, mem);
 
 					m_renderCtx->createShader(handle, mem);
 
@@ -2776,6 +4405,7 @@ namespace bgfx
 
 					const Memory* mem;
 					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Texture, mem);
 
 					uint64_t flags;
 					_cmdbuf.read(flags);
@@ -2811,11 +4441,6 @@ namespace bgfx
 
 			case CommandBuffer::UpdateTexture:
 				{
-					if (m_textureUpdateBatch.isFull() )
-					{
-						flushTextureUpdateBatch(_cmdbuf);
-					}
-
 					uint32_t value = _cmdbuf.m_pos;
 
 					TextureHandle handle;
@@ -2831,7 +4456,11 @@ namespace bgfx
 					_cmdbuf.skip<uint16_t>();
 					_cmdbuf.skip<uint16_t>();
 					_cmdbuf.skip<uint16_t>();
-					_cmdbuf.skip<Memory*>();
+					_cmdbuf.skip<uint8_t>();
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+					recordPatch(_cmdbuf, RecordPatch::Memory, mem);
 
 					uint32_t key = (handle.idx<<16)
 						| (side<<8)
@@ -2849,11 +4478,16 @@ namespace bgfx
 
 					void* data;
 					_cmdbuf.read(data);
+					recordPatch(_cmdbuf, RecordPatch::ReadTexture, data);
 
 					uint8_t mip;
 					_cmdbuf.read(mip);
 
-					m_renderCtx->readTexture(handle, data, mip);
+					// Destination is not available when frame is replayed.
+					if (NULL != data)
+					{
+						m_renderCtx->readTexture(handle, data, mip);
+					}
 				}
 				break;
 
@@ -2899,6 +4533,7 @@ namespace bgfx
 					{
 						void* nwh;
 						_cmdbuf.read(nwh);
+						recordPatch(_cmdbuf, RecordPatch::WindowHandle, nwh);
 
 						uint16_t width;
 						_cmdbuf.read(width);
@@ -3096,40 +4731,21 @@ namespace bgfx
 		, deviceId(0)
 		, debug(BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		, profile(BX_ENABLED(BGFX_CONFIG_DEBUG_PIX) )
+		, recordFilePath(NULL)
+		, cacheDirPath(NULL)
 		, callback(NULL)
 		, allocator(NULL)
 	{
 		limits.maxEncoders     = BGFX_CONFIG_DEFAULT_MAX_ENCODERS;
 		limits.transientVbSize = BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE;
 		limits.transientIbSize = BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE;
+		limits.maxDrawCalls    = BGFX_CONFIG_MAX_DRAW_CALLS;
+		limits.maxUploadSize   = BGFX_CONFIG_MAX_UPLOAD_SIZE;
+		limits.maxCacheSize    = BGFX_CONFIG_MAX_CACHE_SIZE;
 	}
 
-	bool init(const Init& _init)
+	static void initAllocatorCallback(const Init& _init)
 	{
-		if (NULL != s_ctx)
-		{
-			BX_TRACE("bgfx is already initialized.");
-			return false;
-		}
-
-		if (1   > _init.limits.maxEncoders
-		||  128 < _init.limits.maxEncoders)
-		{
-			BX_TRACE("init.limits.maxEncoders must be between 1 and 128.");
-			return false;
-		}
-
-		struct ErrorState
-		{
-			enum Enum
-			{
-				Default,
-				ContextAllocated,
-			};
-		};
-
-		ErrorState::Enum errorState = ErrorState::Default;
-
 		if (NULL != _init.allocator)
 		{
 			g_allocator = _init.allocator;
@@ -3149,23 +4765,43 @@ namespace bgfx
 		{
 			g_callback =
 				s_callbackStub = BX_NEW(g_allocator, CallbackStub);
+
+			if (NULL != _init.cacheDirPath)
+			{
+				s_callbackStub->openCache(_init.cacheDirPath, _init.limits.maxCacheSize);
+			}
 		}
 
-		if (true
-		&&  !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN || BX_PLATFORM_PS4)
-		&&  RendererType::Noop != _init.type
-		&&  NULL == _init.platformData.ndt
-		&&  NULL == _init.platformData.nwh
-		&&  NULL == _init.platformData.context
-		&&  NULL == _init.platformData.backBuffer
-		&&  NULL == _init.platformData.backBufferDS
-		   )
+		BX_WARN(NULL == _init.callback || NULL == _init.cacheDirPath
+			, "Init::cacheDirPath is ignored when application provides callback."
+			);
+	}
+
+	static void shutdownAllocatorCallback()
+	{
+		if (NULL != s_callbackStub)
 		{
-			BX_TRACE("bgfx platform data like window handle or backbuffer is not set, creating headless device.");
+			BX_DELETE(g_allocator, s_callbackStub);
+			s_callbackStub = NULL;
+		}
+
+		if (NULL != s_allocatorStub)
+		{
+			bx::DefaultAllocator allocator;
+			BX_DELETE(&allocator, s_allocatorStub);
+			s_allocatorStub = NULL;
 		}
 
+		s_renderFrameCalled = false;
+		s_threadIndex = 0;
+		g_callback    = NULL;
+		g_allocator   = NULL;
+	}
+
+	static void initCaps(const Init& _init)
+	{
 		bx::memSet(&g_caps, 0, sizeof(g_caps) );
-		g_caps.limits.maxDrawCalls            = BGFX_CONFIG_MAX_DRAW_CALLS;
+		g_caps.limits.maxDrawCalls            = _init.limits.maxDrawCalls;
 		g_caps.limits.maxBlits                = BGFX_CONFIG_MAX_BLIT_ITEMS;
 		g_caps.limits.maxTextureSize          = 0;
 		g_caps.limits.maxTextureLayers        = 1;
@@ -3189,89 +4825,276 @@ namespace bgfx
 		g_caps.limits.transientVbSize         = _init.limits.transientVbSize;
 		g_caps.limits.transientIbSize         = _init.limits.transientIbSize;
 
-		g_caps.vendorId = _init.vendorId;
-		g_caps.deviceId = _init.deviceId;
+		g_caps.vendorId = _init.vendorId;
+		g_caps.deviceId = _init.deviceId;
+	}
+
+	bool init(const Init& _init)
+	{
+		if (NULL != s_ctx)
+		{
+			BX_TRACE("bgfx is already initialized.");
+			return false;
+		}
+
+		if (1   > _init.limits.maxEncoders
+		||  128 < _init.limits.maxEncoders)
+		{
+			BX_TRACE("init.limits.maxEncoders must be between 1 and 128.");
+			return false;
+		}
+
+		if (1 > _init.limits.maxDrawCalls
+		||  UINT32_MAX/2 < _init.limits.maxDrawCalls)
+		{
+			BX_TRACE("init.limits.maxDrawCalls must be between 1 and %u.", UINT32_MAX/2);
+			return false;
+		}
+
+		struct ErrorState
+		{
+			enum Enum
+			{
+				Default,
+				ContextAllocated,
+			};
+		};
+
+		ErrorState::Enum errorState = ErrorState::Default;
+
+		initAllocatorCallback(_init);
+
+		if (true
+		&&  !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN || BX_PLATFORM_PS4)
+		&&  RendererType::Noop != _init.type
+		&&  NULL == _init.platformData.ndt
+		&&  NULL == _init.platformData.nwh
+		&&  NULL == _init.platformData.context
+		&&  NULL == _init.platformData.backBuffer
+		&&  NULL == _init.platformData.backBufferDS
+		   )
+		{
+			BX_TRACE("bgfx platform data like window handle or backbuffer is not set, creating headless device.");
+		}
+
+		initCaps(_init);
+
+		BX_TRACE("Init...");
+
+		errorState = ErrorState::ContextAllocated;
+
+		s_ctx = BX_ALIGNED_NEW(g_allocator, Context, 64);
+		if (s_ctx->init(_init) )
+		{
+			BX_TRACE("Init complete.");
+			return true;
+		}
+
+//error:
+		BX_TRACE("Init failed.");
+
+		switch (errorState)
+		{
+		case ErrorState::ContextAllocated:
+			BX_ALIGNED_DELETE(g_allocator, s_ctx, 64);
+			s_ctx = NULL;
+			BX_FALLTHROUGH;
+
+		case ErrorState::Default:
+			shutdownAllocatorCallback();
+			break;
+		}
+
+		return false;
+	}
+
+	void shutdown()
+	{
+		BX_TRACE("Shutdown...");
+
+		BGFX_CHECK_API_THREAD();
+		Context* ctx = s_ctx; // it's going to be NULLd inside shutdown.
+		ctx->shutdown();
+		BX_CHECK(NULL == s_ctx, "bgfx is should be uninitialized here.");
+
+		BX_ALIGNED_DELETE(g_allocator, ctx, 16);
+
+		BX_TRACE("Shutdown complete.");
+
+		if (NULL != s_callbackStub)
+		{
+			s_callbackStub->closeCache();
+		}
+
+		if (NULL != s_allocatorStub)
+		{
+			s_allocatorStub->checkLeaks();
+		}
+
+		shutdownAllocatorCallback();
+	}
+
+	bool Context::replayInit(const char* _filePath, const Init& _init)
+	{
+		m_replay = BX_NEW(g_allocator, FrameReplay);
+
+		Init init = _init;
+		if (!m_replay->open(_filePath, _init, init.limits) )
+		{
+			BX_DELETE(g_allocator, m_replay);
+			m_replay = NULL;
+			return false;
+		}
+
+		initCaps(init);
+
+		m_init = init;
+
+		if (g_platformData.ndt          == NULL
+		&&  g_platformData.nwh          == NULL
+		&&  g_platformData.context      == NULL
+		&&  g_platformData.backBuffer   == NULL
+		&&  g_platformData.backBufferDS == NULL)
+		{
+			bx::memCopy(&g_platformData, &m_init.platformData, sizeof(PlatformData) );
+		}
+
+		m_exit    = false;
+		m_flipped = true;
+		m_frames  = 0;
 
-		BX_TRACE("Init...");
+		m_timeline.reset();
+		m_timelineFrame = 0;
 
-		errorState = ErrorState::ContextAllocated;
+		m_render->create();
 
-		s_ctx = BX_ALIGNED_NEW(g_allocator, Context, 64);
-		if (s_ctx->init(_init) )
+#if BGFX_CONFIG_MULTITHREADED
+		m_jobScheduler.init(BGFX_CONFIG_SORT_NUM_THREADS);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return true;
+	}
+
+	const Stats* Context::replayFrame()
+	{
+		if (!m_replay->beginFrame() )
 		{
-			BX_TRACE("Init complete.");
-			return true;
+			return NULL;
 		}
 
-//error:
-		BX_TRACE("Init failed.");
-
-		switch (errorState)
+		// Frames are replayed on calling thread, there is nothing to wait for.
+		if (!m_replay->readCommands(m_render->m_cmdPre)
+		||  !m_replay->readFrame(m_render, m_clearQuad, m_textVideoMemBlitter)
+		||  !m_replay->readCommands(m_render->m_cmdPost) )
 		{
-		case ErrorState::ContextAllocated:
-			BX_ALIGNED_DELETE(g_allocator, s_ctx, 64);
-			s_ctx = NULL;
-			BX_FALLTHROUGH;
+			BX_TRACE("Frame recording is truncated.");
+			return NULL;
+		}
 
-		case ErrorState::Default:
-			if (NULL != s_callbackStub)
-			{
-				BX_DELETE(g_allocator, s_callbackStub);
-				s_callbackStub = NULL;
-			}
+		m_render->m_frameNum = ++m_frames;
 
-			if (NULL != s_allocatorStub)
-			{
-				bx::DefaultAllocator allocator;
-				BX_DELETE(&allocator, s_allocatorStub);
-				s_allocatorStub = NULL;
-			}
+		// Frames recorded while renderer was not initialized are not submitted, stats
+		// must not be carried over from previous replayed frame.
+		Stats& stats = m_render->m_perfStats;
+		ViewStats*    viewStats    = stats.viewStats;
+		EncoderStats* encoderStats = stats.encoderStats;
+		bx::memSet(&stats, 0, sizeof(stats) );
+		stats.viewStats    = viewStats;
+		stats.encoderStats = encoderStats;
 
-			s_renderFrameCalled = false;
-			s_threadIndex = 0;
-			g_callback    = NULL;
-			g_allocator   = NULL;
-			break;
+		const int64_t timeBegin = bx::getHPCounter();
+
+		rendererExecFrame();
+		flip();
+
+		if (NULL != m_renderCtx)
+		{
+			g_caps.rendererType = m_renderCtx->getRendererType();
 		}
 
-		return false;
+		stats.cpuTimeFrame = bx::getHPCounter() - timeBegin;
+		stats.cpuTimerFreq = bx::getHPFrequency();
+
+		return &stats;
 	}
 
-	void shutdown()
+	void Context::replayShutdown()
 	{
-		BX_TRACE("Shutdown...");
+		if (NULL != m_renderCtx)
+		{
+			// Recording can end before renderer shutdown commands.
+			m_rendererInitialized = false;
+			rendererDestroy(m_renderCtx);
+			m_renderCtx = NULL;
+		}
 
-		BGFX_CHECK_API_THREAD();
-		Context* ctx = s_ctx; // it's going to be NULLd inside shutdown.
-		ctx->shutdown();
-		BX_CHECK(NULL == s_ctx, "bgfx is should be uninitialized here.");
+		BX_DELETE(g_allocator, m_replay);
+		m_replay = NULL;
 
-		BX_ALIGNED_DELETE(g_allocator, ctx, 16);
+#if BGFX_CONFIG_MULTITHREADED
+		m_jobScheduler.shutdown();
+#endif // BGFX_CONFIG_MULTITHREADED
 
-		BX_TRACE("Shutdown complete.");
+		m_render->destroy();
 
-		if (NULL != s_allocatorStub)
+		m_textureUpdateBatch.destroy();
+		m_textureUpdateStaging.destroy();
+
+		BX_FREE(g_allocator, m_tempKeys);
+		BX_FREE(g_allocator, m_tempValues);
+		m_tempKeys     = NULL;
+		m_tempValues   = NULL;
+		m_tempCapacity = 0;
+
+		bx::memSet(&g_caps, 0, sizeof(g_caps) );
+	}
+
+	bool replayBegin(const char* _filePath, const Init& _init)
+	{
+		if (NULL != s_ctx)
 		{
-			s_allocatorStub->checkLeaks();
+			BX_TRACE("bgfx is already initialized.");
+			return false;
 		}
 
-		if (NULL != s_callbackStub)
+		initAllocatorCallback(_init);
+
+		s_ctx = BX_ALIGNED_NEW(g_allocator, Context, 64);
+		if (s_ctx->replayInit(_filePath, _init) )
 		{
-			BX_DELETE(g_allocator, s_callbackStub);
-			s_callbackStub = NULL;
+			return true;
 		}
 
+		BX_ALIGNED_DELETE(g_allocator, s_ctx, 64);
+		s_ctx = NULL;
+
+		shutdownAllocatorCallback();
+
+		return false;
+	}
+
+	const Stats* replayFrame()
+	{
+		BX_CHECK(NULL != s_ctx && NULL != s_ctx->m_replay, "Replay is not started.");
+		return s_ctx->replayFrame();
+	}
+
+	void replayEnd()
+	{
+		BX_CHECK(NULL != s_ctx && NULL != s_ctx->m_replay, "Replay is not started.");
+
+		Context* ctx = s_ctx;
+		ctx->replayShutdown();
+		s_ctx = NULL;
+
+		BX_ALIGNED_DELETE(g_allocator, ctx, 64);
+
 		if (NULL != s_allocatorStub)
 		{
-			bx::DefaultAllocator allocator;
-			BX_DELETE(&allocator, s_allocatorStub);
-			s_allocatorStub = NULL;
+			s_allocatorStub->checkLeaks();
 		}
 
-		s_renderFrameCalled = false;
-		s_threadIndex = 0;
-		g_callback    = NULL;
-		g_allocator   = NULL;
+		shutdownAllocatorCallback();
 	}
 
 	void reset(uint32_t _width, uint32_t _height, uint32_t _flags, TextureFormat::Enum _format)
@@ -3420,6 +5243,29 @@ namespace bgfx
 		BGFX_ENCODER(setVertexCount(_numVertices) );
 	}
 
+	void Encoder::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
+	{
+		BX_CHECK(NULL != _tib, "_tib can't be NULL");
+		BX_CHECK(0 < _num, "Requesting 0 indices.");
+		BGFX_ENCODER(allocTransientIndexBuffer(_tib, _num) );
+	}
+
+	void Encoder::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl)
+	{
+		BX_CHECK(NULL != _tvb, "_tvb can't be NULL");
+		BX_CHECK(0 < _num, "Requesting 0 vertices.");
+		BX_CHECK(isValid(_decl), "Invalid VertexDecl.");
+		BGFX_ENCODER(allocTransientVertexBuffer(_tvb, _num, _decl) );
+	}
+
+	void Encoder::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
+		BX_CHECK(_stride == BX_ALIGN_16(_stride), "Stride must be multiple of 16.");
+		BX_CHECK(0 < _num, "Requesting 0 instanced data vertices.");
+		BGFX_ENCODER(allocInstanceDataBuffer(_idb, _num, _stride) );
+	}
+
 	void Encoder::setInstanceDataBuffer(const InstanceDataBuffer* _idb)
 	{
 		setInstanceDataBuffer(_idb, 0, UINT32_MAX);
@@ -3449,6 +5295,17 @@ namespace bgfx
 			) );
 	}
 
+	void Encoder::setAutoInstancing(bool _enabled, uint16_t _stride)
+	{
+		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
+		BX_CHECK(_stride == BX_ALIGN_16(_stride), "Stride must be multiple of 16.");
+		BX_CHECK(0 < _stride && _stride <= BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT*16
+			, "Stride must be between 16 and %d."
+			, BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT*16
+			);
+		BGFX_ENCODER(setAutoInstancing(_enabled, _stride) );
+	}
+
 	void Encoder::setInstanceCount(uint32_t _numInstances)
 	{
 		BGFX_CHECK_CAPS(BGFX_CAPS_VERTEX_ID, "Auto generated instances are not supported!");
@@ -3612,6 +5469,116 @@ namespace bgfx
 		return s_ctx->getPerfStats();
 	}
 
+	uint32_t getTimeline(TimelineEvent* _events, uint32_t _max)
+	{
+		return s_ctx->m_timeline.read(_events, _max);
+	}
+
+	static const char* s_timelineStageName[] =
+	{
+		"Encoder",
+		"Wait render",
+		"Swap",
+		"Wait submit",
+		"Exec pre",
+		"Sort",
+		"Submit",
+		"Exec post",
+		"Flip",
+	};
+	BX_STATIC_ASSERT(BX_COUNTOF(s_timelineStageName) == TimelineStage::Count);
+
+	static uint32_t timelineThreadId(const TimelineEvent& _event)
+	{
+		switch (_event.stage)
+		{
+		case TimelineStage::Encoder:    return 2 + _event.encoder;
+		case TimelineStage::WaitRender:
+		case TimelineStage::Swap:       return 0;
+		default:                        break;
+		}
+
+		return 1;
+	}
+
+	static void timelineWrite(bx::WriterI* _writer, bx::Error* _err, const char* _format, ...)
+	{
+		char temp[512];
+
+		va_list argList;
+		va_start(argList, _format);
+		int32_t len = bx::vsnprintf(temp, sizeof(temp), _format, argList);
+		va_end(argList);
+
+		bx::write(_writer, temp, bx::min<int32_t>(len, sizeof(temp)-1), _err);
+	}
+
+	bool dumpTimeline(const char* _filePath)
+	{
+		const uint32_t max = s_ctx->m_timeline.read(NULL, 0);
+		TimelineEvent* events = (TimelineEvent*)BX_ALLOC(g_allocator, bx::max<uint32_t>(max, 1)*sizeof(TimelineEvent) );
+		const uint32_t num = s_ctx->m_timeline.read(events, max);
+
+		bx::FileWriter writer;
+		bx::Error err;
+
+		if (!bx::open(&writer, _filePath, false, &err) )
+		{
+			BX_FREE(g_allocator, events);
+			return false;
+		}
+
+		int64_t timeFirst = INT64_MAX;
+		uint32_t threadMask = 0;
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			timeFirst   = bx::min(timeFirst, events[ii].cpuTimeBegin);
+			threadMask |= UINT32_C(1) << bx::min<uint32_t>(timelineThreadId(events[ii]), 31);
+		}
+
+		// Chrome trace event format, times are in microseconds.
+		const double toUs = 1000000.0/double(bx::getHPFrequency() );
+
+		timelineWrite(&writer, &err
+			, "{\"traceEvents\":[\n"
+			  "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"API thread\"}},\n"
+			  "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Render thread\"}}"
+			);
+
+		for (uint32_t tid = 2; tid < 32; ++tid)
+		{
+			if (0 != (threadMask & (UINT32_C(1) << tid) ) )
+			{
+				timelineWrite(&writer, &err
+					, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"Encoder %d\"}}"
+					, tid
+					, tid-2
+					);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < num && err.isOk(); ++ii)
+		{
+			const TimelineEvent& event = events[ii];
+			timelineWrite(&writer, &err
+				, ",\n{\"name\":\"%s\",\"cat\":\"bgfx\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%d}}"
+				, s_timelineStageName[event.stage]
+				, timelineThreadId(event)
+				, double(event.cpuTimeBegin - timeFirst)*toUs
+				, double(event.cpuTimeEnd - event.cpuTimeBegin)*toUs
+				, event.frame
+				);
+		}
+
+		timelineWrite(&writer, &err, "\n]}\n");
+		bx::close(&writer);
+
+		BX_FREE(g_allocator, events);
+
+		return err.isOk();
+	}
+
 	RendererType::Enum getRendererType()
 	{
 		return g_caps.rendererType;
@@ -3743,6 +5710,12 @@ namespace bgfx
 		s_ctx->update(_handle, _startIndex, _mem);
 	}
 
+	uint32_t updateAsync(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem)
+	{
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->updateAsync(_handle, _startIndex, _mem);
+	}
+
 	void destroy(DynamicIndexBufferHandle _handle)
 	{
 		s_ctx->destroyDynamicIndexBuffer(_handle);
@@ -3767,6 +5740,12 @@ namespace bgfx
 		s_ctx->update(_handle, _startVertex, _mem);
 	}
 
+	uint32_t updateAsync(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem)
+	{
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		return s_ctx->updateAsync(_handle, _startVertex, _mem);
+	}
+
 	void destroy(DynamicVertexBufferHandle _handle)
 	{
 		s_ctx->destroyDynamicVertexBuffer(_handle);
@@ -4228,6 +6207,29 @@ namespace bgfx
 		}
 	}
 
+	uint32_t updateTexture2DAsync(TextureHandle _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const Memory* _mem, uint16_t _pitch)
+	{
+		BX_CHECK(NULL != _mem, "_mem can't be NULL");
+		if (_width  == 0
+		||  _height == 0)
+		{
+			release(_mem);
+			return 0;
+		}
+
+		return s_ctx->updateTextureAsync(_handle, _mip, _x, _y, _layer, _width, _height, _pitch, _mem);
+	}
+
+	bool isUploadComplete(uint32_t _ticket)
+	{
+		return s_ctx->isUploadComplete(_ticket);
+	}
+
+	uint32_t flushUpload(uint32_t _ticket)
+	{
+		return s_ctx->flushUpload(_ticket);
+	}
+
 	void updateTexture3D(TextureHandle _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const Memory* _mem)
 	{
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
@@ -4638,6 +6640,12 @@ namespace bgfx
 		s_ctx->m_encoder0->setInstanceDataBuffer(_handle, _startVertex, _num);
 	}
 
+	void setAutoInstancing(bool _enabled, uint16_t _stride)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->setAutoInstancing(_enabled, _stride);
+	}
+
 	void setInstanceCount(uint32_t _numInstances)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -4985,6 +6993,7 @@ BGFX_C99_ENUM_CHECK(bgfx::OcclusionQueryResult, BGFX_OCCLUSION_QUERY_RESULT_COUN
 BGFX_C99_ENUM_CHECK(bgfx::Topology,             BGFX_TOPOLOGY_COUNT);
 BGFX_C99_ENUM_CHECK(bgfx::TopologyConvert,      BGFX_TOPOLOGY_CONVERT_COUNT);
 BGFX_C99_ENUM_CHECK(bgfx::RenderFrame,          BGFX_RENDER_FRAME_COUNT);
+BGFX_C99_ENUM_CHECK(bgfx::TimelineStage,        BGFX_TIMELINE_STAGE_COUNT);
 #undef BGFX_C99_ENUM_CHECK
 
 #define BGFX_C99_STRUCT_SIZE_CHECK(_cppstruct, _c99struct) \
@@ -4993,6 +7002,8 @@ BGFX_C99_ENUM_CHECK(bgfx::RenderFrame,          BGFX_RENDER_FRAME_COUNT);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::Memory,                bgfx_memory_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::Transform,             bgfx_transform_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::Stats,                 bgfx_stats_t);
+BGFX_C99_STRUCT_SIZE_CHECK(bgfx::TimelineEvent,         bgfx_timeline_event_t);
+BGFX_C99_STRUCT_SIZE_CHECK(bgfx::ProfilerScopeStats,    bgfx_profiler_scope_stats_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::VertexDecl,            bgfx_vertex_decl_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::TransientIndexBuffer,  bgfx_transient_index_buffer_t);
 BGFX_C99_STRUCT_SIZE_CHECK(bgfx::TransientVertexBuffer, bgfx_transient_vertex_buffer_t);
@@ -5194,23 +7205,27 @@ BGFX_C_API void bgfx_init_ctor(bgfx_init_t* _init)
 	BX_PLACEMENT_NEW(_init, bgfx::Init);
 }
 
-BGFX_C_API bool bgfx_init(const bgfx_init_t* _init)
+static void bgfx_init_interfaces(bgfx_init_t& _init)
 {
-	bgfx_init_t init = *_init;
-
-	if (init.callback != NULL)
+	if (_init.callback != NULL)
 	{
 		static bgfx::CallbackC99 s_callback;
-		s_callback.m_interface = init.callback;
-		init.callback = reinterpret_cast<bgfx_callback_interface_t *>(&s_callback);
+		s_callback.m_interface = _init.callback;
+		_init.callback = reinterpret_cast<bgfx_callback_interface_t *>(&s_callback);
 	}
 
-	if (init.allocator != NULL)
+	if (_init.allocator != NULL)
 	{
 		static bgfx::AllocatorC99 s_allocator;
-		s_allocator.m_interface = init.allocator;
-		init.allocator = reinterpret_cast<bgfx_allocator_interface_t *>(&s_allocator);
+		s_allocator.m_interface = _init.allocator;
+		_init.allocator = reinterpret_cast<bgfx_allocator_interface_t *>(&s_allocator);
 	}
+}
+
+BGFX_C_API bool bgfx_init(const bgfx_init_t* _init)
+{
+	bgfx_init_t init = *_init;
+	bgfx_init_interfaces(init);
 
 	union { const bgfx_init_t* c; const bgfx::Init* cpp; } in;
 	in.c = &init;
@@ -5223,6 +7238,27 @@ BGFX_C_API void bgfx_shutdown(void)
 	return bgfx::shutdown();
 }
 
+BGFX_C_API bool bgfx_replay_begin(const char* _filePath, const bgfx_init_t* _init)
+{
+	bgfx_init_t init = *_init;
+	bgfx_init_interfaces(init);
+
+	union { const bgfx_init_t* c; const bgfx::Init* cpp; } in;
+	in.c = &init;
+
+	return bgfx::replayBegin(_filePath, *in.cpp);
+}
+
+BGFX_C_API const bgfx_stats_t* bgfx_replay_frame(void)
+{
+	return reinterpret_cast<const bgfx_stats_t*>(bgfx::replayFrame() );
+}
+
+BGFX_C_API void bgfx_replay_end(void)
+{
+	bgfx::replayEnd();
+}
+
 BGFX_C_API void bgfx_reset(uint32_t _width, uint32_t _height, uint32_t _flags, bgfx_texture_format_t _format)
 {
 	bgfx::reset(_width, _height, _flags, bgfx::TextureFormat::Enum(_format) );
@@ -5248,6 +7284,16 @@ BGFX_C_API const bgfx_stats_t* bgfx_get_stats(void)
 	return (const bgfx_stats_t*)bgfx::getStats();
 }
 
+BGFX_C_API uint32_t bgfx_get_timeline(bgfx_timeline_event_t* _events, uint32_t _max)
+{
+	return bgfx::getTimeline( (bgfx::TimelineEvent*)_events, _max);
+}
+
+BGFX_C_API bool bgfx_dump_timeline(const char* _filePath)
+{
+	return bgfx::dumpTimeline(_filePath);
+}
+
 BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size)
 {
 	return (const bgfx_memory_t*)bgfx::alloc(_size);
@@ -5343,6 +7389,12 @@ BGFX_C_API void bgfx_update_dynamic_index_buffer(bgfx_dynamic_index_buffer_handl
 	bgfx::update(handle.cpp, _startIndex, (const bgfx::Memory*)_mem);
 }
 
+BGFX_C_API uint32_t bgfx_update_dynamic_index_buffer_async(bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _startIndex, const bgfx_memory_t* _mem)
+{
+	union { bgfx_dynamic_index_buffer_handle_t c; bgfx::DynamicIndexBufferHandle cpp; } handle = { _handle };
+	return bgfx::updateAsync(handle.cpp, _startIndex, (const bgfx::Memory*)_mem);
+}
+
 BGFX_C_API void bgfx_destroy_dynamic_index_buffer(bgfx_dynamic_index_buffer_handle_t _handle)
 {
 	union { bgfx_dynamic_index_buffer_handle_t c; bgfx::DynamicIndexBufferHandle cpp; } handle = { _handle };
@@ -5371,6 +7423,12 @@ BGFX_C_API void bgfx_update_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_han
 	bgfx::update(handle.cpp, _startVertex, (const bgfx::Memory*)_mem);
 }
 
+BGFX_C_API uint32_t bgfx_update_dynamic_vertex_buffer_async(bgfx_dynamic_vertex_buffer_handle_t _handle, uint32_t _startVertex, const bgfx_memory_t* _mem)
+{
+	union { bgfx_dynamic_vertex_buffer_handle_t c; bgfx::DynamicVertexBufferHandle cpp; } handle = { _handle };
+	return bgfx::updateAsync(handle.cpp, _startVertex, (const bgfx::Memory*)_mem);
+}
+
 BGFX_C_API void bgfx_destroy_dynamic_vertex_buffer(bgfx_dynamic_vertex_buffer_handle_t _handle)
 {
 	union { bgfx_dynamic_vertex_buffer_handle_t c; bgfx::DynamicVertexBufferHandle cpp; } handle = { _handle };
@@ -5529,6 +7587,22 @@ BGFX_C_API void bgfx_update_texture_2d(bgfx_texture_handle_t _handle, uint16_t _
 	bgfx::updateTexture2D(handle.cpp, _layer, _mip, _x, _y, _width, _height, (const bgfx::Memory*)_mem, _pitch);
 }
 
+BGFX_C_API uint32_t bgfx_update_texture_2d_async(bgfx_texture_handle_t _handle, uint16_t _layer, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, const bgfx_memory_t* _mem, uint16_t _pitch)
+{
+	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
+	return bgfx::updateTexture2DAsync(handle.cpp, _layer, _mip, _x, _y, _width, _height, (const bgfx::Memory*)_mem, _pitch);
+}
+
+BGFX_C_API bool bgfx_is_upload_complete(uint32_t _ticket)
+{
+	return bgfx::isUploadComplete(_ticket);
+}
+
+BGFX_C_API uint32_t bgfx_flush_upload(uint32_t _ticket)
+{
+	return bgfx::flushUpload(_ticket);
+}
+
 BGFX_C_API void bgfx_update_texture_3d(bgfx_texture_handle_t _handle, uint8_t _mip, uint16_t _x, uint16_t _y, uint16_t _z, uint16_t _width, uint16_t _height, uint16_t _depth, const bgfx_memory_t* _mem)
 {
 	union { bgfx_texture_handle_t c; bgfx::TextureHandle cpp; } handle = { _handle };
@@ -5827,6 +7901,11 @@ BGFX_C_API void bgfx_set_instance_data_from_dynamic_vertex_buffer(bgfx_dynamic_v
 	bgfx::setInstanceDataBuffer(handle.cpp, _startVertex, _num);
 }
 
+BGFX_C_API void bgfx_set_auto_instancing(bool _enabled, uint16_t _stride)
+{
+	bgfx::setAutoInstancing(_enabled, _stride);
+}
+
 BGFX_C_API void bgfx_set_instance_count(uint32_t _numInstances)
 {
 	bgfx::setInstanceCount(_numInstances);
@@ -6023,6 +8102,22 @@ BGFX_C_API void bgfx_encoder_set_instance_data_buffer(bgfx_encoder_s* _encoder,
 	BGFX_ENCODER(setInstanceDataBuffer( (const bgfx::InstanceDataBuffer*)_idb, _start, _num) );
 }
 
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_s* _encoder, bgfx_transient_index_buffer_t* _tib, uint32_t _num)
+{
+	BGFX_ENCODER(allocTransientIndexBuffer( (bgfx::TransientIndexBuffer*)_tib, _num) );
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_s* _encoder, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_decl_t* _decl)
+{
+	const bgfx::VertexDecl& decl = *(const bgfx::VertexDecl*)_decl;
+	BGFX_ENCODER(allocTransientVertexBuffer( (bgfx::TransientVertexBuffer*)_tvb, _num, decl) );
+}
+
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_s* _encoder, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride)
+{
+	BGFX_ENCODER(allocInstanceDataBuffer( (bgfx::InstanceDataBuffer*)_idb, _num, _stride) );
+}
+
 BGFX_C_API void bgfx_encoder_set_instance_data_from_vertex_buffer(bgfx_encoder_s* _encoder, bgfx_vertex_buffer_handle_t _handle, uint32_t _startVertex, uint32_t _num)
 {
 	union { bgfx_vertex_buffer_handle_t c; bgfx::VertexBufferHandle cpp; } handle = { _handle };
@@ -6035,6 +8130,11 @@ BGFX_C_API void bgfx_encoder_set_instance_data_from_dynamic_vertex_buffer(bgfx_e
 	BGFX_ENCODER(setInstanceDataBuffer(handle.cpp, _startVertex, _num) );
 }
 
+BGFX_C_API void bgfx_encoder_set_auto_instancing(bgfx_encoder_s* _encoder, bool _enabled, uint16_t _stride)
+{
+	BGFX_ENCODER(setAutoInstancing(_enabled, _stride) );
+}
+
 BGFX_C_API void bgfx_encoder_set_instance_count(bgfx_encoder_s* _encoder, uint32_t _numInstances)
 {
 	BGFX_ENCODER(setInstanceCount(_numInstances) );
@@ -6310,7 +8410,22 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 	BGFX_IMPORT_FUNC(encoder_dispatch_indirect)                            \
 	BGFX_IMPORT_FUNC(encoder_discard)                                      \
 	BGFX_IMPORT_FUNC(encoder_blit)                                         \
-	BGFX_IMPORT_FUNC(request_screen_shot)
+	BGFX_IMPORT_FUNC(request_screen_shot)                                  \
+	BGFX_IMPORT_FUNC(encoder_alloc_transient_index_buffer)                 \
+	BGFX_IMPORT_FUNC(encoder_alloc_transient_vertex_buffer)                \
+	BGFX_IMPORT_FUNC(encoder_alloc_instance_data_buffer)                   \
+	BGFX_IMPORT_FUNC(set_auto_instancing)                                  \
+	BGFX_IMPORT_FUNC(encoder_set_auto_instancing)                          \
+	BGFX_IMPORT_FUNC(update_dynamic_index_buffer_async)                    \
+	BGFX_IMPORT_FUNC(update_dynamic_vertex_buffer_async)                   \
+	BGFX_IMPORT_FUNC(update_texture_2d_async)                              \
+	BGFX_IMPORT_FUNC(is_upload_complete)                                   \
+	BGFX_IMPORT_FUNC(flush_upload)                                         \
+	BGFX_IMPORT_FUNC(replay_begin)                                         \
+	BGFX_IMPORT_FUNC(replay_frame)                                         \
+	BGFX_IMPORT_FUNC(replay_end)                                           \
+	BGFX_IMPORT_FUNC(get_timeline)                                         \
+	BGFX_IMPORT_FUNC(dump_timeline)
 
 		static bgfx_interface_vtbl_t s_bgfx_interface =
 		{
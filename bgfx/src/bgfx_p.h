@@ -52,9 +52,9 @@
 
 #if BGFX_CONFIG_PROFILER
 #	define BGFX_PROFILER_SCOPE(_name, _abgr) ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN(_name, _abgr) g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_END() g_callback->profilerEnd()
-#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
+#	define BGFX_PROFILER_BEGIN(_name, _abgr) profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
+#	define BGFX_PROFILER_END() profilerEnd()
+#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) profilerSetThreadName(_name)
 #else
 #	define BGFX_PROFILER_SCOPE(_name, _abgr) BX_NOOP()
 #	define BGFX_PROFILER_BEGIN(_name, _abgr) BX_NOOP()
@@ -114,6 +114,7 @@ namespace bgfx
 #include <bx/float4x4_t.h>
 #include <bx/handlealloc.h>
 #include <bx/hash.h>
+#include <bx/hashmap.h>
 #include <bx/math.h>
 #include <bx/mutex.h>
 #include <bx/os.h>
@@ -215,6 +216,15 @@ namespace stl = std;
 
 #define BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE UINT8_C(0x80)
 
+#define BGFX_DRAW_CHANGED_STATE             UINT8_C(0x01) //!< State flags.
+#define BGFX_DRAW_CHANGED_STENCIL           UINT8_C(0x02) //!< Stencil state.
+#define BGFX_DRAW_CHANGED_SCISSOR           UINT8_C(0x04) //!< Scissor rect.
+#define BGFX_DRAW_CHANGED_BLEND_FACTOR      UINT8_C(0x08) //!< Blend factor.
+#define BGFX_DRAW_CHANGED_BINDINGS          UINT8_C(0x10) //!< Texture and buffer bindings.
+#define BGFX_DRAW_CHANGED_STREAMS           UINT8_C(0x20) //!< Vertex streams, instance data and index buffer.
+#define BGFX_DRAW_CHANGED_UNIFORMS          UINT8_C(0x40) //!< Draw has its own uniforms.
+#define BGFX_DRAW_CHANGED_ALL               UINT8_C(0x7f)
+
 #define BGFX_RENDERER_DIRECT3D9_NAME  "Direct3D 9"
 #define BGFX_RENDERER_DIRECT3D11_NAME "Direct3D 11"
 #define BGFX_RENDERER_DIRECT3D12_NAME "Direct3D 12"
@@ -267,11 +277,7 @@ namespace bgfx
 	extern PlatformData g_platformData;
 	extern bool g_platformDataChangedSinceReset;
 
-#if BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
-	typedef uint16_t RenderItemCount;
-#else
 	typedef uint32_t RenderItemCount;
-#endif // BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
 
 	struct Handle
 	{
@@ -455,22 +461,50 @@ namespace bgfx
 
 	typedef bx::StringT<&g_allocator> String;
 
+	extern bool g_profilerEnabled;
+
+	void profilerScopeBegin(const char* _name);
+	void profilerScopeEnd();
+	void profilerSetThreadName(const char* _name);
+	void profilerSetEnabled(bool _enabled);
+
+	inline void profilerBegin(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
+	{
+		g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+
+		if (g_profilerEnabled)
+		{
+			profilerScopeBegin(_name);
+		}
+	}
+
+	inline void profilerEnd()
+	{
+		if (g_profilerEnabled)
+		{
+			profilerScopeEnd();
+		}
+
+		g_callback->profilerEnd();
+	}
+
 	struct ProfilerScope
 	{
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
 		{
-			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			profilerBegin(_name, _abgr, _filePath, _line);
 		}
 
 		~ProfilerScope()
 		{
-			g_callback->profilerEnd();
+			profilerEnd();
 		}
 	};
 
 	void setGraphicsDebuggerPresent(bool _present);
 	bool isGraphicsDebuggerPresent();
 	void release(const Memory* _mem);
+	bool isMemoryRef(const Memory* _mem);
 	const char* getAttribName(Attrib::Enum _attr);
 	const char* getAttribNameShort(Attrib::Enum _attr);
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height);
@@ -636,6 +670,14 @@ namespace bgfx
 
 	struct TextVideoMemBlitter
 	{
+		TextVideoMemBlitter()
+			: m_vb(NULL)
+			, m_ib(NULL)
+		{
+			m_texture.idx = kInvalidHandle;
+			m_program.idx = kInvalidHandle;
+		}
+
 		void init();
 		void shutdown();
 
@@ -655,16 +697,32 @@ namespace bgfx
 		blit(_renderCtx, _blitter, *_mem);
 	}
 
-	template <uint32_t maxKeys>
-	struct UpdateBatchT
+	struct UpdateBatch
 	{
-		UpdateBatchT()
+		UpdateBatch()
 			: m_num(0)
+			, m_max(0)
+			, m_keys(NULL)
+			, m_values(NULL)
 		{
 		}
 
+		void destroy()
+		{
+			BX_FREE(g_allocator, m_keys);
+			m_num    = 0;
+			m_max    = 0;
+			m_keys   = NULL;
+			m_values = NULL;
+		}
+
 		void add(uint32_t _key, uint32_t _value)
 		{
+			if (m_num == m_max)
+			{
+				grow();
+			}
+
 			uint32_t num = m_num++;
 			m_keys[num] = _key;
 			m_values[num] = _value;
@@ -674,8 +732,9 @@ namespace bgfx
 		{
 			if (0 < m_num)
 			{
-				uint32_t* tempKeys = (uint32_t*)alloca(sizeof(m_keys) );
-				uint32_t* tempValues = (uint32_t*)alloca(sizeof(m_values) );
+				// Radix sort is stable, updates with the same key stay in submission order.
+				uint32_t* tempKeys   = &m_values[m_max];
+				uint32_t* tempValues = &tempKeys[m_max];
 				bx::radixSort(m_keys, tempKeys, m_values, tempValues, m_num);
 				return true;
 			}
@@ -683,24 +742,41 @@ namespace bgfx
 			return false;
 		}
 
-		bool isFull() const
-		{
-			return m_num >= maxKeys;
-		}
-
 		void reset()
 		{
 			m_num = 0;
 		}
 
-		uint32_t m_num;
-		uint32_t m_keys[maxKeys];
-		uint32_t m_values[maxKeys];
+		uint32_t  m_num;
+		uint32_t  m_max;
+		uint32_t* m_keys;
+		uint32_t* m_values;
+
+	private:
+		void grow()
+		{
+			// Single allocation holds keys, values, and sort scratch for both.
+			const uint32_t max = bx::max<uint32_t>(256, m_max*2);
+			uint32_t* keys = (uint32_t*)BX_ALLOC(g_allocator, max*4*sizeof(uint32_t) );
+			uint32_t* values = &keys[max];
+
+			if (0 < m_num)
+			{
+				bx::memCopy(keys,   m_keys,   m_num*sizeof(uint32_t) );
+				bx::memCopy(values, m_values, m_num*sizeof(uint32_t) );
+			}
+
+			BX_FREE(g_allocator, m_keys);
+			m_max    = max;
+			m_keys   = keys;
+			m_values = values;
+		}
 	};
 
 	struct ClearQuad
 	{
 		ClearQuad()
+			: m_vb(NULL)
 		{
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_program); ++ii)
 			{
@@ -755,9 +831,10 @@ namespace bgfx
 	public:
 		CommandBuffer()
 			: m_pos(0)
-			, m_size(BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE)
+			, m_size(0)
+			, m_page(NULL)
+			, m_numPages(0)
 		{
-			finish();
 		}
 
 		enum Enum
@@ -797,12 +874,25 @@ namespace bgfx
 			RequestScreenShot,
 		};
 
+		void destroy()
+		{
+			for (uint32_t ii = 0; ii < m_numPages; ++ii)
+			{
+				BX_FREE(g_allocator, m_page[ii]);
+			}
+
+			BX_FREE(g_allocator, m_page);
+			m_page     = NULL;
+			m_numPages = 0;
+			m_pos      = 0;
+			m_size     = 0;
+		}
+
 		void write(const void* _data, uint32_t _size)
 		{
-			BX_CHECK(m_size == BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE, "Called write outside start/finish?");
-			BX_CHECK(m_pos < m_size, "CommandBuffer::write error (pos: %d, size: %d).", m_pos, m_size);
-			bx::memCopy(&m_buffer[m_pos], _data, _size);
-			m_pos += _size;
+			BX_CHECK(m_size == UINT32_MAX, "Called write outside start/finish?");
+			uint8_t* data = reserve(_size);
+			bx::memCopy(data, _data, _size);
 		}
 
 		template<typename Type>
@@ -815,8 +905,7 @@ namespace bgfx
 		void read(void* _data, uint32_t _size)
 		{
 			BX_CHECK(m_pos < m_size, "CommandBuffer::read error (pos: %d, size: %d).", m_pos, m_size);
-			bx::memCopy(_data, &m_buffer[m_pos], _size);
-			m_pos += _size;
+			bx::memCopy(_data, reserve(_size), _size);
 		}
 
 		template<typename Type>
@@ -829,9 +918,7 @@ namespace bgfx
 		const uint8_t* skip(uint32_t _size)
 		{
 			BX_CHECK(m_pos < m_size, "CommandBuffer::skip error (pos: %d, size: %d).", m_pos, m_size);
-			const uint8_t* result = &m_buffer[m_pos];
-			m_pos += _size;
-			return result;
+			return reserve(_size);
 		}
 
 		template<typename Type>
@@ -856,7 +943,7 @@ namespace bgfx
 		void start()
 		{
 			m_pos = 0;
-			m_size = BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			m_size = UINT32_MAX;
 		}
 
 		void finish()
@@ -869,7 +956,103 @@ namespace bgfx
 
 		uint32_t m_pos;
 		uint32_t m_size;
-		uint8_t m_buffer[BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE];
+
+	private:
+		// Returns _size contiguous bytes at current position and advances past them. Data that
+		// doesn't fit into the rest of current page starts at the next page. Reader makes the
+		// same decision as writer, so both stay in sync. Pages are allocated on first write and
+		// kept for following frames.
+		uint8_t* reserve(uint32_t _size)
+		{
+			BX_CHECK(_size <= BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+				, "CommandBuffer command is larger than page (size: %d, page size: %d)."
+				, _size
+				, BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+				);
+
+			const uint32_t offset = m_pos % BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE;
+			if (offset + _size > BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE)
+			{
+				m_pos += BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE - offset;
+			}
+
+			const uint32_t page = m_pos / BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE;
+			if (page == m_numPages)
+			{
+				BX_CHECK(m_size == UINT32_MAX, "CommandBuffer read past end (pos: %d, size: %d).", m_pos, m_size);
+
+				m_page = (uint8_t**)BX_REALLOC(g_allocator, m_page, (m_numPages+1)*sizeof(uint8_t*) );
+				m_page[m_numPages] = (uint8_t*)BX_ALLOC(g_allocator, BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE);
+				++m_numPages;
+			}
+
+			uint8_t* result = &m_page[page][m_pos % BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE];
+			m_pos += _size;
+			return result;
+		}
+
+		uint8_t** m_page;
+		uint32_t  m_numPages;
+	};
+
+	BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE) );
+
+	/// Arguments of `CommandBuffer::UpdateTexture` command.
+	struct TextureUpdate
+	{
+		TextureHandle handle;
+		uint8_t  side;
+		uint8_t  mip;
+		Rect     rect;
+		uint16_t zz;
+		uint16_t depth;
+		uint16_t pitch;
+		uint8_t  format;
+		const Memory* mem;
+	};
+
+	/// Staging memory used to compose merged texture updates. Kept between frames.
+	struct TextureUpdateStaging
+	{
+		TextureUpdateStaging()
+			: m_data(NULL)
+			, m_size(0)
+		{
+		}
+
+		void destroy()
+		{
+			BX_FREE(g_allocator, m_data);
+			m_data = NULL;
+			m_size = 0;
+		}
+
+		uint8_t* m_data;
+		uint32_t m_size;
+		Memory   m_mem;
+	};
+
+	void writeTextureUpdate(CommandBuffer& _cmdbuf, const TextureUpdate& _update);
+	void readTextureUpdate(CommandBuffer& _cmdbuf, uint32_t _pos, TextureUpdate& _update);
+
+	/// Reads update at `_pos[0]` into `_update`, and composes following updates of the same
+	/// texture side and mip into it, as long as together they cover a rectangle. Returns number
+	/// of updates read. When it's more than one, `_update` points to composed data in
+	/// `_staging`, and memory of composed updates is released.
+	uint32_t mergeTextureUpdates(CommandBuffer& _cmdbuf, const uint32_t* _pos, uint32_t _num, TextureUpdate& _update, TextureUpdateStaging& _staging);
+
+	/// Pointer stored in command buffer, it can't be replayed as is.
+	struct RecordPatch
+	{
+		enum Enum
+		{
+			Memory,       //!< `const Memory*`, data is replayed from new allocation.
+			Texture,      //!< Same as `Memory`, with `TextureCreate` chunk which references memory.
+			ReadTexture,  //!< Read back destination, replayed as NULL.
+			WindowHandle, //!< Native window handle, replayed as `PlatformData::nwh`.
+
+			Count
+		};
 	};
 
 //
@@ -1191,12 +1374,98 @@ namespace bgfx
 		}
 	};
 
+	/// Storage that grows in chunks. Chunks are never moved, and chunk can be
+	/// allocated while other threads are writing into already allocated chunks.
+	template<typename Ty>
+	struct ChunkArray
+	{
+		ChunkArray()
+			: m_chunk(NULL)
+			, m_maxChunks(0)
+		{
+		}
+
+		void create(uint32_t _maxChunks)
+		{
+			m_maxChunks = _maxChunks;
+			m_chunk = (Ty**)BX_ALLOC(g_allocator, sizeof(Ty*)*m_maxChunks);
+			bx::memSet(m_chunk, 0, sizeof(Ty*)*m_maxChunks);
+		}
+
+		void destroy()
+		{
+			for (uint32_t ii = 0; ii < m_maxChunks; ++ii)
+			{
+				if (NULL != m_chunk[ii])
+				{
+					BX_ALIGNED_FREE(g_allocator, m_chunk[ii], BX_CACHE_LINE_SIZE);
+				}
+			}
+
+			BX_FREE(g_allocator, m_chunk);
+			m_chunk     = NULL;
+			m_maxChunks = 0;
+		}
+
+		Ty* alloc(uint32_t _chunk)
+		{
+			BX_CHECK(_chunk < m_maxChunks, "Chunk out of bounds %d (max: %d).", _chunk, m_maxChunks);
+
+			Ty* chunk = *(Ty* volatile*)&m_chunk[_chunk];
+			if (NULL == chunk)
+			{
+				bx::MutexScope lock(m_lock);
+
+				chunk = m_chunk[_chunk];
+				if (NULL == chunk)
+				{
+					chunk = (Ty*)BX_ALIGNED_ALLOC(g_allocator, sizeof(Ty), BX_CACHE_LINE_SIZE);
+					bx::writeBarrier();
+					m_chunk[_chunk] = chunk;
+				}
+			}
+
+			return chunk;
+		}
+
+		Ty& operator[](uint32_t _chunk)
+		{
+			return *m_chunk[_chunk];
+		}
+
+		const Ty& operator[](uint32_t _chunk) const
+		{
+			return *m_chunk[_chunk];
+		}
+
+		Ty** m_chunk;
+		uint32_t m_maxChunks;
+		bx::Mutex m_lock;
+	};
+
+	struct MatrixCacheChunk
+	{
+		Matrix4 m_matrix[BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+	};
+
 	struct MatrixCache
 	{
 		MatrixCache()
 			: m_num(1)
+			, m_max(0)
+		{
+		}
+
+		void create(uint32_t _max)
+		{
+			m_max = _max;
+			m_chunk.create( (m_max+BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE-1)/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+			m_chunk.alloc(0)->m_matrix[0].setIdentity();
+		}
+
+		void destroy()
 		{
-			m_cache[0].setIdentity();
+			m_chunk.destroy();
 		}
 
 		void reset()
@@ -1204,44 +1473,66 @@ namespace bgfx
 			m_num = 1;
 		}
 
+		/// Returns index of first of `*_num` contiguous matrices, or UINT32_MAX when cache
+		/// doesn't have enough space left.
 		uint32_t reserve(uint16_t* _num)
 		{
-			uint32_t num = *_num;
-			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_MATRIX_CACHE - 1);
-			BX_WARN(first+num < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::min(num, BGFX_CONFIG_MAX_MATRIX_CACHE-1-first);
-			*_num = (uint16_t)num;
-			return first;
-		}
+			const uint32_t num = bx::min<uint32_t>(*_num, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
 
-		uint32_t add(const void* _mtx, uint16_t _num)
-		{
-			if (NULL != _mtx)
+			uint32_t first;
+			for (uint32_t old = m_num;;)
 			{
-				uint32_t first = reserve(&_num);
-				bx::memCopy(&m_cache[first], _mtx, sizeof(Matrix4)*_num);
-				return first;
+				// Matrices must be contiguous, skip rest of the chunk when they don't fit.
+				first = old;
+				if (first%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE + num > BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+				{
+					first = bx::strideAlign(first, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				}
+
+				const uint32_t end = first+num;
+				if (end > m_max)
+				{
+					*_num = 0;
+					return UINT32_MAX;
+				}
+
+				const uint32_t cur = bx::atomicCompareAndSwap<uint32_t>(&m_num, old, end);
+				if (cur == old)
+				{
+					break;
+				}
+
+				old = cur;
 			}
 
-			return 0;
+			*_num = uint16_t(num);
+
+			m_chunk.alloc(first/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+
+			return first;
 		}
 
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_CHECK(_cacheIdx < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_CHECK(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_max
 				);
-			return m_cache[_cacheIdx].un.val;
+			return m_chunk[_cacheIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_matrix[_cacheIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].un.val;
 		}
 
-		uint32_t fromPtr(const void* _ptr) const
+		const Matrix4& get(uint32_t _cacheIdx) const
 		{
-			return uint32_t( (const Matrix4*)_ptr - m_cache);
+			BX_CHECK(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
+				, _cacheIdx
+				, m_max
+				);
+			return m_chunk[_cacheIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_matrix[_cacheIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
 		}
 
-		Matrix4 m_cache[BGFX_CONFIG_MAX_MATRIX_CACHE];
+		ChunkArray<MatrixCacheChunk> m_chunk;
 		uint32_t m_num;
+		uint32_t m_max;
 	};
 
 	struct RectCache
@@ -1395,7 +1686,30 @@ namespace bgfx
 			m_pos = 0;
 		}
 
+		const char* getData(uint32_t _pos) const
+		{
+			return &m_buffer[_pos];
+		}
+
+		/// Reads at `_pos` and advances it, buffer read position is not changed, so that
+		/// multiple threads can read the same buffer.
+		const char* readAt(uint32_t& _pos, uint32_t _size) const
+		{
+			BX_CHECK(_pos < m_size, "Out of bounds %d (size: %d).", _pos, m_size);
+			const char* result = &m_buffer[_pos];
+			_pos += _size;
+			return result;
+		}
+
+		uint32_t readAt(uint32_t& _pos) const
+		{
+			uint32_t result;
+			bx::memCopy(&result, readAt(_pos, sizeof(uint32_t) ), sizeof(uint32_t) );
+			return result;
+		}
+
 		void writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
+		void writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num = 1);
 		void writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num = 1);
 		void writeMarker(const char* _marker);
 
@@ -1416,6 +1730,26 @@ namespace bgfx
 		char m_buffer[256<<20];
 	};
 
+	/// Uniform values as pointers to data in frame uniform buffers, NULL if uniform was not
+	/// updated. Used by backends recording sorted render items on multiple threads, where each
+	/// thread updates its own state instead of renderer uniform storage.
+	struct UniformState
+	{
+		void reset()
+		{
+			bx::memSet(m_data, 0, sizeof(m_data) );
+		}
+
+		/// Applies uniform updates in `[_begin, _end)` of uniform buffer. Thread safe.
+		void update(const UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+
+		/// Uniforms not updated in this state take value from `_prev`.
+		void inherit(const UniformState& _prev);
+
+		const void* m_data[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t    m_size[BGFX_CONFIG_MAX_UNIFORMS];
+	};
+
 	struct UniformRegInfo
 	{
 		UniformHandle m_handle;
@@ -1776,6 +2110,16 @@ namespace bgfx
 
 	struct FrameCache
 	{
+		void create(uint32_t _maxMatrices)
+		{
+			m_matrixCache.create(_maxMatrices);
+		}
+
+		void destroy()
+		{
+			m_matrixCache.destroy();
+		}
+
 		void reset()
 		{
 			m_matrixCache.reset();
@@ -1798,18 +2142,52 @@ namespace bgfx
 		RectCache m_rectCache;
 	};
 
+	/// Range of sorted render items.
+	struct RenderItemRange
+	{
+		uint32_t m_begin;
+		uint32_t m_end;
+	};
+
+	struct RenderItemSlab
+	{
+		void clear()
+		{
+			m_begin = 0;
+			m_end   = 0;
+		}
+
+		uint32_t m_begin;
+		uint32_t m_end;
+	};
+
+	struct RenderItemChunk
+	{
+		uint64_t        m_sortKey[BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		RenderItemCount m_sortValue[BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		RenderItem      m_renderItem[BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		RenderBind      m_renderItemBind[BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+	};
+
+	BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE) );
+	BX_STATIC_ASSERT(0 == BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE%BGFX_CONFIG_ENCODER_SLAB_SIZE);
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
-			: m_waitSubmit(0)
+			: m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_drawChanged(NULL)
+			, m_modelView(NULL)
+			, m_modelViewProj(NULL)
+			, m_sortCapacity(0)
+			, m_uploadSize(0)
+			, m_uploadTicket(0)
+			, m_frameNum(0)
+			, m_waitSubmit(0)
 			, m_waitRender(0)
 			, m_capture(false)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = kInvalidHandle;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
 			m_perfStats.viewStats = m_viewStats;
@@ -1830,6 +2208,18 @@ namespace bgfx
 				{
 					m_uniformBuffer[ii] = UniformBuffer::create();
 				}
+
+				m_unusedSlab = (RenderItemSlab*)BX_ALLOC(g_allocator, sizeof(RenderItemSlab)*num);
+			}
+
+			{
+				const uint32_t num = g_caps.limits.maxDrawCalls;
+
+				m_renderItemChunk.create( (num+BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE-1)/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				const uint32_t maxRuns = (num+BGFX_CONFIG_ENCODER_SLAB_SIZE-1)/BGFX_CONFIG_ENCODER_SLAB_SIZE;
+				m_run     = (RenderItemSlab*)BX_ALLOC(g_allocator, sizeof(RenderItemSlab)*maxRuns);
+				m_runHeap = (uint32_t*)BX_ALLOC(g_allocator, sizeof(uint32_t)*maxRuns);
+				m_frameCache.create(num+1);
 			}
 
 			reset();
@@ -1845,7 +2235,26 @@ namespace bgfx
 			}
 
 			BX_FREE(g_allocator, m_uniformBuffer);
+			BX_FREE(g_allocator, m_unusedSlab);
 			BX_DELETE(g_allocator, m_textVideoMem);
+
+			m_renderItemChunk.destroy();
+			m_frameCache.destroy();
+			BX_FREE(g_allocator, m_run);
+			BX_FREE(g_allocator, m_runHeap);
+			m_cmdPre.destroy();
+			m_cmdPost.destroy();
+			BX_FREE(g_allocator, m_sortKeys);
+			BX_FREE(g_allocator, m_sortValues);
+			BX_FREE(g_allocator, m_drawChanged);
+			BX_ALIGNED_FREE(g_allocator, m_modelView, 16);
+			BX_ALIGNED_FREE(g_allocator, m_modelViewProj, 16);
+			m_sortKeys      = NULL;
+			m_sortValues    = NULL;
+			m_drawChanged   = NULL;
+			m_modelView     = NULL;
+			m_modelViewProj = NULL;
+			m_sortCapacity  = 0;
 		}
 
 		void reset()
@@ -1857,14 +2266,31 @@ namespace bgfx
 
 		void start()
 		{
-			m_perfStats.transientVbUsed = m_vboffset;
-			m_perfStats.transientIbUsed = m_iboffset;
+			m_perfStats.transientVbUsed   = m_vboffset;
+			m_perfStats.transientIbUsed   = m_iboffset;
+			m_perfStats.transientVbWasted = m_vbwasted;
+			m_perfStats.transientIbWasted = m_ibwasted;
+			m_perfStats.uniformBytesSaved = m_uniformBytesSaved;
+			m_perfStats.uploadSize        = m_uploadSize;
 
 			m_frameCache.reset();
 			m_numRenderItems = 0;
 			m_numBlitItems   = 0;
+			m_numRuns        = 0;
+
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				m_unusedSlab[ii].clear();
+			}
+
 			m_iboffset = 0;
 			m_vboffset = 0;
+			m_ibwasted = 0;
+			m_vbwasted = 0;
+			m_uniformBytesSaved = 0;
+			m_numBatches = 0;
+			m_numBatchedDraws = 0;
+			m_uploadSize = 0;
 			m_cmdPre.start();
 			m_cmdPost.start();
 			m_capture = false;
@@ -1875,18 +2301,97 @@ namespace bgfx
 			m_cmdPre.finish();
 			m_cmdPost.finish();
 
+			if (!BX_ENABLED(BGFX_CONFIG_SORT_ENCODER_RUNS) )
+			{
+				compact();
+			}
+
 //			if (0 < m_numDropped)
 //			{
 //				BX_TRACE("Too many draw calls: %d, dropped %d (max: %d)"
 //					, m_numRenderItems+m_numDropped
 //					, m_numDropped
-//					, BGFX_CONFIG_MAX_DRAW_CALLS
+//					, g_caps.limits.maxDrawCalls
 //					);
 //			}
 		}
 
+		void addRun(uint32_t _begin, uint32_t _end)
+		{
+			const uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_numRuns, 1);
+			m_run[idx].m_begin = _begin;
+			m_run[idx].m_end   = _end;
+		}
+
+		RenderItemChunk* allocRenderItemChunk(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk.alloc(_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+		}
+
+		/// Sort key as submitted by encoder, before frame is sorted.
+		uint64_t& getSortKey(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_sortKey[_renderItemIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		RenderItemCount& getSortValue(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_sortValue[_renderItemIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		RenderItem& getRenderItem(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItem[_renderItemIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		const RenderItem& getRenderItem(uint32_t _renderItemIdx) const
+		{
+			return m_renderItemChunk[_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItem[_renderItemIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		RenderBind& getRenderItemBind(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItemBind[_renderItemIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		const RenderBind& getRenderItemBind(uint32_t _renderItemIdx) const
+		{
+			return m_renderItemChunk[_renderItemIdx/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItemBind[_renderItemIdx%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		void moveRenderItems(uint32_t _dst, uint32_t _src, uint32_t _num);
+		void compact();
+		void reserveSortKeys(uint32_t _num);
+		void gatherRenderItems(ViewId* _viewRemap);
+		void gatherRuns(ViewId* _viewRemap);
+		void mergeRuns();
+		/// Fills m_drawChanged for sorted items, called at the end of sort so that all
+		/// renderers can skip redundant state changes using BGFX_DRAW_CHANGED_*.
+		void diffRenderItems();
+		void computeModelMatrices(uint32_t _begin, uint32_t _end);
+		void computeModelMatrices();
 		void sort();
 
+		/// Splits sorted render items into at most `_maxRanges` contiguous ranges of similar
+		/// size, each at least `_minItems` long, for recording on multiple threads. Split
+		/// points are moved to nearby view or compute/draw boundary when possible. Returns
+		/// number of ranges.
+		uint32_t splitRenderItems(RenderItemRange* _outRange, uint32_t _maxRanges, uint32_t _minItems) const;
+
+		/// Returns true if sorted item is first of its view's compute or draw segment. Backends
+		/// recording split ranges clear view at first draw, no matter which range it's in.
+		bool isSegmentBegin(uint32_t _item) const
+		{
+			return 0 == _item
+				|| (m_sortKeys[_item-1]>>SORT_KEY_DRAW_BIT_SHIFT) != (m_sortKeys[_item]>>SORT_KEY_DRAW_BIT_SHIFT)
+				;
+		}
+
+		/// Fills `_outState[ii]` with uniform values at start of range `ii`, and
+		/// `_outState[_numRanges]` with values at the end of frame, relative to uniform values
+		/// before frame. Ranges are scanned in parallel.
+		void gatherUniformStates(UniformState* _outState, const RenderItemRange* _range, uint32_t _numRanges) const;
+
 		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
 		{
 			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
@@ -1896,12 +2401,31 @@ namespace bgfx
 			return num;
 		}
 
+		/// Reserve up to _size bytes aligned to _align. Lock-free, can be called from any
+		/// encoder thread.
+		static uint32_t allocTransient(uint32_t* _offset, uint32_t _max, uint32_t& _size, uint32_t _align)
+		{
+			for (uint32_t old = *_offset;;)
+			{
+				const uint32_t offset = bx::min(bx::strideAlign(old, _align), _max);
+				const uint32_t end    = offset + bx::min(_size, _max-offset);
+
+				const uint32_t cur = bx::atomicCompareAndSwap<uint32_t>(_offset, old, end);
+				if (cur == old)
+				{
+					_size = end - offset;
+					return offset;
+				}
+
+				old = cur;
+			}
+		}
+
 		uint32_t allocTransientIndexBuffer(uint32_t& _num)
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t num    = getAvailTransientIndexBuffer(_num);
-			m_iboffset = offset + num*sizeof(uint16_t);
-			_num = num;
+			uint32_t size   = _num*sizeof(uint16_t);
+			uint32_t offset = allocTransient(&m_iboffset, g_caps.limits.transientIbSize, size, sizeof(uint16_t) );
+			_num = size/sizeof(uint16_t);
 
 			return offset;
 		}
@@ -1917,10 +2441,9 @@ namespace bgfx
 
 		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
+			uint32_t size   = _num*_stride;
+			uint32_t offset = allocTransient(&m_vboffset, g_caps.limits.transientVbSize, size, _stride);
+			_num = size/_stride;
 
 			return offset;
 		}
@@ -1984,22 +2507,37 @@ namespace bgfx
 
 		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		ChunkArray<RenderItemChunk> m_renderItemChunk;
+
+		uint64_t* m_sortKeys;
+		RenderItemCount* m_sortValues;
+		uint8_t* m_drawChanged; //!< BGFX_DRAW_CHANGED_* relative to previous sorted item, see diffRenderItems.
+		Matrix4* m_modelView;     //!< Per sorted draw u_modelView (eye 0).
+		Matrix4* m_modelViewProj; //!< Per sorted draw u_modelViewProj (eye 0).
+		uint32_t m_sortCapacity;
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 
 		FrameCache m_frameCache;
 		UniformBuffer** m_uniformBuffer;
+		RenderItemSlab* m_unusedSlab;
+		RenderItemSlab* m_run;
+		uint32_t*       m_runHeap;
 
 		uint32_t m_numRenderItems;
+		uint32_t m_numRuns;
 		uint16_t m_numBlitItems;
 
 		uint32_t m_iboffset;
 		uint32_t m_vboffset;
+		uint32_t m_ibwasted;
+		uint32_t m_vbwasted;
+		uint32_t m_uniformBytesSaved;
+		uint32_t m_numBatches;      //!< Auto-instanced batches submitted by all encoders.
+		uint32_t m_numBatchedDraws; //!< Draw calls merged into auto-instanced batches.
+		uint32_t m_uploadSize;   //!< Asynchronous upload bytes passed to renderer.
+		uint32_t m_uploadTicket; //!< Last asynchronous upload passed to renderer.
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
@@ -2079,6 +2617,8 @@ namespace bgfx
 		Stats     m_perfStats;
 		ViewStats m_viewStats[BGFX_CONFIG_MAX_VIEWS];
 
+		uint32_t m_frameNum;
+
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
 
@@ -2088,10 +2628,25 @@ namespace bgfx
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
 	{
 		EncoderImpl()
+			: m_uniformCacheEpoch(0)
+			, m_uniformBytesSaved(0)
+			, m_batchNum(0)
+			, m_autoInstancingStride(0)
+			, m_runTempKeys(NULL)
+			, m_runTempValues(NULL)
+			, m_runTempCapacity(0)
 		{
+			bx::memSet(m_uniformCache, 0, sizeof(m_uniformCache) );
+
 			discard();
 		}
 
+		~EncoderImpl()
+		{
+			BX_FREE(g_allocator, m_runTempKeys);
+			BX_FREE(g_allocator, m_runTempValues);
+		}
+
 		void begin(Frame* _frame, uint8_t _idx)
 		{
 			m_frame = _frame;
@@ -2105,17 +2660,55 @@ namespace bgfx
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 			uniformBuffer->reset();
 
-			m_numSubmitted = 0;
-			m_numDropped   = 0;
+			m_numSubmitted    = 0;
+			m_numDropped      = 0;
+			m_numBatches      = 0;
+			m_numBatchedDraws = 0;
+
+			m_itemSlab.clear();
+			m_matrixSlab.clear();
+			m_tvbBlock.clear();
+			m_tibBlock.clear();
+			m_numDeclCache = 0;
+
+			// Invalidates uniform cache, uniform buffer was reset.
+			++m_uniformCacheEpoch;
+			m_uniformBytesSaved = 0;
+
+			m_autoInstancingStride = 0;
+			m_batchNum = 0;
+
+			m_runBegin   = 0;
+			m_runLastKey = 0;
+			m_runSorted  = true;
 		}
 
 		void end(bool _finalize)
 		{
+			flushBatch();
+
 			if (_finalize)
 			{
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 				uniformBuffer->finish();
 
+				finishRun();
+
+				m_frame->m_unusedSlab[m_uniformIdx] = m_itemSlab;
+				m_itemSlab.clear();
+				m_matrixSlab.clear();
+
+				bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_vbwasted, m_tvbBlock.m_end - m_tvbBlock.m_begin);
+				bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_ibwasted, m_tibBlock.m_end - m_tibBlock.m_begin);
+				bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_uniformBytesSaved, m_uniformBytesSaved);
+				m_uniformBytesSaved = 0;
+				bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numBatches, m_numBatches);
+				bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numBatchedDraws, m_numBatchedDraws);
+				m_numBatches      = 0;
+				m_numBatchedDraws = 0;
+				m_tvbBlock.clear();
+				m_tibBlock.clear();
+
 				m_cpuTimeEnd = bx::getHPCounter();
 			}
 
@@ -2149,10 +2742,11 @@ namespace bgfx
 			}
 
 			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
-			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
+			writeUniform(_type, _handle, _value, _num);
 		}
 
+		void writeUniform(UniformType::Enum _type, UniformHandle _handle, const void* _value, uint16_t _num);
+
 		void setState(uint64_t _state, uint32_t _rgba)
 		{
 			uint8_t blend = ( (_state&BGFX_STATE_BLEND_MASK)>>BGFX_STATE_BLEND_SHIFT)&0xff;
@@ -2163,32 +2757,159 @@ namespace bgfx
 			m_draw.m_rgba = _rgba;
 		}
 
-		void setCondition(OcclusionQueryHandle _handle, bool _visible)
-		{
-			m_draw.m_occlusionQuery = _handle;
-			m_draw.m_submitFlags   |= _visible ? BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE : 0;
+		void setCondition(OcclusionQueryHandle _handle, bool _visible)
+		{
+			m_draw.m_occlusionQuery = _handle;
+			m_draw.m_submitFlags   |= _visible ? BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE : 0;
+		}
+
+		void setStencil(uint32_t _fstencil, uint32_t _bstencil)
+		{
+			m_draw.m_stencil = packStencil(_fstencil, _bstencil);
+		}
+
+		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+		{
+			uint16_t scissor = (uint16_t)m_frame->m_frameCache.m_rectCache.add(_x, _y, _width, _height);
+			m_draw.m_scissor = scissor;
+			return scissor;
+		}
+
+		void setScissor(uint16_t _cache)
+		{
+			m_draw.m_scissor = _cache;
+		}
+
+		uint32_t allocRenderItem()
+		{
+			if (m_itemSlab.m_begin == m_itemSlab.m_end)
+			{
+				const uint32_t max   = g_caps.limits.maxDrawCalls-1;
+				const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, BGFX_CONFIG_ENCODER_SLAB_SIZE, max);
+
+				// Encoder's run continues into the new slab when no other encoder took slab in
+				// between. Run is split only when it would cross render item chunk, since sort
+				// keys of a run must be contiguous in memory.
+				if (first != m_itemSlab.m_end
+				||  0 == first%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+				{
+					finishRun();
+					m_runBegin = first;
+				}
+
+				m_itemSlab.m_begin = first;
+				m_itemSlab.m_end   = bx::min<uint32_t>(first+BGFX_CONFIG_ENCODER_SLAB_SIZE, max);
+
+				if (m_itemSlab.m_begin == m_itemSlab.m_end)
+				{
+					return UINT32_MAX;
+				}
+
+				m_frame->allocRenderItemChunk(first);
+			}
+
+			return m_itemSlab.m_begin++;
 		}
 
-		void setStencil(uint32_t _fstencil, uint32_t _bstencil)
+		void setSortKey(uint32_t _renderItemIdx, uint64_t _key)
 		{
-			m_draw.m_stencil = packStencil(_fstencil, _bstencil);
+			m_frame->getSortKey(_renderItemIdx)   = _key;
+			m_frame->getSortValue(_renderItemIdx) = RenderItemCount(_renderItemIdx);
+
+			if (BX_ENABLED(BGFX_CONFIG_SORT_ENCODER_RUNS) )
+			{
+				m_runSorted &= m_runLastKey <= _key;
+				m_runLastKey = _key;
+			}
 		}
 
-		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
+		void finishRun()
 		{
-			uint16_t scissor = (uint16_t)m_frame->m_frameCache.m_rectCache.add(_x, _y, _width, _height);
-			m_draw.m_scissor = scissor;
-			return scissor;
+			if (BX_ENABLED(BGFX_CONFIG_SORT_ENCODER_RUNS)
+			&&  m_runBegin != m_itemSlab.m_begin)
+			{
+				if (!m_runSorted)
+				{
+					const uint32_t num = m_itemSlab.m_begin - m_runBegin;
+					if (m_runTempCapacity < num)
+					{
+						m_runTempCapacity = bx::max<uint32_t>(num, m_runTempCapacity*2);
+						m_runTempKeys     = (uint64_t*)BX_REALLOC(g_allocator, m_runTempKeys, m_runTempCapacity*sizeof(uint64_t) );
+						m_runTempValues   = (RenderItemCount*)BX_REALLOC(g_allocator, m_runTempValues, m_runTempCapacity*sizeof(RenderItemCount) );
+					}
+
+					bx::radixSort(
+						  &m_frame->getSortKey(m_runBegin)
+						, m_runTempKeys
+						, &m_frame->getSortValue(m_runBegin)
+						, m_runTempValues
+						, num
+						);
+				}
+
+				m_frame->addRun(m_runBegin, m_itemSlab.m_begin);
+				m_runBegin = m_itemSlab.m_begin;
+			}
+
+			m_runLastKey = 0;
+			m_runSorted  = true;
 		}
 
-		void setScissor(uint16_t _cache)
+		uint32_t allocMatrix(uint16_t* _num)
 		{
-			m_draw.m_scissor = _cache;
+			MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+
+			const uint32_t num = *_num;
+			if (m_matrixSlab.m_end - m_matrixSlab.m_begin < num)
+			{
+				// Matrices must be contiguous, when request doesn't fit, remaining tail of the
+				// slab is abandoned. Each refill can waste up to `num-1` matrix cache entries.
+				if (BGFX_CONFIG_ENCODER_SLAB_SIZE < num)
+				{
+					return matrixCache.reserve(_num);
+				}
+
+				uint16_t slab = BGFX_CONFIG_ENCODER_SLAB_SIZE;
+				const uint32_t begin = matrixCache.reserve(&slab);
+				if (UINT32_MAX == begin)
+				{
+					// Not enough space left for whole slab, reserve only what is needed.
+					return matrixCache.reserve(_num);
+				}
+
+				m_matrixSlab.m_begin = begin;
+				m_matrixSlab.m_end   = begin + slab;
+			}
+
+			const uint32_t first = m_matrixSlab.m_begin;
+			m_matrixSlab.m_begin += *_num;
+
+			return first;
 		}
 
 		uint32_t setTransform(const void* _mtx, uint16_t _num)
 		{
-			m_draw.m_startMatrix = m_frame->m_frameCache.m_matrixCache.add(_mtx, _num);
+			if (NULL != _mtx)
+			{
+				MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+				const uint32_t first = allocMatrix(&_num);
+				if (UINT32_MAX == first)
+				{
+					BX_WARN(false, "Matrix cache overflow, draw is dropped. (max: %d)", matrixCache.m_max);
+					m_discard = true;
+					m_draw.m_startMatrix = 0;
+					m_draw.m_numMatrices = 0;
+					return UINT32_MAX;
+				}
+
+				bx::memCopy(matrixCache.toPtr(first), _mtx, sizeof(Matrix4)*_num);
+				m_draw.m_startMatrix = first;
+			}
+			else
+			{
+				m_draw.m_startMatrix = 0;
+			}
+
 			m_draw.m_numMatrices = _num;
 
 			return m_draw.m_startMatrix;
@@ -2196,7 +2917,17 @@ namespace bgfx
 
 		uint32_t allocTransform(Transform* _transform, uint16_t _num)
 		{
-			uint32_t first   = m_frame->m_frameCache.m_matrixCache.reserve(&_num);
+			uint32_t first = allocMatrix(&_num);
+			if (UINT32_MAX == first)
+			{
+				BX_WARN(false, "Matrix cache overflow, transform is not allocated. (max: %d)"
+					, m_frame->m_frameCache.m_matrixCache.m_max
+					);
+				_transform->data = NULL;
+				_transform->num  = 0;
+				return UINT32_MAX;
+			}
+
 			_transform->data = m_frame->m_frameCache.m_matrixCache.toPtr(first);
 			_transform->num  = _num;
 
@@ -2205,12 +2936,22 @@ namespace bgfx
 
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
-			BX_CHECK(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			if (UINT32_MAX == _cache)
+			{
+				// Transform allocation failed, draw using it is dropped.
+				m_discard = true;
+				m_draw.m_startMatrix = 0;
+				m_draw.m_numMatrices = 0;
+				return;
+			}
+
+			const uint32_t max = m_frame->m_frameCache.m_matrixCache.m_max;
+			BX_CHECK(_cache < max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
-				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				, max
 				);
 			m_draw.m_startMatrix = _cache;
-			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
+			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, max) - _cache);
 		}
 
 		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2297,6 +3038,31 @@ namespace bgfx
 			m_numVertices[0]     = _numVertices;
 		}
 
+		uint32_t allocTransient(RenderItemSlab& _block, uint32_t* _offset, uint32_t _max, uint32_t* _wasted, uint32_t& _size, uint32_t _align)
+		{
+			uint32_t offset = bx::strideAlign(_block.m_begin, _align);
+			if (offset + _size > _block.m_end)
+			{
+				// Tail of the current block is wasted, reserve new block from frame.
+				bx::atomicFetchAndAdd<uint32_t>(_wasted, _block.m_end - _block.m_begin);
+
+				uint32_t size = bx::max<uint32_t>(_size, BGFX_CONFIG_TRANSIENT_BUFFER_BLOCK_SIZE);
+				offset = Frame::allocTransient(_offset, _max, size, _align);
+				_block.m_begin = offset;
+				_block.m_end   = offset + size;
+			}
+
+			_size = bx::min(_size, _block.m_end - offset);
+			_block.m_begin = offset + _size;
+
+			return offset;
+		}
+
+		VertexDeclHandle findVertexDecl(const VertexDecl& _decl);
+		void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num);
+		void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl);
+		void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride);
+
 		void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _start, uint32_t _num)
 		{
 			const uint32_t start = bx::min(_start, _idb->num);
@@ -2315,6 +3081,12 @@ namespace bgfx
 			m_draw.m_instanceDataBuffer = _handle;
 		}
 
+		void setAutoInstancing(bool _enabled, uint16_t _stride)
+		{
+			flushBatch();
+			m_autoInstancingStride = _enabled ? _stride : 0;
+		}
+
 		void setInstanceCount(uint32_t _numInstances)
 		{
 			BX_CHECK(!isValid(m_draw.m_instanceDataBuffer), "Instance buffer already set.");
@@ -2381,6 +3153,10 @@ namespace bgfx
 			m_bind.clear();
 		}
 
+		uint32_t getNumVertices() const;
+		uint64_t encodeDrawKey(ViewId _id, ProgramHandle _program, uint32_t _depth);
+		bool batch(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState);
+		void flushBatch();
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState);
 
 		void submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState)
@@ -2414,6 +3190,47 @@ namespace bgfx
 
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
+		uint32_t m_numBatches;
+		uint32_t m_numBatchedDraws;
+
+		RenderItemSlab m_itemSlab;
+		RenderItemSlab m_matrixSlab;
+		RenderItemSlab m_tvbBlock;
+		RenderItemSlab m_tibBlock;
+
+		uint32_t         m_declCacheHash[8];
+		VertexDeclHandle m_declCache[8];
+		uint32_t         m_numDeclCache;
+
+		struct UniformCacheEntry
+		{
+			uint32_t m_epoch;
+			uint32_t m_hash;
+			uint32_t m_size;
+			uint32_t m_pos;
+		};
+
+		UniformCacheEntry m_uniformCache[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t          m_uniformCacheEpoch;
+		uint32_t          m_uniformBytesSaved;
+
+		RenderDraw    m_batchDraw;
+		RenderBind    m_batchBind;
+		uint64_t      m_batchKey;
+		ProgramHandle m_batchProgram;
+		ViewId        m_batchView;
+		uint32_t      m_batchDepth;
+		uint32_t      m_batchNum;
+		uint32_t      m_batchMatrix[BGFX_CONFIG_MAX_AUTO_INSTANCING_BATCH];
+		uint16_t      m_autoInstancingStride;
+
+		uint64_t m_runLastKey;
+		uint32_t m_runBegin;
+		bool     m_runSorted;
+
+		uint64_t*        m_runTempKeys;
+		RenderItemCount* m_runTempValues;
+		uint32_t         m_runTempCapacity;
 
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
@@ -2705,6 +3522,138 @@ namespace bgfx
 
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
 
+	/// Number of threads, including render thread, running jobs started with rendererRunJobs.
+	uint32_t rendererGetNumThreads();
+
+	/// Runs `_num` jobs on render thread and sort threads, and waits for them to finish.
+	void rendererRunJobs(bx::JobFn _fn, void* _userData, uint32_t _num);
+
+	struct UploadItem
+	{
+		struct Type
+		{
+			enum Enum
+			{
+				Texture,
+				DynamicIndexBuffer,
+				DynamicVertexBuffer,
+			};
+		};
+
+		const Memory* m_mem;
+		uint32_t m_ticket;
+		uint32_t m_start; //!< Start index or vertex of dynamic buffer update.
+		Rect     m_rect;  //!< Texture update region.
+		uint16_t m_handle;
+		uint16_t m_layer;
+		uint16_t m_pitch;
+		uint8_t  m_type;
+		uint8_t  m_mip;
+		bool     m_cancelled;
+	};
+
+	// FIFO of asynchronous uploads. Items are pushed by API thread. Upload thread stages them in
+	// order, taking data referenced with makeRef into memory owned by bgfx, so that caller's
+	// buffer is released early. API thread pops staged items when building frame.
+	class UploadQueue
+	{
+		BX_CLASS(UploadQueue
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		UploadQueue();
+
+		~UploadQueue();
+
+		void init();
+
+		void shutdown();
+
+		uint32_t push(UploadItem& _item);
+
+		bool isFull() const
+		{
+			return m_write - m_read == BGFX_CONFIG_MAX_UPLOADS;
+		}
+
+		uint32_t getNumPending() const
+		{
+			return m_write - m_read;
+		}
+
+		uint32_t getLastTicket() const
+		{
+			return m_ticket;
+		}
+
+		// Returns oldest queued upload if it's staged. If it's not staged yet and its ticket is
+		// not after _waitTicket, blocks until upload thread stages it.
+		bool peek(UploadItem& _item, uint32_t _waitTicket);
+
+		void pop();
+
+		void cancel(UploadItem::Type::Enum _type, uint16_t _handle);
+
+	private:
+		static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+
+		void stopThread();
+
+		void stage();
+
+		UploadItem m_item[BGFX_CONFIG_MAX_UPLOADS];
+
+#if BGFX_CONFIG_MULTITHREADED
+		bx::Mutex     m_lock;
+		bx::Semaphore m_sem;
+		bx::Semaphore m_stagedSem;
+		bx::Thread    m_thread;
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		uint32_t m_read;
+		uint32_t m_staged;
+		uint32_t m_write;
+		uint32_t m_ticket;
+		bool     m_exit;
+	};
+
+	// Ring of frame stage timestamps. API, render and encoder threads push events and any
+	// thread can read them without locking. Slot sequence number tells reader whether slot
+	// was being written or overwritten while it was copied.
+	class FrameTimeline
+	{
+		BX_CLASS(FrameTimeline
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		FrameTimeline();
+
+		void reset();
+
+		void push(TimelineStage::Enum _stage, uint32_t _frame, uint16_t _encoder, int64_t _begin, int64_t _end);
+
+		uint32_t read(TimelineEvent* _events, uint32_t _max) const;
+
+	private:
+		BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_TIMELINE_EVENTS) );
+
+		struct Slot
+		{
+			volatile uint32_t m_seq;
+			TimelineEvent m_event;
+		};
+
+		Slot m_slot[BGFX_CONFIG_MAX_TIMELINE_EVENTS];
+		volatile uint32_t m_head;
+	};
+
+	class FrameRecorder;
+	class FrameReplay;
+
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
 #else
@@ -2716,6 +3665,12 @@ namespace bgfx
 		Context()
 			: m_render(&m_frame[0])
 			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_tempCapacity(0)
+			, m_uniformUpdatesSkipped(0)
+			, m_uploadTicketCommitted(0)
+			, m_uploadTicketComplete(0)
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
@@ -2731,6 +3686,11 @@ namespace bgfx
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_recorder(NULL)
+			, m_replay(NULL)
+			, m_timelineFrame(0)
+			, m_profilerScopes(NULL)
+			, m_numProfilerScopes(0)
 		{
 		}
 
@@ -2751,6 +3711,11 @@ namespace bgfx
 		bool init(const Init& _init);
 		void shutdown();
 
+		// Replays recorded frames without API thread.
+		bool replayInit(const char* _filePath, const Init& _init);
+		const Stats* replayFrame();
+		void replayShutdown();
+
 		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
 		{
 			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
@@ -2805,6 +3770,13 @@ namespace bgfx
 		BGFX_API_FUNC(void setDebug(uint32_t _debug) )
 		{
 			m_debug = _debug;
+
+			if (0 != (m_debug & BGFX_DEBUG_PROFILER_TEXT) )
+			{
+				m_debug |= BGFX_DEBUG_PROFILER;
+			}
+
+			profilerSetEnabled(BX_ENABLED(BGFX_CONFIG_PROFILER) && 0 != (m_debug & BGFX_DEBUG_PROFILER) );
 		}
 
 		BGFX_API_FUNC(void dbgTextClear(uint8_t _attr, bool _small) )
@@ -2841,6 +3813,8 @@ namespace bgfx
 			stats.textWidth  = tvm->m_width;
 			stats.textHeight = tvm->m_height;
 			stats.encoderStats = m_encoderStats;
+			stats.numProfilerScopes = m_numProfilerScopes;
+			stats.profilerScopes    = m_profilerScopes;
 
 			stats.numDynamicIndexBuffers  = m_dynamicIndexBufferHandle.getNumHandles();
 			stats.numDynamicVertexBuffers = m_dynamicVertexBufferHandle.getNumHandles();
@@ -2854,6 +3828,8 @@ namespace bgfx
 			stats.numVertexBuffers        = m_vertexBufferHandle.getNumHandles();
 			stats.numVertexDecls          = m_vertexDeclHandle.getNumHandles();
 
+			stats.numUploadsPending = m_uploadQueue.getNumPending();
+
 			stats.textureMemoryUsed = m_textureMemoryUsed;
 			stats.rtMemoryUsed      = m_rtMemoryUsed;
 
@@ -3126,6 +4102,7 @@ namespace bgfx
 
 			BGFX_CHECK_HANDLE("destroyDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
+			m_uploadQueue.cancel(UploadItem::Type::DynamicIndexBuffer, _handle.idx);
 			m_freeDynamicIndexBufferHandle[m_numFreeDynamicIndexBufferHandles++] = _handle;
 		}
 
@@ -3313,6 +4290,7 @@ namespace bgfx
 
 			BGFX_CHECK_HANDLE("destroyDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
+			m_uploadQueue.cancel(UploadItem::Type::DynamicVertexBuffer, _handle.idx);
 			m_freeDynamicVertexBufferHandle[m_numFreeDynamicVertexBufferHandles++] = _handle;
 		}
 
@@ -3459,14 +4437,10 @@ namespace bgfx
 			BX_ALIGNED_FREE(g_allocator, _tvb, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl) )
+		VertexDeclHandle findTransientVertexDecl(const VertexDecl& _decl)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
 			VertexDeclHandle declHandle = m_declRef.find(_decl.m_hash);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
-
 			if (!isValid(declHandle) )
 			{
 				VertexDeclHandle temp = { m_vertexDeclHandle.alloc() };
@@ -3477,6 +4451,17 @@ namespace bgfx
 				m_declRef.add(declHandle, _decl.m_hash);
 			}
 
+			return declHandle;
+		}
+
+		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			VertexDeclHandle declHandle = findTransientVertexDecl(_decl);
+
+			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+
 			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _decl.m_stride);
 
 			_tvb->data = &dvb.data[offset];
@@ -4092,6 +5077,7 @@ namespace bgfx
 			if (0 == refs)
 			{
 				ref.m_name.clear();
+				m_uploadQueue.cancel(UploadItem::Type::Texture, _handle.idx);
 
 				if (ref.m_rt)
 				{
@@ -4134,20 +5120,185 @@ namespace bgfx
 				return;
 			}
 
+			TextureUpdate update;
+			update.handle        = _handle;
+			update.side          = _side;
+			update.mip           = _mip;
+			update.rect.m_x      = _x;
+			update.rect.m_y      = _y;
+			update.rect.m_width  = _width;
+			update.rect.m_height = _height;
+			update.zz            = _z;
+			update.depth         = _depth;
+			update.pitch         = _pitch;
+			update.format        = textureRef.m_format;
+			update.mem           = _mem;
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
-			cmdbuf.write(_handle);
-			cmdbuf.write(_side);
-			cmdbuf.write(_mip);
-			Rect rect;
-			rect.m_x = _x;
-			rect.m_y = _y;
-			rect.m_width  = _width;
-			rect.m_height = _height;
-			cmdbuf.write(rect);
-			cmdbuf.write(_z);
-			cmdbuf.write(_depth);
-			cmdbuf.write(_pitch);
-			cmdbuf.write(_mem);
+			writeTextureUpdate(cmdbuf, update);
+		}
+
+		BGFX_API_FUNC(uint32_t updateTextureAsync(
+			  TextureHandle _handle
+			, uint8_t _mip
+			, uint16_t _x
+			, uint16_t _y
+			, uint16_t _layer
+			, uint16_t _width
+			, uint16_t _height
+			, uint16_t _pitch
+			, const Memory* _mem
+			) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("updateTextureAsync", m_textureHandle, _handle);
+
+			if (m_textureRef[_handle.idx].m_immutable)
+			{
+				BX_WARN(false, "Can't update immutable texture.");
+				release(_mem);
+				return 0;
+			}
+
+			UploadItem item;
+			item.m_type          = UploadItem::Type::Texture;
+			item.m_handle        = _handle.idx;
+			item.m_mem           = _mem;
+			item.m_mip           = _mip;
+			item.m_layer         = _layer;
+			item.m_pitch         = _pitch;
+			item.m_rect.m_x      = _x;
+			item.m_rect.m_y      = _y;
+			item.m_rect.m_width  = _width;
+			item.m_rect.m_height = _height;
+			return pushUpload(item);
+		}
+
+		BGFX_API_FUNC(uint32_t updateAsync(DynamicIndexBufferHandle _handle, uint32_t _startIndex, const Memory* _mem) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("updateDynamicIndexBufferAsync", m_dynamicIndexBufferHandle, _handle);
+
+			UploadItem item;
+			item.m_type   = UploadItem::Type::DynamicIndexBuffer;
+			item.m_handle = _handle.idx;
+			item.m_mem    = _mem;
+			item.m_start  = _startIndex;
+			return pushUpload(item);
+		}
+
+		BGFX_API_FUNC(uint32_t updateAsync(DynamicVertexBufferHandle _handle, uint32_t _startVertex, const Memory* _mem) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("updateDynamicVertexBufferAsync", m_dynamicVertexBufferHandle, _handle);
+
+			UploadItem item;
+			item.m_type   = UploadItem::Type::DynamicVertexBuffer;
+			item.m_handle = _handle.idx;
+			item.m_mem    = _mem;
+			item.m_start  = _startVertex;
+			return pushUpload(item);
+		}
+
+		BGFX_API_FUNC(bool isUploadComplete(uint32_t _ticket) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			return int32_t(_ticket - m_uploadTicketComplete) <= 0;
+		}
+
+		BGFX_API_FUNC(uint32_t flushUpload(uint32_t _ticket) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (int32_t(_ticket - m_uploadTicketComplete) <= 0)
+			{
+				return m_frames;
+			}
+
+			commitUploads(_ticket);
+			return m_frames + 2;
+		}
+
+		uint32_t pushUpload(UploadItem& _item)
+		{
+			if (m_uploadQueue.isFull() )
+			{
+				BX_TRACE("Upload queue is full, passing all queued uploads to renderer.");
+				commitUploads(m_uploadQueue.getLastTicket() );
+			}
+
+			return m_uploadQueue.push(_item);
+		}
+
+		// Passes staged uploads to renderer until frame's upload budget is used. Uploads up to
+		// _flushTicket are passed regardless of budget, waiting for upload thread if needed.
+		void commitUploads(uint32_t _flushTicket)
+		{
+			UploadItem item;
+			while (m_uploadQueue.peek(item, _flushTicket) )
+			{
+				const bool flush = int32_t(item.m_ticket - _flushTicket) <= 0;
+				if (!flush
+				&&  0 != m_submit->m_uploadSize
+				&&  m_submit->m_uploadSize + item.m_mem->size > m_init.limits.maxUploadSize)
+				{
+					break;
+				}
+
+				m_uploadQueue.pop();
+				m_uploadTicketCommitted = item.m_ticket;
+
+				if (item.m_cancelled)
+				{
+					release(item.m_mem);
+					continue;
+				}
+
+				m_submit->m_uploadSize += item.m_mem->size;
+
+				switch (item.m_type)
+				{
+				case UploadItem::Type::Texture:
+					{
+						const TextureHandle handle = { item.m_handle };
+						updateTexture(handle
+							, 0
+							, item.m_mip
+							, item.m_rect.m_x
+							, item.m_rect.m_y
+							, item.m_layer
+							, item.m_rect.m_width
+							, item.m_rect.m_height
+							, 1
+							, item.m_pitch
+							, item.m_mem
+							);
+					}
+					break;
+
+				case UploadItem::Type::DynamicIndexBuffer:
+					{
+						const DynamicIndexBufferHandle handle = { item.m_handle };
+						update(handle, item.m_start, item.m_mem);
+					}
+					break;
+
+				case UploadItem::Type::DynamicVertexBuffer:
+					{
+						const DynamicVertexBufferHandle handle = { item.m_handle };
+						update(handle, item.m_start, item.m_mem);
+					}
+					break;
+
+				default:
+					BX_CHECK(false, "Invalid upload type %d.", item.m_type);
+					break;
+				}
+			}
 		}
 
 		bool checkFrameBuffer(uint8_t _num, const Attachment* _attachment) const
@@ -4579,8 +5730,10 @@ namespace bgfx
 		// render thread
 		void flip();
 		RenderFrame::Enum renderFrame(int32_t _msecs = -1);
+		void rendererExecFrame();
 		void flushTextureUpdateBatch(CommandBuffer& _cmdbuf);
 		void rendererExecCommands(CommandBuffer& _cmdbuf);
+		void recordPatch(const CommandBuffer& _cmdbuf, RecordPatch::Enum _type, const void* _ptr);
 
 #if BGFX_CONFIG_MULTITHREADED
 		void apiSemPost()
@@ -4603,8 +5756,10 @@ namespace bgfx
 			bool ok = m_apiSem.wait(_msecs);
 			if (ok)
 			{
-				m_render->m_waitSubmit = bx::getHPCounter()-start;
+				const int64_t now = bx::getHPCounter();
+				m_render->m_waitSubmit = now-start;
 				m_submit->m_perfStats.waitSubmit = m_submit->m_waitSubmit;
+				m_timeline.push(TimelineStage::WaitSubmit, m_render->m_frameNum, 0, start, now);
 				return true;
 			}
 
@@ -4627,8 +5782,10 @@ namespace bgfx
 				int64_t start = bx::getHPCounter();
 				bool ok = m_renderSem.wait();
 				BX_CHECK(ok, "Semaphore wait failed."); BX_UNUSED(ok);
-				m_submit->m_waitRender = bx::getHPCounter() - start;
+				const int64_t now = bx::getHPCounter();
+				m_submit->m_waitRender = now - start;
 				m_submit->m_perfStats.waitRender = m_submit->m_waitRender;
+				m_timeline.push(TimelineStage::WaitRender, m_frames+1, 0, start, now);
 			}
 		}
 
@@ -4646,6 +5803,7 @@ namespace bgfx
 				uint16_t idx = m_encoderHandle->getHandleAt(ii);
 				m_encoderStats[ii].cpuTimeBegin = m_encoder[idx].m_cpuTimeBegin;
 				m_encoderStats[ii].cpuTimeEnd   = m_encoder[idx].m_cpuTimeEnd;
+				m_timeline.push(TimelineStage::Encoder, m_frames+1, idx, m_encoder[idx].m_cpuTimeBegin, m_encoder[idx].m_cpuTimeEnd);
 			}
 
 			m_submit->m_perfStats.numEncoders = uint8_t(numEncoders);
@@ -4661,6 +5819,7 @@ namespace bgfx
 		bx::Mutex     m_encoderApiLock;
 		bx::Mutex     m_resourceApiLock;
 		bx::Thread    m_thread;
+		bx::JobScheduler m_jobScheduler;
 #else
 		void apiSemPost()
 		{
@@ -4685,6 +5844,7 @@ namespace bgfx
 			m_encoderStats[0].cpuTimeBegin = m_encoder[0].m_cpuTimeBegin;
 			m_encoderStats[0].cpuTimeEnd   = m_encoder[0].m_cpuTimeEnd;
 			m_submit->m_perfStats.numEncoders = 1;
+			m_timeline.push(TimelineStage::Encoder, m_frames+1, 0, m_encoder[0].m_cpuTimeBegin, m_encoder[0].m_cpuTimeEnd);
 		}
 #endif // BGFX_CONFIG_MULTITHREADED
 
@@ -4698,8 +5858,23 @@ namespace bgfx
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		uint64_t* m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t m_tempCapacity;
+
+		// Render thread, last data written to uniform by rendererUpdateUniforms.
+		struct UniformWrite
+		{
+			const UniformBuffer* m_buffer;
+			uint32_t m_pos;
+		};
+
+		UniformWrite m_uniformWrite[BGFX_CONFIG_MAX_UNIFORMS];
+		uint32_t m_uniformUpdatesSkipped;
+
+		UploadQueue m_uploadQueue;
+		uint32_t m_uploadTicketCommitted;
+		uint32_t m_uploadTicketComplete;
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
@@ -4848,8 +6023,17 @@ namespace bgfx
 		bool m_singleThreaded;
 		bool m_flipped;
 
-		typedef UpdateBatchT<256> TextureUpdateBatch;
-		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
+		BX_ALIGN_DECL_CACHE_LINE(UpdateBatch m_textureUpdateBatch);
+		TextureUpdateStaging m_textureUpdateStaging;
+
+		FrameRecorder* m_recorder;
+		FrameReplay*   m_replay;
+
+		FrameTimeline m_timeline;
+		uint32_t      m_timelineFrame; //!< Last frame executed by renderer.
+
+		ProfilerScopeStats* m_profilerScopes;
+		uint16_t            m_numProfilerScopes;
 	};
 
 #undef BGFX_API_FUNC
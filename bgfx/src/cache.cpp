@@ -0,0 +1,587 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "cache.h"
+
+#include <bx/file.h>
+
+#if BX_PLATFORM_WINDOWS
+#	include <windows.h>
+#	include <dirent.h>
+#	include <stdio.h>    // rename
+#	include <sys/stat.h> // stat
+#	include <sys/utime.h>
+#	define BGFX_DISK_CACHE 1
+#elif BX_PLATFORM_LINUX   \
+	|| BX_PLATFORM_ANDROID \
+	|| BX_PLATFORM_BSD     \
+	|| BX_PLATFORM_OSX     \
+	|| BX_PLATFORM_IOS
+#	include <dirent.h>
+#	include <fcntl.h>
+#	include <stdio.h>    // rename
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	include <utime.h>
+#	define BGFX_DISK_CACHE 1
+#else
+#	define BGFX_DISK_CACHE 0
+#endif // BX_PLATFORM_*
+
+#define BGFX_CHUNK_MAGIC_CSH BX_MAKEFOURCC('C', 'S', 'H', 0x0)
+
+namespace bgfx
+{
+	struct DiskCacheHeader
+	{
+		uint32_t m_magic;
+		uint32_t m_version;
+		uint64_t m_id;
+		uint32_t m_size;
+		uint32_t m_hash;
+	};
+
+#if BGFX_DISK_CACHE
+	class MappedFile
+	{
+	public:
+		MappedFile()
+			: m_data(NULL)
+			, m_size(0)
+#if BX_PLATFORM_WINDOWS
+			, m_file(INVALID_HANDLE_VALUE)
+			, m_mapping(NULL)
+#endif // BX_PLATFORM_WINDOWS
+		{
+		}
+
+		~MappedFile()
+		{
+			close();
+		}
+
+		bool open(const char* _filePath)
+		{
+#if BX_PLATFORM_WINDOWS
+			m_file = CreateFileA(_filePath, GENERIC_READ, FILE_SHARE_READ|FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (INVALID_HANDLE_VALUE == m_file)
+			{
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_file, &size)
+			||  0 == size.QuadPart
+			||  UINT32_MAX < size.QuadPart)
+			{
+				return false;
+			}
+
+			m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (NULL == m_mapping)
+			{
+				return false;
+			}
+
+			m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+			m_size = uint32_t(size.QuadPart);
+#else
+			const int fd = ::open(_filePath, O_RDONLY);
+			if (-1 == fd)
+			{
+				return false;
+			}
+
+			struct stat st;
+			if (0 == fstat(fd, &st)
+			&&  0 < st.st_size
+			&&  UINT32_MAX >= uint64_t(st.st_size) )
+			{
+				void* data = mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+				if (MAP_FAILED != data)
+				{
+					m_data = data;
+					m_size = uint32_t(st.st_size);
+				}
+			}
+
+			// Mapping stays valid after file descriptor is closed.
+			::close(fd);
+#endif // BX_PLATFORM_WINDOWS
+
+			return NULL != m_data;
+		}
+
+		void close()
+		{
+#if BX_PLATFORM_WINDOWS
+			if (NULL != m_data)
+			{
+				UnmapViewOfFile(m_data);
+			}
+
+			if (NULL != m_mapping)
+			{
+				CloseHandle(m_mapping);
+				m_mapping = NULL;
+			}
+
+			if (INVALID_HANDLE_VALUE != m_file)
+			{
+				CloseHandle(m_file);
+				m_file = INVALID_HANDLE_VALUE;
+			}
+#else
+			if (NULL != m_data)
+			{
+				munmap(m_data, m_size);
+			}
+#endif // BX_PLATFORM_WINDOWS
+
+			m_data = NULL;
+			m_size = 0;
+		}
+
+		const void* getData() const
+		{
+			return m_data;
+		}
+
+		uint32_t getSize() const
+		{
+			return m_size;
+		}
+
+	private:
+		void*    m_data;
+		uint32_t m_size;
+#if BX_PLATFORM_WINDOWS
+		HANDLE m_file;
+		HANDLE m_mapping;
+#endif // BX_PLATFORM_WINDOWS
+	};
+
+	static bool renameFile(const bx::FilePath& _from, const bx::FilePath& _to)
+	{
+#if BX_PLATFORM_WINDOWS
+		return 0 != MoveFileExA(_from.get(), _to.get(), MOVEFILE_REPLACE_EXISTING);
+#else
+		return 0 == ::rename(_from.get(), _to.get() );
+#endif // BX_PLATFORM_WINDOWS
+	}
+
+	static void touchFile(const bx::FilePath& _filePath)
+	{
+#if BX_PLATFORM_WINDOWS
+		_utime(_filePath.get(), NULL);
+#else
+		utime(_filePath.get(), NULL);
+#endif // BX_PLATFORM_WINDOWS
+	}
+
+	// Modification time in nanoseconds, where available, files touched within the same second
+	// keep their order.
+	static int64_t getModifiedTime(const struct stat& _st)
+	{
+#if BX_PLATFORM_LINUX || BX_PLATFORM_ANDROID
+		return int64_t(_st.st_mtim.tv_sec)*INT64_C(1000000000) + int64_t(_st.st_mtim.tv_nsec);
+#elif BX_PLATFORM_OSX || BX_PLATFORM_IOS
+		return int64_t(_st.st_mtimespec.tv_sec)*INT64_C(1000000000) + int64_t(_st.st_mtimespec.tv_nsec);
+#else
+		return int64_t(_st.st_mtime)*INT64_C(1000000000);
+#endif // BX_PLATFORM_*
+	}
+
+	static bool parseHex(const char* _str, uint32_t _len, uint64_t& _outValue)
+	{
+		uint64_t value = 0;
+
+		for (uint32_t ii = 0; ii < _len; ++ii)
+		{
+			const char ch = _str[ii];
+			if (!bx::isHexNum(ch) )
+			{
+				return false;
+			}
+
+			value = value << 4 | uint64_t(bx::isNumeric(ch) ? ch - '0' : bx::toLower(ch) - 'a' + 10);
+		}
+
+		_outValue = value;
+		return true;
+	}
+#endif // BGFX_DISK_CACHE
+
+	// Entries are looked up by id mixed with version key, id and version stored in entry are
+	// compared to resolve collisions.
+	static uint64_t entryKey(uint64_t _id, uint32_t _version)
+	{
+		return _id ^ (uint64_t(_version)<<32 | _version);
+	}
+
+	DiskCache::DiskCache()
+		: m_totalSize(0)
+		, m_maxSize(0)
+		, m_clock(0)
+		, m_version(0)
+		, m_open(false)
+		, m_scanned(false)
+		, m_numHits(0)
+		, m_numMisses(0)
+		, m_numWrites(0)
+		, m_numEvicted(0)
+	{
+	}
+
+	DiskCache::~DiskCache()
+	{
+		close();
+	}
+
+	bool DiskCache::open(const char* _dirPath, uint32_t _maxSize)
+	{
+		close();
+
+#if BGFX_DISK_CACHE
+		m_dirPath.set(_dirPath);
+
+		bx::Error err;
+		bx::makeAll(m_dirPath, &err);
+
+		bx::FileInfo fi;
+		if (!bx::stat(m_dirPath, fi)
+		||  bx::FileInfo::Directory != fi.m_type)
+		{
+			BX_TRACE("Disk cache: Unable to create cache directory '%s'.", _dirPath);
+			return false;
+		}
+
+		m_maxSize = _maxSize;
+		m_open    = true;
+
+		return true;
+#else
+		BX_UNUSED(_dirPath, _maxSize);
+		BX_TRACE("Disk cache: Not supported on this platform.");
+		return false;
+#endif // BGFX_DISK_CACHE
+	}
+
+	void DiskCache::close()
+	{
+		if (m_open)
+		{
+			BX_TRACE("Disk cache: %d hits, %d misses, %d writes, %d evicted, %" PRIu64 " bytes."
+				, m_numHits
+				, m_numMisses
+				, m_numWrites
+				, m_numEvicted
+				, m_totalSize
+				);
+		}
+
+		m_entries.clear();
+		m_totalSize = 0;
+		m_clock     = 0;
+		m_version   = 0;
+		m_open      = false;
+		m_scanned   = false;
+
+		m_numHits    = 0;
+		m_numMisses  = 0;
+		m_numWrites  = 0;
+		m_numEvicted = 0;
+	}
+
+	void DiskCache::scan()
+	{
+		m_scanned = true;
+
+		// Renderer and GPU are known only once renderer is initialized, cache is scanned on first
+		// access from renderer.
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(BGFX_API_VERSION);
+		murmur.add(g_caps.rendererType);
+		murmur.add(g_caps.vendorId);
+		murmur.add(g_caps.deviceId);
+		m_version = murmur.end();
+
+#if BGFX_DISK_CACHE
+		DIR* dir = opendir(m_dirPath.get() );
+		if (NULL == dir)
+		{
+			return;
+		}
+
+		for (dirent* item = readdir(dir); NULL != item; item = readdir(dir) )
+		{
+			// <id:16 hex>-<version:8 hex>.bin
+			const char* name = item->d_name;
+			if (29 != bx::strLen(name)
+			||  '-' != name[16]
+			||  0 != bx::strCmp(&name[25], ".bin") )
+			{
+				continue;
+			}
+
+			uint64_t id;
+			uint64_t version;
+			if (!parseHex(name, 16, id)
+			||  !parseHex(&name[17], 8, version) )
+			{
+				continue;
+			}
+
+			bx::FilePath filePath(m_dirPath);
+			filePath.join(name);
+
+			struct stat st;
+			if (0 != ::stat(filePath.get(), &st)
+			||  sizeof(DiskCacheHeader) > uint64_t(st.st_size) )
+			{
+				continue;
+			}
+
+			Entry entry;
+			entry.m_lastUse = getModifiedTime(st);
+			entry.m_id      = id;
+			entry.m_version = uint32_t(version);
+			entry.m_size    = uint32_t(st.st_size);
+			if (m_entries.insert(stl::make_pair(entryKey(id, entry.m_version), entry) ).second)
+			{
+				m_totalSize += entry.m_size;
+				m_clock = bx::max(m_clock, entry.m_lastUse);
+			}
+		}
+
+		closedir(dir);
+
+		BX_TRACE("Disk cache: '%s', %d entries, %" PRIu64 " bytes."
+			, m_dirPath.get()
+			, m_entries.size()
+			, m_totalSize
+			);
+
+		evict();
+#endif // BGFX_DISK_CACHE
+	}
+
+	void DiskCache::getFilePath(bx::FilePath& _outFilePath, uint64_t _id, uint32_t _version) const
+	{
+		char name[32];
+		bx::snprintf(name, BX_COUNTOF(name), "%016" PRIx64 "-%08x.bin", _id, _version);
+
+		_outFilePath = m_dirPath;
+		_outFilePath.join(name);
+	}
+
+	DiskCache::EntryMap::iterator DiskCache::find(uint64_t _id)
+	{
+		if (!m_scanned)
+		{
+			scan();
+		}
+
+		EntryMap::iterator it = m_entries.find(entryKey(_id, m_version) );
+		if (it != m_entries.end()
+		&&  it->second.m_id      == _id
+		&&  it->second.m_version == m_version)
+		{
+			return it;
+		}
+
+		return m_entries.end();
+	}
+
+	void DiskCache::remove(EntryMap::iterator _it)
+	{
+		bx::FilePath filePath;
+		getFilePath(filePath, _it->second.m_id, _it->second.m_version);
+
+		bx::Error err;
+		bx::remove(filePath, &err);
+
+		m_totalSize -= _it->second.m_size;
+		m_entries.erase(_it);
+	}
+
+	void DiskCache::evict()
+	{
+		while (m_totalSize > m_maxSize
+		&&     !m_entries.empty() )
+		{
+			EntryMap::iterator lru = m_entries.begin();
+			for (EntryMap::iterator it = m_entries.begin(), itEnd = m_entries.end(); it != itEnd; ++it)
+			{
+				if (it->second.m_lastUse < lru->second.m_lastUse)
+				{
+					lru = it;
+				}
+			}
+
+			remove(lru);
+			++m_numEvicted;
+		}
+	}
+
+	uint32_t DiskCache::readSize(uint64_t _id)
+	{
+		if (!m_open)
+		{
+			return 0;
+		}
+
+		EntryMap::iterator it = find(_id);
+		if (it == m_entries.end() )
+		{
+			++m_numMisses;
+			return 0;
+		}
+
+		return it->second.m_size - uint32_t(sizeof(DiskCacheHeader) );
+	}
+
+	bool DiskCache::read(uint64_t _id, void* _data, uint32_t _size)
+	{
+#if BGFX_DISK_CACHE
+		if (!m_open)
+		{
+			return false;
+		}
+
+		EntryMap::iterator it = find(_id);
+		if (it == m_entries.end() )
+		{
+			return false;
+		}
+
+		bx::FilePath filePath;
+		getFilePath(filePath, _id, m_version);
+
+		bool result = false;
+
+		MappedFile file;
+		if (file.open(filePath.get() )
+		&&  sizeof(DiskCacheHeader) + _size == file.getSize() )
+		{
+			const DiskCacheHeader* header = (const DiskCacheHeader*)file.getData();
+			const void* data = &header[1];
+
+			result = true
+				&& BGFX_CHUNK_MAGIC_CSH == header->m_magic
+				&& m_version == header->m_version
+				&& _id       == header->m_id
+				&& _size     == header->m_size
+				&& header->m_hash == bx::hash<bx::HashMurmur2A>(data, _size)
+				;
+
+			if (result)
+			{
+				bx::memCopy(_data, data, _size);
+			}
+		}
+
+		file.close();
+
+		if (!result)
+		{
+			BX_TRACE("Disk cache: Entry '%s' is invalid.", filePath.get() );
+			remove(it);
+			++m_numMisses;
+			return false;
+		}
+
+		it->second.m_lastUse = ++m_clock;
+		touchFile(filePath);
+		++m_numHits;
+
+		return true;
+#else
+		BX_UNUSED(_id, _data, _size);
+		return false;
+#endif // BGFX_DISK_CACHE
+	}
+
+	void DiskCache::write(uint64_t _id, const void* _data, uint32_t _size)
+	{
+		if (!m_open)
+		{
+			return;
+		}
+
+		if (!m_scanned)
+		{
+			scan();
+		}
+
+		// Replaces previous version of entry, or entry with colliding key.
+		EntryMap::iterator it = m_entries.find(entryKey(_id, m_version) );
+		if (it != m_entries.end() )
+		{
+			m_totalSize -= it->second.m_size;
+			m_entries.erase(it);
+		}
+
+#if BGFX_DISK_CACHE
+		DiskCacheHeader header;
+		header.m_magic   = BGFX_CHUNK_MAGIC_CSH;
+		header.m_version = m_version;
+		header.m_id      = _id;
+		header.m_size    = _size;
+		header.m_hash    = bx::hash<bx::HashMurmur2A>(_data, _size);
+
+		bx::FilePath filePath;
+		getFilePath(filePath, _id, m_version);
+
+		// Entry is written into uniquely named temporary file, and renamed when complete, so that
+		// other processes using the same cache directory never see partially written entry.
+		char tempName[64];
+		bx::snprintf(tempName, BX_COUNTOF(tempName), "%016" PRIx64 "-%08x.%" PRIx64 ".tmp"
+			, _id
+			, m_version
+			, bx::getHPCounter()
+			);
+
+		bx::FilePath tempFilePath(m_dirPath);
+		tempFilePath.join(tempName);
+
+		bx::Error err;
+		bx::FileWriter writer;
+		if (bx::open(&writer, tempFilePath, false, &err) )
+		{
+			bx::write(&writer, header, &err);
+			bx::write(&writer, _data, int32_t(_size), &err);
+			bx::close(&writer);
+
+			if (err.isOk()
+			&&  renameFile(tempFilePath, filePath) )
+			{
+				Entry entry;
+				entry.m_lastUse = ++m_clock;
+				entry.m_id      = _id;
+				entry.m_version = m_version;
+				entry.m_size    = uint32_t(sizeof(DiskCacheHeader) ) + _size;
+				m_entries.insert(stl::make_pair(entryKey(_id, m_version), entry) );
+
+				m_totalSize += entry.m_size;
+				++m_numWrites;
+
+				evict();
+				return;
+			}
+
+			err.reset();
+			bx::remove(tempFilePath, &err);
+		}
+
+		BX_TRACE("Disk cache: Failed to write '%s'.", filePath.get() );
+#else
+		BX_UNUSED(_data, _size);
+#endif // BGFX_DISK_CACHE
+	}
+
+} // namespace bgfx
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_CACHE_H_HEADER_GUARD
+#define BGFX_CACHE_H_HEADER_GUARD
+
+#include "bgfx_p.h"
+
+#include <bx/filepath.h>
+
+namespace bgfx
+{
+	/// Default implementation of `CallbackI` cache callbacks, used when application doesn't
+	/// provide its own callback. Every entry is stored in its own file in cache directory, named
+	/// by entry id and version key, so that cache written by different bgfx version, renderer,
+	/// or GPU is never read. Files are written to temporary file first and then renamed, and read
+	/// through memory mapping. When total size of cache directory exceeds maximum size, least
+	/// recently used entries are removed.
+	///
+	class DiskCache
+	{
+		BX_CLASS(DiskCache
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		DiskCache();
+		~DiskCache();
+
+		bool open(const char* _dirPath, uint32_t _maxSize);
+		void close();
+
+		bool isOpen() const
+		{
+			return m_open;
+		}
+
+		uint32_t readSize(uint64_t _id);
+		bool read(uint64_t _id, void* _data, uint32_t _size);
+		void write(uint64_t _id, const void* _data, uint32_t _size);
+
+	private:
+		struct Entry
+		{
+			int64_t  m_lastUse;
+			uint64_t m_id;
+			uint32_t m_version;
+			uint32_t m_size;
+		};
+
+		typedef stl::unordered_map<uint64_t, Entry> EntryMap;
+
+		void scan();
+		void getFilePath(bx::FilePath& _outFilePath, uint64_t _id, uint32_t _version) const;
+		EntryMap::iterator find(uint64_t _id);
+		void remove(EntryMap::iterator _it);
+		void evict();
+
+		bx::FilePath m_dirPath;
+		EntryMap m_entries;
+		uint64_t m_totalSize;
+		uint64_t m_maxSize;
+		int64_t  m_clock;
+		uint32_t m_version;
+		bool     m_open;
+		bool     m_scanned;
+
+		uint32_t m_numHits;
+		uint32_t m_numMisses;
+		uint32_t m_numWrites;
+		uint32_t m_numEvicted;
+	};
+
+} // namespace bgfx
+
+#endif // BGFX_CACHE_H_HEADER_GUARD
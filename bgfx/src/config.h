@@ -177,17 +177,73 @@
 #	define BGFX_CONFIG_MULTITHREADED ( (0 == BX_PLATFORM_EMSCRIPTEN) ? 1 : 0)
 #endif // BGFX_CONFIG_MULTITHREADED
 
+/// Default maximum number of draw calls per frame. It can be changed at init
+/// time with `Init::limits.maxDrawCalls`.
 #ifndef BGFX_CONFIG_MAX_DRAW_CALLS
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+/// Number of render items, and matrix cache entries, frame storage grows by
+/// once more draw calls are submitted. Must be power of two.
+#ifndef BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+#	define BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE (16<<10)
+#endif // BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
 
-#ifndef BGFX_CONFIG_MAX_MATRIX_CACHE
-#	define BGFX_CONFIG_MAX_MATRIX_CACHE (BGFX_CONFIG_MAX_DRAW_CALLS+1)
-#endif // BGFX_CONFIG_MAX_MATRIX_CACHE
+/// Number of render items and matrix cache entries encoder reserves from
+/// frame at once. Unused render items are compacted when frame is finished.
+#ifndef BGFX_CONFIG_ENCODER_SLAB_SIZE
+#	define BGFX_CONFIG_ENCODER_SLAB_SIZE 256
+#endif // BGFX_CONFIG_ENCODER_SLAB_SIZE
+
+/// Number of threads, including render thread, used to sort render items, and by backends
+/// recording sorted render items on multiple threads.
+#ifndef BGFX_CONFIG_SORT_NUM_THREADS
+#	define BGFX_CONFIG_SORT_NUM_THREADS (BGFX_CONFIG_MULTITHREADED ? 4 : 1)
+#endif // BGFX_CONFIG_SORT_NUM_THREADS
+
+/// Minimum number of render items in frame to sort them in parallel.
+#ifndef BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS
+#	define BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS (16<<10)
+#endif // BGFX_CONFIG_SORT_PARALLEL_MIN_ITEMS
+
+/// Maximum number of ranges sorted render items are split into, when backend records them on
+/// multiple threads.
+#ifndef BGFX_CONFIG_MAX_RECORD_RANGES
+#	define BGFX_CONFIG_MAX_RECORD_RANGES 16
+#endif // BGFX_CONFIG_MAX_RECORD_RANGES
+
+/// Minimum number of sorted render items in range recorded by single thread. Frames with less
+/// render items are recorded on render thread only.
+#ifndef BGFX_CONFIG_RECORD_PARALLEL_MIN_ITEMS
+#	define BGFX_CONFIG_RECORD_PARALLEL_MIN_ITEMS (2<<10)
+#endif // BGFX_CONFIG_RECORD_PARALLEL_MIN_ITEMS
+
+/// Number of draw calls backend scratch buffers (per draw uniform data and
+/// descriptors, used by Vulkan and Direct3D 12 renderers) are created for.
+/// Scratch buffer grows when frame has more draw calls, up to maxDrawCalls.
+#ifndef BGFX_CONFIG_SCRATCH_BUFFER_DRAW_CALLS
+#	define BGFX_CONFIG_SCRATCH_BUFFER_DRAW_CALLS (4<<10)
+#endif // BGFX_CONFIG_SCRATCH_BUFFER_DRAW_CALLS
+
+/// Compute u_modelView and u_modelViewProj for all draws after sort, in batches
+/// of this many render items, instead of computing them while submitting each
+/// draw. Batches are spread across sort threads. 0 disables precompute.
+#ifndef BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE
+#	define BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE (4<<10)
+#endif // BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE
+
+/// Encoders sort render items they submit between begin and end as one run,
+/// and frame sort merges those sorted runs instead of sorting all render items.
+/// Run is split only where another encoder's slab interleaves, or at render
+/// item chunk boundary. Useful when each encoder submits mostly in sort order,
+/// for example one encoder per view.
+#ifndef BGFX_CONFIG_SORT_ENCODER_RUNS
+#	define BGFX_CONFIG_SORT_ENCODER_RUNS 0
+#endif // BGFX_CONFIG_SORT_ENCODER_RUNS
 
 #ifndef BGFX_CONFIG_MAX_RECT_CACHE
 #	define BGFX_CONFIG_MAX_RECT_CACHE (4<<10)
@@ -280,9 +336,29 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
-#ifndef BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
-#	define BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE (64<<10)
-#endif // BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
+/// Command buffers grow by chaining pages of this size. Pages are kept and reused between
+/// frames. Single command must fit into one page.
+#ifndef BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+#	define BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE (64<<10)
+#endif // BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+
+/// Maximum number of asynchronous uploads waiting to be passed to renderer. When queue is
+/// full, queued uploads are passed to renderer in current frame regardless of budget.
+#ifndef BGFX_CONFIG_MAX_UPLOADS
+#	define BGFX_CONFIG_MAX_UPLOADS (4<<10)
+#endif // BGFX_CONFIG_MAX_UPLOADS
+
+/// Default number of bytes of asynchronous uploads passed to renderer per frame. Can be
+/// changed at init time with `Init::limits.maxUploadSize`.
+#ifndef BGFX_CONFIG_MAX_UPLOAD_SIZE
+#	define BGFX_CONFIG_MAX_UPLOAD_SIZE (16<<20)
+#endif // BGFX_CONFIG_MAX_UPLOAD_SIZE
+
+/// Default maximum size of cache directory in bytes, when cache directory is set with
+/// `Init::cacheDirPath`. Can be changed at init time with `Init::limits.maxCacheSize`.
+#ifndef BGFX_CONFIG_MAX_CACHE_SIZE
+#	define BGFX_CONFIG_MAX_CACHE_SIZE (64<<20)
+#endif // BGFX_CONFIG_MAX_CACHE_SIZE
 
 #ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 #	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
@@ -292,10 +368,22 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Size of transient vertex and index buffer block encoder reserves from frame
+/// at once. Encoder allocations are sub-allocated from its block without locking.
+#ifndef BGFX_CONFIG_TRANSIENT_BUFFER_BLOCK_SIZE
+#	define BGFX_CONFIG_TRANSIENT_BUFFER_BLOCK_SIZE (64<<10)
+#endif // BGFX_CONFIG_TRANSIENT_BUFFER_BLOCK_SIZE
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 
+/// Maximum number of draws encoder merges into single instanced draw when
+/// auto instancing is enabled.
+#ifndef BGFX_CONFIG_MAX_AUTO_INSTANCING_BATCH
+#	define BGFX_CONFIG_MAX_AUTO_INSTANCING_BATCH 1024
+#endif // BGFX_CONFIG_MAX_AUTO_INSTANCING_BATCH
+
 #ifndef BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE
 #	define BGFX_CONFIG_MAX_COLOR_PALETTE 16
 #endif // BGFX_CONFIG_MAX_CLEAR_COLOR_PALETTE
@@ -306,6 +394,26 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_PROFILER 0
 #endif // BGFX_CONFIG_PROFILER
 
+/// Maximum number of threads recorded by built-in CPU profiler.
+#ifndef BGFX_CONFIG_MAX_PROFILER_THREADS
+#	define BGFX_CONFIG_MAX_PROFILER_THREADS 16
+#endif // BGFX_CONFIG_MAX_PROFILER_THREADS
+
+/// Maximum number of unique scopes per thread recorded by built-in CPU profiler.
+#ifndef BGFX_CONFIG_MAX_PROFILER_SCOPES
+#	define BGFX_CONFIG_MAX_PROFILER_SCOPES 256
+#endif // BGFX_CONFIG_MAX_PROFILER_SCOPES
+
+/// Maximum scope nesting depth recorded by built-in CPU profiler.
+#ifndef BGFX_CONFIG_MAX_PROFILER_DEPTH
+#	define BGFX_CONFIG_MAX_PROFILER_DEPTH 32
+#endif // BGFX_CONFIG_MAX_PROFILER_DEPTH
+
+/// Number of frame timeline events kept, must be power of 2.
+#ifndef BGFX_CONFIG_MAX_TIMELINE_EVENTS
+#	define BGFX_CONFIG_MAX_TIMELINE_EVENTS (4<<10)
+#endif // BGFX_CONFIG_MAX_TIMELINE_EVENTS
+
 #ifndef BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
 #	define BGFX_CONFIG_RENDERDOC_LOG_FILEPATH "temp/bgfx"
 #endif // BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
@@ -0,0 +1,325 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "profiler.h"
+
+namespace bgfx
+{
+	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_PROFILER_SCOPES < UINT16_MAX);
+	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_PROFILER_THREADS < UINT16_MAX);
+
+	static const uint16_t kInvalidNode = UINT16_MAX;
+	static const uint16_t kInvalidSlot = UINT16_MAX;
+
+	// Per thread profiler slot, generation in high 16 bits and slot index in low 16 bits.
+	// Generation changes with every `CpuProfiler::init`, so that slot from previous bgfx
+	// session is never used.
+#if BGFX_CONFIG_MULTITHREADED && !defined(BX_THREAD_LOCAL)
+	static bx::TlsData s_profilerSlotTls;
+
+	static uint32_t getProfilerSlot()
+	{
+		union { void* ptr; uintptr_t ui; } cast = { s_profilerSlotTls.get() };
+		return uint32_t(cast.ui);
+	}
+
+	static void setProfilerSlot(uint32_t _slot)
+	{
+		union { uintptr_t ui; void* ptr; } cast = { _slot };
+		s_profilerSlotTls.set(cast.ptr);
+	}
+#else
+#	if !BGFX_CONFIG_MULTITHREADED
+	static uint32_t s_profilerSlot = 0;
+#	else
+	static BX_THREAD_LOCAL uint32_t s_profilerSlot = 0;
+#	endif // !BGFX_CONFIG_MULTITHREADED
+
+	static uint32_t getProfilerSlot()
+	{
+		return s_profilerSlot;
+	}
+
+	static void setProfilerSlot(uint32_t _slot)
+	{
+		s_profilerSlot = _slot;
+	}
+#endif // BGFX_CONFIG_MULTITHREADED && !defined(BX_THREAD_LOCAL)
+
+	bool g_profilerEnabled = false;
+	CpuProfiler g_cpuProfiler;
+
+	void profilerScopeBegin(const char* _name)
+	{
+		g_cpuProfiler.begin(_name);
+	}
+
+	void profilerScopeEnd()
+	{
+		g_cpuProfiler.end();
+	}
+
+	void profilerSetThreadName(const char* _name)
+	{
+		g_cpuProfiler.setThreadName(_name);
+	}
+
+	void profilerSetEnabled(bool _enabled)
+	{
+		g_cpuProfiler.setEnabled(_enabled);
+	}
+
+	CpuProfiler::CpuProfiler()
+		: m_numThreads(0)
+		, m_epoch(0)
+		, m_generation(0)
+	{
+		bx::memSet(m_thread, 0, sizeof(m_thread) );
+	}
+
+	void CpuProfiler::init()
+	{
+		m_numThreads = 0;
+		m_generation = 0 == m_generation+1 ? 1 : m_generation+1;
+		bx::memSet(m_thread, 0, sizeof(m_thread) );
+	}
+
+	void CpuProfiler::shutdown()
+	{
+		setEnabled(false);
+
+		const uint32_t num = bx::min<uint32_t>(m_numThreads, BGFX_CONFIG_MAX_PROFILER_THREADS);
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			BX_DELETE(g_allocator, m_thread[ii]);
+			m_thread[ii] = NULL;
+		}
+
+		m_numThreads = 0;
+	}
+
+	void CpuProfiler::setEnabled(bool _enabled)
+	{
+		if (_enabled
+		&&  !g_profilerEnabled)
+		{
+			// Scopes that were open while profiler was disabled are discarded.
+			++m_epoch;
+		}
+
+		g_profilerEnabled = _enabled;
+	}
+
+	CpuProfiler::Thread* CpuProfiler::getThread()
+	{
+		uint32_t slot = getProfilerSlot();
+
+		if (m_generation != slot>>16)
+		{
+			if (0 == m_generation)
+			{
+				return NULL;
+			}
+
+			const uint32_t idx = uint32_t(bx::atomicFetchAndAdd<int32_t>(&m_numThreads, 1) );
+			if (idx < BGFX_CONFIG_MAX_PROFILER_THREADS)
+			{
+				Thread* thread = BX_NEW(g_allocator, Thread);
+				bx::memSet(thread, 0, sizeof(Thread) );
+				thread->m_numNodes = 1;
+				thread->m_epoch    = m_epoch;
+				bx::snprintf(thread->m_name, BX_COUNTOF(thread->m_name), "Thread %d", idx);
+
+				bx::memoryBarrier();
+				m_thread[idx] = thread;
+			}
+			else
+			{
+				BX_TRACE("Too many threads for CPU profiler (max: %d).", BGFX_CONFIG_MAX_PROFILER_THREADS);
+			}
+
+			slot = uint32_t(m_generation)<<16
+				| (idx < BGFX_CONFIG_MAX_PROFILER_THREADS ? idx : kInvalidSlot)
+				;
+			setProfilerSlot(slot);
+		}
+
+		const uint16_t idx = uint16_t(slot);
+		return kInvalidSlot == idx ? NULL : m_thread[idx];
+	}
+
+	void CpuProfiler::begin(const char* _name)
+	{
+		Thread* thread = getThread();
+		if (NULL == thread)
+		{
+			return;
+		}
+
+		if (thread->m_epoch != m_epoch)
+		{
+			thread->m_epoch = m_epoch;
+			thread->m_depth = 0;
+		}
+
+		const uint32_t depth = thread->m_depth++;
+		if (depth >= BGFX_CONFIG_MAX_PROFILER_DEPTH)
+		{
+			return;
+		}
+
+		Entry& entry = thread->m_stack[depth];
+		entry.m_node = kInvalidNode;
+
+		const uint16_t parent = 0 == depth ? 0 : thread->m_stack[depth-1].m_node;
+		if (kInvalidNode != parent)
+		{
+			Node* node = thread->m_node;
+
+			// Names are string literals, comparing pointers is enough.
+			uint16_t idx = node[parent].m_child;
+			while (0 != idx
+			&&     _name != node[idx].m_name)
+			{
+				idx = node[idx].m_next;
+			}
+
+			if (0 == idx
+			&&  thread->m_numNodes < BGFX_CONFIG_MAX_PROFILER_SCOPES)
+			{
+				idx = uint16_t(thread->m_numNodes);
+
+				Node& child = node[idx];
+				child.m_name      = _name;
+				child.m_time      = 0;
+				child.m_count     = 0;
+				child.m_parent    = parent;
+				child.m_depth     = uint16_t(depth);
+				child.m_child     = 0;
+				child.m_lastChild = 0;
+				child.m_next      = 0;
+
+				bx::memoryBarrier();
+				thread->m_numNodes = idx+1;
+
+				if (0 == node[parent].m_child)
+				{
+					node[parent].m_child = idx;
+				}
+				else
+				{
+					node[node[parent].m_lastChild].m_next = idx;
+				}
+
+				node[parent].m_lastChild = idx;
+			}
+
+			entry.m_node = 0 == idx ? kInvalidNode : idx;
+		}
+
+		entry.m_begin = bx::getHPCounter();
+	}
+
+	void CpuProfiler::end()
+	{
+		const int64_t now = bx::getHPCounter();
+
+		Thread* thread = getThread();
+		if (NULL == thread
+		||  0 == thread->m_depth
+		||  thread->m_epoch != m_epoch)
+		{
+			return;
+		}
+
+		const uint32_t depth = --thread->m_depth;
+		if (depth >= BGFX_CONFIG_MAX_PROFILER_DEPTH)
+		{
+			return;
+		}
+
+		const Entry& entry = thread->m_stack[depth];
+		if (kInvalidNode != entry.m_node)
+		{
+			Node& node = thread->m_node[entry.m_node];
+			node.m_time += now - entry.m_begin;
+			node.m_count++;
+		}
+	}
+
+	void CpuProfiler::setThreadName(const char* _name)
+	{
+		Thread* thread = getThread();
+		if (NULL != thread)
+		{
+			bx::strCopy(thread->m_name, BX_COUNTOF(thread->m_name), _name);
+		}
+	}
+
+	uint16_t CpuProfiler::collect(ProfilerScopeStats* _stats, uint16_t _max)
+	{
+		uint16_t num = 0;
+
+		const uint32_t numThreads = bx::min<uint32_t>(m_numThreads, BGFX_CONFIG_MAX_PROFILER_THREADS);
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			Thread* thread = m_thread[ii];
+			if (NULL == thread)
+			{
+				continue;
+			}
+
+			const uint32_t numNodes = thread->m_numNodes;
+			bx::memoryBarrier();
+
+			const Node* node = thread->m_node;
+
+			// Depth first walk, links to nodes that are not published yet are ignored.
+			uint16_t idx = node[0].m_child;
+			while (0 != idx
+			&&     idx < numNodes)
+			{
+				const Node& current = node[idx];
+				const int64_t  time  = current.m_time;
+				const uint32_t count = current.m_count;
+
+				if (count != thread->m_prevCount[idx]
+				&&  num < _max)
+				{
+					ProfilerScopeStats& stats = _stats[num++];
+					stats.name           = current.m_name;
+					stats.threadName     = thread->m_name;
+					stats.cpuTimeElapsed = time  - thread->m_prevTime[idx];
+					stats.count          = count - thread->m_prevCount[idx];
+					stats.depth          = current.m_depth;
+				}
+
+				thread->m_prevTime[idx]  = time;
+				thread->m_prevCount[idx] = count;
+
+				uint16_t next = current.m_child;
+				if (0 == next
+				||  next >= numNodes)
+				{
+					for (next = idx; 0 != next; next = node[next].m_parent)
+					{
+						const uint16_t sibling = node[next].m_next;
+						if (0 != sibling
+						&&  sibling < numNodes)
+						{
+							next = sibling;
+							break;
+						}
+					}
+				}
+
+				idx = next;
+			}
+		}
+
+		return num;
+	}
+
+} // namespace bgfx
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_PROFILER_H_HEADER_GUARD
+#define BGFX_PROFILER_H_HEADER_GUARD
+
+#include "bgfx_p.h"
+
+namespace bgfx
+{
+	/// Built-in CPU profiler behind `BGFX_PROFILER_SCOPE`. Every thread records into its own
+	/// tree of scopes, and only that thread writes to it. Nodes accumulate time and count,
+	/// `collect` reports difference since previous call, so it should be called once per frame
+	/// from single thread.
+	///
+	class CpuProfiler
+	{
+		BX_CLASS(CpuProfiler
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		CpuProfiler();
+
+		void init();
+		void shutdown();
+
+		void setEnabled(bool _enabled);
+
+		void begin(const char* _name);
+		void end();
+
+		void setThreadName(const char* _name);
+
+		/// Returns number of scopes entered since previous call. Scope names and thread names
+		/// are valid until `shutdown`.
+		uint16_t collect(ProfilerScopeStats* _stats, uint16_t _max);
+
+	private:
+		struct Node
+		{
+			const char* m_name;
+			int64_t  m_time;
+			uint32_t m_count;
+			uint16_t m_parent;
+			uint16_t m_depth;
+			uint16_t m_child;
+			uint16_t m_lastChild;
+			uint16_t m_next;
+		};
+
+		struct Entry
+		{
+			int64_t  m_begin;
+			uint16_t m_node;
+		};
+
+		struct Thread
+		{
+			Node m_node[BGFX_CONFIG_MAX_PROFILER_SCOPES];
+			volatile uint32_t m_numNodes;
+
+			Entry    m_stack[BGFX_CONFIG_MAX_PROFILER_DEPTH];
+			uint32_t m_depth;
+			uint32_t m_epoch;
+
+			char m_name[64];
+
+			int64_t  m_prevTime[BGFX_CONFIG_MAX_PROFILER_SCOPES];
+			uint32_t m_prevCount[BGFX_CONFIG_MAX_PROFILER_SCOPES];
+		};
+
+		Thread* getThread();
+
+		Thread* m_thread[BGFX_CONFIG_MAX_PROFILER_THREADS];
+		volatile int32_t m_numThreads;
+		uint32_t m_epoch;
+		uint16_t m_generation;
+	};
+
+	extern CpuProfiler g_cpuProfiler;
+
+} // namespace bgfx
+
+#endif // BGFX_PROFILER_H_HEADER_GUARD
@@ -0,0 +1,884 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "record.h"
+
+#include <bx/hash.h>
+
+namespace bgfx
+{
+#define BGFX_CHUNK_MAGIC_REC BX_MAKEFOURCC('R', 'E', 'C', 0x0)
+#define BGFX_CHUNK_MAGIC_FRM BX_MAKEFOURCC('F', 'R', 'M', 0x0)
+
+	static const uint32_t kRecordVersion = 1;
+
+	static uint32_t recordLayoutHash()
+	{
+		// Frame data is stored in native layout, hash of structure sizes and limits catches
+		// recordings made by different build configuration.
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(uint32_t(sizeof(void*) ) );
+		murmur.add(uint32_t(sizeof(Init) ) );
+		murmur.add(uint32_t(sizeof(TextureCreate) ) );
+		murmur.add(uint32_t(sizeof(View) ) );
+		murmur.add(uint32_t(sizeof(RenderItem) ) );
+		murmur.add(uint32_t(sizeof(RenderBind) ) );
+		murmur.add(uint32_t(sizeof(RenderItemCount) ) );
+		murmur.add(uint32_t(sizeof(RenderItemSlab) ) );
+		murmur.add(uint32_t(sizeof(BlitItem) ) );
+		murmur.add(uint32_t(sizeof(Matrix4) ) );
+		murmur.add(uint32_t(sizeof(Rect) ) );
+		murmur.add(uint32_t(BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE) );
+		murmur.add(uint32_t(BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE) );
+		murmur.add(uint32_t(BGFX_CONFIG_ENCODER_SLAB_SIZE) );
+		murmur.add(uint32_t(BGFX_CONFIG_SORT_ENCODER_RUNS) );
+		murmur.add(uint32_t(BGFX_CONFIG_MAX_VIEWS) );
+		murmur.add(uint32_t(BGFX_CONFIG_MAX_COLOR_PALETTE) );
+		murmur.add(uint32_t(BGFX_CONFIG_MAX_BLIT_ITEMS) );
+		murmur.add(uint32_t(BGFX_CONFIG_MAX_RECT_CACHE) );
+		return murmur.end();
+	}
+
+	static void uniformBufferSize(const Frame* _frame, uint32_t _begin, uint32_t _end, uint32_t* _size)
+	{
+		const uint32_t maxEncoders = g_caps.limits.maxEncoders;
+
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const RenderItem& renderItem = _frame->getRenderItem(ii);
+			const uint64_t key = _frame->m_renderItemChunk[ii/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_sortKey[ii%BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+
+			uint8_t  idx;
+			uint32_t end;
+			if (0 != (key & SORT_KEY_DRAW_BIT) )
+			{
+				idx = renderItem.draw.m_uniformIdx;
+				end = renderItem.draw.m_uniformEnd;
+			}
+			else
+			{
+				idx = renderItem.compute.m_uniformIdx;
+				end = renderItem.compute.m_uniformEnd;
+			}
+
+			if (idx < maxEncoders)
+			{
+				_size[idx] = bx::max(_size[idx], end);
+			}
+		}
+	}
+
+	FrameRecorder::FrameRecorder()
+		: m_open(false)
+	{
+		bx::memSet(m_view, 0, sizeof(m_view) );
+	}
+
+	FrameRecorder::~FrameRecorder()
+	{
+		close();
+	}
+
+	bool FrameRecorder::open(const char* _filePath, const Init::Limits& _limits)
+	{
+		bx::Error err;
+		if (!m_writer.open(_filePath, false, &err) )
+		{
+			BX_TRACE("Failed to open frame recording file %s.", _filePath);
+			return false;
+		}
+
+		m_open = true;
+
+		bx::write(&m_writer, uint32_t(BGFX_CHUNK_MAGIC_REC) );
+		bx::write(&m_writer, kRecordVersion);
+		bx::write(&m_writer, uint32_t(BGFX_API_VERSION) );
+		bx::write(&m_writer, recordLayoutHash() );
+		bx::write(&m_writer, _limits);
+
+		return true;
+	}
+
+	void FrameRecorder::close()
+	{
+		if (m_open)
+		{
+			m_writer.close();
+			m_open = false;
+		}
+	}
+
+	void FrameRecorder::patch(const CommandBuffer& _cmdbuf, RecordPatch::Enum _type, const void* _ptr)
+	{
+		// Patches are written while commands are executed, memory is released right after
+		// it's passed to renderer.
+		const uint32_t pos = _cmdbuf.m_pos - uint32_t(sizeof(void*) );
+		bx::write(&m_writer, pos);
+		bx::write(&m_writer, uint8_t(_type) );
+
+		if (RecordPatch::Memory  != _type
+		&&  RecordPatch::Texture != _type)
+		{
+			return;
+		}
+
+		const Memory* mem = (const Memory*)_ptr;
+		if (NULL == mem)
+		{
+			bx::write(&m_writer, UINT32_MAX);
+			return;
+		}
+
+		bx::write(&m_writer, mem->size);
+		bx::write(&m_writer, mem->data, int32_t(mem->size) );
+
+		if (RecordPatch::Texture == _type)
+		{
+			// Texture created with `createTexture2D` and similar stores reference to data
+			// memory inside texture create chunk.
+			uint32_t size = UINT32_MAX;
+			const Memory* data = NULL;
+
+			uint32_t magic = 0;
+			if (sizeof(magic) + sizeof(TextureCreate) <= mem->size)
+			{
+				bx::memCopy(&magic, mem->data, sizeof(magic) );
+			}
+
+			if (BGFX_CHUNK_MAGIC_TEX == magic)
+			{
+				TextureCreate tc;
+				bx::memCopy(&tc, &mem->data[sizeof(magic)], sizeof(tc) );
+
+				if (NULL != tc.m_mem)
+				{
+					size = tc.m_mem->size;
+					data = tc.m_mem;
+				}
+			}
+
+			bx::write(&m_writer, size);
+
+			if (NULL != data)
+			{
+				bx::write(&m_writer, data->data, int32_t(data->size) );
+			}
+		}
+	}
+
+	void FrameRecorder::beginFrame()
+	{
+		bx::write(&m_writer, uint32_t(BGFX_CHUNK_MAGIC_FRM) );
+	}
+
+	void FrameRecorder::writeCommands(CommandBuffer& _cmdbuf)
+	{
+		bx::write(&m_writer, UINT32_MAX);
+
+		const uint32_t size = _cmdbuf.m_size;
+		bx::write(&m_writer, size);
+
+		// Command buffer is written page by page, padding at the end of page is preserved
+		// so that positions of commands don't change.
+		_cmdbuf.reset();
+		for (uint32_t pos = 0; pos < size; pos += BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE)
+		{
+			const uint32_t num = bx::min<uint32_t>(size-pos, BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE);
+			bx::write(&m_writer, _cmdbuf.skip(num), int32_t(num) );
+		}
+		_cmdbuf.reset();
+	}
+
+	void FrameRecorder::writeFrame(const Frame* _frame, bool _submit, const ClearQuad& _clearQuad, const TextVideoMemBlitter& _blitter)
+	{
+		bx::write(&m_writer, _submit);
+
+		if (!_submit)
+		{
+			return;
+		}
+
+		bx::write(&m_writer, _frame->m_resolution);
+		bx::write(&m_writer, _frame->m_debug);
+		bx::write(&m_writer, _frame->m_capture);
+		bx::write(&m_writer, _frame->m_viewRemap, int32_t(sizeof(_frame->m_viewRemap) ) );
+		bx::write(&m_writer, _frame->m_colorPalette, int32_t(sizeof(_frame->m_colorPalette) ) );
+
+		{
+			// Most views don't change between frames, only views different from previous frame
+			// are written.
+			uint16_t numViews = 0;
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				numViews += 0 != bx::memCmp(&m_view[ii], &_frame->m_view[ii], sizeof(View) );
+			}
+
+			bx::write(&m_writer, numViews);
+
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				if (0 != bx::memCmp(&m_view[ii], &_frame->m_view[ii], sizeof(View) ) )
+				{
+					bx::memCopy(&m_view[ii], &_frame->m_view[ii], sizeof(View) );
+					bx::write(&m_writer, ViewId(ii) );
+					bx::write(&m_writer, m_view[ii]);
+				}
+			}
+		}
+
+		{
+			// Render items are written unsorted, exactly as renderer gets them.
+			const uint32_t numRenderItems = _frame->m_numRenderItems;
+			bx::write(&m_writer, numRenderItems);
+
+			for (uint32_t ii = 0; ii < numRenderItems; ii += BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+			{
+				const RenderItemChunk& chunk = _frame->m_renderItemChunk[ii/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+				const uint32_t size = bx::min<uint32_t>(numRenderItems-ii, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+
+				bx::write(&m_writer, chunk.m_sortKey,    int32_t(size*sizeof(uint64_t) ) );
+				bx::write(&m_writer, chunk.m_sortValue,  int32_t(size*sizeof(RenderItemCount) ) );
+				bx::write(&m_writer, chunk.m_renderItem, int32_t(size*sizeof(RenderItem) ) );
+
+				// Consecutive draws usually share bindings.
+				for (uint32_t jj = 0; jj < size; ++jj)
+				{
+					const bool same = 0 < jj
+						&& 0 == bx::memCmp(&chunk.m_renderItemBind[jj], &chunk.m_renderItemBind[jj-1], sizeof(RenderBind) )
+						;
+					bx::write(&m_writer, same);
+
+					if (!same)
+					{
+						bx::write(&m_writer, chunk.m_renderItemBind[jj]);
+					}
+				}
+			}
+
+			bx::write(&m_writer, _frame->m_numRuns);
+			bx::write(&m_writer, _frame->m_run, int32_t(_frame->m_numRuns*sizeof(RenderItemSlab) ) );
+
+			const uint16_t numBlitItems = _frame->m_numBlitItems;
+			bx::write(&m_writer, numBlitItems);
+			bx::write(&m_writer, _frame->m_blitKeys, int32_t(numBlitItems*sizeof(uint32_t) ) );
+			bx::write(&m_writer, _frame->m_blitItem, int32_t(numBlitItems*sizeof(BlitItem) ) );
+		}
+
+		{
+			const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+			const uint32_t numMatrices = matrixCache.m_num;
+			bx::write(&m_writer, numMatrices);
+
+			for (uint32_t ii = 0; ii < numMatrices; ii += BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+			{
+				const uint32_t size = bx::min<uint32_t>(numMatrices-ii, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				bx::write(&m_writer, &matrixCache.get(ii), int32_t(size*sizeof(Matrix4) ) );
+			}
+
+			const RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+			bx::write(&m_writer, rectCache.m_num);
+			bx::write(&m_writer, rectCache.m_cache, int32_t(rectCache.m_num*sizeof(Rect) ) );
+		}
+
+		{
+			// Uniform buffer position is reset when encoder finishes, used size is found
+			// from render items that reference it.
+			const uint32_t maxEncoders = g_caps.limits.maxEncoders;
+			uint32_t* size = (uint32_t*)alloca(maxEncoders*sizeof(uint32_t) );
+			bx::memSet(size, 0, maxEncoders*sizeof(uint32_t) );
+
+			if (BX_ENABLED(BGFX_CONFIG_SORT_ENCODER_RUNS) )
+			{
+				for (uint32_t ii = 0, num = _frame->m_numRuns; ii < num; ++ii)
+				{
+					uniformBufferSize(_frame, _frame->m_run[ii].m_begin, _frame->m_run[ii].m_end, size);
+				}
+			}
+			else
+			{
+				uniformBufferSize(_frame, 0, _frame->m_numRenderItems, size);
+			}
+
+			for (uint32_t ii = 0; ii < maxEncoders; ++ii)
+			{
+				bx::write(&m_writer, size[ii]);
+				bx::write(&m_writer, _frame->m_uniformBuffer[ii]->getData(0), int32_t(size[ii]) );
+			}
+		}
+
+		{
+			bx::write(&m_writer, _frame->m_iboffset);
+			if (0 < _frame->m_iboffset)
+			{
+				bx::write(&m_writer, *_frame->m_transientIb);
+				bx::write(&m_writer, _frame->m_transientIb->data, int32_t(_frame->m_iboffset) );
+			}
+
+			bx::write(&m_writer, _frame->m_vboffset);
+			if (0 < _frame->m_vboffset)
+			{
+				bx::write(&m_writer, *_frame->m_transientVb);
+				bx::write(&m_writer, _frame->m_transientVb->data, int32_t(_frame->m_vboffset) );
+			}
+		}
+
+		{
+			// Clear quad and debug text vertices are generated by renderer, only buffer
+			// description is needed.
+			bx::write(&m_writer, _clearQuad.m_program, int32_t(sizeof(_clearQuad.m_program) ) );
+			bx::write(&m_writer, _clearQuad.m_decl);
+
+			const bool clearQuadVb = NULL != _clearQuad.m_vb;
+			bx::write(&m_writer, clearQuadVb);
+			if (clearQuadVb)
+			{
+				bx::write(&m_writer, *_clearQuad.m_vb);
+			}
+
+			bx::write(&m_writer, _blitter.m_texture);
+			bx::write(&m_writer, _blitter.m_program);
+			bx::write(&m_writer, _blitter.m_decl);
+
+			const bool blitterVb = NULL != _blitter.m_vb;
+			bx::write(&m_writer, blitterVb);
+			if (blitterVb)
+			{
+				bx::write(&m_writer, *_blitter.m_vb);
+				bx::write(&m_writer, *_blitter.m_ib);
+			}
+		}
+
+		if (0 != (_frame->m_debug & BGFX_DEBUG_TEXT) )
+		{
+			const TextVideoMem& tvm = *_frame->m_textVideoMem;
+			bx::write(&m_writer, tvm.m_small);
+			bx::write(&m_writer, tvm.m_width);
+			bx::write(&m_writer, tvm.m_height);
+			bx::write(&m_writer, tvm.m_mem, int32_t(tvm.m_size*sizeof(TextVideoMem::MemSlot) ) );
+		}
+	}
+
+	template<typename Ty>
+	static Ty* transientRealloc(Ty* _buffer, const Ty& _desc)
+	{
+		if (NULL == _buffer
+		||  _buffer->size != _desc.size)
+		{
+			const uint32_t size = BX_ALIGN_16(sizeof(Ty) ) + BX_ALIGN_16(_desc.size);
+			_buffer = (Ty*)BX_ALIGNED_REALLOC(g_allocator, _buffer, size, 16);
+		}
+
+		bx::memCopy(_buffer, &_desc, sizeof(Ty) );
+		_buffer->data = (uint8_t*)_buffer + BX_ALIGN_16(sizeof(Ty) );
+
+		return _buffer;
+	}
+
+	template<typename Ty>
+	static void transientFree(Ty*& _buffer)
+	{
+		if (NULL != _buffer)
+		{
+			BX_ALIGNED_FREE(g_allocator, _buffer, 16);
+			_buffer = NULL;
+		}
+	}
+
+	FrameReplay::FrameReplay()
+		: m_patch(NULL)
+		, m_maxPatches(0)
+		, m_page(NULL)
+		, m_transientIb(NULL)
+		, m_transientVb(NULL)
+		, m_clearQuadVb(NULL)
+		, m_blitterVb(NULL)
+		, m_blitterIb(NULL)
+	{
+		bx::memSet(m_view, 0, sizeof(m_view) );
+	}
+
+	FrameReplay::~FrameReplay()
+	{
+		close();
+	}
+
+	bool FrameReplay::open(const char* _filePath, const Init& _init, Init::Limits& _limits)
+	{
+		bx::Error err;
+		if (!m_reader.open(_filePath, &err) )
+		{
+			BX_TRACE("Failed to open frame recording file %s.", _filePath);
+			return false;
+		}
+
+		uint32_t magic = 0;
+		bx::read(&m_reader, magic, &err);
+
+		uint32_t version = 0;
+		bx::read(&m_reader, version, &err);
+
+		uint32_t apiVersion = 0;
+		bx::read(&m_reader, apiVersion, &err);
+
+		uint32_t hash = 0;
+		bx::read(&m_reader, hash, &err);
+
+		bx::read(&m_reader, _limits, &err);
+
+		if (!err.isOk()
+		||  BGFX_CHUNK_MAGIC_REC != magic
+		||  kRecordVersion       != version
+		||  BGFX_API_VERSION     != apiVersion
+		||  recordLayoutHash()   != hash)
+		{
+			BX_TRACE("File %s is not frame recording, or it was recorded by different bgfx build.", _filePath);
+			m_reader.close();
+			return false;
+		}
+
+		m_init = _init;
+		m_page = (uint8_t*)BX_ALLOC(g_allocator, BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE);
+
+		return true;
+	}
+
+	void FrameReplay::close()
+	{
+		if (NULL != m_page)
+		{
+			m_reader.close();
+
+			BX_FREE(g_allocator, m_page);
+			BX_FREE(g_allocator, m_patch);
+			m_page       = NULL;
+			m_patch      = NULL;
+			m_maxPatches = 0;
+
+			transientFree(m_transientIb);
+			transientFree(m_transientVb);
+			transientFree(m_clearQuadVb);
+			transientFree(m_blitterVb);
+			transientFree(m_blitterIb);
+		}
+	}
+
+	bool FrameReplay::beginFrame()
+	{
+		bx::Error err;
+
+		uint32_t magic = 0;
+		bx::read(&m_reader, magic, &err);
+
+		return err.isOk()
+			&& BGFX_CHUNK_MAGIC_FRM == magic
+			;
+	}
+
+	static const Memory* readMemory(bx::ReaderI* _reader, bx::Error* _err)
+	{
+		uint32_t size = UINT32_MAX;
+		bx::read(_reader, size, _err);
+
+		if (!_err->isOk()
+		||  UINT32_MAX == size)
+		{
+			return NULL;
+		}
+
+		Memory* mem = const_cast<Memory*>(alloc(bx::max<uint32_t>(size, 1) ) );
+		mem->size = size;
+		bx::read(_reader, mem->data, int32_t(size), _err);
+
+		return mem;
+	}
+
+	bool FrameReplay::readCommands(CommandBuffer& _cmdbuf)
+	{
+		bx::Error err;
+
+		uint32_t numPatches = 0;
+		for (;;)
+		{
+			uint32_t pos = UINT32_MAX;
+			bx::read(&m_reader, pos, &err);
+
+			if (!err.isOk()
+			||  UINT32_MAX == pos)
+			{
+				break;
+			}
+
+			uint8_t type = RecordPatch::Count;
+			bx::read(&m_reader, type, &err);
+
+			void* ptr = NULL;
+
+			switch (type)
+			{
+			case RecordPatch::Memory:
+				ptr = const_cast<Memory*>(readMemory(&m_reader, &err) );
+				break;
+
+			case RecordPatch::Texture:
+				{
+					const Memory* mem  = readMemory(&m_reader, &err);
+					const Memory* data = NULL != mem ? readMemory(&m_reader, &err) : NULL;
+
+					if (NULL != data)
+					{
+						// Point texture create chunk to new copy of texture data.
+						TextureCreate tc;
+						bx::memCopy(&tc, &mem->data[sizeof(uint32_t)], sizeof(tc) );
+						tc.m_mem = data;
+						bx::memCopy(&mem->data[sizeof(uint32_t)], &tc, sizeof(tc) );
+					}
+
+					ptr = const_cast<Memory*>(mem);
+				}
+				break;
+
+			case RecordPatch::ReadTexture:
+				break;
+
+			case RecordPatch::WindowHandle:
+				ptr = g_platformData.nwh;
+				break;
+
+			default:
+				BX_TRACE("Invalid record patch type %d.", type);
+				return false;
+			}
+
+			if (numPatches == m_maxPatches)
+			{
+				m_maxPatches = bx::max<uint32_t>(64, m_maxPatches*2);
+				m_patch = (Patch*)BX_REALLOC(g_allocator, m_patch, m_maxPatches*sizeof(Patch) );
+			}
+
+			m_patch[numPatches].m_pos = pos;
+			m_patch[numPatches].m_ptr = ptr;
+			++numPatches;
+		}
+
+		uint32_t size = 0;
+		bx::read(&m_reader, size, &err);
+
+		if (!err.isOk() )
+		{
+			return false;
+		}
+
+		_cmdbuf.start();
+		for (uint32_t pos = 0; pos < size; pos += BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE)
+		{
+			const uint32_t num = bx::min<uint32_t>(size-pos, BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE);
+			bx::read(&m_reader, m_page, int32_t(num), &err);
+			_cmdbuf.write(m_page, num);
+		}
+
+		for (uint32_t ii = 0; ii < numPatches; ++ii)
+		{
+			_cmdbuf.m_pos = m_patch[ii].m_pos;
+			_cmdbuf.write(&m_patch[ii].m_ptr, sizeof(void*) );
+		}
+
+		if (0 < size)
+		{
+			_cmdbuf.reset();
+
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			if (CommandBuffer::RendererInit == command)
+			{
+				// Renderer is created with replay settings, only resolution and limits are
+				// taken from recording.
+				_cmdbuf.align(BX_ALIGNOF(Init) );
+				const uint32_t pos = _cmdbuf.m_pos;
+
+				Init init;
+				_cmdbuf.read(init);
+
+				init.type         = m_init.type;
+				init.vendorId     = m_init.vendorId;
+				init.deviceId     = m_init.deviceId;
+				init.debug        = m_init.debug;
+				init.profile      = m_init.profile;
+				init.callback     = m_init.callback;
+				init.allocator    = m_init.allocator;
+				init.recordFilePath = NULL;
+				bx::memCopy(&init.platformData, &g_platformData, sizeof(PlatformData) );
+
+				_cmdbuf.m_pos = pos;
+				_cmdbuf.write(init);
+			}
+		}
+
+		_cmdbuf.m_size = size;
+		_cmdbuf.m_pos  = 0;
+
+		return err.isOk();
+	}
+
+	bool FrameReplay::readFrame(Frame* _frame, ClearQuad& _clearQuad, TextVideoMemBlitter& _blitter)
+	{
+		bx::Error err;
+
+		bool submit = false;
+		bx::read(&m_reader, submit, &err);
+
+		if (!submit)
+		{
+			return err.isOk();
+		}
+
+		bx::read(&m_reader, _frame->m_resolution, &err);
+		bx::read(&m_reader, _frame->m_debug, &err);
+		bx::read(&m_reader, _frame->m_capture, &err);
+		bx::read(&m_reader, _frame->m_viewRemap, int32_t(sizeof(_frame->m_viewRemap) ), &err);
+		bx::read(&m_reader, _frame->m_colorPalette, int32_t(sizeof(_frame->m_colorPalette) ), &err);
+
+		{
+			uint16_t numViews = 0;
+			bx::read(&m_reader, numViews, &err);
+
+			for (uint32_t ii = 0; ii < numViews && err.isOk(); ++ii)
+			{
+				ViewId id = 0;
+				bx::read(&m_reader, id, &err);
+
+				if (BGFX_CONFIG_MAX_VIEWS <= id)
+				{
+					return false;
+				}
+
+				bx::read(&m_reader, m_view[id], &err);
+			}
+
+			bx::memCopy(_frame->m_view, m_view, sizeof(m_view) );
+		}
+
+		{
+			uint32_t numRenderItems = 0;
+			bx::read(&m_reader, numRenderItems, &err);
+
+			if (!err.isOk()
+			||  g_caps.limits.maxDrawCalls < numRenderItems)
+			{
+				return false;
+			}
+
+			for (uint32_t ii = 0; ii < numRenderItems; ii += BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+			{
+				RenderItemChunk& chunk = *_frame->allocRenderItemChunk(ii);
+				const uint32_t size = bx::min<uint32_t>(numRenderItems-ii, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+
+				bx::read(&m_reader, chunk.m_sortKey,    int32_t(size*sizeof(uint64_t) ), &err);
+				bx::read(&m_reader, chunk.m_sortValue,  int32_t(size*sizeof(RenderItemCount) ), &err);
+				bx::read(&m_reader, chunk.m_renderItem, int32_t(size*sizeof(RenderItem) ), &err);
+
+				for (uint32_t jj = 0; jj < size; ++jj)
+				{
+					bool same = false;
+					bx::read(&m_reader, same, &err);
+
+					if (same
+					&&  0 < jj)
+					{
+						bx::memCopy(&chunk.m_renderItemBind[jj], &chunk.m_renderItemBind[jj-1], sizeof(RenderBind) );
+					}
+					else
+					{
+						bx::read(&m_reader, chunk.m_renderItemBind[jj], &err);
+					}
+				}
+			}
+
+			_frame->m_numRenderItems = numRenderItems;
+
+			uint32_t numRuns = 0;
+			bx::read(&m_reader, numRuns, &err);
+
+			if (!err.isOk()
+			||  (numRenderItems+BGFX_CONFIG_ENCODER_SLAB_SIZE-1)/BGFX_CONFIG_ENCODER_SLAB_SIZE < numRuns)
+			{
+				return false;
+			}
+
+			bx::read(&m_reader, _frame->m_run, int32_t(numRuns*sizeof(RenderItemSlab) ), &err);
+			_frame->m_numRuns = numRuns;
+
+			uint16_t numBlitItems = 0;
+			bx::read(&m_reader, numBlitItems, &err);
+
+			if (!err.isOk()
+			||  BGFX_CONFIG_MAX_BLIT_ITEMS < numBlitItems)
+			{
+				return false;
+			}
+
+			bx::read(&m_reader, _frame->m_blitKeys, int32_t(numBlitItems*sizeof(uint32_t) ), &err);
+			bx::read(&m_reader, _frame->m_blitItem, int32_t(numBlitItems*sizeof(BlitItem) ), &err);
+			_frame->m_numBlitItems = numBlitItems;
+		}
+
+		{
+			MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+
+			uint32_t numMatrices = 0;
+			bx::read(&m_reader, numMatrices, &err);
+
+			if (!err.isOk()
+			||  matrixCache.m_max < numMatrices)
+			{
+				return false;
+			}
+
+			for (uint32_t ii = 0; ii < numMatrices; ii += BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+			{
+				const uint32_t size = bx::min<uint32_t>(numMatrices-ii, BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				MatrixCacheChunk* chunk = matrixCache.m_chunk.alloc(ii/BGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				bx::read(&m_reader, chunk->m_matrix, int32_t(size*sizeof(Matrix4) ), &err);
+			}
+
+			matrixCache.m_num = numMatrices;
+
+			RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+
+			uint32_t numRects = 0;
+			bx::read(&m_reader, numRects, &err);
+
+			if (!err.isOk()
+			||  BGFX_CONFIG_MAX_RECT_CACHE < numRects)
+			{
+				return false;
+			}
+
+			bx::read(&m_reader, rectCache.m_cache, int32_t(numRects*sizeof(Rect) ), &err);
+			rectCache.m_num = numRects;
+		}
+
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num && err.isOk(); ++ii)
+		{
+			uint32_t size = 0;
+			bx::read(&m_reader, size, &err);
+
+			UniformBuffer*& uniformBuffer = _frame->m_uniformBuffer[ii];
+			uniformBuffer->reset();
+			UniformBuffer::update(&uniformBuffer, size, size);
+
+			for (uint32_t pos = 0; pos < size && err.isOk(); pos += BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE)
+			{
+				const uint32_t chunk = bx::min<uint32_t>(size-pos, BGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE);
+				bx::read(&m_reader, m_page, int32_t(chunk), &err);
+				uniformBuffer->write(m_page, chunk);
+			}
+
+			uniformBuffer->reset();
+		}
+
+		{
+			uint32_t iboffset = 0;
+			bx::read(&m_reader, iboffset, &err);
+
+			if (0 < iboffset)
+			{
+				TransientIndexBuffer tib;
+				bx::read(&m_reader, tib, &err);
+
+				if (!err.isOk()
+				||  tib.size < iboffset)
+				{
+					return false;
+				}
+
+				m_transientIb = transientRealloc(m_transientIb, tib);
+				bx::read(&m_reader, m_transientIb->data, int32_t(iboffset), &err);
+			}
+
+			_frame->m_iboffset    = iboffset;
+			_frame->m_transientIb = m_transientIb;
+
+			uint32_t vboffset = 0;
+			bx::read(&m_reader, vboffset, &err);
+
+			if (0 < vboffset)
+			{
+				TransientVertexBuffer tvb;
+				bx::read(&m_reader, tvb, &err);
+
+				if (!err.isOk()
+				||  tvb.size < vboffset)
+				{
+					return false;
+				}
+
+				m_transientVb = transientRealloc(m_transientVb, tvb);
+				bx::read(&m_reader, m_transientVb->data, int32_t(vboffset), &err);
+			}
+
+			_frame->m_vboffset    = vboffset;
+			_frame->m_transientVb = m_transientVb;
+		}
+
+		{
+			bx::read(&m_reader, _clearQuad.m_program, int32_t(sizeof(_clearQuad.m_program) ), &err);
+			bx::read(&m_reader, _clearQuad.m_decl, &err);
+
+			bool clearQuadVb = false;
+			bx::read(&m_reader, clearQuadVb, &err);
+
+			if (clearQuadVb)
+			{
+				TransientVertexBuffer tvb;
+				bx::read(&m_reader, tvb, &err);
+				m_clearQuadVb = transientRealloc(m_clearQuadVb, tvb);
+			}
+
+			_clearQuad.m_vb = m_clearQuadVb;
+
+			bx::read(&m_reader, _blitter.m_texture, &err);
+			bx::read(&m_reader, _blitter.m_program, &err);
+			bx::read(&m_reader, _blitter.m_decl, &err);
+
+			bool blitterVb = false;
+			bx::read(&m_reader, blitterVb, &err);
+
+			if (blitterVb)
+			{
+				TransientVertexBuffer tvb;
+				bx::read(&m_reader, tvb, &err);
+				m_blitterVb = transientRealloc(m_blitterVb, tvb);
+
+				TransientIndexBuffer tib;
+				bx::read(&m_reader, tib, &err);
+				m_blitterIb = transientRealloc(m_blitterIb, tib);
+			}
+
+			_blitter.m_vb = m_blitterVb;
+			_blitter.m_ib = m_blitterIb;
+		}
+
+		if (0 != (_frame->m_debug & BGFX_DEBUG_TEXT) )
+		{
+			bool smallFont = false;
+			bx::read(&m_reader, smallFont, &err);
+
+			uint16_t width = 0;
+			bx::read(&m_reader, width, &err);
+
+			uint16_t height = 0;
+			bx::read(&m_reader, height, &err);
+
+			TextVideoMem& tvm = *_frame->m_textVideoMem;
+			tvm.resize(smallFont, width*8, height*(smallFont ? 8 : 16) );
+			bx::read(&m_reader, tvm.m_mem, int32_t(tvm.m_size*sizeof(TextVideoMem::MemSlot) ), &err);
+		}
+
+		return err.isOk();
+	}
+
+} // namespace bgfx
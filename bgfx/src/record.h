@@ -0,0 +1,82 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_RECORD_H_HEADER_GUARD
+#define BGFX_RECORD_H_HEADER_GUARD
+
+#include "bgfx_p.h"
+
+#include <bx/file.h>
+
+namespace bgfx
+{
+	/// Writes every frame passed to renderer into file: command buffers with memory they
+	/// reference, and frame data as renderer sees it in `RendererContextI::submit`. Data is
+	/// stored in native layout, recording can be replayed only by the same bgfx build.
+	///
+	class FrameRecorder
+	{
+	public:
+		FrameRecorder();
+		~FrameRecorder();
+
+		bool open(const char* _filePath, const Init::Limits& _limits);
+		void close();
+
+		/// Must be called right after pointer is read from command buffer.
+		void patch(const CommandBuffer& _cmdbuf, RecordPatch::Enum _type, const void* _ptr);
+
+		void beginFrame();
+		void writeCommands(CommandBuffer& _cmdbuf);
+		void writeFrame(const Frame* _frame, bool _submit, const ClearQuad& _clearQuad, const TextVideoMemBlitter& _blitter);
+
+	private:
+		bx::FileWriter m_writer;
+		View m_view[BGFX_CONFIG_MAX_VIEWS];
+		bool m_open;
+	};
+
+	/// Reads frames written by `FrameRecorder`.
+	///
+	class FrameReplay
+	{
+	public:
+		FrameReplay();
+		~FrameReplay();
+
+		bool open(const char* _filePath, const Init& _init, Init::Limits& _limits);
+		void close();
+
+		/// Returns false when there are no more frames in recording.
+		bool beginFrame();
+		bool readCommands(CommandBuffer& _cmdbuf);
+		bool readFrame(Frame* _frame, ClearQuad& _clearQuad, TextVideoMemBlitter& _blitter);
+
+	private:
+		struct Patch
+		{
+			uint32_t m_pos;
+			void*    m_ptr;
+		};
+
+		bx::FileReader m_reader;
+		Init m_init;
+
+		Patch*   m_patch;
+		uint32_t m_maxPatches;
+		uint8_t* m_page;
+
+		TransientIndexBuffer*  m_transientIb;
+		TransientVertexBuffer* m_transientVb;
+		TransientVertexBuffer* m_clearQuadVb;
+		TransientVertexBuffer* m_blitterVb;
+		TransientIndexBuffer*  m_blitterIb;
+
+		View m_view[BGFX_CONFIG_MAX_VIEWS];
+	};
+
+} // namespace bgfx
+
+#endif // BGFX_RECORD_H_HEADER_GUARD
@@ -113,10 +113,17 @@ namespace bgfx
 			}
 		}
 
+		/// `_item` is draw's sorted render item index, used to read matrices precomputed
+		/// by Frame::sort. Pass UINT32_MAX to compute them here.
 		template<uint16_t mtxRegs, typename RendererContext, typename Program, typename Draw>
-		void setPredefined(RendererContext* _renderer, uint16_t _view, uint8_t _eye, const Program& _program, const Frame* _frame, const Draw& _draw)
+		void setPredefined(RendererContext* _renderer, uint16_t _view, uint8_t _eye, const Program& _program, const Frame* _frame, const Draw& _draw, uint32_t _item = UINT32_MAX)
 		{
 			const FrameCache& frameCache = _frame->m_frameCache;
+			const bool precomputed = true
+				&& 0 != BGFX_CONFIG_PREDEFINED_MATRIX_BATCH_SIZE
+				&& 0 == _eye
+				&& UINT32_MAX != _item
+				;
 
 			for (uint32_t ii = 0, num = _program.m_numPredefined; ii < num; ++ii)
 			{
@@ -243,7 +250,7 @@ namespace bgfx
 
 				case PredefinedUniform::Model:
 					{
-						const Matrix4& model = frameCache.m_matrixCache.m_cache[_draw.m_startMatrix];
+						const Matrix4& model = frameCache.m_matrixCache.get(_draw.m_startMatrix);
 						_renderer->setShaderUniform4x4f(flags
 							, predefined.m_loc
 							, model.un.val
@@ -255,14 +262,23 @@ namespace bgfx
 				case PredefinedUniform::ModelView:
 					{
 						Matrix4 modelView;
-						const Matrix4& model = frameCache.m_matrixCache.m_cache[_draw.m_startMatrix];
-						bx::float4x4_mul(&modelView.un.f4x4
-							, &model.un.f4x4
-							, &m_view[_eye][_view].un.f4x4
-							);
+						const Matrix4* mtx = &modelView;
+						if (precomputed)
+						{
+							mtx = &_frame->m_modelView[_item];
+						}
+						else
+						{
+							const Matrix4& model = frameCache.m_matrixCache.get(_draw.m_startMatrix);
+							bx::float4x4_mul(&modelView.un.f4x4
+								, &model.un.f4x4
+								, &m_view[_eye][_view].un.f4x4
+								);
+						}
+
 						_renderer->setShaderUniform4x4f(flags
 							, predefined.m_loc
-							, modelView.un.val
+							, mtx->un.val
 							, bx::uint32_min(mtxRegs, predefined.m_count)
 							);
 					}
@@ -271,14 +287,23 @@ namespace bgfx
 				case PredefinedUniform::ModelViewProj:
 					{
 						Matrix4 modelViewProj;
-						const Matrix4& model = frameCache.m_matrixCache.m_cache[_draw.m_startMatrix];
-						bx::float4x4_mul(&modelViewProj.un.f4x4
-							, &model.un.f4x4
-							, &m_viewProj[_eye][_view].un.f4x4
-							);
+						const Matrix4* mtx = &modelViewProj;
+						if (precomputed)
+						{
+							mtx = &_frame->m_modelViewProj[_item];
+						}
+						else
+						{
+							const Matrix4& model = frameCache.m_matrixCache.get(_draw.m_startMatrix);
+							bx::float4x4_mul(&modelViewProj.un.f4x4
+								, &model.un.f4x4
+								, &m_viewProj[_eye][_view].un.f4x4
+								);
+						}
+
 						_renderer->setShaderUniform4x4f(flags
 							, predefined.m_loc
-							, modelViewProj.un.val
+							, mtx->un.val
 							, bx::uint32_min(mtxRegs, predefined.m_count)
 							);
 					}
@@ -318,6 +343,11 @@ namespace bgfx
 	class StateCacheLru
 	{
 	public:
+		StateCacheLru()
+			: m_hashMap(g_allocator)
+		{
+		}
+
 		Ty* add(uint64_t _key, const Ty& _value, uint16_t _parent)
 		{
 			uint16_t handle = m_alloc.alloc();
@@ -334,17 +364,17 @@ namespace bgfx
 			data.m_hash   = _key;
 			data.m_value  = _value;
 			data.m_parent = _parent;
-			m_hashMap.insert(stl::make_pair(_key, handle) );
+			m_hashMap.insert(_key, handle);
 
 			return &m_data[handle].m_value;
 		}
 
 		Ty* find(uint64_t _key)
 		{
-			HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			const uint16_t* value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				uint16_t handle = it->second;
+				uint16_t handle = *value;
 				m_alloc.touch(handle);
 				return &m_data[handle].m_value;
 			}
@@ -354,12 +384,12 @@ namespace bgfx
 
 		void invalidate(uint64_t _key)
 		{
-			HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			const uint16_t* value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				uint16_t handle = it->second;
+				uint16_t handle = *value;
 				m_alloc.free(handle);
-				m_hashMap.erase(it);
+				m_hashMap.remove(_key);
 				release(m_data[handle].m_value);
 			}
 		}
@@ -370,7 +400,7 @@ namespace bgfx
 			{
 				m_alloc.free(_handle);
 				Data& data = m_data[_handle];
-				m_hashMap.erase(m_hashMap.find(data.m_hash) );
+				m_hashMap.remove(data.m_hash);
 				release(data.m_value);
 			}
 		}
@@ -385,7 +415,7 @@ namespace bgfx
 				if (data.m_parent == _parent)
 				{
 					m_alloc.free(handle);
-					m_hashMap.erase(m_hashMap.find(data.m_hash) );
+					m_hashMap.remove(data.m_hash);
 					release(data.m_value);
 				}
 				else
@@ -404,17 +434,17 @@ namespace bgfx
 				release(data.m_value);
 			}
 
-			m_hashMap.clear();
+			m_hashMap.reset();
 			m_alloc.reset();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_hashMap.getNumElements();
 		}
 
 	private:
-		typedef stl::unordered_map<uint64_t, uint16_t> HashMap;
+		typedef bx::HashMapT<uint64_t, uint16_t> HashMap;
 		HashMap m_hashMap;
 		bx::HandleAllocLruT<MaxHandleT> m_alloc;
 		struct Data
@@ -430,18 +460,22 @@ namespace bgfx
 	class StateCache
 	{
 	public:
+		StateCache()
+			: m_hashMap(g_allocator)
+		{
+		}
+
 		void add(uint64_t _key, uint16_t _value)
 		{
-			invalidate(_key);
-			m_hashMap.insert(stl::make_pair(_key, _value) );
+			m_hashMap.insert(_key, _value);
 		}
 
 		uint16_t find(uint64_t _key)
 		{
-			HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			const uint16_t* value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				return it->second;
+				return *value;
 			}
 
 			return UINT16_MAX;
@@ -449,28 +483,54 @@ namespace bgfx
 
 		void invalidate(uint64_t _key)
 		{
-			HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
-			{
-				m_hashMap.erase(it);
-			}
+			m_hashMap.remove(_key);
 		}
 
 		void invalidate()
 		{
-			m_hashMap.clear();
+			m_hashMap.reset();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_hashMap.getNumElements();
 		}
 
 	private:
-		typedef stl::unordered_map<uint64_t, uint16_t> HashMap;
+		typedef bx::HashMapT<uint64_t, uint16_t> HashMap;
 		HashMap m_hashMap;
 	};
 
+	/// Returns number of draw calls backend scratch buffer must hold for frame with `_numDrawCalls`.
+	/// Returns `_capacity` when it's already large enough, otherwise grows it geometrically, up
+	/// to maxDrawCalls, and to what `_sizePerDrawCall` bytes per draw call can address with 32-bit
+	/// offsets.
+	inline uint32_t scratchBufferCapacity(uint32_t _capacity, uint32_t _numDrawCalls, uint32_t _sizePerDrawCall)
+	{
+		if (_numDrawCalls <= _capacity)
+		{
+			return _capacity;
+		}
+
+		const uint64_t maxCapacity = bx::min<uint64_t>(g_caps.limits.maxDrawCalls, UINT32_MAX/_sizePerDrawCall);
+		const uint64_t capacity    = bx::max<uint64_t>(_numDrawCalls, uint64_t(_capacity)*2);
+		BX_WARN(_numDrawCalls <= maxCapacity
+			, "Scratch buffer can't hold %d draw calls (max: %d)."
+			, _numDrawCalls
+			, uint32_t(maxCapacity)
+			);
+
+		return uint32_t(bx::min(capacity, maxCapacity) );
+	}
+
+	/// Size in bytes of scratch buffer holding `_capacity` draw calls.
+	inline uint32_t scratchBufferSize(uint32_t _capacity, uint32_t _sizePerDrawCall)
+	{
+		const uint64_t size = uint64_t(_capacity)*_sizePerDrawCall;
+		BX_CHECK(size <= UINT32_MAX, "Scratch buffer size overflow.");
+		return uint32_t(size);
+	}
+
 	inline bool hasVertexStreamChanged(const RenderDraw& _current, const RenderDraw& _new)
 	{
 		if (_current.m_streamMask             != _new.m_streamMask
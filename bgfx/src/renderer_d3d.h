@@ -178,10 +178,15 @@ namespace bgfx
 	class StateCacheT
 	{
 	public:
+		StateCacheT()
+			: m_hashMap(g_allocator)
+		{
+		}
+
 		void add(uint64_t _key, Ty* _value)
 		{
 			invalidate(_key);
-			m_hashMap.insert(stl::make_pair(_key, _value) );
+			m_hashMap.insert(_key, _value);
 			BX_CHECK(isGraphicsDebuggerPresent()
 				|| 1 == getRefCount(_value), "Interface ref count %d, hash %" PRIx64 "."
 				, getRefCount(_value)
@@ -191,10 +196,10 @@ namespace bgfx
 
 		Ty* find(uint64_t _key)
 		{
-			typename HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			Ty** value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				return it->second;
+				return *value;
 			}
 
 			return NULL;
@@ -202,32 +207,32 @@ namespace bgfx
 
 		void invalidate(uint64_t _key)
 		{
-			typename HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			Ty** value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				DX_RELEASE_W(it->second, 0);
-				m_hashMap.erase(it);
+				DX_RELEASE_W(*value, 0);
+				m_hashMap.remove(_key);
 			}
 		}
 
 		void invalidate()
 		{
-			for (typename HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			for (typename HashMap::Iterator it = m_hashMap.first(); m_hashMap.next(it); )
 			{
-				DX_CHECK_REFCOUNT(it->second, 1);
-				it->second->Release();
+				DX_CHECK_REFCOUNT(*it.value, 1);
+				(*it.value)->Release();
 			}
 
-			m_hashMap.clear();
+			m_hashMap.reset();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_hashMap.getNumElements();
 		}
 
 	private:
-		typedef stl::unordered_map<uint64_t, Ty*> HashMap;
+		typedef bx::HashMapT<uint64_t, Ty*> HashMap;
 		HashMap m_hashMap;
 	};
 
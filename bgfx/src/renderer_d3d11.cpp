@@ -5300,6 +5300,10 @@ namespace bgfx { namespace d3d11
 			uint8_t restartState = 0;
 			viewState.m_rect = _render->m_view[0].m_rect;
 
+			// Sorted item index at which precomputed draw changes can be used, i.e.
+			// previous item's state is fully applied.
+			int32_t diffItem = -1;
+
 			int32_t numItems = _render->m_numRenderItems;
 			for (int32_t item = 0, restartItem = numItems; item < numItems || restartItem < numItems;)
 			{
@@ -5313,8 +5317,8 @@ namespace bgfx { namespace d3d11
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -5592,6 +5596,12 @@ namespace bgfx { namespace d3d11
 
 				const RenderDraw& draw = renderItem.draw;
 
+				const uint8_t drawChanged = !resetState && diffItem == item-1
+					? _render->m_drawChanged[item-1]
+					: BGFX_DRAW_CHANGED_ALL
+					;
+				diffItem = -1;
+
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
 					const bool occluded = true
@@ -5794,7 +5804,7 @@ namespace bgfx { namespace d3d11
 						}
 					}
 
-					viewState.setPredefined<4>(this, view, eye, program, _render, draw);
+					viewState.setPredefined<4>(this, view, eye, program, _render, draw, item-1);
 
 					if (constantsChanged
 					||  program.m_numPredefined > 0)
@@ -5803,6 +5813,8 @@ namespace bgfx { namespace d3d11
 					}
 				}
 
+				if (programChanged
+				||  0 != (drawChanged & BGFX_DRAW_CHANGED_BINDINGS) )
 				{
 					uint32_t changes = 0;
 					for (uint8_t stage = 0; stage < maxTextureSamplers; ++stage)
@@ -5856,7 +5868,8 @@ namespace bgfx { namespace d3d11
 					}
 				}
 
-				bool vertexStreamChanged = hasVertexStreamChanged(currentState, draw);
+				const bool streamsChanged = 0 != (drawChanged & BGFX_DRAW_CHANGED_STREAMS);
+				bool vertexStreamChanged = streamsChanged && hasVertexStreamChanged(currentState, draw);
 
 				if (programChanged
 				||  vertexStreamChanged)
@@ -5944,7 +5957,8 @@ namespace bgfx { namespace d3d11
 					}
 				}
 
-				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+				if (streamsChanged
+				&&  currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
 				{
 					currentState.m_indexBuffer = draw.m_indexBuffer;
 
@@ -5963,6 +5977,8 @@ namespace bgfx { namespace d3d11
 					}
 				}
 
+				diffItem = item;
+
 				if (0 != currentState.m_streamMask)
 				{
 					uint32_t numVertices       = currentState.m_numVertices;
@@ -44,6 +44,9 @@ namespace bgfx { namespace d3d12
 	};
 	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_primInfo)-1);
 
+	/// Scratch buffer space reserved for constants of each draw call.
+	static const uint32_t s_scratchBufferDrawCallSize = 1024;
+
 	static const uint32_t s_checkMsaa[] =
 	{
 		0,
@@ -1061,8 +1064,9 @@ namespace bgfx { namespace d3d12
 
 				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 				{
-					m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
-						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+					m_scratchBufferCapacity[ii] = scratchBufferCapacity(0, BGFX_CONFIG_SCRATCH_BUFFER_DRAW_CALLS, s_scratchBufferDrawCallSize);
+					m_scratchBuffer[ii].create(scratchBufferSize(m_scratchBufferCapacity[ii], s_scratchBufferDrawCallSize)
+						, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + m_scratchBufferCapacity[ii]
 						);
 				}
 				m_samplerAllocator.create(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
@@ -3253,6 +3257,7 @@ namespace bgfx { namespace d3d12
 		ID3D12Resource* m_backBufferDepthStencil;
 
 		ScratchBufferD3D12 m_scratchBuffer[BGFX_CONFIG_MAX_BACK_BUFFERS];
+		uint32_t m_scratchBufferCapacity[BGFX_CONFIG_MAX_BACK_BUFFERS];
 		DescriptorAllocatorD3D12 m_samplerAllocator;
 
 		ID3D12RootSignature*    m_rootSignature;
@@ -3334,7 +3339,7 @@ namespace bgfx { namespace d3d12
 			, (void**)&m_heap
 			) );
 
-		m_upload = createCommittedResource(device, HeapProperty::Upload, desc.NumDescriptors * 1024);
+		m_upload = createCommittedResource(device, HeapProperty::Upload, _size);
 		m_gpuVA  = m_upload->GetGPUVirtualAddress();
 		D3D12_RANGE readRange = { 0, 0 };
 		m_upload->Map(0, &readRange, (void**)&m_data);
@@ -5712,6 +5717,24 @@ namespace bgfx { namespace d3d12
 
 		D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle;
 		ScratchBufferD3D12& scratchBuffer = m_scratchBuffer[m_backBufferColorIdx];
+
+		{
+			// Clear quad per view, and debug text blit, need scratch space too.
+			const uint32_t numDrawCalls = _render->m_numRenderItems + BGFX_CONFIG_MAX_VIEWS + 1;
+			uint32_t& capacity = m_scratchBufferCapacity[m_backBufferColorIdx];
+			const uint32_t newCapacity = scratchBufferCapacity(capacity, numDrawCalls, s_scratchBufferDrawCallSize);
+
+			if (newCapacity != capacity)
+			{
+				finishAll(true);
+				scratchBuffer.destroy();
+				scratchBuffer.create(scratchBufferSize(newCapacity, s_scratchBufferDrawCallSize)
+					, BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + newCapacity
+					);
+				capacity = newCapacity;
+			}
+		}
+
 		scratchBuffer.reset(gpuHandle);
 
 		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = UINT64_C(0);
@@ -5751,6 +5774,10 @@ namespace bgfx { namespace d3d12
 // 			uint8_t restartState = 0;
 			viewState.m_rect = _render->m_view[0].m_rect;
 
+			// Sorted item index at which precomputed draw changes can be used, i.e.
+			// previous item's state is fully applied.
+			int32_t diffItem = -1;
+
 			int32_t numItems = _render->m_numRenderItems;
 			for (int32_t item = 0, restartItem = numItems; item < numItems || restartItem < numItems;)
 			{
@@ -5764,8 +5791,8 @@ namespace bgfx { namespace d3d12
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -6034,6 +6061,12 @@ namespace bgfx { namespace d3d12
 
 				const RenderDraw& draw = renderItem.draw;
 
+				const uint8_t drawChanged = !resetState && diffItem == item-1
+					? _render->m_drawChanged[item-1]
+					: BGFX_DRAW_CHANGED_ALL
+					;
+				diffItem = -1;
+
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
 					const bool occluded = true
@@ -6163,7 +6196,10 @@ namespace bgfx { namespace d3d12
 							);
 
 					uint16_t scissor = draw.m_scissor;
-					uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
+					const uint32_t bindHash = 0 == (drawChanged & BGFX_DRAW_CHANGED_BINDINGS) && 0 != currentBindHash
+						? currentBindHash
+						: bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) )
+						;
 					if (currentBindHash != bindHash
 					||  0 != changedStencil
 					|| (hasFactor && blendFactor != draw.m_rgba)
@@ -6379,10 +6415,12 @@ namespace bgfx { namespace d3d12
 						ProgramD3D12& program = m_program[currentProgramIdx];
 						uint32_t ref = (newFlags&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT;
 						viewState.m_alphaRef = ref/255.0f;
-						viewState.setPredefined<4>(this, view, 0, program, _render, draw);
+						viewState.setPredefined<4>(this, view, 0, program, _render, draw, item-1);
 						commitShaderConstants(key.m_program, gpuAddress);
 					}
 
+					diffItem = item;
+
 					uint32_t numIndices        = m_batch.draw(m_commandList, gpuAddress, draw);
 					uint32_t numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
 					uint32_t numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
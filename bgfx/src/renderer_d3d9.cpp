@@ -3796,8 +3796,8 @@ namespace bgfx { namespace d3d9
 				}
 
 				const uint32_t itemIdx = _render->m_sortValues[item];
-				const RenderDraw& draw = _render->m_renderItem[itemIdx].draw;
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderDraw& draw = _render->getRenderItem(itemIdx).draw;
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
@@ -4153,7 +4153,7 @@ namespace bgfx { namespace d3d9
 						}
 					}
 
-					viewState.setPredefined<4>(this, view, 0, program, _render, draw);
+					viewState.setPredefined<4>(this, view, 0, program, _render, draw, item);
 				}
 
 				{
@@ -1766,6 +1766,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 			m_fbh.idx = kInvalidHandle;
 			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			m_uniformGeneration = 0;
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			setRenderContextSize(_init.resolution.width, _init.resolution.height);
@@ -2904,6 +2905,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
+			++m_uniformGeneration;
 		}
 
 		void destroyUniform(UniformHandle _handle) override
@@ -2967,6 +2969,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
 			bx::memCopy(m_uniforms[_loc], _data, _size);
+			++m_uniformGeneration;
 		}
 
 		void setMarker(const char* _marker, uint32_t _size) override
@@ -3830,6 +3833,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		FrameBufferGL m_frameBuffers[BGFX_CONFIG_MAX_FRAME_BUFFERS];
 		UniformRegistry m_uniformReg;
 		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		uint64_t m_uniformGeneration; // Incremented on each uniform update.
 
 		TimerQueryGL m_gpuTimer;
 		OcclusionQueryGL m_occlusionQuery;
@@ -4085,6 +4089,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 	void ProgramGL::create(const ShaderGL& _vsh, const ShaderGL& _fsh)
 	{
 		m_id = glCreateProgram();
+		m_uniformGeneration = UINT64_MAX;
 		BX_TRACE("Program create: GL%d: GL%d, GL%d", m_id, _vsh.m_id, _fsh.m_id);
 
 		const uint64_t id = (uint64_t(_vsh.m_hash)<<32) | _fsh.m_hash;
@@ -6403,6 +6408,10 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			uint8_t restartState = 0;
 			viewState.m_rect = _render->m_view[0].m_rect;
 
+			// Sorted item index at which precomputed draw changes can be used, i.e.
+			// previous item's state is fully applied.
+			int32_t diffItem = -1;
+
 			int32_t numItems = _render->m_numRenderItems;
 			for (int32_t item = 0, restartItem = numItems; item < numItems || restartItem < numItems;)
 			{
@@ -6416,8 +6425,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -6664,6 +6673,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				const RenderDraw& draw = renderItem.draw;
 
+				const uint8_t drawChanged = !resetState && diffItem == item-1
+					? _render->m_drawChanged[item-1]
+					: BGFX_DRAW_CHANGED_ALL
+					;
+				diffItem = -1;
+
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
 					const bool occluded = true
@@ -7046,14 +7061,20 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				{
 					ProgramGL& program = m_program[programIdx];
 
+					// GL program keeps uniform values, commit only if any uniform was updated
+					// since program's constants were committed last time.
 					if (constantsChanged
-					&&  NULL != program.m_constantBuffer)
+					&&  NULL != program.m_constantBuffer
+					&&  program.m_uniformGeneration != m_uniformGeneration)
 					{
 						commit(*program.m_constantBuffer);
+						program.m_uniformGeneration = m_uniformGeneration;
 					}
 
-					viewState.setPredefined<1>(this, view, eye, program, _render, draw);
+					viewState.setPredefined<1>(this, view, eye, program, _render, draw, item-1);
 
+					if (programChanged
+					||  0 != (drawChanged & BGFX_DRAW_CHANGED_BINDINGS) )
 					{
 						for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 						{
@@ -7097,28 +7118,34 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					}
 
 					{
+						const bool streamsChanged = 0 != (drawChanged & BGFX_DRAW_CHANGED_STREAMS);
+
 						bool diffStreamHandles = false;
-						for (uint32_t idx = 0, streamMask = draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
-							; 0 != streamMask
-							; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
-							)
+						if (streamsChanged)
 						{
-							streamMask >>= ntz;
-							idx         += ntz;
-
-							if (currentState.m_stream[idx].m_handle.idx != draw.m_stream[idx].m_handle.idx)
+							for (uint32_t idx = 0, streamMask = draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
+								; 0 != streamMask
+								; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
+								)
 							{
-								diffStreamHandles = true;
-								break;
+								streamMask >>= ntz;
+								idx         += ntz;
+
+								if (currentState.m_stream[idx].m_handle.idx != draw.m_stream[idx].m_handle.idx)
+								{
+									diffStreamHandles = true;
+									break;
+								}
 							}
 						}
 
 						if (programChanged
-						||  currentState.m_streamMask             != draw.m_streamMask
+						|| (streamsChanged
+						&& (currentState.m_streamMask             != draw.m_streamMask
 						||  currentState.m_instanceDataBuffer.idx != draw.m_instanceDataBuffer.idx
 						||  currentState.m_instanceDataOffset     != draw.m_instanceDataOffset
 						||  currentState.m_instanceDataStride     != draw.m_instanceDataStride
-						||  diffStreamHandles)
+						||  diffStreamHandles) ) )
 						{
 							currentState.m_streamMask             = draw.m_streamMask;
 							currentState.m_instanceDataBuffer.idx = draw.m_instanceDataBuffer.idx;
@@ -7139,7 +7166,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							bindAttribs = true;
 						}
 
-						if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+						if (streamsChanged
+						&&  currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
 						{
 							currentState.m_indexBuffer = draw.m_indexBuffer;
 
@@ -7158,7 +7186,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 						if (0 != currentState.m_streamMask)
 						{
 							bool diffStartVertex = false;
-							for (uint32_t idx = 0, streamMask = draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
+							for (uint32_t idx = 0, streamMask = streamsChanged ? draw.m_streamMask : 0, ntz = bx::uint32_cnttz(streamMask)
 								; 0 != streamMask
 								; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
 								)
@@ -7215,6 +7243,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 						}
 					}
 
+					diffItem = item;
+
 					if (0 != currentState.m_streamMask)
 					{
 						uint32_t numVertices = draw.m_numVertices;
@@ -1078,6 +1078,11 @@ namespace bgfx { namespace gl
 	class SamplerStateCache
 	{
 	public:
+		SamplerStateCache()
+			: m_hashMap(g_allocator)
+		{
+		}
+
 		GLuint add(uint32_t _hash)
 		{
 			invalidate(_hash);
@@ -1085,17 +1090,17 @@ namespace bgfx { namespace gl
 			GLuint samplerId;
 			GL_CHECK(glGenSamplers(1, &samplerId) );
 
-			m_hashMap.insert(stl::make_pair(_hash, samplerId) );
+			m_hashMap.insert(_hash, samplerId);
 
 			return samplerId;
 		}
 
 		GLuint find(uint32_t _hash)
 		{
-			HashMap::iterator it = m_hashMap.find(_hash);
-			if (it != m_hashMap.end() )
+			const GLuint* value = m_hashMap.find(_hash);
+			if (NULL != value)
 			{
-				return it->second;
+				return *value;
 			}
 
 			return UINT32_MAX;
@@ -1103,30 +1108,30 @@ namespace bgfx { namespace gl
 
 		void invalidate(uint32_t _hash)
 		{
-			HashMap::iterator it = m_hashMap.find(_hash);
-			if (it != m_hashMap.end() )
+			GLuint* value = m_hashMap.find(_hash);
+			if (NULL != value)
 			{
-				GL_CHECK(glDeleteSamplers(1, &it->second) );
-				m_hashMap.erase(it);
+				GL_CHECK(glDeleteSamplers(1, value) );
+				m_hashMap.remove(_hash);
 			}
 		}
 
 		void invalidate()
 		{
-			for (HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			for (HashMap::Iterator it = m_hashMap.first(); m_hashMap.next(it); )
 			{
-				GL_CHECK(glDeleteSamplers(1, &it->second) );
+				GL_CHECK(glDeleteSamplers(1, it.value) );
 			}
-			m_hashMap.clear();
+			m_hashMap.reset();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_hashMap.getNumElements();
 		}
 
 	private:
-		typedef stl::unordered_map<uint32_t, GLuint> HashMap;
+		typedef bx::HashMapT<uint32_t, GLuint> HashMap;
 		HashMap m_hashMap;
 	};
 
@@ -1322,6 +1327,7 @@ namespace bgfx { namespace gl
 			: m_id(0)
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
+			, m_uniformGeneration(UINT64_MAX)
 		{
 		}
 
@@ -1367,6 +1373,7 @@ namespace bgfx { namespace gl
 		UniformBuffer* m_constantBuffer;
 		PredefinedUniform m_predefined[PredefinedUniform::Count];
 		uint8_t m_numPredefined;
+		uint64_t m_uniformGeneration;
 	};
 
 	struct TimerQueryGL
@@ -661,18 +661,23 @@ namespace bgfx { namespace mtl
 	class StateCacheT
 	{
 	public:
+		StateCacheT()
+			: m_hashMap(g_allocator)
+		{
+		}
+
 		void add(uint64_t _id, Ty _item)
 		{
 			invalidate(_id);
-			m_hashMap.insert(stl::make_pair(_id, _item) );
+			m_hashMap.insert(_id, _item);
 		}
 
 		Ty find(uint64_t _id)
 		{
-			typename HashMap::iterator it = m_hashMap.find(_id);
-			if (it != m_hashMap.end() )
+			Ty* value = m_hashMap.find(_id);
+			if (NULL != value)
 			{
-				return it->second;
+				return *value;
 			}
 
 			return NULL;
@@ -680,31 +685,31 @@ namespace bgfx { namespace mtl
 
 		void invalidate(uint64_t _id)
 		{
-			typename HashMap::iterator it = m_hashMap.find(_id);
-			if (it != m_hashMap.end() )
+			Ty* value = m_hashMap.find(_id);
+			if (NULL != value)
 			{
-				MTL_RELEASE(it->second);
-				m_hashMap.erase(it);
+				MTL_RELEASE(*value);
+				m_hashMap.remove(_id);
 			}
 		}
 
 		void invalidate()
 		{
-			for (typename HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			for (typename HashMap::Iterator it = m_hashMap.first(); m_hashMap.next(it); )
 			{
-				release(it->second);
+				release(*it.value);
 			}
 
-			m_hashMap.clear();
+			m_hashMap.reset();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_hashMap.getNumElements();
 		}
 
 	private:
-		typedef stl::unordered_map<uint64_t, Ty> HashMap;
+		typedef bx::HashMapT<uint64_t, Ty> HashMap;
 		HashMap m_hashMap;
 	};
 
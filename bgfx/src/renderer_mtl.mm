@@ -3409,6 +3409,10 @@ namespace bgfx { namespace mtl
 			uint8_t restartState = 0;
 			viewState.m_rect = _render->m_view[0].m_rect;
 
+			// Sorted item index at which precomputed draw changes can be used, i.e.
+			// previous item's state is fully applied.
+			int32_t diffItem = -1;
+
 			int32_t numItems = _render->m_numRenderItems;
 			for (int32_t item = 0, restartItem = numItems; item < numItems || restartItem < numItems;)
 			{
@@ -3422,8 +3426,8 @@ namespace bgfx { namespace mtl
 					;
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+				const RenderBind& renderBind = _render->getRenderItemBind(itemIdx);
 				++item;
 
 				if (viewChanged)
@@ -3650,6 +3654,12 @@ namespace bgfx { namespace mtl
 
 				const RenderDraw& draw = renderItem.draw;
 
+				const uint8_t drawChanged = !resetState && diffItem == item-1
+					? _render->m_drawChanged[item-1]
+					: BGFX_DRAW_CHANGED_ALL
+					;
+				diffItem = -1;
+
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
 					const bool occluded = true
@@ -3793,7 +3803,10 @@ namespace bgfx { namespace mtl
 				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
 				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
-				bool vertexStreamChanged = hasVertexStreamChanged(currentState, draw);
+				bool vertexStreamChanged = true
+					&& 0 != (drawChanged & BGFX_DRAW_CHANGED_STREAMS)
+					&& hasVertexStreamChanged(currentState, draw)
+					;
 
 				if (key.m_program != programIdx
 				||  vertexStreamChanged
@@ -3931,13 +3944,14 @@ namespace bgfx { namespace mtl
 						}
 					}
 
-					viewState.setPredefined<4>(this, view, eye, program, _render, draw);
+					viewState.setPredefined<4>(this, view, eye, program, _render, draw, item-1);
 
 					m_uniformBufferFragmentOffset += fragmentUniformBufferSize;
 					m_uniformBufferVertexOffset = m_uniformBufferFragmentOffset;
 				}
 
-				if (kInvalidHandle != programIdx)
+				if (kInvalidHandle != programIdx
+				&& (programChanged || 0 != (drawChanged & BGFX_DRAW_CHANGED_BINDINGS) ) )
 				{
 					ProgramMtl& program = m_program[programIdx];
 
@@ -3970,6 +3984,8 @@ namespace bgfx { namespace mtl
 					}
 				}
 
+				diffItem = item;
+
 				if (0 != currentState.m_streamMask)
 				{
 					uint32_t numVertices = draw.m_numVertices;
@@ -7,6 +7,29 @@
 
 namespace bgfx { namespace noop
 {
+	struct RecordJob
+	{
+		static void execute(void* _userData, uint32_t _idx)
+		{
+			RecordJob& job = *(RecordJob*)_userData;
+			const RenderItemRange& range = job.m_range[_idx];
+
+			uint32_t numCompute = 0;
+			for (uint32_t ii = range.m_begin; ii < range.m_end; ++ii)
+			{
+				numCompute += 0 == (job.m_frame->m_sortKeys[ii] & SORT_KEY_DRAW_BIT);
+			}
+
+			job.m_numItems[_idx]   = range.m_end - range.m_begin;
+			job.m_numCompute[_idx] = numCompute;
+		}
+
+		const Frame* m_frame;
+		const RenderItemRange* m_range;
+		uint32_t m_numItems[BGFX_CONFIG_MAX_RECORD_RANGES];
+		uint32_t m_numCompute[BGFX_CONFIG_MAX_RECORD_RANGES];
+	};
+
 	struct RendererContextNOOP : public RendererContextI
 	{
 		RendererContextNOOP()
@@ -245,9 +268,41 @@ namespace bgfx { namespace noop
 
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
 			perfStats.cpuTimerFreq  = timerFreq;
 
+			// Sort also computes per-draw change masks (Frame::diffRenderItems) consumed by
+			// all backends, run it here so that its cost can be measured without GPU.
+			_render->sort();
+			perfStats.cpuTimeEnd    = bx::getHPCounter();
+
+			// Split and process sorted render items the same way as backends recording them on
+			// multiple threads, so that splitting can be tested without GPU.
+			RenderItemRange range[BGFX_CONFIG_MAX_RECORD_RANGES];
+			const uint32_t maxRanges = bx::min<uint32_t>(BGFX_CONFIG_MAX_RECORD_RANGES, rendererGetNumThreads()*2);
+			const uint32_t numRanges = _render->splitRenderItems(range, maxRanges, BGFX_CONFIG_RECORD_PARALLEL_MIN_ITEMS);
+
+			_render->gatherUniformStates(m_uniformState, range, numRanges);
+
+			RecordJob job;
+			job.m_frame = _render;
+			job.m_range = range;
+			rendererRunJobs(RecordJob::execute, &job, numRanges);
+
+			uint32_t numItems   = 0;
+			uint32_t numCompute = 0;
+			for (uint32_t ii = 0; ii < numRanges; ++ii)
+			{
+				BX_CHECK(range[ii].m_begin == (0 == ii ? 0 : range[ii-1].m_end), "Ranges must be contiguous.");
+				numItems   += job.m_numItems[ii];
+				numCompute += job.m_numCompute[ii];
+			}
+
+			BX_CHECK(numItems == _render->m_numRenderItems, "Ranges must cover all render items.");
+
+			perfStats.numDraw       = numItems - numCompute;
+			perfStats.numCompute    = numCompute;
+			perfStats.numBlit       = _render->m_numBlitItems;
+
 			perfStats.gpuTimeBegin  = 0;
 			perfStats.gpuTimeEnd    = 0;
 			perfStats.gpuTimerFreq  = 1000000000;
@@ -265,6 +320,8 @@ namespace bgfx { namespace noop
 		void blitRender(TextVideoMemBlitter& /*_blitter*/, uint32_t /*_numIndices*/) override
 		{
 		}
+
+		UniformState m_uniformState[BGFX_CONFIG_MAX_RECORD_RANGES+1];
 	};
 
 	static RendererContextNOOP* s_renderNOOP;
@@ -31,6 +31,9 @@ namespace bgfx { namespace vk
 	};
 	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_primInfo)-1);
 
+	/// Scratch buffer space reserved for uniforms of each draw call.
+	static const uint32_t s_scratchBufferDrawCallSize = 1024;
+
 	static const uint32_t s_checkMsaa[] =
 	{
 		0,
@@ -1692,6 +1695,25 @@ VK_IMPORT_DEVICE
 				finishAll();
 
 				VK_CHECK(vkResetCommandPool(m_device, m_commandPool, 0) );
+
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_recorder) && VK_SUCCESS == result; ++ii)
+				{
+					result = m_recorder[ii].create();
+				}
+
+				if (VK_SUCCESS != result)
+				{
+					for (uint32_t ii = 0; ii < BX_COUNTOF(m_recorder); ++ii)
+					{
+						m_recorder[ii].destroy();
+					}
+
+					vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
+					vkDestroy(m_commandPool);
+					vkDestroy(m_fence);
+					BX_TRACE("Init error: Creating command recorders failed %d: %s.", result, getName(result) );
+					goto error;
+				}
 			}
 
 			errorState = ErrorState::CommandBuffersCreated;
@@ -1774,7 +1796,8 @@ VK_IMPORT_DEVICE
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 			{
-				m_scratchBuffer[ii].create(BGFX_CONFIG_MAX_DRAW_CALLS*1024
+				m_scratchBufferCapacity[ii] = scratchBufferCapacity(0, BGFX_CONFIG_SCRATCH_BUFFER_DRAW_CALLS, s_scratchBufferDrawCallSize);
+				m_scratchBuffer[ii].create(scratchBufferSize(m_scratchBufferCapacity[ii], s_scratchBufferDrawCallSize)
 					, 1024 //BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
 					);
 			}
@@ -1795,6 +1818,11 @@ VK_IMPORT_DEVICE
 				BX_FALLTHROUGH;
 
 			case ErrorState::CommandBuffersCreated:
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_recorder); ++ii)
+				{
+					m_recorder[ii].destroy();
+				}
+
 				vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
 				vkDestroy(m_commandPool);
 				vkDestroy(m_fence);
@@ -1899,6 +1927,11 @@ VK_IMPORT_DEVICE
 			vkDestroy(m_descriptorSetLayout);
 			vkDestroy(m_descriptorPool);
 
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_recorder); ++ii)
+			{
+				m_recorder[ii].destroy();
+			}
+
 			vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
 			vkDestroy(m_commandPool);
 			vkDestroy(m_fence);
@@ -2164,6 +2197,9 @@ VK_IMPORT_DEVICE
 
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
+		/// Clears view that has no draws, views with draws are cleared by recorders.
+		void clearView(const Frame* _render, uint16_t _view, const VkRenderPassBeginInfo& _rpbi);
+
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
 
 		void blitSetup(TextVideoMemBlitter& /*_blitter*/) override
@@ -2253,68 +2289,6 @@ VK_IMPORT_DEVICE
 			}
 		}
 
-		void setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
-		{
-			BX_UNUSED(_flags, _regIndex, _val, _numRegs);
-			if (_flags&BGFX_UNIFORM_FRAGMENTBIT)
-			{
-				bx::memCopy(&m_fsScratch[_regIndex], _val, _numRegs*16);
-				m_fsChanges += _numRegs;
-			}
-			else
-			{
-				bx::memCopy(&m_vsScratch[_regIndex], _val, _numRegs*16);
-				m_vsChanges += _numRegs;
-			}
-		}
-
-		void setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
-		{
-			setShaderUniform(_flags, _regIndex, _val, _numRegs);
-		}
-
-		void setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
-		{
-			setShaderUniform(_flags, _regIndex, _val, _numRegs);
-		}
-
-		void commitShaderUniforms(VkCommandBuffer _commandBuffer, uint16_t _programIdx)
-		{
-			const ProgramVK& program = m_program[_programIdx];
-			VkDescriptorBufferInfo descriptorBufferInfo;
-			uint32_t total = 0
-				+ program.m_vsh->m_size
-				+ (NULL != program.m_fsh ? program.m_fsh->m_size : 0)
-				;
-			if (0 < total)
-			{
-				uint8_t* data = (uint8_t*)m_scratchBuffer[m_backBufferColorIdx].allocUbv(descriptorBufferInfo, total);
-
-				uint32_t size = program.m_vsh->m_size;
-				bx::memCopy(data, m_vsScratch, size);
-				data += size;
-
-				if (NULL != program.m_fsh)
-				{
-					bx::memCopy(data, m_fsScratch, program.m_fsh->m_size);
-				}
-
-				vkCmdBindDescriptorSets(_commandBuffer
-					, VK_PIPELINE_BIND_POINT_GRAPHICS
-					, m_pipelineLayout
-					, 0
-					, 1
-					, &m_scratchBuffer[m_backBufferColorIdx].m_descriptorSet
-						[m_scratchBuffer[m_backBufferColorIdx].m_currentDs - 1]
-					, 0
-					, NULL
-					);
-			}
-
-			m_vsChanges = 0;
-			m_fsChanges = 0;
-		}
-
 		void setFrameBuffer(FrameBufferHandle _fbh, bool _msaa = true)
 		{
 			BX_UNUSED(_msaa);
@@ -2597,7 +2571,8 @@ VK_IMPORT_DEVICE
 			return VK_NULL_HANDLE;
 		}
 
-		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint16_t _declIdx, uint16_t _programIdx, uint8_t _numInstanceData)
+		/// Thread safe.
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint16_t _declIdx, uint16_t _programIdx, uint8_t _numInstanceData, FrameBufferHandle _fbh)
 		{
 			ProgramVK& program = m_program[_programIdx];
 
@@ -2639,10 +2614,12 @@ VK_IMPORT_DEVICE
 			murmur.add(program.m_fsh->m_hash);
 			murmur.add(m_vertexDecls[_declIdx].m_hash);
 			murmur.add(decl.m_attributes, sizeof(decl.m_attributes) );
-			murmur.add(m_fbh.idx);
+			murmur.add(_fbh.idx);
 			murmur.add(_numInstanceData);
 			const uint32_t hash = murmur.end();
 
+			bx::MutexScope lock(m_pipelineLock);
+
 			VkPipeline pipeline = m_pipelineStateCache.find(hash);
 
 			if (VK_NULL_HANDLE != pipeline)
@@ -2808,87 +2785,7 @@ VK_IMPORT_DEVICE
 			return pipeline;
 		}
 
-		void commit(UniformBuffer& _uniformBuffer)
-		{
-			_uniformBuffer.reset();
-
-			for (;;)
-			{
-				uint32_t opcode = _uniformBuffer.read();
-
-				if (UniformType::End == opcode)
-				{
-					break;
-				}
-
-				UniformType::Enum type;
-				uint16_t loc;
-				uint16_t num;
-				uint16_t copy;
-				UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
-
-				const char* data;
-				if (copy)
-				{
-					data = _uniformBuffer.read(g_uniformTypeSize[type]*num);
-				}
-				else
-				{
-					UniformHandle handle;
-					bx::memCopy(&handle, _uniformBuffer.read(sizeof(UniformHandle) ), sizeof(UniformHandle) );
-					data = (const char*)m_uniforms[handle.idx];
-				}
-
-#define CASE_IMPLEMENT_UNIFORM(_uniform, _dxsuffix, _type) \
-				case UniformType::_uniform: \
-				case UniformType::_uniform|BGFX_UNIFORM_FRAGMENTBIT: \
-						{ \
-							setShaderUniform(uint8_t(type), loc, data, num); \
-						} \
-						break;
-
-				switch ( (uint32_t)type)
-				{
-				case UniformType::Mat3:
-				case UniformType::Mat3|BGFX_UNIFORM_FRAGMENTBIT:
-					 {
-						 float* value = (float*)data;
-						 for (uint32_t ii = 0, count = num/3; ii < count; ++ii,  loc += 3*16, value += 9)
-						 {
-							 Matrix4 mtx;
-							 mtx.un.val[ 0] = value[0];
-							 mtx.un.val[ 1] = value[1];
-							 mtx.un.val[ 2] = value[2];
-							 mtx.un.val[ 3] = 0.0f;
-							 mtx.un.val[ 4] = value[3];
-							 mtx.un.val[ 5] = value[4];
-							 mtx.un.val[ 6] = value[5];
-							 mtx.un.val[ 7] = 0.0f;
-							 mtx.un.val[ 8] = value[6];
-							 mtx.un.val[ 9] = value[7];
-							 mtx.un.val[10] = value[8];
-							 mtx.un.val[11] = 0.0f;
-							 setShaderUniform(uint8_t(type), loc, &mtx.un.val[0], 3);
-						 }
-					}
-					break;
-
-				CASE_IMPLEMENT_UNIFORM(Int1, I, int);
-				CASE_IMPLEMENT_UNIFORM(Vec4, F, float);
-				CASE_IMPLEMENT_UNIFORM(Mat4, F, float);
-
-				case UniformType::End:
-					break;
-
-				default:
-					BX_TRACE("%4d: INVALID 0x%08x, t %d, l %d, n %d, c %d", _uniformBuffer.getPos(), opcode, type, loc, num, copy);
-					break;
-				}
-#undef CASE_IMPLEMENT_UNIFORM
-			}
-		}
-
-		void clearQuad(const Rect& _rect, const Clear& _clear, const float _palette[][4])
+		void clearQuad(VkCommandBuffer _commandBuffer, const Rect& _rect, const Clear& _clear, const float _palette[][4])
 		{
 			VkClearRect rect[1];
 			rect[0].rect.offset.x      = _rect.m_x;
@@ -2956,7 +2853,7 @@ VK_IMPORT_DEVICE
 				++mrt;
 			}
 
- 			vkCmdClearAttachments(m_commandBuffer
+ 			vkCmdClearAttachments(_commandBuffer
 				, mrt
 				, attachments
 				, BX_COUNTOF(rect)
@@ -3036,6 +2933,7 @@ VK_IMPORT_DEVICE
 		VkImageView      m_backBufferDepthStencilImageView;
 
 		ScratchBufferVK  m_scratchBuffer[4];
+		uint32_t         m_scratchBufferCapacity[4];
 		VkSemaphore      m_presentDone[4];
 
 		uint32_t m_qfiGraphics;
@@ -3067,6 +2965,10 @@ VK_IMPORT_DEVICE
 		UniformRegistry m_uniformReg;
 
 		StateCacheT<VkPipeline> m_pipelineStateCache;
+		bx::Mutex m_pipelineLock;
+
+		CommandRecorderVK m_recorder[BGFX_CONFIG_MAX_RECORD_RANGES];
+		UniformState m_uniformState[BGFX_CONFIG_MAX_RECORD_RANGES+1];
 
 		Resolution m_resolution;
 		uint32_t m_maxAnisotropy;
@@ -3075,11 +2977,6 @@ VK_IMPORT_DEVICE
 
 		TextVideoMem m_textVideoMem;
 
-		uint8_t m_fsScratch[64<<10];
-		uint8_t m_vsScratch[64<<10];
-		uint32_t m_fsChanges;
-		uint32_t m_vsChanges;
-
 		uint32_t m_backBufferColorIdx;
 		FrameBufferHandle m_fbh;
 	};
@@ -3205,19 +3102,25 @@ VK_DESTROY
 		m_currentDs = 0;
 	}
 
-	void* ScratchBufferVK::allocUbv(VkDescriptorBufferInfo& _descriptorBufferInfo, uint32_t _size)
+	void* ScratchBufferVK::allocUbv(VkDescriptorBufferInfo& _descriptorBufferInfo, VkDescriptorSet& _outDescriptorSet, uint32_t _size)
 	{
 		uint32_t total = bx::strideAlign(_size
 			, uint32_t(s_renderVK->m_deviceProperties.limits.minUniformBufferOffsetAlignment)
 			);
+		const uint32_t pos = bx::atomicFetchAndAdd(&m_pos, total);
+		const uint32_t ds  = bx::atomicFetchAndAdd(&m_currentDs, 1u);
+		BX_CHECK(pos + total <= m_size, "Scratch buffer overflow %d (size: %d).", pos + total, m_size);
+		BX_CHECK(ds < m_maxDescriptors, "Out of scratch buffer descriptor sets (max: %d).", m_maxDescriptors);
+
 		_descriptorBufferInfo.buffer = m_buffer;
-		_descriptorBufferInfo.offset = m_pos;
+		_descriptorBufferInfo.offset = pos;
 		_descriptorBufferInfo.range  = total;
+		_outDescriptorSet = m_descriptorSet[ds];
 
 		VkWriteDescriptorSet wds[1];
 		wds[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		wds[0].pNext = NULL;
-		wds[0].dstSet     = m_descriptorSet[m_currentDs];
+		wds[0].dstSet     = _outDescriptorSet;
 		wds[0].dstBinding = DslBinding::UniformBuffer;
 		wds[0].dstArrayElement  = 0;
 		wds[0].descriptorCount  = 1;
@@ -3227,11 +3130,7 @@ VK_DESTROY
 		wds[0].pTexelBufferView = NULL;
 		vkUpdateDescriptorSets(s_renderVK->m_device, BX_COUNTOF(wds), wds, 0, NULL);
 
-		void* data = &m_data[m_pos];
-		m_pos += total;
-		++m_currentDs;
-
-		return data;
+		return &m_data[pos];
 	}
 
 	VkResult ImageVK::create(VkFormat _format, const VkExtent3D& _extent)
@@ -3640,197 +3539,358 @@ VK_DESTROY
 	{
 	}
 
-	void RendererContextVK::submitBlit(BlitState& _bs, uint16_t _view)
+	CommandRecorderVK::CommandRecorderVK()
+		: m_numCommandBuffers(0)
+		, m_commandPool(VK_NULL_HANDLE)
+		, m_pipeline(g_allocator)
+		, m_fsChanges(0)
+		, m_vsChanges(0)
 	{
-		while (_bs.hasItem(_view) )
+	}
+
+	VkResult CommandRecorderVK::create()
+	{
+		VkCommandPoolCreateInfo cpci;
+		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cpci.pNext = NULL;
+		cpci.flags = 0;
+		cpci.queueFamilyIndex = s_renderVK->m_qfiGraphics;
+
+		m_numCommandBuffers = 0;
+		return vkCreateCommandPool(s_renderVK->m_device, &cpci, s_renderVK->m_allocatorCb, &m_commandPool);
+	}
+
+	void CommandRecorderVK::destroy()
+	{
+		if (!m_commandBuffer.empty() )
 		{
-			const BlitItem& blit = _bs.advance();
-			BX_UNUSED(blit);
+			vkFreeCommandBuffers(s_renderVK->m_device, m_commandPool, uint32_t(m_commandBuffer.size() ), &m_commandBuffer[0]);
+			m_commandBuffer.clear();
 		}
+
+		vkDestroy(m_commandPool);
+		m_numCommandBuffers = 0;
+		m_segment.clear();
 	}
 
-	void RendererContextVK::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
+	void CommandRecorderVK::reset()
 	{
-		BX_UNUSED(_render, _clearQuad, _textVideoMemBlitter);
+		if (0 != m_numCommandBuffers)
+		{
+			VK_CHECK(vkResetCommandPool(s_renderVK->m_device, m_commandPool, 0) );
+		}
 
-		updateResolution(_render->m_resolution);
+		m_numCommandBuffers = 0;
+		m_segment.clear();
+		m_pipeline.reset();
+	}
 
-		int64_t timeBegin = bx::getHPCounter();
-		int64_t captureElapsed = 0;
+	VkCommandBuffer CommandRecorderVK::begin(uint16_t _view, bool _compute)
+	{
+		if (m_numCommandBuffers == m_commandBuffer.size() )
+		{
+			VkCommandBufferAllocateInfo cbai;
+			cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cbai.pNext = NULL;
+			cbai.commandPool = m_commandPool;
+			cbai.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			cbai.commandBufferCount = 1;
+
+			VkCommandBuffer commandBuffer;
+			VK_CHECK(vkAllocateCommandBuffers(s_renderVK->m_device, &cbai, &commandBuffer) );
+			m_commandBuffer.push_back(commandBuffer);
+		}
 
-//		m_gpuTimer.begin(m_commandList);
+		VkCommandBuffer commandBuffer = m_commandBuffer[m_numCommandBuffers++];
 
-		if (0 < _render->m_iboffset)
+		// Draws are executed inside primary command buffer render pass, compute outside of it.
+		VkCommandBufferInheritanceInfo cbii;
+		cbii.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		cbii.pNext = NULL;
+		cbii.renderPass  = _compute ? VK_NULL_HANDLE : s_renderVK->m_renderPass;
+		cbii.subpass     = 0;
+		cbii.framebuffer = _compute ? VK_NULL_HANDLE : s_renderVK->m_backBufferColor[s_renderVK->m_backBufferColorIdx];
+		cbii.occlusionQueryEnable = VK_FALSE;
+		cbii.queryFlags = 0;
+		cbii.pipelineStatistics = 0;
+
+		VkCommandBufferBeginInfo cbbi;
+		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cbbi.pNext = NULL;
+		cbbi.flags = 0
+			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+			| (_compute ? 0 : VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT)
+			;
+		cbbi.pInheritanceInfo = &cbii;
+		VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
+
+		Segment segment;
+		segment.m_commandBuffer = commandBuffer;
+		segment.m_view    = _view;
+		segment.m_compute = _compute;
+		m_segment.push_back(segment);
+
+		return commandBuffer;
+	}
+
+	VkPipeline CommandRecorderVK::getPipeline(uint64_t _state, uint64_t _stencil, uint16_t _declIdx, uint16_t _programIdx, uint8_t _numInstanceData, FrameBufferHandle _fbh)
+	{
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(_state);
+		murmur.add(_stencil);
+		murmur.add(_declIdx);
+		murmur.add(_programIdx);
+		murmur.add(_numInstanceData);
+		murmur.add(_fbh.idx);
+		const uint32_t hash = murmur.end();
+
+		const VkPipeline* cached = m_pipeline.find(hash);
+		if (NULL != cached)
 		{
-//			TransientIndexBuffer* ib = _render->m_transientIb;
-//			m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->m_iboffset, ib->data);
+			return *cached;
 		}
 
-		if (0 < _render->m_vboffset)
+		VkPipeline pipeline = s_renderVK->getPipeline(_state, _stencil, _declIdx, _programIdx, _numInstanceData, _fbh);
+		m_pipeline.insert(hash, pipeline);
+
+		return pipeline;
+	}
+
+	void CommandRecorderVK::setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+	{
+		if (_flags&BGFX_UNIFORM_FRAGMENTBIT)
 		{
-//			TransientVertexBuffer* vb = _render->m_transientVb;
-//			m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->m_vboffset, vb->data);
+			bx::memCopy(&m_fsScratch[_regIndex], _val, _numRegs*16);
+			m_fsChanges += _numRegs;
+		}
+		else
+		{
+			bx::memCopy(&m_vsScratch[_regIndex], _val, _numRegs*16);
+			m_vsChanges += _numRegs;
 		}
+	}
 
-		_render->sort();
+	void CommandRecorderVK::setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+	{
+		setShaderUniform(_flags, _regIndex, _val, _numRegs);
+	}
+
+	void CommandRecorderVK::setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+	{
+		setShaderUniform(_flags, _regIndex, _val, _numRegs);
+	}
+
+	void CommandRecorderVK::commitShaderUniforms(VkCommandBuffer _commandBuffer, uint16_t _programIdx)
+	{
+		const ProgramVK& program = s_renderVK->m_program[_programIdx];
+		uint32_t total = 0
+			+ program.m_vsh->m_size
+			+ (NULL != program.m_fsh ? program.m_fsh->m_size : 0)
+			;
+		if (0 < total)
+		{
+			VkDescriptorBufferInfo descriptorBufferInfo;
+			VkDescriptorSet descriptorSet;
+			uint8_t* data = (uint8_t*)s_renderVK->m_scratchBuffer[s_renderVK->m_backBufferColorIdx].allocUbv(descriptorBufferInfo, descriptorSet, total);
+
+			uint32_t size = program.m_vsh->m_size;
+			bx::memCopy(data, m_vsScratch, size);
+			data += size;
+
+			if (NULL != program.m_fsh)
+			{
+				bx::memCopy(data, m_fsScratch, program.m_fsh->m_size);
+			}
+
+			vkCmdBindDescriptorSets(_commandBuffer
+				, VK_PIPELINE_BIND_POINT_GRAPHICS
+				, s_renderVK->m_pipelineLayout
+				, 0
+				, 1
+				, &descriptorSet
+				, 0
+				, NULL
+				);
+		}
+
+		m_vsChanges = 0;
+		m_fsChanges = 0;
+	}
+
+	void CommandRecorderVK::commit(const UniformBuffer& _uniformBuffer)
+	{
+		for (uint32_t pos = 0;;)
+		{
+			uint32_t opcode = _uniformBuffer.readAt(pos);
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			const char* data;
+			if (copy)
+			{
+				data = _uniformBuffer.readAt(pos, g_uniformTypeSize[type]*num);
+			}
+			else
+			{
+				UniformHandle handle;
+				bx::memCopy(&handle, _uniformBuffer.readAt(pos, sizeof(UniformHandle) ), sizeof(UniformHandle) );
+
+				// Uniform values set by render items recorded so far, or values from previous
+				// frames.
+				data = (const char*)m_uniformState.m_data[handle.idx];
+				if (NULL == data)
+				{
+					data = (const char*)s_renderVK->m_uniforms[handle.idx];
+				}
+			}
+
+#define CASE_IMPLEMENT_UNIFORM(_uniform, _dxsuffix, _type) \
+			case UniformType::_uniform: \
+			case UniformType::_uniform|BGFX_UNIFORM_FRAGMENTBIT: \
+					{ \
+						setShaderUniform(uint8_t(type), loc, data, num); \
+					} \
+					break;
+
+			switch ( (uint32_t)type)
+			{
+			case UniformType::Mat3:
+			case UniformType::Mat3|BGFX_UNIFORM_FRAGMENTBIT:
+				 {
+					 float* value = (float*)data;
+					 for (uint32_t ii = 0, count = num/3; ii < count; ++ii,  loc += 3*16, value += 9)
+					 {
+						 Matrix4 mtx;
+						 mtx.un.val[ 0] = value[0];
+						 mtx.un.val[ 1] = value[1];
+						 mtx.un.val[ 2] = value[2];
+						 mtx.un.val[ 3] = 0.0f;
+						 mtx.un.val[ 4] = value[3];
+						 mtx.un.val[ 5] = value[4];
+						 mtx.un.val[ 6] = value[5];
+						 mtx.un.val[ 7] = 0.0f;
+						 mtx.un.val[ 8] = value[6];
+						 mtx.un.val[ 9] = value[7];
+						 mtx.un.val[10] = value[8];
+						 mtx.un.val[11] = 0.0f;
+						 setShaderUniform(uint8_t(type), loc, &mtx.un.val[0], 3);
+					 }
+				}
+				break;
+
+			CASE_IMPLEMENT_UNIFORM(Int1, I, int);
+			CASE_IMPLEMENT_UNIFORM(Vec4, F, float);
+			CASE_IMPLEMENT_UNIFORM(Mat4, F, float);
+
+			case UniformType::End:
+				break;
+
+			default:
+				BX_TRACE("%4d: INVALID 0x%08x, t %d, l %d, n %d, c %d", pos, opcode, type, loc, num, copy);
+				break;
+			}
+#undef CASE_IMPLEMENT_UNIFORM
+		}
+	}
+
+	void CommandRecorderVK::record(Frame* _render, const RenderItemRange& _range, const UniformState& _uniformState)
+	{
+		bx::memCopy(&m_uniformState, &_uniformState, sizeof(UniformState) );
+
+		const bool hmdEnabled = false;
+		m_viewState.reset(_render, hmdEnabled);
+
+		bx::memSet(m_numPrimsSubmitted, 0, sizeof(m_numPrimsSubmitted) );
+		bx::memSet(m_numPrimsRendered,  0, sizeof(m_numPrimsRendered) );
+		bx::memSet(m_numInstances,      0, sizeof(m_numInstances) );
+		bx::memSet(m_numKeyType,        0, sizeof(m_numKeyType) );
+		m_numIndices = 0;
 
 		RenderDraw currentState;
 		currentState.clear();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
 		currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
 
-		const bool hmdEnabled = false;
-		ViewState viewState(_render, hmdEnabled);
-		viewState.reset(_render, hmdEnabled);
-
-// 		bool wireframe = !!(_render->m_debug&BGFX_DEBUG_WIREFRAME);
-// 		setDebugWireframe(wireframe);
-
-		uint16_t currentSamplerStateIdx = kInvalidHandle;
-		uint16_t currentProgramIdx      = kInvalidHandle;
-		uint32_t currentBindHash        = 0;
-		bool     hasPredefined          = false;
-		bool     commandListChanged     = false;
+		uint16_t currentProgramIdx = kInvalidHandle;
+		bool     hasPredefined     = false;
+		bool     resetState        = false;
 		VkPipeline currentPipeline = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
+		bool wasCompute = false;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
-		BlitState bs(_render);
-
 		uint32_t blendFactor = 0;
 
 		const uint64_t primType = _render->m_debug&BGFX_DEBUG_WIREFRAME ? BGFX_STATE_PT_LINES : 0;
 		uint8_t primIndex = uint8_t(primType >> BGFX_STATE_PT_SHIFT);
 		PrimInfo prim = s_primInfo[primIndex];
 
-		bool wasCompute = false;
 		bool viewHasScissor = false;
 		bool restoreScissor = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
 
-		const uint32_t maxComputeBindings = g_caps.limits.maxComputeBindings;
-		BX_UNUSED(maxComputeBindings);
-
-		uint32_t statsNumPrimsSubmitted[BX_COUNTOF(s_primInfo)] = {};
-		uint32_t statsNumPrimsRendered[BX_COUNTOF(s_primInfo)] = {};
-		uint32_t statsNumInstances[BX_COUNTOF(s_primInfo)] = {};
-		uint32_t statsNumIndices = 0;
-		uint32_t statsKeyType[2] = {};
-
-		VkSemaphore renderWait = m_presentDone[m_backBufferColorIdx];
-		VK_CHECK(vkAcquireNextImageKHR(m_device
-				, m_swapchain
-				, UINT64_MAX
-				, renderWait
-				, VK_NULL_HANDLE
-				, &m_backBufferColorIdx
-				) );
-
 		const uint64_t f0 = BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_FACTOR, BGFX_STATE_BLEND_FACTOR);
 		const uint64_t f1 = BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_INV_FACTOR, BGFX_STATE_BLEND_INV_FACTOR);
 
+		// Sorted item index at which precomputed draw changes can be used, i.e.
+		// previous item's state is fully applied.
+		uint32_t diffItem = UINT32_MAX;
 
-		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_backBufferColorIdx];
-		VkDescriptorBufferInfo descriptorBufferInfo;
-		scratchBuffer.reset(descriptorBufferInfo);
+		for (uint32_t item = _range.m_begin; item < _range.m_end; ++item)
+		{
+			const uint64_t encodedKey = _render->m_sortKeys[item];
+			const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
+			m_numKeyType[isCompute]++;
+
+			const uint32_t itemIdx       = _render->m_sortValues[item];
+			const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+
+			// Command buffer state is not inherited between secondary command buffers, each
+			// segment starts from scratch.
+			const bool segmentChanged = 0
+				|| VK_NULL_HANDLE == commandBuffer
+				|| key.m_view != view
+				|| isCompute  != wasCompute
+				;
 
-		VkCommandBufferBeginInfo cbbi;
-		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		cbbi.pNext = NULL;
-		cbbi.flags = 0
-			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
-//			| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
-			;
-		cbbi.pInheritanceInfo = NULL;
+			if (segmentChanged)
+			{
+				if (VK_NULL_HANDLE != commandBuffer)
+				{
+					VK_CHECK(vkEndCommandBuffer(commandBuffer) );
+				}
 
-		m_commandBuffer = m_commandBuffers[m_backBufferColorIdx];
-		VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
+				view       = key.m_view;
+				wasCompute = isCompute;
+				commandBuffer = begin(view, isCompute);
 
-		setImageMemoryBarrier(m_commandBuffer
-			, m_backBufferColorImage[m_backBufferColorIdx]
-			, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-			, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-			);
+				currentPipeline   = VK_NULL_HANDLE;
+				currentProgramIdx = kInvalidHandle;
+				hasPredefined     = false;
 
-		VkRenderPassBeginInfo rpbi;
-		rpbi.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		rpbi.pNext = NULL;
-		rpbi.renderPass  = m_renderPass;
-		rpbi.framebuffer = m_backBufferColor[m_backBufferColorIdx];
-		rpbi.renderArea.offset.x = 0;
-		rpbi.renderArea.offset.y = 0;
-		rpbi.renderArea.extent = m_sci.imageExtent;
-		rpbi.clearValueCount = 0;
-		rpbi.pClearValues    = NULL;
+				fbh = _render->m_view[view].m_fbh;
 
-		bool beginRenderPass = false;
+				m_viewState.m_rect = _render->m_view[view].m_rect;
+				const Rect& rect        = _render->m_view[view].m_rect;
+				const Rect& scissorRect = _render->m_view[view].m_scissor;
+				viewHasScissor  = !scissorRect.isZero();
+				viewScissorRect = viewHasScissor ? scissorRect : rect;
 
-		if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
-		{
-//			m_batch.begin();
-
-// 			uint8_t eye = 0;
-// 			uint8_t restartState = 0;
-			viewState.m_rect = _render->m_view[0].m_rect;
-
-			int32_t numItems = _render->m_numRenderItems;
-			for (int32_t item = 0, restartItem = numItems; item < numItems || restartItem < numItems;)
-			{
-				const uint64_t encodedKey = _render->m_sortKeys[item];
-				const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
-				statsKeyType[isCompute]++;
-
-				const bool viewChanged = 0
-					|| key.m_view != view
-					|| item == numItems
-					;
-
-				const uint32_t itemIdx       = _render->m_sortValues[item];
-				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
-				++item;
-
-				if (viewChanged)
+				if (!isCompute)
 				{
-					if (beginRenderPass)
-					{
-						vkCmdEndRenderPass(m_commandBuffer);
-						beginRenderPass = false;
-					}
-
-					VK_CHECK(vkEndCommandBuffer(m_commandBuffer) );
-
-//					m_batch.flush(m_commandList, true);
-					kick(renderWait);
-					renderWait = VK_NULL_HANDLE;
-finishAll();
-
-					view = key.m_view;
-					currentPipeline = VK_NULL_HANDLE;
-					currentSamplerStateIdx = kInvalidHandle;
-BX_UNUSED(currentSamplerStateIdx);
-					currentProgramIdx      = kInvalidHandle;
-					hasPredefined          = false;
-
-					fbh = _render->m_view[view].m_fbh;
-					setFrameBuffer(fbh);
-
-					viewState.m_rect = _render->m_view[view].m_rect;
-					const Rect& rect        = _render->m_view[view].m_rect;
-					const Rect& scissorRect = _render->m_view[view].m_scissor;
-					viewHasScissor  = !scissorRect.isZero();
-					viewScissorRect = viewHasScissor ? scissorRect : rect;
-
-					rpbi.renderArea.offset.x = rect.m_x;
-					rpbi.renderArea.offset.y = rect.m_y;
-					rpbi.renderArea.extent.width  = rect.m_width;
-					rpbi.renderArea.extent.height = rect.m_height;
-					VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
-					vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
-					beginRenderPass = true;
-
 					VkViewport vp;
 					vp.x        = rect.m_x;
 					vp.y        = rect.m_y;
@@ -3838,548 +3898,576 @@ BX_UNUSED(currentSamplerStateIdx);
 					vp.height   = rect.m_height;
 					vp.minDepth = 0.0f;
 					vp.maxDepth = 1.0f;
-					vkCmdSetViewport(m_commandBuffer, 0, 1, &vp);
+					vkCmdSetViewport(commandBuffer, 0, 1, &vp);
 
 					VkRect2D rc;
 					rc.offset.x      = viewScissorRect.m_x;
 					rc.offset.y      = viewScissorRect.m_y;
 					rc.extent.width  = viewScissorRect.m_x + viewScissorRect.m_width;
 					rc.extent.height = viewScissorRect.m_y + viewScissorRect.m_height;
-					vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
+					vkCmdSetScissor(commandBuffer, 0, 1, &rc);
 
 					restoreScissor = false;
 
-					Clear& clr = _render->m_view[view].m_clear;
-					if (BGFX_CLEAR_NONE != clr.m_flags)
+					// View is cleared by recorder of its first draw.
+					const bool firstDraw = _render->isSegmentBegin(item);
+
+					const Clear& clr = _render->m_view[view].m_clear;
+					if (firstDraw
+					&&  BGFX_CLEAR_NONE != clr.m_flags)
 					{
 						Rect clearRect = rect;
 						clearRect.setIntersect(rect, viewScissorRect);
-						clearQuad(clearRect, clr, _render->m_colorPalette);
+						s_renderVK->clearQuad(commandBuffer, clearRect, clr, _render->m_colorPalette);
 					}
 
+					resetState = true;
 					prim = s_primInfo[Topology::Count]; // Force primitive type update.
-
-					submitBlit(bs, view);
 				}
+			}
 
-				if (isCompute)
+			if (isCompute)
+			{
+				const RenderCompute& compute = renderItem.compute;
+				m_uniformState.update(_render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+
+				VkPipeline pipeline = s_renderVK->getPipeline(key.m_program);
+				if (pipeline != currentPipeline)
 				{
-					if (!wasCompute)
-					{
-						wasCompute = true;
-
-//						m_commandList->SetComputeRootSignature(m_rootSignature);
-//						ID3D12DescriptorHeap* heaps[] = {
-//							m_samplerAllocator.getHeap(),
-//							scratchBuffer.getHeap(),
-//						};
-//						m_commandList->SetDescriptorHeaps(BX_COUNTOF(heaps), heaps);
-					}
+					currentPipeline = pipeline;
+					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+				}
 
-					const RenderCompute& compute = renderItem.compute;
+				bool constantsChanged = false;
+				if (compute.m_uniformBegin < compute.m_uniformEnd
+				||  currentProgramIdx != key.m_program)
+				{
+					currentProgramIdx = key.m_program;
+					ProgramVK& program = s_renderVK->m_program[currentProgramIdx];
 
-					VkPipeline pipeline = getPipeline(key.m_program);
-					if (pipeline != currentPipeline)
+					UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
+					if (NULL != vcb)
 					{
-						currentPipeline = pipeline;
-						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
-						currentBindHash = 0;
+						commit(*vcb);
 					}
 
-//					uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
-//					if (currentBindHash != bindHash)
-//					{
-//						currentBindHash  = bindHash;
-//
-//						Bind* bindCached = bindLru.find(bindHash);
-//						if (NULL == bindCached)
-//						{
-//							D3D12_GPU_DESCRIPTOR_HANDLE srvHandle[BGFX_MAX_COMPUTE_BINDINGS] = {};
-//							uint32_t samplerFlags[BGFX_MAX_COMPUTE_BINDINGS] = {};
-//
-//							for (uint32_t ii = 0; ii < maxComputeBindings; ++ii)
-//							{
-//								const Binding& bind = renderBind.m_bind[ii];
-//								if (kInvalidHandle != bind.m_idx)
-//								{
-//									switch (bind.m_type)
-//									{
-//									case Binding::Image:
-//										{
-//											TextureD3D12& texture = m_textures[bind.m_idx];
-//
-//											if (Access::Read != bind.m_un.m_compute.m_access)
-//											{
-//												texture.setState(m_commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-//												scratchBuffer.allocUav(srvHandle[ii], texture, bind.m_un.m_compute.m_mip);
-//											}
-//											else
-//											{
-//												texture.setState(m_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
-//												scratchBuffer.allocSrv(srvHandle[ii], texture, bind.m_un.m_compute.m_mip);
-//												samplerFlags[ii] = texture.m_flags;
-//											}
-//										}
-//										break;
-//
-//									case Binding::IndexBuffer:
-//									case Binding::VertexBuffer:
-//										{
-//											BufferD3D12& buffer = Binding::IndexBuffer == bind.m_type
-//												? m_indexBuffers[bind.m_idx]
-//												: m_vertexBuffers[bind.m_idx]
-//												;
-//
-//											if (Access::Read != bind.m_un.m_compute.m_access)
-//											{
-//												buffer.setState(m_commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-//												scratchBuffer.allocUav(srvHandle[ii], buffer);
-//											}
-//											else
-//											{
-//												buffer.setState(m_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
-//												scratchBuffer.allocSrv(srvHandle[ii], buffer);
-//											}
-//										}
-//										break;
-//									}
-//								}
-//							}
-//
-//							uint16_t samplerStateIdx = getSamplerState(samplerFlags, maxComputeBindings, _render->m_colorPalette);
-//							if (samplerStateIdx != currentSamplerStateIdx)
-//							{
-//								currentSamplerStateIdx = samplerStateIdx;
-//								m_commandList->SetComputeRootDescriptorTable(Rdt::Sampler, m_samplerAllocator.get(samplerStateIdx) );
-//							}
-//
-//							m_commandList->SetComputeRootDescriptorTable(Rdt::SRV, srvHandle[0]);
-//							m_commandList->SetComputeRootDescriptorTable(Rdt::UAV, srvHandle[0]);
-//
-//							Bind bind;
-//							bind.m_srvHandle = srvHandle[0];
-//							bind.m_samplerStateIdx = samplerStateIdx;
-//							bindLru.add(bindHash, bind, 0);
-//						}
-//						else
-//						{
-//							uint16_t samplerStateIdx = bindCached->m_samplerStateIdx;
-//							if (samplerStateIdx != currentSamplerStateIdx)
-//							{
-//								currentSamplerStateIdx = samplerStateIdx;
-//								m_commandList->SetComputeRootDescriptorTable(Rdt::Sampler, m_samplerAllocator.get(samplerStateIdx) );
-//							}
-//							m_commandList->SetComputeRootDescriptorTable(Rdt::SRV, bindCached->m_srvHandle);
-//							m_commandList->SetComputeRootDescriptorTable(Rdt::UAV, bindCached->m_srvHandle);
-//						}
-//					}
-
-					bool constantsChanged = false;
-					if (compute.m_uniformBegin < compute.m_uniformEnd
-					||  currentProgramIdx != key.m_program)
-					{
-						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+					hasPredefined = 0 < program.m_numPredefined;
+					constantsChanged = true;
+				}
 
-						currentProgramIdx = key.m_program;
-						ProgramVK& program = m_program[currentProgramIdx];
+				if (constantsChanged
+				||  hasPredefined)
+				{
+					ProgramVK& program = s_renderVK->m_program[currentProgramIdx];
+					m_viewState.setPredefined<4>(this, view, 0, program, _render, compute);
+				}
 
-						UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
-						if (NULL != vcb)
-						{
-							commit(*vcb);
-						}
+				if (isValid(compute.m_indirectBuffer) )
+				{
+					const VertexBufferVK& vb = s_renderVK->m_vertexBuffers[compute.m_indirectBuffer.idx];
 
-						hasPredefined = 0 < program.m_numPredefined;
-						constantsChanged = true;
-					}
+					uint32_t numDrawIndirect = UINT16_MAX == compute.m_numIndirect
+						? vb.m_size/BGFX_CONFIG_DRAW_INDIRECT_STRIDE
+						: compute.m_numIndirect
+						;
 
-					if (constantsChanged
-					||  hasPredefined)
+					uint32_t args = compute.m_startIndirect * BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
+					for (uint32_t ii = 0; ii < numDrawIndirect; ++ii)
 					{
-						ProgramVK& program = m_program[currentProgramIdx];
-						viewState.setPredefined<4>(this, view, 0, program, _render, compute);
-//						commitShaderConstants(key.m_program, gpuAddress);
-//						m_commandList->SetComputeRootConstantBufferView(Rdt::CBV, gpuAddress);
+//						vkCmdDispatchIndirect(commandBuffer, vb.m_buffer, args);
+						args += BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
 					}
+				}
+				else
+				{
+//					vkCmdDispatch(commandBuffer, compute.m_numX, compute.m_numY, compute.m_numZ);
+				}
 
-					if (isValid(compute.m_indirectBuffer) )
-					{
-						const VertexBufferVK& vb = m_vertexBuffers[compute.m_indirectBuffer.idx];
+				continue;
+			}
 
-						uint32_t numDrawIndirect = UINT16_MAX == compute.m_numIndirect
-							? vb.m_size/BGFX_CONFIG_DRAW_INDIRECT_STRIDE
-							: compute.m_numIndirect
-							;
+			const RenderDraw& draw = renderItem.draw;
 
-						uint32_t args = compute.m_startIndirect * BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
-						for (uint32_t ii = 0; ii < numDrawIndirect; ++ii)
-						{
-//							m_commandList->ExecuteIndirect(ptr, args);
-							args += BGFX_CONFIG_DRAW_INDIRECT_STRIDE;
-						}
-					}
-					else
-					{
-//						m_commandList->Dispatch(compute.m_numX, compute.m_numY, compute.m_numZ);
-					}
+			const uint8_t drawChanged = !resetState && diffItem == item
+				? _render->m_drawChanged[item]
+				: BGFX_DRAW_CHANGED_ALL
+				;
+			diffItem = UINT32_MAX;
 
-					continue;
-				}
+			// Uniforms are updated for culled draws too, uniform state at start of each range
+			// is gathered the same way.
+			m_uniformState.update(_render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
 
-				const RenderDraw& draw = renderItem.draw;
+			if (_render->m_frameCache.isZeroArea(viewScissorRect, draw.m_scissor) )
+			{
+				continue;
+			}
 
-				const bool hasOcclusionQuery = false; //0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
-				{
-					const bool occluded = false //true
-//						&& isValid(draw.m_occlusionQuery)
-//						&& !hasOcclusionQuery
-//						&& !isVisible(_render, draw.m_occlusionQuery, 0 != (draw.m_submitFlags&BGFX_SUBMIT_INTERNAL_OCCLUSION_VISIBLE) )
-						;
+			const uint64_t newFlags = draw.m_stateFlags;
+			uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
+			currentState.m_stateFlags = newFlags;
 
-					if (occluded
-					||  _render->m_frameCache.isZeroArea(viewScissorRect, draw.m_scissor) )
-					{
-//						if (resetState)
-//						{
-//							currentState.clear();
-//							currentState.m_scissor = !draw.m_scissor;
-//							currentBind.clear();
-//						}
-
-						continue;
-					}
-				}
+			const uint64_t newStencil = draw.m_stencil;
+			uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
+			currentState.m_stencil = newStencil;
+
+			if (resetState)
+			{
+				resetState = false;
 
-				const uint64_t newFlags = draw.m_stateFlags;
-				uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
+				currentState.clear();
+				currentState.m_scissor = !draw.m_scissor;
+				changedFlags = BGFX_STATE_MASK;
+				changedStencil = packStencil(BGFX_STENCIL_MASK, BGFX_STENCIL_MASK);
 				currentState.m_stateFlags = newFlags;
+				currentState.m_stencil    = newStencil;
 
-				const uint64_t newStencil = draw.m_stencil;
-				uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
-				currentState.m_stencil = newStencil;
+				const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
+				primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+			}
 
-				if (viewChanged
-				||  wasCompute)
-				{
-					if (wasCompute)
-					{
-						wasCompute = false;
-					}
+			if (isValid(draw.m_stream[0].m_handle) )
+			{
+				const uint64_t state = draw.m_stateFlags;
+				bool hasFactor = 0
+					|| f0 == (state & f0)
+					|| f1 == (state & f1)
+					;
 
-					if (BX_ENABLED(BGFX_CONFIG_DEBUG_PIX) )
-					{
-						BX_UNUSED(s_viewName);
-// 						wchar_t* viewNameW = s_viewNameW[view];
-// 						viewNameW[3] = L' ';
-// 						PIX_ENDEVENT();
-// 						PIX_BEGINEVENT(toRgba8(0xff, 0x00, 0x00, 0xff), viewNameW);
-					}
+				const VertexBufferVK& vb = s_renderVK->m_vertexBuffers[draw.m_stream[0].m_handle.idx];
+				uint16_t declIdx = !isValid(vb.m_decl) ? draw.m_stream[0].m_decl.idx : vb.m_decl.idx;
+
+				VkPipeline pipeline =
+					getPipeline(state
+						, draw.m_stencil
+						, declIdx
+						, key.m_program
+						, uint8_t(draw.m_instanceDataStride/16)
+						, fbh
+						);
 
-					commandListChanged = true;
+				uint16_t scissor = draw.m_scissor;
+
+				if (pipeline != currentPipeline
+				||  0 != changedStencil)
+				{
+					const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
+					const uint32_t ref = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
+					vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FRONT_AND_BACK, ref);
 				}
 
-				if (commandListChanged)
+				if (pipeline != currentPipeline
+				|| (hasFactor && blendFactor != draw.m_rgba) )
 				{
-					commandListChanged = false;
-
-//					m_commandList->SetGraphicsRootSignature(m_rootSignature);
-//					ID3D12DescriptorHeap* heaps[] = {
-//						m_samplerAllocator.getHeap(),
-//						scratchBuffer.getHeap(),
-//					};
-//					m_commandList->SetDescriptorHeaps(BX_COUNTOF(heaps), heaps);
-
-					currentPipeline        = VK_NULL_HANDLE;
-					currentBindHash        = 0;
-					currentSamplerStateIdx = kInvalidHandle;
-					currentProgramIdx      = kInvalidHandle;
-					currentState.clear();
-					currentState.m_scissor = !draw.m_scissor;
-					changedFlags = BGFX_STATE_MASK;
-					changedStencil = packStencil(BGFX_STENCIL_MASK, BGFX_STENCIL_MASK);
-					currentState.m_stateFlags = newFlags;
-					currentState.m_stencil    = newStencil;
+					blendFactor = draw.m_rgba;
+
+					float bf[4];
+					bf[0] = ( (draw.m_rgba>>24)     )/255.0f;
+					bf[1] = ( (draw.m_rgba>>16)&0xff)/255.0f;
+					bf[2] = ( (draw.m_rgba>> 8)&0xff)/255.0f;
+					bf[3] = ( (draw.m_rgba    )&0xff)/255.0f;
+					vkCmdSetBlendConstants(commandBuffer, bf);
+				}
 
+				if (0 != (BGFX_STATE_PT_MASK & changedFlags)
+				||  prim.m_topology != s_primInfo[primIndex].m_topology)
+				{
 					const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
 					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+					prim = s_primInfo[primIndex];
 				}
 
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
-
-				if (isValid(draw.m_stream[0].m_handle) )
+				if (currentState.m_scissor != scissor)
 				{
-					const uint64_t state = draw.m_stateFlags;
-					bool hasFactor = 0
-						|| f0 == (state & f0)
-						|| f1 == (state & f1)
-						;
-
-					const VertexBufferVK& vb = m_vertexBuffers[draw.m_stream[0].m_handle.idx];
-					uint16_t declIdx = !isValid(vb.m_decl) ? draw.m_stream[0].m_decl.idx : vb.m_decl.idx;
-
-					VkPipeline pipeline =
-						getPipeline(state
-							, draw.m_stencil
-							, declIdx
-							, key.m_program
-							, uint8_t(draw.m_instanceDataStride/16)
-							);
-
-					uint16_t scissor = draw.m_scissor;
-					uint32_t bindHash = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
-					if (currentBindHash != bindHash
-					||  0 != changedStencil
-					|| (hasFactor && blendFactor != draw.m_rgba)
-					|| (0 != (BGFX_STATE_PT_MASK & changedFlags)
-					||  prim.m_topology != s_primInfo[primIndex].m_topology)
-					||  currentState.m_scissor != scissor
-					||  pipeline != currentPipeline
-					||  hasOcclusionQuery)
-					{
-//						m_batch.flush(m_commandList);
-					}
-
-//					if (currentBindHash != bindHash)
-//					{
-//						currentBindHash  = bindHash;
-//
-//						Bind* bindCached = bindLru.find(bindHash);
-//						if (NULL == bindCached)
-//						{
-//							D3D12_GPU_DESCRIPTOR_HANDLE srvHandle[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
-//							uint32_t samplerFlags[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
-//							{
-//								srvHandle[0].ptr = 0;
-//								for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
-//								{
-//									const Binding& bind = renderBind.m_bind[stage];
-//									if (kInvalidHandle != bind.m_idx)
-//									{
-//										TextureD3D12& texture = m_textures[bind.m_idx];
-//										texture.setState(m_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
-//										scratchBuffer.allocSrv(srvHandle[stage], texture);
-//										samplerFlags[stage] = (0 == (BGFX_TEXTURE_INTERNAL_DEFAULT_SAMPLER & bind.m_un.m_draw.m_textureFlags)
-//											? bind.m_un.m_draw.m_textureFlags
-//											: texture.m_flags
-//											) & (BGFX_TEXTURE_SAMPLER_BITS_MASK|BGFX_TEXTURE_BORDER_COLOR_MASK)
-//											;
-//									}
-//									else
-//									{
-//										bx::memCopy(&srvHandle[stage], &srvHandle[0], sizeof(D3D12_GPU_DESCRIPTOR_HANDLE) );
-//										samplerFlags[stage] = 0;
-//									}
-//								}
-//							}
-//
-//							if (srvHandle[0].ptr != 0)
-//							{
-//								uint16_t samplerStateIdx = getSamplerState(samplerFlags, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, _render->m_colorPalette);
-//								if (samplerStateIdx != currentSamplerStateIdx)
-//								{
-//									currentSamplerStateIdx = samplerStateIdx;
-//									m_commandList->SetGraphicsRootDescriptorTable(Rdt::Sampler, m_samplerAllocator.get(samplerStateIdx) );
-//								}
-//
-//								m_commandList->SetGraphicsRootDescriptorTable(Rdt::SRV, srvHandle[0]);
-//
-//								Bind bind;
-//								bind.m_srvHandle = srvHandle[0];
-//								bind.m_samplerStateIdx = samplerStateIdx;
-//								bindLru.add(bindHash, bind, 0);
-//							}
-//						}
-//						else
-//						{
-//							uint16_t samplerStateIdx = bindCached->m_samplerStateIdx;
-//							if (samplerStateIdx != currentSamplerStateIdx)
-//							{
-//								currentSamplerStateIdx = samplerStateIdx;
-//								m_commandList->SetGraphicsRootDescriptorTable(Rdt::Sampler, m_samplerAllocator.get(samplerStateIdx) );
-//							}
-//							m_commandList->SetGraphicsRootDescriptorTable(Rdt::SRV, bindCached->m_srvHandle);
-//						}
-//					}
+					currentState.m_scissor = scissor;
 
-					if (pipeline != currentPipeline
-					||  0 != changedStencil)
+					if (UINT16_MAX == scissor)
 					{
-						const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
-						const uint32_t ref = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
-						vkCmdSetStencilReference(m_commandBuffer, VK_STENCIL_FRONT_AND_BACK, ref);
-					}
-
-					if (pipeline != currentPipeline
-					|| (hasFactor && blendFactor != draw.m_rgba) )
-					{
-						blendFactor = draw.m_rgba;
-
-						float bf[4];
-						bf[0] = ( (draw.m_rgba>>24)     )/255.0f;
-						bf[1] = ( (draw.m_rgba>>16)&0xff)/255.0f;
-						bf[2] = ( (draw.m_rgba>> 8)&0xff)/255.0f;
-						bf[3] = ( (draw.m_rgba    )&0xff)/255.0f;
-						vkCmdSetBlendConstants(m_commandBuffer, bf);
-					}
-
-					if (0 != (BGFX_STATE_PT_MASK & changedFlags)
-					||  prim.m_topology != s_primInfo[primIndex].m_topology)
-					{
-						const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
-						primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
-						prim = s_primInfo[primIndex];
-//						m_commandList->IASetPrimitiveTopology(prim.m_topology);
-					}
-
-					if (currentState.m_scissor != scissor)
-					{
-						currentState.m_scissor = scissor;
-
-						if (UINT16_MAX == scissor)
+						if (restoreScissor
+						||  viewHasScissor)
 						{
-							if (restoreScissor
-							||  viewHasScissor)
-							{
-								restoreScissor = false;
-								VkRect2D rc;
-								rc.offset.x      = viewScissorRect.m_x;
-								rc.offset.y      = viewScissorRect.m_y;
-								rc.extent.width  = viewScissorRect.m_x + viewScissorRect.m_width;
-								rc.extent.height = viewScissorRect.m_y + viewScissorRect.m_height;
-								vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
-							}
-						}
-						else
-						{
-							restoreScissor = true;
-							Rect scissorRect;
-							scissorRect.setIntersect(viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
-
+							restoreScissor = false;
 							VkRect2D rc;
-							rc.offset.x      = scissorRect.m_x;
-							rc.offset.y      = scissorRect.m_y;
-							rc.extent.width  = scissorRect.m_x + scissorRect.m_width;
-							rc.extent.height = scissorRect.m_y + scissorRect.m_height;
-							vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
+							rc.offset.x      = viewScissorRect.m_x;
+							rc.offset.y      = viewScissorRect.m_y;
+							rc.extent.width  = viewScissorRect.m_x + viewScissorRect.m_width;
+							rc.extent.height = viewScissorRect.m_y + viewScissorRect.m_height;
+							vkCmdSetScissor(commandBuffer, 0, 1, &rc);
 						}
 					}
-
-					if (pipeline != currentPipeline)
+					else
 					{
-						currentPipeline = pipeline;
-						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+						restoreScissor = true;
+						Rect scissorRect;
+						scissorRect.setIntersect(viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
+
+						VkRect2D rc;
+						rc.offset.x      = scissorRect.m_x;
+						rc.offset.y      = scissorRect.m_y;
+						rc.extent.width  = scissorRect.m_x + scissorRect.m_width;
+						rc.extent.height = scissorRect.m_y + scissorRect.m_height;
+						vkCmdSetScissor(commandBuffer, 0, 1, &rc);
 					}
+				}
 
-					bool constantsChanged = false;
-					if (draw.m_uniformBegin < draw.m_uniformEnd
-					||  currentProgramIdx != key.m_program
-					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
-					{
-						currentProgramIdx = key.m_program;
-						ProgramVK& program = m_program[currentProgramIdx];
-
-						UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
-						if (NULL != vcb)
-						{
-							commit(*vcb);
-						}
+				if (pipeline != currentPipeline)
+				{
+					currentPipeline = pipeline;
+					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+				}
 
-						UniformBuffer* fcb = program.m_fsh->m_constantBuffer;
-						if (NULL != fcb)
-						{
-							commit(*fcb);
-						}
+				bool constantsChanged = false;
+				if (draw.m_uniformBegin < draw.m_uniformEnd
+				||  currentProgramIdx != key.m_program
+				||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
+				{
+					currentProgramIdx = key.m_program;
+					ProgramVK& program = s_renderVK->m_program[currentProgramIdx];
 
-						hasPredefined = 0 < program.m_numPredefined;
-						constantsChanged = true;
+					UniformBuffer* vcb = program.m_vsh->m_constantBuffer;
+					if (NULL != vcb)
+					{
+						commit(*vcb);
 					}
 
-					if (constantsChanged
-					||  hasPredefined)
+					UniformBuffer* fcb = program.m_fsh->m_constantBuffer;
+					if (NULL != fcb)
 					{
-						ProgramVK& program = m_program[currentProgramIdx];
-						uint32_t ref = (newFlags&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT;
-						viewState.m_alphaRef = ref/255.0f;
-						viewState.setPredefined<4>(this, view, 0, program, _render, draw);
-						commitShaderUniforms(m_commandBuffer, key.m_program); //, gpuAddress);
+						commit(*fcb);
 					}
 
+					hasPredefined = 0 < program.m_numPredefined;
+					constantsChanged = true;
+				}
+
+				if (constantsChanged
+				||  hasPredefined)
+				{
+					ProgramVK& program = s_renderVK->m_program[currentProgramIdx];
+					uint32_t ref = (newFlags&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT;
+					m_viewState.m_alphaRef = ref/255.0f;
+					m_viewState.setPredefined<4>(this, view, 0, program, _render, draw, item);
+					commitShaderUniforms(commandBuffer, key.m_program);
+				}
 
-//					vb.setState(_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
+				const VertexDecl& vertexDecl = s_renderVK->m_vertexDecls[declIdx];
+				uint32_t numIndices = 0;
 
-					const VertexDecl& vertexDecl = m_vertexDecls[declIdx];
-					uint32_t numIndices = 0;
+				const bool streamsChanged = 0 != (drawChanged & BGFX_DRAW_CHANGED_STREAMS);
 
+				if (streamsChanged)
+				{
 					VkDeviceSize offset = 0;
-					vkCmdBindVertexBuffers(m_commandBuffer
+					vkCmdBindVertexBuffers(commandBuffer
 						, 0
 						, 1
 						, &vb.m_buffer
 						, &offset
 						);
+				}
 
-					if (!isValid(draw.m_indexBuffer) )
-					{
-						const uint32_t numVertices = UINT32_MAX == draw.m_numVertices
-							? vb.m_size / vertexDecl.m_stride
-							: draw.m_numVertices
-							;
-						vkCmdDraw(m_commandBuffer
-							, numVertices
-							, draw.m_numInstances
-							, draw.m_stream[0].m_startVertex
-							, 0
-							);
-					}
-					else
-					{
-						BufferVK& ib = m_indexBuffers[draw.m_indexBuffer.idx];
-//						ib.setState(_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
+				diffItem = item+1;
 
-						const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
-						const uint32_t indexSize = hasIndex16 ? 2 : 4;
+				if (!isValid(draw.m_indexBuffer) )
+				{
+					const uint32_t numVertices = UINT32_MAX == draw.m_numVertices
+						? vb.m_size / vertexDecl.m_stride
+						: draw.m_numVertices
+						;
+					vkCmdDraw(commandBuffer
+						, numVertices
+						, draw.m_numInstances
+						, draw.m_stream[0].m_startVertex
+						, 0
+						);
+				}
+				else
+				{
+					const BufferVK& ib = s_renderVK->m_indexBuffers[draw.m_indexBuffer.idx];
 
-						numIndices = UINT32_MAX == draw.m_numIndices
-							? ib.m_size / indexSize
-							: draw.m_numIndices
-							;
+					const bool hasIndex16 = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32);
+					const uint32_t indexSize = hasIndex16 ? 2 : 4;
 
-						vkCmdBindIndexBuffer(m_commandBuffer
+					numIndices = UINT32_MAX == draw.m_numIndices
+						? ib.m_size / indexSize
+						: draw.m_numIndices
+						;
+
+					if (streamsChanged)
+					{
+						vkCmdBindIndexBuffer(commandBuffer
 							, ib.m_buffer
 							, 0
 							, hasIndex16
 								? VK_INDEX_TYPE_UINT16
 								: VK_INDEX_TYPE_UINT32
 							);
-						vkCmdDrawIndexed(m_commandBuffer
-							, numIndices
-							, draw.m_numInstances
-							, draw.m_startIndex
-							, draw.m_stream[0].m_startVertex
-							, 0
-							);
 					}
+					vkCmdDrawIndexed(commandBuffer
+						, numIndices
+						, draw.m_numInstances
+						, draw.m_startIndex
+						, draw.m_stream[0].m_startVertex
+						, 0
+						);
+				}
+
+				uint32_t numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
+				uint32_t numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
+
+				m_numPrimsSubmitted[primIndex] += numPrimsSubmitted;
+				m_numPrimsRendered[primIndex]  += numPrimsRendered;
+				m_numInstances[primIndex]      += draw.m_numInstances;
+				m_numIndices                   += numIndices;
+			}
+		}
+
+		if (VK_NULL_HANDLE != commandBuffer)
+		{
+			VK_CHECK(vkEndCommandBuffer(commandBuffer) );
+		}
+	}
+
+	struct RecordJobVK
+	{
+		static void execute(void* _userData, uint32_t _idx)
+		{
+			const RecordJobVK& job = *(const RecordJobVK*)_userData;
+			s_renderVK->m_recorder[_idx].record(job.m_render, job.m_range[_idx], s_renderVK->m_uniformState[_idx]);
+		}
+
+		Frame* m_render;
+		const RenderItemRange* m_range;
+	};
+
+	void RendererContextVK::clearView(const Frame* _render, uint16_t _view, const VkRenderPassBeginInfo& _rpbi)
+	{
+		const Clear& clr = _render->m_view[_view].m_clear;
+		if (BGFX_CLEAR_NONE != clr.m_flags)
+		{
+			const Rect& rect        = _render->m_view[_view].m_rect;
+			const Rect& scissorRect = _render->m_view[_view].m_scissor;
+
+			Rect clearRect = rect;
+			clearRect.setIntersect(rect, scissorRect.isZero() ? rect : scissorRect);
+
+			vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_INLINE);
+			clearQuad(m_commandBuffer, clearRect, clr, _render->m_colorPalette);
+			vkCmdEndRenderPass(m_commandBuffer);
+		}
+	}
+
+	void RendererContextVK::submitBlit(BlitState& _bs, uint16_t _view)
+	{
+		while (_bs.hasItem(_view) )
+		{
+			const BlitItem& blit = _bs.advance();
+			BX_UNUSED(blit);
+		}
+	}
+
+	void RendererContextVK::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
+	{
+		BX_UNUSED(_render, _clearQuad, _textVideoMemBlitter);
+
+		updateResolution(_render->m_resolution);
 
-					uint32_t numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
-					uint32_t numPrimsRendered  = numPrimsSubmitted*draw.m_numInstances;
+		int64_t timeBegin = bx::getHPCounter();
+		int64_t captureElapsed = 0;
+
+//		m_gpuTimer.begin(m_commandList);
 
-					statsNumPrimsSubmitted[primIndex] += numPrimsSubmitted;
-					statsNumPrimsRendered[primIndex]  += numPrimsRendered;
-					statsNumInstances[primIndex]      += draw.m_numInstances;
-					statsNumIndices                   += numIndices;
+		if (0 < _render->m_iboffset)
+		{
+//			TransientIndexBuffer* ib = _render->m_transientIb;
+//			m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->m_iboffset, ib->data);
+		}
+
+		if (0 < _render->m_vboffset)
+		{
+//			TransientVertexBuffer* vb = _render->m_transientVb;
+//			m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->m_vboffset, vb->data);
+		}
+
+		_render->sort();
+
+		BlitState bs(_render);
+
+		uint32_t statsNumPrimsSubmitted[BX_COUNTOF(s_primInfo)] = {};
+		uint32_t statsNumPrimsRendered[BX_COUNTOF(s_primInfo)] = {};
+		uint32_t statsNumInstances[BX_COUNTOF(s_primInfo)] = {};
+		uint32_t statsNumIndices = 0;
+		uint32_t statsKeyType[2] = {};
+
+		VkSemaphore renderWait = m_presentDone[m_backBufferColorIdx];
+		VK_CHECK(vkAcquireNextImageKHR(m_device
+				, m_swapchain
+				, UINT64_MAX
+				, renderWait
+				, VK_NULL_HANDLE
+				, &m_backBufferColorIdx
+				) );
+
+		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_backBufferColorIdx];
+
+		{
+			// Clear quad per view, and debug text blit, need scratch space too.
+			const uint32_t numDrawCalls = _render->m_numRenderItems + BGFX_CONFIG_MAX_VIEWS + 1;
+			uint32_t& capacity = m_scratchBufferCapacity[m_backBufferColorIdx];
+			const uint32_t newCapacity = scratchBufferCapacity(capacity, numDrawCalls, s_scratchBufferDrawCallSize);
+
+			if (newCapacity != capacity)
+			{
+				finishAll();
+				scratchBuffer.destroy();
+				scratchBuffer.create(scratchBufferSize(newCapacity, s_scratchBufferDrawCallSize)
+					, 1024 //BGFX_CONFIG_MAX_TEXTURES + BGFX_CONFIG_MAX_SHADERS + BGFX_CONFIG_MAX_DRAW_CALLS
+					);
+				capacity = newCapacity;
+			}
+		}
+
+		VkDescriptorBufferInfo descriptorBufferInfo;
+		scratchBuffer.reset(descriptorBufferInfo);
 
-					if (hasOcclusionQuery)
+		VkCommandBufferBeginInfo cbbi;
+		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cbbi.pNext = NULL;
+		cbbi.flags = 0
+			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+			;
+		cbbi.pInheritanceInfo = NULL;
+
+		m_commandBuffer = m_commandBuffers[m_backBufferColorIdx];
+		VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
+
+		setImageMemoryBarrier(m_commandBuffer
+			, m_backBufferColorImage[m_backBufferColorIdx]
+			, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+			, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+			);
+
+		VkRenderPassBeginInfo rpbi;
+		rpbi.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		rpbi.pNext = NULL;
+		rpbi.renderPass  = m_renderPass;
+		rpbi.framebuffer = m_backBufferColor[m_backBufferColorIdx];
+		rpbi.renderArea.offset.x = 0;
+		rpbi.renderArea.offset.y = 0;
+		rpbi.renderArea.extent = m_sci.imageExtent;
+		rpbi.clearValueCount = 0;
+		rpbi.pClearValues    = NULL;
+
+		bool beginRenderPass = false;
+
+		if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
+		{
+			// Sorted render items are split into ranges recorded in parallel into secondary
+			// command buffers, primary command buffer only switches views and executes them.
+			RenderItemRange range[BGFX_CONFIG_MAX_RECORD_RANGES];
+			const uint32_t maxRanges = bx::min<uint32_t>(BX_COUNTOF(m_recorder), rendererGetNumThreads()*2);
+			const uint32_t numRanges = _render->splitRenderItems(range, maxRanges, BGFX_CONFIG_RECORD_PARALLEL_MIN_ITEMS);
+
+			_render->gatherUniformStates(m_uniformState, range, numRanges);
+
+			{
+				BGFX_PROFILER_SCOPE("bgfx/Record", 0xff2040ff);
+
+				RecordJobVK job;
+				job.m_render = _render;
+				job.m_range  = range;
+				rendererRunJobs(RecordJobVK::execute, &job, numRanges);
+			}
+
+			uint16_t view = UINT16_MAX;
+			bool viewHasDraw = false;
+
+			for (uint32_t ii = 0; ii < numRanges; ++ii)
+			{
+				const CommandRecorderVK& recorder = m_recorder[ii];
+
+				for (uint32_t jj = 0, num = uint32_t(recorder.m_segment.size() ); jj < num; ++jj)
+				{
+					const CommandRecorderVK::Segment& segment = recorder.m_segment[jj];
+
+					if (segment.m_view != view)
+					{
+						if (beginRenderPass)
+						{
+							vkCmdEndRenderPass(m_commandBuffer);
+							beginRenderPass = false;
+						}
+
+						if (UINT16_MAX != view
+						&&  !viewHasDraw)
+						{
+							clearView(_render, view, rpbi);
+						}
+
+						view = segment.m_view;
+						viewHasDraw = false;
+
+						setFrameBuffer(_render->m_view[view].m_fbh);
+						submitBlit(bs, view);
+
+						const Rect& rect = _render->m_view[view].m_rect;
+						rpbi.renderArea.offset.x = rect.m_x;
+						rpbi.renderArea.offset.y = rect.m_y;
+						rpbi.renderArea.extent.width  = rect.m_width;
+						rpbi.renderArea.extent.height = rect.m_height;
+					}
+
+					if (segment.m_compute)
 					{
-//						m_occlusionQuery.begin(m_commandList, _render, draw.m_occlusionQuery);
-//						m_batch.flush(m_commandList);
-//						m_occlusionQuery.end(m_commandList);
+						BX_CHECK(!beginRenderPass, "Compute must be executed outside of render pass.");
 					}
+					else if (!beginRenderPass)
+					{
+						vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+						beginRenderPass = true;
+						viewHasDraw = true;
+					}
+
+					vkCmdExecuteCommands(m_commandBuffer, 1, &segment.m_commandBuffer);
 				}
+
+				for (uint32_t jj = 0; jj < Topology::Count; ++jj)
+				{
+					statsNumPrimsSubmitted[jj] += recorder.m_numPrimsSubmitted[jj];
+					statsNumPrimsRendered[jj]  += recorder.m_numPrimsRendered[jj];
+					statsNumInstances[jj]      += recorder.m_numInstances[jj];
+				}
+
+				statsNumIndices += recorder.m_numIndices;
+				statsKeyType[0] += recorder.m_numKeyType[0];
+				statsKeyType[1] += recorder.m_numKeyType[1];
+			}
+
+			if (beginRenderPass)
+			{
+				vkCmdEndRenderPass(m_commandBuffer);
+				beginRenderPass = false;
+			}
+
+			if (UINT16_MAX != view
+			&&  !viewHasDraw)
+			{
+				clearView(_render, view, rpbi);
 			}
 
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
-//			m_batch.end(m_commandList);
+			// Recorders didn't update renderer uniforms, values at the end of frame are kept
+			// for the next frame.
+			const UniformState& uniformState = m_uniformState[numRanges];
+			for (uint16_t ii = 0; ii < BGFX_CONFIG_MAX_UNIFORMS; ++ii)
+			{
+				if (NULL != uniformState.m_data[ii]
+				&&  NULL != m_uniforms[ii])
+				{
+					updateUniform(ii, uniformState.m_data[ii], uniformState.m_size[ii]);
+				}
+			}
 		}
 
 		int64_t timeEnd = bx::getHPCounter();
@@ -4597,12 +4685,6 @@ BX_UNUSED(presentMin, presentMax);
 //			PIX_ENDEVENT();
 		}
 
-		if (beginRenderPass)
-		{
-			vkCmdEndRenderPass(m_commandBuffer);
-			beginRenderPass = false;
-		}
-
 		setImageMemoryBarrier(m_commandBuffer
 			, m_backBufferColorImage[m_backBufferColorIdx]
 			, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
@@ -4615,6 +4697,11 @@ BX_UNUSED(presentMin, presentMax);
 		finishAll();
 
 		VK_CHECK(vkResetCommandPool(m_device, m_commandPool, 0) );
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_recorder); ++ii)
+		{
+			m_recorder[ii].reset();
+		}
 	}
 
 } /* namespace vk */ } // namespace bgfx
@@ -161,6 +161,7 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdClearAttachments);          \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdResolveImage);              \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdCopyBuffer);                \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdExecuteCommands);           \
 			VK_IMPORT_DEVICE_FUNC(false, vkMapMemory);                    \
 			VK_IMPORT_DEVICE_FUNC(false, vkUnmapMemory);                  \
 			VK_IMPORT_DEVICE_FUNC(false, vkFlushMappedMemoryRanges);      \
@@ -239,18 +240,23 @@ VK_DESTROY
 	class StateCacheT
 	{
 	public:
+		StateCacheT()
+			: m_hashMap(g_allocator)
+		{
+		}
+
 		void add(uint64_t _key, Ty _value)
 		{
 			invalidate(_key);
-			m_hashMap.insert(stl::make_pair(_key, _value) );
+			m_hashMap.insert(_key, _value);
 		}
 
 		Ty find(uint64_t _key)
 		{
-			typename HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			Ty* value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				return it->second;
+				return *value;
 			}
 
 			return 0;
@@ -258,31 +264,31 @@ VK_DESTROY
 
 		void invalidate(uint64_t _key)
 		{
-			typename HashMap::iterator it = m_hashMap.find(_key);
-			if (it != m_hashMap.end() )
+			Ty* value = m_hashMap.find(_key);
+			if (NULL != value)
 			{
-				vkDestroy(it->second);
-				m_hashMap.erase(it);
+				vkDestroy(*value);
+				m_hashMap.remove(_key);
 			}
 		}
 
 		void invalidate()
 		{
-			for (typename HashMap::iterator it = m_hashMap.begin(), itEnd = m_hashMap.end(); it != itEnd; ++it)
+			for (typename HashMap::Iterator it = m_hashMap.first(); m_hashMap.next(it); )
 			{
-				vkDestroy(it->second);
+				vkDestroy(*it.value);
 			}
 
-			m_hashMap.clear();
+			m_hashMap.reset();
 		}
 
 		uint32_t getCount() const
 		{
-			return uint32_t(m_hashMap.size() );
+			return m_hashMap.getNumElements();
 		}
 
 	private:
-		typedef stl::unordered_map<uint64_t, Ty> HashMap;
+		typedef bx::HashMapT<uint64_t, Ty> HashMap;
 		HashMap m_hashMap;
 	};
 
@@ -300,7 +306,9 @@ VK_DESTROY
 		void create(uint32_t _size, uint32_t _maxDescriptors);
 		void destroy();
 		void reset(VkDescriptorBufferInfo& _gpuAddress);
-		void* allocUbv(VkDescriptorBufferInfo& _gpuAddress, uint32_t _size);
+
+		/// Thread safe.
+		void* allocUbv(VkDescriptorBufferInfo& _gpuAddress, VkDescriptorSet& _outDescriptorSet, uint32_t _size);
 
 		VkDescriptorSet* m_descriptorSet;
 		VkBuffer m_buffer;
@@ -448,6 +456,66 @@ VK_DESTROY
 		Attachment m_attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
 	};
 
+	/// Records range of sorted render items into secondary command buffers, one for each part
+	/// of range with the same view and compute/draw type. Each recorder is used by one thread at
+	/// a time, and has its own command pool, uniform state and shader constant staging.
+	class CommandRecorderVK
+	{
+	public:
+		CommandRecorderVK();
+
+		VkResult create();
+		void destroy();
+
+		/// Command buffers must not be in use by GPU.
+		void reset();
+
+		void record(Frame* _render, const RenderItemRange& _range, const UniformState& _uniformState);
+
+		void setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs);
+		void setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs);
+		void setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs);
+
+		struct Segment
+		{
+			VkCommandBuffer m_commandBuffer;
+			uint16_t m_view;
+			bool     m_compute;
+		};
+
+		typedef stl::vector<Segment> SegmentArray;
+		SegmentArray m_segment;
+
+		uint32_t m_numPrimsSubmitted[Topology::Count];
+		uint32_t m_numPrimsRendered[Topology::Count];
+		uint32_t m_numInstances[Topology::Count];
+		uint32_t m_numIndices;
+		uint32_t m_numKeyType[2];
+
+	private:
+		VkCommandBuffer begin(uint16_t _view, bool _compute);
+		VkPipeline getPipeline(uint64_t _state, uint64_t _stencil, uint16_t _declIdx, uint16_t _programIdx, uint8_t _numInstanceData, FrameBufferHandle _fbh);
+		void commit(const UniformBuffer& _uniformBuffer);
+		void commitShaderUniforms(VkCommandBuffer _commandBuffer, uint16_t _programIdx);
+
+		typedef stl::vector<VkCommandBuffer> CommandBufferArray;
+		CommandBufferArray m_commandBuffer;
+		uint32_t m_numCommandBuffers;
+		VkCommandPool m_commandPool;
+
+		// Pipelines used by this recorder in current frame, so that most pipeline lookups
+		// don't have to lock shared pipeline cache.
+		typedef bx::HashMapT<uint32_t, VkPipeline> PipelineMap;
+		PipelineMap m_pipeline;
+
+		UniformState m_uniformState;
+		ViewState m_viewState;
+		uint8_t m_fsScratch[64<<10];
+		uint8_t m_vsScratch[64<<10];
+		uint32_t m_fsChanges;
+		uint32_t m_vsChanges;
+	};
+
 } /* namespace bgfx */ } // namespace vk
 
 #endif // BGFX_RENDERER_VK_H_HEADER_GUARD
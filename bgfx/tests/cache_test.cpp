@@ -0,0 +1,59 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// bgfx_p.h overrides bx debug macros, it must be included first.
+#include "../src/bgfx_p.h"
+#include "test.h"
+
+#include <bx/filepath.h>
+
+namespace
+{
+	bool initWithCache(const char* _cacheDirPath)
+	{
+		bgfx::Init init;
+		init.type         = bgfx::RendererType::Noop;
+		init.cacheDirPath = _cacheDirPath;
+		return bgfx::init(init);
+	}
+}
+
+TEST_CASE("Default callback disk cache cold and warm start", "")
+{
+	bx::FilePath dirPath(bx::Dir::Temp);
+	dirPath.join("bgfx-test-cache");
+
+	bx::Error err;
+	bx::removeAll(dirPath, &err);
+
+	const uint64_t id = UINT64_C(0x0123456789abcdef);
+	const uint8_t data[] = { 'b', 'g', 'f', 'x', 0, 1, 2, 3 };
+
+	// Cold start, cache directory is empty.
+	REQUIRE(initWithCache(dirPath.get() ) );
+	REQUIRE(0 == bgfx::g_callback->cacheReadSize(id) );
+	bgfx::g_callback->cacheWrite(id, data, sizeof(data) );
+	REQUIRE(sizeof(data) == bgfx::g_callback->cacheReadSize(id) );
+	bgfx::shutdown();
+
+	// Warm start, entry written by previous run is found.
+	REQUIRE(initWithCache(dirPath.get() ) );
+	REQUIRE(sizeof(data) == bgfx::g_callback->cacheReadSize(id) );
+
+	uint8_t read[sizeof(data)] = {};
+	REQUIRE(bgfx::g_callback->cacheRead(id, read, sizeof(read) ) );
+	REQUIRE(0 == bx::memCmp(read, data, sizeof(data) ) );
+	bgfx::shutdown();
+
+	// Without cache directory default callback doesn't cache anything.
+	REQUIRE(initWithCache(NULL) );
+	REQUIRE(0 == bgfx::g_callback->cacheReadSize(id) );
+	REQUIRE(!bgfx::g_callback->cacheRead(id, read, sizeof(read) ) );
+	bgfx::shutdown();
+
+	err.reset();
+	bx::removeAll(dirPath, &err);
+	REQUIRE(err.isOk() );
+}
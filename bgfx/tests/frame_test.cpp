@@ -0,0 +1,241 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// bgfx_p.h overrides bx debug macros, it must be included first.
+#include "../src/bgfx_p.h"
+#include "test.h"
+
+namespace
+{
+	struct TestFrame
+	{
+		TestFrame()
+		{
+			m_frame = BX_ALIGNED_NEW(bgfx::g_allocator, bgfx::Frame, BX_CACHE_LINE_SIZE);
+			m_frame->create();
+
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				m_frame->m_viewRemap[ii] = bgfx::ViewId(ii);
+			}
+		}
+
+		~TestFrame()
+		{
+			m_frame->destroy();
+			BX_ALIGNED_DELETE(bgfx::g_allocator, m_frame, BX_CACHE_LINE_SIZE);
+		}
+
+		bgfx::Frame* m_frame;
+	};
+
+	// Vertex count is used to tag each draw with its submission order.
+	void submitTaggedView(bgfx::EncoderImpl& _encoder, bgfx::ViewId _view, uint32_t _tag)
+	{
+		_encoder.setVertexCount(_tag);
+		_encoder.submit(_view, BGFX_INVALID_HANDLE, BGFX_INVALID_HANDLE, 0, false);
+	}
+
+	void submitTagged(bgfx::EncoderImpl& _encoder, uint32_t _tag)
+	{
+		submitTaggedView(_encoder, 0, _tag);
+	}
+}
+
+TEST_CASE("Frame compaction preserves submission order", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	TestFrame test;
+	bgfx::Frame& frame = *test.m_frame;
+	frame.start();
+
+	bgfx::EncoderImpl& encoder0 = *BX_ALIGNED_NEW(bgfx::g_allocator, bgfx::EncoderImpl, BX_CACHE_LINE_SIZE);
+	bgfx::EncoderImpl& encoder1 = *BX_ALIGNED_NEW(bgfx::g_allocator, bgfx::EncoderImpl, BX_CACHE_LINE_SIZE);
+	encoder0.m_key.reset();
+	encoder1.m_key.reset();
+	encoder0.begin(&frame, 0);
+	encoder1.begin(&frame, 1);
+
+	// Encoder 0 takes first slab, encoder 1 second slab, and encoder 0 third one. Both encoders
+	// leave unused slab tails behind.
+	const uint32_t num0 = BGFX_CONFIG_ENCODER_SLAB_SIZE + 44;
+	const uint32_t num1 = 10;
+
+	for (uint32_t ii = 0; ii < BGFX_CONFIG_ENCODER_SLAB_SIZE; ++ii)
+	{
+		submitTagged(encoder0, 1+ii);
+	}
+
+	for (uint32_t ii = 0; ii < num1; ++ii)
+	{
+		submitTagged(encoder1, 100000+ii);
+	}
+
+	for (uint32_t ii = BGFX_CONFIG_ENCODER_SLAB_SIZE; ii < num0; ++ii)
+	{
+		submitTagged(encoder0, 1+ii);
+	}
+
+	encoder0.end(true);
+	encoder1.end(true);
+	frame.finish();
+
+	REQUIRE(frame.m_numRenderItems == num0 + num1);
+
+	uint32_t expected[num0 + num1];
+	uint32_t idx = 0;
+	for (uint32_t ii = 0; ii < BGFX_CONFIG_ENCODER_SLAB_SIZE; ++ii) { expected[idx++] = 1+ii;      }
+	for (uint32_t ii = 0; ii < num1;                          ++ii) { expected[idx++] = 100000+ii; }
+	for (uint32_t ii = BGFX_CONFIG_ENCODER_SLAB_SIZE; ii < num0; ++ii) { expected[idx++] = 1+ii;  }
+
+	for (uint32_t ii = 0; ii < frame.m_numRenderItems; ++ii)
+	{
+		REQUIRE(frame.getRenderItem(ii).draw.m_numVertices == expected[ii]);
+		REQUIRE(frame.getSortValue(ii) == ii);
+	}
+
+	// All draws have equal sort key, sort must keep them in submission order.
+	frame.sort();
+
+	for (uint32_t ii = 0; ii < frame.m_numRenderItems; ++ii)
+	{
+		REQUIRE(frame.getRenderItem(frame.m_sortValues[ii]).draw.m_numVertices == expected[ii]);
+	}
+
+	BX_ALIGNED_DELETE(bgfx::g_allocator, &encoder0, BX_CACHE_LINE_SIZE);
+	BX_ALIGNED_DELETE(bgfx::g_allocator, &encoder1, BX_CACHE_LINE_SIZE);
+}
+
+TEST_CASE("Frame merge of sorted runs orders equal keys by position", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	TestFrame test;
+	bgfx::Frame& frame = *test.m_frame;
+	frame.start();
+
+	// Two runs, each already sorted, sharing some keys. Second run is registered first, as
+	// if its encoder finished earlier.
+	const uint64_t keys[] = { 1, 2, 2, 3, /**/ 2, 2, 3, 3 };
+	const uint32_t num = BX_COUNTOF(keys);
+
+	frame.allocRenderItemChunk(0);
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		frame.getSortKey(ii)   = keys[ii];
+		frame.getSortValue(ii) = bgfx::RenderItemCount(ii);
+	}
+
+	frame.m_numRenderItems = num;
+	frame.addRun(4, 8);
+	frame.addRun(0, 4);
+
+	frame.reserveSortKeys(num);
+	frame.mergeRuns();
+
+	const bgfx::RenderItemCount expected[] = { 0, 1, 2, 4, 5, 3, 6, 7 };
+	REQUIRE(frame.m_numRenderItems == num);
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		REQUIRE(frame.m_sortKeys[ii]   == keys[expected[ii] ]);
+		REQUIRE(frame.m_sortValues[ii] == expected[ii]);
+	}
+
+	// Gathering runs for full sort must not depend on registration order either.
+	frame.m_numRenderItems = num;
+	frame.m_numRuns = 0;
+	frame.addRun(4, 8);
+	frame.addRun(0, 4);
+
+	bgfx::ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+	for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+	{
+		viewRemap[ii] = bgfx::ViewId(ii);
+	}
+
+	frame.gatherRuns(viewRemap);
+	REQUIRE(frame.m_numRenderItems == num);
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		REQUIRE(frame.m_sortValues[ii] == ii);
+	}
+}
+
+TEST_CASE("Frame sort computes per draw change masks", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	TestFrame test;
+	bgfx::Frame& frame = *test.m_frame;
+	frame.start();
+
+	bgfx::EncoderImpl& encoder = *BX_ALIGNED_NEW(bgfx::g_allocator, bgfx::EncoderImpl, BX_CACHE_LINE_SIZE);
+	encoder.m_key.reset();
+	encoder.begin(&frame, 0);
+
+	const uint64_t stateA = BGFX_STATE_WRITE_RGB|BGFX_STATE_WRITE_Z|BGFX_STATE_DEPTH_TEST_LESS;
+	const uint64_t stateB = BGFX_STATE_WRITE_RGB;
+
+	struct Draw { bgfx::ViewId view; uint64_t state; bool scissor; uint32_t stencil; };
+	const Draw draws[] =
+	{
+		{ 0, stateA, false, BGFX_STENCIL_NONE },
+		{ 0, stateA, false, BGFX_STENCIL_NONE },
+		{ 0, stateB, false, BGFX_STENCIL_NONE },
+		{ 0, stateB, true,  BGFX_STENCIL_NONE },
+		{ 0, stateB, true,  BGFX_STENCIL_TEST_ALWAYS },
+		{ 1, stateB, true,  BGFX_STENCIL_TEST_ALWAYS },
+		{ 1, stateB, true,  BGFX_STENCIL_TEST_ALWAYS },
+	};
+
+	const uint8_t expected[] =
+	{
+		BGFX_DRAW_CHANGED_ALL,
+		0,
+		BGFX_DRAW_CHANGED_STATE,
+		BGFX_DRAW_CHANGED_SCISSOR,
+		BGFX_DRAW_CHANGED_STENCIL,
+		BGFX_DRAW_CHANGED_ALL,
+		0,
+	};
+
+	// All scissored draws use the same cached rect.
+	const uint16_t scissor = encoder.setScissor(0, 0, 16, 16);
+	encoder.setScissor(UINT16_MAX);
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(draws); ++ii)
+	{
+		const Draw& draw = draws[ii];
+		encoder.setState(draw.state, 0);
+		encoder.setStencil(draw.stencil, BGFX_STENCIL_NONE);
+
+		if (draw.scissor)
+		{
+			encoder.setScissor(scissor);
+		}
+
+		submitTaggedView(encoder, draw.view, 3);
+	}
+
+	encoder.end(true);
+	frame.finish();
+	frame.sort();
+
+	REQUIRE(frame.m_numRenderItems == BX_COUNTOF(draws) );
+
+	for (uint32_t ii = 0; ii < frame.m_numRenderItems; ++ii)
+	{
+		INFO("item " << ii);
+		REQUIRE(frame.m_drawChanged[ii] == expected[ii]);
+	}
+
+	BX_ALIGNED_DELETE(bgfx::g_allocator, &encoder, BX_CACHE_LINE_SIZE);
+}
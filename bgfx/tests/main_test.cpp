@@ -0,0 +1,24 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "test.h"
+
+static const char* s_argv[] = { "bgfx.test" };
+
+int runAllTests(int _argc, const char* _argv[]);
+
+#if BX_PLATFORM_ANDROID
+#	include <android/native_activity.h>
+
+void ANativeActivity_onCreate(ANativeActivity*, void*, size_t)
+{
+	exit(runAllTests(BX_COUNTOF(s_argv), s_argv) );
+}
+#else
+int main(int _argc, const char* _argv[])
+{
+	return runAllTests(_argc, _argv);
+}
+#endif // BX_PLATFORM
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "test.h"
+#include <bx/filepath.h>
+
+TEST_CASE("Replay doesn't carry stats over to frames that were not submitted", "")
+{
+	bx::FilePath filePath(bx::Dir::Temp);
+	filePath.join("bgfx_replay_test.bin");
+
+	const uint32_t numDraws = 5;
+
+	{
+		bgfx::Init init;
+		init.type = bgfx::RendererType::Noop;
+		init.recordFilePath = filePath.get();
+		REQUIRE(bgfx::init(init) );
+
+		bgfx::ProgramHandle program = createTestProgram();
+		REQUIRE(bgfx::isValid(program) );
+
+		bgfx::VertexDecl decl;
+		decl.begin()
+			.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float)
+			.end();
+
+		const float vertices[3][4] = {};
+		bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices) ), decl);
+		REQUIRE(bgfx::isValid(vbh) );
+
+		for (uint32_t frame = 0; frame < 3; ++frame)
+		{
+			for (uint32_t ii = 0; ii < numDraws; ++ii)
+			{
+				bgfx::setVertexBuffer(0, vbh);
+				bgfx::submit(0, program);
+			}
+
+			bgfx::frame();
+		}
+
+		bgfx::destroy(vbh);
+		bgfx::destroy(program);
+		bgfx::shutdown();
+	}
+
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+	REQUIRE(bgfx::replayBegin(filePath.get(), init) );
+
+	uint32_t numFrames    = 0;
+	uint32_t numSubmitted = 0;
+	uint32_t numDraw      = 0;
+
+	for (const bgfx::Stats* stats = bgfx::replayFrame(); NULL != stats; stats = bgfx::replayFrame() )
+	{
+		++numFrames;
+		numDraw += stats->numDraw;
+
+		if (0 != stats->numDraw)
+		{
+			CHECK(numDraws == stats->numDraw);
+			++numSubmitted;
+		}
+	}
+
+	bgfx::replayEnd();
+	bx::remove(filePath);
+
+	// Renderer init and shutdown frames are recorded, but they are not submitted,
+	// and must not report draws of frame replayed before them.
+	REQUIRE(3 < numFrames);
+	REQUIRE(3 == numSubmitted);
+	REQUIRE(3*numDraws == numDraw);
+}
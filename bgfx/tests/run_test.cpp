@@ -0,0 +1,12 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#define CATCH_CONFIG_RUNNER
+#include "test.h"
+
+int runAllTests(int _argc, const char* _argv[])
+{
+	return Catch::Session().run(_argc, _argv);
+}
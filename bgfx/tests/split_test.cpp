@@ -0,0 +1,145 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// bgfx_p.h overrides bx debug macros, it must be included first.
+#include "../src/bgfx_p.h"
+#include "test.h"
+
+#include <bx/math.h>
+
+namespace
+{
+	const uint32_t kNumViews        = 3;
+	const uint32_t kNumDrawsPerView = 3000;
+}
+
+TEST_CASE("Split ranges clear each view once and cover all draws", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::Frame& frame = *BX_ALIGNED_NEW(bgfx::g_allocator, bgfx::Frame, BX_CACHE_LINE_SIZE);
+	frame.create();
+
+	for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+	{
+		frame.m_viewRemap[ii] = bgfx::ViewId(ii);
+		frame.m_view[ii].m_clear.m_flags = BGFX_CLEAR_NONE;
+	}
+
+	// Middle view has no clear.
+	frame.m_view[0].m_clear.m_flags = BGFX_CLEAR_COLOR;
+	frame.m_view[2].m_clear.m_flags = BGFX_CLEAR_COLOR|BGFX_CLEAR_DEPTH;
+
+	frame.start();
+
+	bgfx::EncoderImpl& encoder = *BX_ALIGNED_NEW(bgfx::g_allocator, bgfx::EncoderImpl, BX_CACHE_LINE_SIZE);
+	encoder.m_key.reset();
+	encoder.begin(&frame, 0);
+
+	for (uint32_t view = 0; view < kNumViews; ++view)
+	{
+		for (uint32_t ii = 0; ii < kNumDrawsPerView; ++ii)
+		{
+			encoder.setVertexCount(3);
+			encoder.submit(bgfx::ViewId(view), BGFX_INVALID_HANDLE, BGFX_INVALID_HANDLE, 0, false);
+		}
+	}
+
+	encoder.end(true);
+	frame.finish();
+	frame.sort();
+
+	REQUIRE(frame.m_numRenderItems == kNumViews*kNumDrawsPerView);
+
+	// Small minimum range size forces splits inside views.
+	bgfx::RenderItemRange range[BGFX_CONFIG_MAX_RECORD_RANGES];
+	const uint32_t numRanges = frame.splitRenderItems(range, 8, 64);
+	REQUIRE(numRanges > kNumViews);
+
+	uint32_t numDraws  = 0;
+	uint32_t numSplitInView = 0;
+	uint32_t numClears[kNumViews] = {};
+
+	for (uint32_t rr = 0; rr < numRanges; ++rr)
+	{
+		REQUIRE(range[rr].m_begin == (0 == rr ? 0 : range[rr-1].m_end) );
+		REQUIRE(range[rr].m_begin <  range[rr].m_end);
+
+		numSplitInView += !frame.isSegmentBegin(range[rr].m_begin);
+
+		// Same decision backend recorder makes for each item of its range.
+		for (uint32_t ii = range[rr].m_begin; ii < range[rr].m_end; ++ii)
+		{
+			const uint64_t key = frame.m_sortKeys[ii];
+			REQUIRE(0 != (key & SORT_KEY_DRAW_BIT) );
+			++numDraws;
+
+			const bgfx::ViewId view = bgfx::SortKey::decodeView(key);
+			if (frame.isSegmentBegin(ii)
+			&&  BGFX_CLEAR_NONE != frame.m_view[view].m_clear.m_flags)
+			{
+				++numClears[view];
+			}
+		}
+	}
+
+	REQUIRE(range[numRanges-1].m_end == frame.m_numRenderItems);
+	REQUIRE(0 < numSplitInView);
+	REQUIRE(numDraws == kNumViews*kNumDrawsPerView);
+	REQUIRE(numClears[0] == 1);
+	REQUIRE(numClears[1] == 0);
+	REQUIRE(numClears[2] == 1);
+
+	BX_ALIGNED_DELETE(bgfx::g_allocator, &encoder, BX_CACHE_LINE_SIZE);
+	frame.destroy();
+	BX_ALIGNED_DELETE(bgfx::g_allocator, &frame, BX_CACHE_LINE_SIZE);
+}
+
+TEST_CASE("No-op renderer counts draws recorded in split ranges", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::ProgramHandle program = createTestProgram();
+	REQUIRE(bgfx::isValid(program) );
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float)
+		.end();
+
+	const float vertices[3][4] = {};
+	bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices) ), decl);
+
+	for (uint32_t view = 0; view < kNumViews; ++view)
+	{
+		bgfx::setViewClear(bgfx::ViewId(view), 1 == view ? BGFX_CLEAR_NONE : BGFX_CLEAR_COLOR);
+	}
+
+	// Enough draws that frame is split into multiple ranges recorded by job threads. Stats
+	// returned by getStats are from frame rendered before last one.
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		for (uint32_t view = 0; view < kNumViews; ++view)
+		{
+			for (uint32_t ii = 0; ii < kNumDrawsPerView; ++ii)
+			{
+				bgfx::setVertexBuffer(0, vbh);
+				bgfx::submit(bgfx::ViewId(view), program);
+			}
+		}
+
+		bgfx::frame();
+	}
+
+	const bgfx::Stats* stats = bgfx::getStats();
+	REQUIRE(BGFX_CONFIG_RECORD_PARALLEL_MIN_ITEMS < kNumViews*kNumDrawsPerView);
+	REQUIRE(stats->numDraw    == kNumViews*kNumDrawsPerView);
+	REQUIRE(stats->numCompute == 0);
+
+	bgfx::destroy(vbh);
+	bgfx::destroy(program);
+}
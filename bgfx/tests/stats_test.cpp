@@ -0,0 +1,143 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "test.h"
+#include <bx/math.h>
+
+namespace
+{
+	// Stats returned by getStats are from frame rendered before last one, submit same
+	// draws for few frames so that they show up.
+	const bgfx::Stats* submitFrames(bgfx::ProgramHandle _program, bgfx::VertexBufferHandle _vbh, uint32_t _num, bgfx::DynamicVertexBufferHandle _buffer)
+	{
+		float mtx[16];
+		bx::mtxIdentity(mtx);
+
+		for (uint32_t frame = 0; frame < 3; ++frame)
+		{
+			bgfx::Encoder* encoder = bgfx::begin();
+			encoder->setAutoInstancing(true, 64);
+
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				if (bgfx::isValid(_buffer) )
+				{
+					// Only access differs between halves, texture flags don't apply to buffers.
+					encoder->setBuffer(0, _buffer, ii < _num/2 ? bgfx::Access::Read : bgfx::Access::ReadWrite);
+				}
+
+				encoder->setTransform(mtx);
+				encoder->setVertexBuffer(0, _vbh);
+				encoder->submit(0, _program);
+			}
+
+			bgfx::end(encoder);
+			bgfx::frame();
+		}
+
+		return bgfx::getStats();
+	}
+}
+
+TEST_CASE("Stats count each draw merged by auto instancing", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::ProgramHandle program = createTestProgram();
+	REQUIRE(bgfx::isValid(program) );
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float)
+		.end();
+
+	const float vertices[3][4] = {};
+	bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices) ), decl);
+	REQUIRE(bgfx::isValid(vbh) );
+
+	const bgfx::Stats* stats = submitFrames(program, vbh, 10, BGFX_INVALID_HANDLE);
+	REQUIRE(stats->numDraw         == 10);
+	REQUIRE(stats->numBatches      == 1);
+	REQUIRE(stats->numBatchedDraws == 10);
+
+	bgfx::DynamicVertexBufferHandle buffer = bgfx::createDynamicVertexBuffer(4, decl, BGFX_BUFFER_COMPUTE_READ_WRITE);
+	REQUIRE(bgfx::isValid(buffer) );
+
+	stats = submitFrames(program, vbh, 10, buffer);
+	REQUIRE(stats->numDraw         == 10);
+	REQUIRE(stats->numBatches      == 2);
+	REQUIRE(stats->numBatchedDraws == 10);
+
+	bgfx::destroy(buffer);
+	bgfx::destroy(vbh);
+	bgfx::destroy(program);
+}
+
+TEST_CASE("Draws are dropped when matrix cache overflows", "")
+{
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+	init.limits.maxDrawCalls = 1000;
+	REQUIRE(bgfx::init(init) );
+
+	bgfx::ProgramHandle program = createTestProgram();
+	REQUIRE(bgfx::isValid(program) );
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float)
+		.end();
+
+	const float vertices[3][4] = {};
+	bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices) ), decl);
+	REQUIRE(bgfx::isValid(vbh) );
+
+	float mtx[16];
+	bx::mtxIdentity(mtx);
+
+	const bgfx::Stats* stats = NULL;
+
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		// Matrix cache has room for maxDrawCalls matrices (index 0 is identity), leave
+		// only 100 of them for draws below.
+		bgfx::Transform transform;
+		for (uint32_t ii = 0; ii < 3; ++ii)
+		{
+			REQUIRE(UINT32_MAX != bgfx::allocTransform(&transform, 300) );
+			REQUIRE(300 == transform.num);
+			REQUIRE(NULL != transform.data);
+		}
+
+		REQUIRE(UINT32_MAX == bgfx::allocTransform(&transform, 300) );
+		REQUIRE(0 == transform.num);
+		REQUIRE(NULL == transform.data);
+
+		uint32_t numFailed = 0;
+		for (uint32_t ii = 0; ii < 110; ++ii)
+		{
+			numFailed += UINT32_MAX == bgfx::setTransform(mtx) ? 1 : 0;
+			bgfx::setVertexBuffer(0, vbh);
+			bgfx::submit(0, program);
+		}
+
+		REQUIRE(10 == numFailed);
+
+		// Failed allocation passed as cached transform drops draw too.
+		bgfx::setTransform(UINT32_MAX);
+		bgfx::setVertexBuffer(0, vbh);
+		bgfx::submit(0, program);
+
+		bgfx::frame();
+		stats = bgfx::getStats();
+	}
+
+	REQUIRE(100 == stats->numDraw);
+
+	bgfx::destroy(vbh);
+	bgfx::destroy(program);
+	bgfx::shutdown();
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_TEST_H_HEADER_GUARD
+#define BGFX_TEST_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+BX_PRAGMA_DIAGNOSTIC_PUSH();
+BX_PRAGMA_DIAGNOSTIC_IGNORED_MSVC(4312); // warning C4312 : 'reinterpret_cast' : conversion from 'int' to 'const char *' of greater size
+#include <catch/catch.hpp>
+BX_PRAGMA_DIAGNOSTIC_POP();
+
+#include <bgfx/bgfx.h>
+
+/// Initializes bgfx with no-op renderer for the duration of test scope. Tests
+/// that need internals (Frame, EncoderImpl) include src/bgfx_p.h directly.
+struct NoopContext
+{
+	NoopContext(uint32_t _maxEncoders = 0)
+	{
+		bgfx::Init init;
+		init.type = bgfx::RendererType::Noop;
+
+		if (0 != _maxEncoders)
+		{
+			init.limits.maxEncoders = uint16_t(_maxEncoders);
+		}
+
+		m_valid = bgfx::init(init);
+	}
+
+	~NoopContext()
+	{
+		if (m_valid)
+		{
+			bgfx::shutdown();
+		}
+	}
+
+	bool m_valid;
+};
+
+/// Creates program from empty shader binaries. Only usable with no-op renderer,
+/// which doesn't look at shader code.
+inline bgfx::ProgramHandle createTestProgram()
+{
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t hashIn;
+		uint32_t hashOut;
+		uint16_t count;
+	};
+
+	const uint32_t hash = 0x7e57;
+
+	const Header vsh = { BX_MAKEFOURCC('V', 'S', 'H', 6), 0, hash, 0 };
+	const Header fsh = { BX_MAKEFOURCC('F', 'S', 'H', 6), hash, 0, 0 };
+
+	return bgfx::createProgram(
+		  bgfx::createShader(bgfx::copy(&vsh, 14) )
+		, bgfx::createShader(bgfx::copy(&fsh, 14) )
+		, true
+		);
+}
+
+#endif // BGFX_TEST_H_HEADER_GUARD
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// bgfx_p.h overrides bx debug macros, it must be included first.
+#include "../src/bgfx_p.h"
+#include "test.h"
+
+// Texel value encodes its position in texture, so that composed data can be checked.
+static uint32_t getTexel(uint32_t _x, uint32_t _y)
+{
+	return 0xab000000 | (_y<<8) | _x;
+}
+
+static uint32_t writeUpdate(bgfx::CommandBuffer& _cmdbuf, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height, uint16_t _pitch = UINT16_MAX)
+{
+	const uint32_t pitch = UINT16_MAX == _pitch ? _width*4 : _pitch;
+	const bgfx::Memory* mem = bgfx::alloc(pitch*_height);
+	bx::memSet(mem->data, 0, mem->size);
+
+	for (uint32_t yy = 0; yy < _height; ++yy)
+	{
+		uint32_t* row = (uint32_t*)&mem->data[yy*pitch];
+		for (uint32_t xx = 0; xx < _width; ++xx)
+		{
+			row[xx] = getTexel(_x+xx, _y+yy);
+		}
+	}
+
+	bgfx::TextureUpdate update;
+	update.handle.idx    = 7;
+	update.side          = 0;
+	update.mip           = 0;
+	update.rect.m_x      = _x;
+	update.rect.m_y      = _y;
+	update.rect.m_width  = _width;
+	update.rect.m_height = _height;
+	update.zz            = 0;
+	update.depth         = 1;
+	update.pitch         = _pitch;
+	update.format        = uint8_t(bgfx::TextureFormat::RGBA8);
+	update.mem           = mem;
+
+	const uint32_t pos = _cmdbuf.m_pos;
+	bgfx::writeTextureUpdate(_cmdbuf, update);
+	return pos;
+}
+
+static bool checkTexels(const bgfx::TextureUpdate& _update)
+{
+	const bgfx::Rect& rect = _update.rect;
+	const uint32_t* data = (const uint32_t*)_update.mem->data;
+
+	if (_update.mem->size != uint32_t(rect.m_width*rect.m_height*4) )
+	{
+		return false;
+	}
+
+	for (uint32_t yy = 0; yy < rect.m_height; ++yy)
+	{
+		for (uint32_t xx = 0; xx < rect.m_width; ++xx)
+		{
+			if (getTexel(rect.m_x+xx, rect.m_y+yy) != data[yy*rect.m_width+xx])
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+TEST_CASE("Adjacent texture updates are merged", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::CommandBuffer cmdbuf;
+	cmdbuf.start();
+
+	// Two halves of top row, and bottom row with padded pitch, cover 8x4 rectangle.
+	uint32_t pos[6];
+	pos[0] = writeUpdate(cmdbuf, 0, 0, 4, 2);
+	pos[1] = writeUpdate(cmdbuf, 4, 0, 4, 2);
+	pos[2] = writeUpdate(cmdbuf, 0, 2, 8, 2, 40);
+
+	// Doesn't touch rectangle above, next update touches it.
+	pos[3] = writeUpdate(cmdbuf, 10, 10, 2, 2);
+	pos[4] = writeUpdate(cmdbuf, 12, 10, 2, 2);
+
+	// Touches rectangle above only at corner.
+	pos[5] = writeUpdate(cmdbuf, 14, 12, 2, 2);
+
+	cmdbuf.finish();
+
+	bgfx::TextureUpdateStaging staging;
+	bgfx::TextureUpdate update;
+
+	uint32_t ii = 0;
+	uint32_t numCommands = 0;
+
+	while (ii < BX_COUNTOF(pos) )
+	{
+		const uint32_t merged = bgfx::mergeTextureUpdates(cmdbuf, &pos[ii], BX_COUNTOF(pos)-ii, update, staging);
+		REQUIRE(0 < merged);
+
+		CHECK(7 == update.handle.idx);
+		CHECK(bgfx::TextureFormat::RGBA8 == update.format);
+		CHECK(1 == update.depth);
+		CHECK(checkTexels(update) );
+
+		switch (numCommands)
+		{
+		case 0:
+			CHECK(3 == merged);
+			CHECK( 0 == update.rect.m_x);
+			CHECK( 0 == update.rect.m_y);
+			CHECK( 8 == update.rect.m_width);
+			CHECK( 4 == update.rect.m_height);
+			CHECK(UINT16_MAX == update.pitch);
+			break;
+
+		case 1:
+			CHECK(2 == merged);
+			CHECK(10 == update.rect.m_x);
+			CHECK(10 == update.rect.m_y);
+			CHECK( 4 == update.rect.m_width);
+			CHECK( 2 == update.rect.m_height);
+			break;
+
+		case 2:
+			CHECK(1 == merged);
+			CHECK(14 == update.rect.m_x);
+			CHECK(12 == update.rect.m_y);
+			CHECK(update.mem != &staging.m_mem);
+			bgfx::release(update.mem);
+			break;
+		}
+
+		ii += merged;
+		++numCommands;
+	}
+
+	CHECK(3 == numCommands);
+
+	staging.destroy();
+	cmdbuf.destroy();
+}
+
+TEST_CASE("Compressed texture updates are not merged", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::CommandBuffer cmdbuf;
+	cmdbuf.start();
+
+	uint32_t pos[2];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(pos); ++ii)
+	{
+		bgfx::TextureUpdate update;
+		update.handle.idx    = 3;
+		update.side          = 0;
+		update.mip           = 0;
+		update.rect.m_x      = uint16_t(ii*4);
+		update.rect.m_y      = 0;
+		update.rect.m_width  = 4;
+		update.rect.m_height = 4;
+		update.zz            = 0;
+		update.depth         = 1;
+		update.pitch         = UINT16_MAX;
+		update.format        = uint8_t(bgfx::TextureFormat::BC1);
+		update.mem           = bgfx::alloc(8);
+
+		pos[ii] = cmdbuf.m_pos;
+		bgfx::writeTextureUpdate(cmdbuf, update);
+	}
+
+	cmdbuf.finish();
+
+	bgfx::TextureUpdateStaging staging;
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(pos); ++ii)
+	{
+		bgfx::TextureUpdate update;
+		REQUIRE(1 == bgfx::mergeTextureUpdates(cmdbuf, &pos[ii], BX_COUNTOF(pos)-ii, update, staging) );
+		CHECK(bgfx::TextureFormat::BC1 == update.format);
+		CHECK(ii*4 == update.rect.m_x);
+		CHECK(8 == update.mem->size);
+		bgfx::release(update.mem);
+	}
+
+	CHECK(NULL == staging.m_data);
+
+	staging.destroy();
+	cmdbuf.destroy();
+}
+
+TEST_CASE("Adjacent and separate texture updates are flushed at frame", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::TextureHandle handle = bgfx::createTexture2D(16, 16, false, 1, bgfx::TextureFormat::RGBA8);
+	REQUIRE(bgfx::isValid(handle) );
+
+	const uint32_t data[4*4] = {};
+
+	// First two columns are adjacent, last one is separate.
+	const uint16_t columns[] = { 0, 4, 12 };
+
+	for (uint16_t yy = 0; yy < 16; yy += 4)
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(columns); ++ii)
+		{
+			bgfx::updateTexture2D(handle, 0, 0, columns[ii], yy, 4, 4, bgfx::copy(data, sizeof(data) ) );
+		}
+	}
+
+	bgfx::frame();
+	bgfx::frame();
+
+	bgfx::destroy(handle);
+	bgfx::frame();
+}
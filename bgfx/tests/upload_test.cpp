@@ -0,0 +1,192 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+// bgfx_p.h overrides bx debug macros, it must be included first.
+#include "../src/bgfx_p.h"
+#include "test.h"
+
+TEST_CASE("UploadQueue stops upload thread when destroyed without shutdown", "")
+{
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+
+	bgfx::UploadQueue* queue = BX_NEW(bgfx::g_allocator, bgfx::UploadQueue);
+	queue->init();
+
+	static const uint8_t data[16] = { 1, 2, 3, 4 };
+
+	bgfx::UploadItem item;
+	bx::memSet(&item, 0, sizeof(item) );
+	item.m_mem    = bgfx::makeRef(data, sizeof(data) );
+	item.m_type   = bgfx::UploadItem::Type::DynamicVertexBuffer;
+	item.m_handle = 0;
+
+	const uint32_t ticket = queue->push(item);
+
+	bgfx::UploadItem staged;
+	REQUIRE(queue->peek(staged, ticket) );
+	REQUIRE(staged.m_ticket == ticket);
+	REQUIRE(0 == bx::memCmp(staged.m_mem->data, data, sizeof(data) ) );
+	queue->pop();
+	bgfx::release(staged.m_mem);
+
+	// Upload thread is still waiting for next item, destructor must wake it up and join it.
+	BX_DELETE(bgfx::g_allocator, queue);
+}
+
+TEST_CASE("Failed init after asynchronous upload", "")
+{
+	{
+		NoopContext ctx;
+		REQUIRE(ctx.m_valid);
+
+		bgfx::VertexDecl decl;
+		decl.begin()
+			.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float)
+			.end();
+
+		static const float vertices[4][4] = {};
+
+		bgfx::DynamicVertexBufferHandle handle = bgfx::createDynamicVertexBuffer(4, decl);
+		REQUIRE(bgfx::isValid(handle) );
+
+		bgfx::update(handle, 0, bgfx::makeRef(vertices, sizeof(vertices) ) );
+		bgfx::frame();
+		bgfx::frame();
+
+		REQUIRE(0 == bgfx::getStats()->numUploadsPending);
+
+		bgfx::destroy(handle);
+	}
+
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+	init.limits.maxEncoders = 0;
+	REQUIRE(!bgfx::init(init) );
+
+	NoopContext ctx;
+	REQUIRE(ctx.m_valid);
+}
+
+namespace
+{
+	void countRelease(void* /*_ptr*/, void* _userData)
+	{
+		// Called from upload thread.
+		bx::atomicFetchAndAdd<uint32_t>( (volatile uint32_t*)_userData, 1);
+	}
+
+	const uint32_t kUploadSize    = 6<<10;
+	const uint32_t kMaxUploadSize = 4<<10;
+	const uint32_t kNumVertices   = kUploadSize/16;
+	const uint32_t kNumUploads    = 4;
+
+	uint32_t getNumComplete(const uint32_t* _ticket, uint32_t _num)
+	{
+		uint32_t num = 0;
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			if (bgfx::isUploadComplete(_ticket[ii]) )
+			{
+				// Tickets complete in order they were queued.
+				REQUIRE(num == ii);
+				++num;
+			}
+		}
+
+		return num;
+	}
+}
+
+TEST_CASE("Asynchronous uploads are spread over frames and complete in order", "")
+{
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+	init.limits.maxUploadSize = kMaxUploadSize;
+	REQUIRE(bgfx::init(init) );
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 4, bgfx::AttribType::Float)
+		.end();
+
+	static uint8_t data[kUploadSize];
+
+	bgfx::DynamicVertexBufferHandle handle = bgfx::createDynamicVertexBuffer(kNumVertices, decl);
+	REQUIRE(bgfx::isValid(handle) );
+
+	volatile uint32_t numReleased = 0;
+	uint32_t ticket[kNumUploads];
+
+	// Each upload is larger than per frame budget, renderer must get one upload per frame.
+	for (uint32_t ii = 0; ii < kNumUploads; ++ii)
+	{
+		ticket[ii] = bgfx::updateAsync(handle, 0, bgfx::makeRef(data, kUploadSize, countRelease, (void*)&numReleased) );
+	}
+
+	uint32_t totalUploadSize = 0;
+	uint32_t numComplete     = 0;
+	for (uint32_t frame = 0; frame < kNumUploads+4; ++frame)
+	{
+		bgfx::frame();
+
+		const bgfx::Stats* stats = bgfx::getStats();
+		REQUIRE(stats->uploadSize <= kUploadSize);
+		totalUploadSize += stats->uploadSize;
+
+		const uint32_t num = getNumComplete(ticket, kNumUploads);
+		REQUIRE(num - numComplete <= 1);
+		numComplete = num;
+	}
+
+	REQUIRE(kNumUploads == numComplete);
+	REQUIRE(kNumUploads*kUploadSize == totalUploadSize);
+	REQUIRE(kNumUploads == numReleased);
+	REQUIRE(0 == bgfx::getStats()->numUploadsPending);
+
+	// Flushed uploads are passed to renderer in single frame regardless of budget.
+	for (uint32_t ii = 0; ii < kNumUploads; ++ii)
+	{
+		ticket[ii] = bgfx::updateAsync(handle, 0, bgfx::makeRef(data, kUploadSize, countRelease, (void*)&numReleased) );
+	}
+
+	const uint32_t flushFrame = bgfx::flushUpload(ticket[kNumUploads-1]);
+	REQUIRE(2*kNumUploads == numReleased);
+
+	for (uint32_t frame = bgfx::frame(); frame < flushFrame; frame = bgfx::frame() )
+	{
+		REQUIRE(!bgfx::isUploadComplete(ticket[kNumUploads-1]) );
+	}
+
+	REQUIRE(kNumUploads == getNumComplete(ticket, kNumUploads) );
+	REQUIRE(kNumUploads*kUploadSize == bgfx::getStats()->uploadSize);
+
+	// Uploads to destroyed resource are cancelled, not passed to renderer, but their
+	// memory is still released and tickets complete.
+	bgfx::DynamicVertexBufferHandle destroyed = bgfx::createDynamicVertexBuffer(kNumVertices, decl);
+	REQUIRE(bgfx::isValid(destroyed) );
+
+	for (uint32_t ii = 0; ii < kNumUploads; ++ii)
+	{
+		ticket[ii] = bgfx::updateAsync(destroyed, 0, bgfx::makeRef(data, kUploadSize, countRelease, (void*)&numReleased) );
+	}
+
+	bgfx::destroy(destroyed);
+
+	totalUploadSize = 0;
+	for (uint32_t frame = 0; frame < 4; ++frame)
+	{
+		bgfx::frame();
+		totalUploadSize += bgfx::getStats()->uploadSize;
+	}
+
+	REQUIRE(0 == totalUploadSize);
+	REQUIRE(kNumUploads == getNumComplete(ticket, kNumUploads) );
+	REQUIRE(3*kNumUploads == numReleased);
+	REQUIRE(0 == bgfx::getStats()->numUploadsPending);
+
+	bgfx::destroy(handle);
+	bgfx::shutdown();
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <stdio.h>
+
+#include <bx/bx.h>
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bgfx/bgfx.h>
+
+#define BGFX_REPLAY_VERSION_MAJOR 1
+#define BGFX_REPLAY_VERSION_MINOR 0
+
+struct RendererName
+{
+	const char* name;
+	bgfx::RendererType::Enum type;
+};
+
+static const RendererName s_rendererName[] =
+{
+	{ "noop",  bgfx::RendererType::Noop       },
+	{ "d3d9",  bgfx::RendererType::Direct3D9  },
+	{ "d3d11", bgfx::RendererType::Direct3D11 },
+	{ "d3d12", bgfx::RendererType::Direct3D12 },
+	{ "gnm",   bgfx::RendererType::Gnm        },
+	{ "mtl",   bgfx::RendererType::Metal      },
+	{ "gles",  bgfx::RendererType::OpenGLES   },
+	{ "gl",    bgfx::RendererType::OpenGL     },
+	{ "vk",    bgfx::RendererType::Vulkan     },
+};
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		fprintf(stderr, "Error:\n%s\n\n", _error);
+	}
+
+	fprintf(stderr
+		, "replay, bgfx frame recording replay tool, version %d.%d.%d.\n"
+		  "Copyright 2011-2018 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_REPLAY_VERSION_MAJOR
+		, BGFX_REPLAY_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	fprintf(stderr
+		, "Usage: replay -f <in>\n"
+
+		  "\n"
+		  "Frames are recorded by setting `bgfx::Init::recordFilePath`. Recording can be\n"
+		  "replayed only by the same bgfx build.\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -f <file path>           Input file path.\n"
+		  "      --type <renderer>    Renderer type (default: noop).\n"
+		  "           noop, d3d9, d3d11, d3d12, gnm, mtl, gles, gl, vk\n"
+		  "           Shader binaries in recording are backend specific, other than noop\n"
+		  "           renderer must match one used while recording.\n"
+		  "  -n, --loops <num>        Number of times recording is replayed (default: 1).\n"
+		  "      --frames             Print stats of every replayed frame.\n"
+
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		fprintf(stderr
+			, "replay, bgfx frame recording replay tool, version %d.%d.%d.\n"
+			, BGFX_REPLAY_VERSION_MAJOR
+			, BGFX_REPLAY_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	const char* filePath = cmdLine.findOption('f');
+	if (NULL == filePath)
+	{
+		help("Input file name must be specified.");
+		return bx::kExitFailure;
+	}
+
+	bgfx::Init init;
+	init.type = bgfx::RendererType::Noop;
+
+	const char* type = cmdLine.findOption("type");
+	if (NULL != type)
+	{
+		init.type = bgfx::RendererType::Count;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_rendererName); ++ii)
+		{
+			if (0 == bx::strCmpI(type, s_rendererName[ii].name) )
+			{
+				init.type = s_rendererName[ii].type;
+				break;
+			}
+		}
+
+		if (bgfx::RendererType::Count == init.type)
+		{
+			help("Unknown renderer type.");
+			return bx::kExitFailure;
+		}
+	}
+
+	uint32_t numLoops = 1;
+	cmdLine.hasArg(numLoops, 'n', "loops");
+	numLoops = bx::max<uint32_t>(numLoops, 1);
+
+	const bool printFrames = cmdLine.hasArg("frames");
+
+	for (uint32_t loop = 0; loop < numLoops; ++loop)
+	{
+		if (!bgfx::replayBegin(filePath, init) )
+		{
+			fprintf(stderr, "Unable to replay '%s'.\n", filePath);
+			return bx::kExitFailure;
+		}
+
+		uint32_t numFrames = 0;
+		uint64_t numDraw   = 0;
+		double total = 0.0;
+		double min   = 0.0;
+		double max   = 0.0;
+
+		for (const bgfx::Stats* stats = bgfx::replayFrame(); NULL != stats; stats = bgfx::replayFrame() )
+		{
+			const double toMs = 1000.0/double(stats->cpuTimerFreq);
+			const double frameMs = double(stats->cpuTimeFrame)*toMs;
+
+			min = 0 == numFrames ? frameMs : bx::min(min, frameMs);
+			max = bx::max(max, frameMs);
+			total   += frameMs;
+			numDraw += stats->numDraw;
+			++numFrames;
+
+			if (printFrames)
+			{
+				printf("%6d: %8.3f [ms], draw %6d, compute %4d, blit %4d\n"
+					, numFrames
+					, frameMs
+					, stats->numDraw
+					, stats->numCompute
+					, stats->numBlit
+					);
+			}
+		}
+
+		bgfx::replayEnd();
+
+		if (0 == numFrames)
+		{
+			fprintf(stderr, "No frames in '%s'.\n", filePath);
+			return bx::kExitFailure;
+		}
+
+		printf("%s: %d frames, %.3f [ms] total, frame avg %.3f / min %.3f / max %.3f [ms], %.1f draws per frame\n"
+			, filePath
+			, numFrames
+			, total
+			, total/double(numFrames)
+			, min
+			, max
+			, double(numDraw)/double(numFrames)
+			);
+	}
+
+	return bx::kExitSuccess;
+}
@@ -15,6 +15,7 @@ namespace bx
 {
 	struct AllocatorI;
 	class  Error;
+	class  FilePath;
 	struct ReaderSeekerI;
 	struct WriterI;
 
@@ -196,6 +197,7 @@ namespace bimg
 		bool     m_ktx;
 		bool     m_ktxLE;
 		bool     m_srgb;
+		bool     m_mapped;
 	};
 
 	struct ImageMip
@@ -568,6 +570,17 @@ namespace bimg
 		, bx::Error* _err = NULL
 		);
 
+	/// Memory maps DDS, KTX or PVR3 file without copying image data. `m_data` and `m_size` of
+	/// returned container cover the whole file, and `m_offset` is the start of image data inside
+	/// of it, so mips returned by `imageGetRawData` point directly into the mapping. Mapping is
+	/// released by `imageFree`.
+	///
+	ImageContainer* imageMapFile(
+		  bx::AllocatorI* _allocator
+		, const bx::FilePath& _filePath
+		, bx::Error* _err = NULL
+		);
+
 	///
 	ImageContainer* imageParseDds(
 		  bx::AllocatorI* _allocator
@@ -8,6 +8,8 @@
 
 #include "bimg.h"
 
+#include <bx/thread.h>
+
 namespace bimg
 {
 	struct Quality
@@ -33,6 +35,7 @@ namespace bimg
 		, TextureFormat::Enum _format
 		, Quality::Enum _quality
 		, bx::Error* _err = NULL
+		, bx::JobSchedulerI* _jobScheduler = NULL
 		);
 
 	///
@@ -46,6 +49,7 @@ namespace bimg
 		, TextureFormat::Enum _format
 		, Quality::Enum _quality
 		, bx::Error* _err = NULL
+		, bx::JobSchedulerI* _jobScheduler = NULL
 		);
 
 	///
@@ -60,6 +64,7 @@ namespace bimg
 		, TextureFormat::Enum _dstFormat
 		, Quality::Enum _quality
 		, bx::Error* _err
+		, bx::JobSchedulerI* _jobScheduler = NULL
 		);
 
 	///
@@ -68,6 +73,7 @@ namespace bimg
 		, TextureFormat::Enum _dstFormat
 		, Quality::Enum _quality
 		, const ImageContainer& _input
+		, bx::JobSchedulerI* _jobScheduler = NULL
 		);
 
 	///
@@ -167,6 +173,7 @@ namespace bimg
 		, const ImageContainer& _image
 		, LightingModel::Enum _lightingModel
 		, bx::Error* _err
+		, bx::JobSchedulerI* _jobScheduler = NULL
 		);
 
 } // namespace bimg
@@ -10,7 +10,6 @@ project "bimg_decode"
 		path.join(BX_DIR, "include"),
 		path.join(BIMG_DIR, "include"),
 		path.join(BIMG_DIR, "3rdparty"),
-		path.join(BIMG_DIR, "3rdparty/nvtt"),
 		path.join(BIMG_DIR, "3rdparty/iqa/include"),
 	}
 
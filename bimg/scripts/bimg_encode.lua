@@ -10,7 +10,6 @@ project "bimg_encode"
 		path.join(BX_DIR, "include"),
 		path.join(BIMG_DIR, "include"),
 		path.join(BIMG_DIR, "3rdparty"),
-		path.join(BIMG_DIR, "3rdparty/nvtt"),
 		path.join(BIMG_DIR, "3rdparty/iqa/include"),
 	}
 
@@ -26,8 +25,6 @@ project "bimg_encode"
 		path.join(BIMG_DIR, "3rdparty/etc1/**.h"),
 		path.join(BIMG_DIR, "3rdparty/etc2/**.cpp"),
 		path.join(BIMG_DIR, "3rdparty/etc2/**.hpp"),
-		path.join(BIMG_DIR, "3rdparty/nvtt/**.cpp"),
-		path.join(BIMG_DIR, "3rdparty/nvtt/**.h"),
 		path.join(BIMG_DIR, "3rdparty/pvrtc/**.cpp"),
 		path.join(BIMG_DIR, "3rdparty/pvrtc/**.h"),
 		path.join(BIMG_DIR, "3rdparty/astc/**.cpp"),
@@ -70,6 +70,91 @@ dofile "bimg_encode.lua"
 
 dofile(path.join(BX_DIR, "scripts/bx.lua"))
 
+group "tests"
+project "bimg.bench"
+	kind "ConsoleApp"
+
+	debugdir (path.join(BIMG_DIR, "tests"))
+
+	includedirs {
+		path.join(BX_DIR,   "include"),
+		path.join(BIMG_DIR, "include"),
+	}
+
+	files {
+		path.join(BIMG_DIR, "tests/*_bench.cpp"),
+	}
+
+	links {
+		"bimg",
+		"bx",
+	}
+
+	configuration { "vs* or mingw*" }
+		links {
+			"psapi",
+		}
+
+	configuration { "linux-*" }
+		links {
+			"pthread",
+		}
+
+	configuration { "osx" }
+		links {
+			"Cocoa.framework",
+		}
+
+	configuration {}
+
+	strip()
+
+project "bimg.test"
+	kind "ConsoleApp"
+
+	debugdir (path.join(BIMG_DIR, "tests"))
+
+	removeflags {
+		"NoExceptions",
+	}
+
+	includedirs {
+		path.join(BX_DIR,   "include"),
+		path.join(BX_DIR,   "3rdparty"),
+		path.join(BIMG_DIR, "include"),
+	}
+
+	files {
+		path.join(BIMG_DIR, "tests/*_test.cpp"),
+		path.join(BIMG_DIR, "tests/*.h"),
+	}
+
+	links {
+		"bimg_encode",
+		"bimg_decode",
+		"bimg",
+		"bx",
+	}
+
+	configuration { "vs* or mingw*" }
+		links {
+			"psapi",
+		}
+
+	configuration { "linux-*" }
+		links {
+			"pthread",
+		}
+
+	configuration { "osx" }
+		links {
+			"Cocoa.framework",
+		}
+
+	configuration {}
+
+	strip()
+
 if _OPTIONS["with-tools"] then
 	group "tools"
 	dofile "texturec.lua"
@@ -79,6 +79,44 @@ namespace bimg
 		, uint32_t _srcPitch
 		);
 
+	struct Bc6hModeInfo
+	{
+		uint8_t transformed;
+		uint8_t partitionBits;
+		uint8_t endpointBits;
+		uint8_t deltaBits[3];
+	};
+
+	struct Bc7ModeInfo
+	{
+		uint8_t numSubsets;
+		uint8_t partitionBits;
+		uint8_t rotationBits;
+		uint8_t indexSelectionBits;
+		uint8_t colorBits;
+		uint8_t alphaBits;
+		uint8_t endpointPBits;
+		uint8_t sharedPBits;
+		uint8_t indexBits[2];
+	};
+
+	extern const uint16_t     g_bptcP2[64];
+	extern const uint32_t     g_bptcP3[64];
+	extern const uint8_t      g_bptcA2[64];
+	extern const uint8_t      g_bptcA3[2][64];
+	extern const uint8_t      g_bptcFactors[3][16];
+	extern const Bc6hModeInfo g_bc6hModeInfo[32];
+	extern const Bc7ModeInfo  g_bc7ModeInfo[8];
+
+	/// Expands BC7 endpoint to 8 bits by replicating most significant bits.
+	uint8_t bc7Unquantize(uint32_t _value, uint8_t _bits);
+
+	///
+	uint16_t bc6hUnquantize(uint16_t _value, bool _signed, uint8_t _endpointBits);
+
+	///
+	uint16_t bc6hUnquantizeFinal(int32_t _value, bool _signed);
+
 	///
 	bool imageParseGnf(
 		  ImageContainer& _imageContainer
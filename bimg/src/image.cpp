@@ -4,6 +4,7 @@
  */
 
 #include "bimg_p.h"
+#include <bx/file.h>
 #include <bx/hash.h>
 
 #if BIMG_CONFIG_ASTC_DECODE
@@ -1175,6 +1176,443 @@ namespace bimg
 		}
 	}
 
+	typedef void (*ConvertFn)(void* _dst, const void* _src, uint32_t _num);
+
+	// Same as bx::fromUnorm.
+	inline bx::simd128_t simdFromUnorm(bx::simd128_t _value, bx::simd128_t _scale)
+	{
+		using namespace bx;
+		return simd_div(simd_itof(_value), _scale);
+	}
+
+	// Same as bx::toUnorm.
+	inline bx::simd128_t simdToUnorm(bx::simd128_t _value, bx::simd128_t _scale)
+	{
+		using namespace bx;
+		const simd128_t clamped = simd_max(simd_min(_value, simd_splat(1.0f) ), simd_zero() );
+		const simd128_t scaled  = simd_add(simd_mul(clamped, _scale), simd_splat(0.5f) );
+		return simd_ftoi(simd_floor(scaled) );
+	}
+
+	// Same as bx::halfToFloat.
+	inline bx::simd128_t simdHalfToFloat(bx::simd128_t _half)
+	{
+		using namespace bx;
+		const simd128_t h_e         = simd_and(_half, simd_isplat(0x00007c00) );
+		const simd128_t h_m         = simd_and(_half, simd_isplat(0x000003ff) );
+		const simd128_t f_s         = simd_sll(simd_and(_half, simd_isplat(0x00008000) ), 16);
+		const simd128_t f_em        = simd_iadd(simd_sll(simd_or(h_e, h_m), 13), simd_isplat(0x38000000) );
+		const simd128_t f_em_denorm = simd_mul(simd_itof(h_m), simd_splat(1.0f/16777216.0f) );
+		const simd128_t f_em_nan    = simd_or(simd_isplat(0x7f800000), simd_sll(h_m, 13) );
+		const simd128_t is_e_zero   = simd_icmpeq(h_e, simd_zero() );
+		const simd128_t is_e_max    = simd_icmpeq(h_e, simd_isplat(0x00007c00) );
+		const simd128_t f_em_result = simd_selb(is_e_max, f_em_nan, simd_selb(is_e_zero, f_em_denorm, f_em) );
+
+		return simd_or(f_s, f_em_result);
+	}
+
+	// Same as bx::halfFromFloat. Values that round to half denormals are rare, and are converted
+	// with scalar code.
+	inline void simdHalfFromFloat(uint16_t* _dst, bx::simd128_t _value)
+	{
+		using namespace bx;
+		const simd128_t f_abs                  = simd_and(_value, simd_isplat(0x7fffffff) );
+		const simd128_t f_s                    = simd_and(_value, simd_isplat(0x80000000) );
+		const simd128_t f_e                    = simd_and(_value, simd_isplat(0x7f800000) );
+		const simd128_t f_m                    = simd_and(_value, simd_isplat(0x007fffff) );
+		const simd128_t h_s                    = simd_srl(f_s, 16);
+		const simd128_t f_e_half_bias          = simd_isub(simd_srl(f_e, 23), simd_isplat(0x00000070) );
+		const simd128_t f_snan                 = simd_and(_value, simd_isplat(0x7fc00000) );
+		const simd128_t f_m_rounded            = simd_iadd(f_m, simd_sll(simd_and(f_m, simd_isplat(0x00001000) ), 1) );
+		const simd128_t f_m_rounded_overflow   = simd_and(f_m_rounded, simd_isplat(0x00800000) );
+		const simd128_t m_nan                  = simd_srl(f_m, 13);
+		const simd128_t h_em_nan               = simd_or(simd_isplat(0x00007c00), m_nan);
+		const simd128_t h_e_norm_overflow      = simd_sll(simd_iadd(f_e_half_bias, simd_isplat(1) ), 10);
+		const simd128_t h_em_norm              = simd_or(simd_sll(f_e_half_bias, 10), simd_srl(f_m_rounded, 13) );
+		const simd128_t is_f_e_flagged_msb     = simd_isub(simd_isplat(0x0000008f), f_e_half_bias);
+		const simd128_t is_f_m_eqz_msb         = simd_isub(f_m, simd_isplat(1) );
+		const simd128_t is_h_nan_eqz_msb       = simd_isub(m_nan, simd_isplat(1) );
+		const simd128_t is_f_inf_msb           = simd_and(is_f_e_flagged_msb, is_f_m_eqz_msb);
+		const simd128_t is_f_nan_underflow_msb = simd_and(is_f_e_flagged_msb, is_h_nan_eqz_msb);
+		const simd128_t is_e_overflow_msb      = simd_isub(simd_isplat(0x0000001f), f_e_half_bias);
+		const simd128_t is_h_inf_msb           = simd_or(is_e_overflow_msb, is_f_inf_msb);
+		const simd128_t is_f_snan_msb          = simd_not(simd_isub(f_snan, simd_isplat(0x7fc00000) ) );
+		const simd128_t is_m_norm_overflow_msb = simd_isub(simd_zero(), f_m_rounded_overflow);
+		const simd128_t is_zero                = simd_icmpeq(f_abs, simd_zero() );
+		const simd128_t is_h_denorm            = simd_andc(simd_icmplt(f_abs, simd_isplat(0x38800000) ), is_zero);
+		const simd128_t h_em_overflow_result   = simd_sels(is_m_norm_overflow_msb, h_e_norm_overflow, h_em_norm);
+		const simd128_t h_em_nan_result        = simd_sels(is_f_e_flagged_msb, h_em_nan, h_em_overflow_result);
+		const simd128_t h_em_nan_uf_result     = simd_sels(is_f_nan_underflow_msb, simd_isplat(0x00007c01), h_em_nan_result);
+		const simd128_t h_em_inf_result        = simd_sels(is_h_inf_msb, simd_isplat(0x00007c00), h_em_nan_uf_result);
+		const simd128_t h_em_snan_result       = simd_sels(is_f_snan_msb, simd_isplat(0x00007e00), h_em_inf_result);
+		const simd128_t h_result               = simd_or(h_s, simd_andc(h_em_snan_result, is_zero) );
+
+		BX_ALIGN_DECL_16(uint32_t result[4]);
+		simd_st(result, h_result);
+
+		_dst[0] = uint16_t(result[0]);
+		_dst[1] = uint16_t(result[1]);
+		_dst[2] = uint16_t(result[2]);
+		_dst[3] = uint16_t(result[3]);
+
+		if (simd_test_any_xyzw(is_h_denorm) )
+		{
+			BX_ALIGN_DECL_16(float value[4]);
+			simd_st(value, _value);
+
+			for (uint32_t ii = 0; ii < 4; ++ii)
+			{
+				if (0 != (bx::floatToBits(value[ii]) & 0x7fffffff)
+				&&        (bx::floatToBits(value[ii]) & 0x7fffffff) < 0x38800000)
+				{
+					_dst[ii] = bx::halfFromFloat(value[ii]);
+				}
+			}
+		}
+	}
+
+	// SIMD versions of bx::unpack*/bx::pack* functions, operating on all four channels at once.
+	inline bx::simd128_t simdUnpackRgba8(const void* _src)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		return simdFromUnorm(bx::simd_ild(src[0], src[1], src[2], src[3]), bx::simd_splat(255.0f) );
+	}
+
+	inline void simdPackRgba8(void* _dst, bx::simd128_t _rgba)
+	{
+		BX_ALIGN_DECL_16(uint32_t tmp[4]);
+		bx::simd_st(tmp, simdToUnorm(_rgba, bx::simd_splat(255.0f) ) );
+
+		uint8_t* dst = (uint8_t*)_dst;
+		dst[0] = uint8_t(tmp[0]);
+		dst[1] = uint8_t(tmp[1]);
+		dst[2] = uint8_t(tmp[2]);
+		dst[3] = uint8_t(tmp[3]);
+	}
+
+	inline bx::simd128_t simdUnpackBgra8(const void* _src)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		return simdFromUnorm(bx::simd_ild(src[2], src[1], src[0], src[3]), bx::simd_splat(255.0f) );
+	}
+
+	inline void simdPackBgra8(void* _dst, bx::simd128_t _rgba)
+	{
+		BX_ALIGN_DECL_16(uint32_t tmp[4]);
+		bx::simd_st(tmp, simdToUnorm(_rgba, bx::simd_splat(255.0f) ) );
+
+		uint8_t* dst = (uint8_t*)_dst;
+		dst[0] = uint8_t(tmp[2]);
+		dst[1] = uint8_t(tmp[1]);
+		dst[2] = uint8_t(tmp[0]);
+		dst[3] = uint8_t(tmp[3]);
+	}
+
+	inline bx::simd128_t simdUnpackRgba16F(const void* _src)
+	{
+		const uint16_t* src = (const uint16_t*)_src;
+		return simdHalfToFloat(bx::simd_ild(src[0], src[1], src[2], src[3]) );
+	}
+
+	inline void simdPackRgba16F(void* _dst, bx::simd128_t _rgba)
+	{
+		simdHalfFromFloat( (uint16_t*)_dst, _rgba);
+	}
+
+	inline bx::simd128_t simdUnpackRgba32F(const void* _src)
+	{
+		BX_ALIGN_DECL_16(float tmp[4]);
+		bx::memCopy(tmp, _src, 16);
+		return bx::simd_ld(tmp);
+	}
+
+	inline void simdPackRgba32F(void* _dst, bx::simd128_t _rgba)
+	{
+		BX_ALIGN_DECL_16(float tmp[4]);
+		bx::simd_st(tmp, _rgba);
+		bx::memCopy(_dst, tmp, 16);
+	}
+
+	inline bx::simd128_t simdUnpackRgb10A2(const void* _src)
+	{
+		const uint32_t packed = *( (const uint32_t*)_src);
+		return simdFromUnorm(
+			  bx::simd_ild(packed & 0x3ff, (packed>>10) & 0x3ff, (packed>>20) & 0x3ff, packed>>30)
+			, bx::simd_ld(1023.0f, 1023.0f, 1023.0f, 3.0f)
+			);
+	}
+
+	inline void simdPackRgb10A2(void* _dst, bx::simd128_t _rgba)
+	{
+		BX_ALIGN_DECL_16(uint32_t tmp[4]);
+		bx::simd_st(tmp, simdToUnorm(_rgba, bx::simd_ld(1023.0f, 1023.0f, 1023.0f, 3.0f) ) );
+		*( (uint32_t*)_dst) = tmp[0] | (tmp[1]<<10) | (tmp[2]<<20) | (tmp[3]<<30);
+	}
+
+	inline bx::simd128_t simdUnpackR5G6B5(const void* _src)
+	{
+		const uint16_t packed = *( (const uint16_t*)_src);
+		return simdFromUnorm(
+			  bx::simd_ild( (packed>>11) & 0x1f, (packed>>5) & 0x3f, packed & 0x1f, 1)
+			, bx::simd_ld(31.0f, 63.0f, 31.0f, 1.0f)
+			);
+	}
+
+	inline void simdPackR5G6B5(void* _dst, bx::simd128_t _rgba)
+	{
+		BX_ALIGN_DECL_16(uint32_t tmp[4]);
+		bx::simd_st(tmp, simdToUnorm(_rgba, bx::simd_ld(31.0f, 63.0f, 31.0f, 1.0f) ) );
+		*( (uint16_t*)_dst) = uint16_t( (tmp[0]<<11) | (tmp[1]<<5) | tmp[2]);
+	}
+
+	// Single channel formats, four pixels at the time.
+	inline bx::simd128_t simdUnpackR16x4(const void* _src)
+	{
+		const uint16_t* src = (const uint16_t*)_src;
+		return simdFromUnorm(bx::simd_ild(src[0], src[1], src[2], src[3]), bx::simd_splat(65535.0f) );
+	}
+
+	inline void simdPackR16x4(void* _dst, bx::simd128_t _r)
+	{
+		BX_ALIGN_DECL_16(uint32_t tmp[4]);
+		bx::simd_st(tmp, simdToUnorm(_r, bx::simd_splat(65535.0f) ) );
+
+		uint16_t* dst = (uint16_t*)_dst;
+		dst[0] = uint16_t(tmp[0]);
+		dst[1] = uint16_t(tmp[1]);
+		dst[2] = uint16_t(tmp[2]);
+		dst[3] = uint16_t(tmp[3]);
+	}
+
+	inline uint32_t readR24(const uint8_t* _src)
+	{
+		return _src[0] | (_src[1]<<8) | (_src[2]<<16);
+	}
+
+	inline bx::simd128_t simdUnpackR24x4(const void* _src)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		return simdFromUnorm(
+			  bx::simd_ild(readR24(&src[0]), readR24(&src[3]), readR24(&src[6]), readR24(&src[9]) )
+			, bx::simd_splat(16777216.0f)
+			);
+	}
+
+	inline void simdPackR24x4(void* _dst, bx::simd128_t _r)
+	{
+		BX_ALIGN_DECL_16(uint32_t tmp[4]);
+		bx::simd_st(tmp, simdToUnorm(_r, bx::simd_splat(16777216.0f) ) );
+
+		uint8_t* dst = (uint8_t*)_dst;
+		for (uint32_t ii = 0; ii < 4; ++ii, dst += 3)
+		{
+			dst[0] = uint8_t(tmp[ii]    );
+			dst[1] = uint8_t(tmp[ii]>> 8);
+			dst[2] = uint8_t(tmp[ii]>>16);
+		}
+	}
+
+	inline bx::simd128_t simdUnpackR24G8x4(const void* _src)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		return simdFromUnorm(
+			  bx::simd_ild(readR24(&src[0]), readR24(&src[4]), readR24(&src[8]), readR24(&src[12]) )
+			, bx::simd_splat(16777216.0f)
+			);
+	}
+
+	inline bx::simd128_t simdUnpackR32Fx4(const void* _src)
+	{
+		return simdUnpackRgba32F(_src);
+	}
+
+	inline void simdPackR32Fx4(void* _dst, bx::simd128_t _r)
+	{
+		simdPackRgba32F(_dst, _r);
+	}
+
+	typedef bx::simd128_t (*SimdUnpackFn)(const void*);
+	typedef void (*SimdPackFn)(void*, bx::simd128_t);
+
+	// Converts one RGBA pixel per iteration.
+	template<SimdPackFn PackT, uint32_t DstBppT, SimdUnpackFn UnpackT, uint32_t SrcBppT>
+	static void convertSimdRgba(void* _dst, const void* _src, uint32_t _num)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t ii = 0; ii < _num; ++ii, src += SrcBppT/8, dst += DstBppT/8)
+		{
+			PackT(dst, UnpackT(src) );
+		}
+	}
+
+	// Converts four single channel pixels per iteration, remainder goes through temporary.
+	template<SimdPackFn PackT, uint32_t DstBppT, SimdUnpackFn UnpackT, uint32_t SrcBppT>
+	static void convertSimdR(void* _dst, const void* _src, uint32_t _num)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		uint32_t ii = 0;
+		for (const uint32_t num = _num & ~3; ii < num; ii += 4, src += SrcBppT/2, dst += DstBppT/2)
+		{
+			PackT(dst, UnpackT(src) );
+		}
+
+		if (ii < _num)
+		{
+			uint8_t srcTmp[SrcBppT/2] = {};
+			uint8_t dstTmp[DstBppT/2];
+			const uint32_t rest = _num - ii;
+			bx::memCopy(srcTmp, src, rest*SrcBppT/8);
+			PackT(dstTmp, UnpackT(srcTmp) );
+			bx::memCopy(dst, dstTmp, rest*DstBppT/8);
+		}
+	}
+
+	// 8-bit paths don't need to go through float at all.
+	static void convertSwizzleBgra8(void* _dst, const void* _src, uint32_t _num)
+	{
+		using namespace bx;
+
+		const simd128_t mf0f0 = simd_isplat(0xff00ff00);
+		const simd128_t m0f0f = simd_isplat(0x00ff00ff);
+
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		uint32_t ii = 0;
+		for (const uint32_t num = _num & ~3; ii < num; ii += 4, src += 16, dst += 16)
+		{
+			BX_ALIGN_DECL_16(uint32_t tmp[4]);
+			memCopy(tmp, src, 16);
+
+			const simd128_t tabgr = simd_ld(tmp);
+			const simd128_t t00ab = simd_srl(tabgr, 16);
+			const simd128_t tgr00 = simd_sll(tabgr, 16);
+			const simd128_t tgrab = simd_or(t00ab, tgr00);
+			const simd128_t ta0g0 = simd_and(tabgr, mf0f0);
+			const simd128_t t0r0b = simd_and(tgrab, m0f0f);
+			const simd128_t targb = simd_or(ta0g0, t0r0b);
+
+			simd_st(tmp, targb);
+			memCopy(dst, tmp, 16);
+		}
+
+		for (; ii < _num; ++ii, src += 4, dst += 4)
+		{
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = src[3];
+		}
+	}
+
+	static void convertR8ToRgba8(void* _dst, const void* _src, uint32_t _num)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint32_t* dst = (uint32_t*)_dst;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint8_t rgba[4] = { src[ii], 0, 0, 0xff };
+			bx::memCopy(&dst[ii], rgba, 4);
+		}
+	}
+
+	static void convertR8ToBgra8(void* _dst, const void* _src, uint32_t _num)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint32_t* dst = (uint32_t*)_dst;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint8_t bgra[4] = { 0, 0, src[ii], 0xff };
+			bx::memCopy(&dst[ii], bgra, 4);
+		}
+	}
+
+	template<uint32_t ChannelT>
+	static void convert8888ToR8(void* _dst, const void* _src, uint32_t _num)
+	{
+		const uint8_t* src = (const uint8_t*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			dst[ii] = src[ii*4 + ChannelT];
+		}
+	}
+
+	struct ConvertFast
+	{
+		TextureFormat::Enum dstFormat;
+		TextureFormat::Enum srcFormat;
+		ConvertFn convert;
+	};
+
+#define CONVERT_RGBA(_dst, _dstBpp, _src, _srcBpp) convertSimdRgba<simdPack##_dst, _dstBpp, simdUnpack##_src, _srcBpp>
+#define CONVERT_R(_dst, _dstBpp, _src, _srcBpp)    convertSimdR<simdPack##_dst##x4, _dstBpp, simdUnpack##_src##x4, _srcBpp>
+
+	static const ConvertFast s_convertFast[] =
+	{
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA8,   convertSwizzleBgra8                            },
+		{ TextureFormat::RGBA8,   TextureFormat::BGRA8,   convertSwizzleBgra8                            },
+		{ TextureFormat::RGBA8,   TextureFormat::R8,      convertR8ToRgba8                               },
+		{ TextureFormat::BGRA8,   TextureFormat::R8,      convertR8ToBgra8                               },
+		{ TextureFormat::R8,      TextureFormat::RGBA8,   convert8888ToR8<0>                             },
+		{ TextureFormat::R8,      TextureFormat::BGRA8,   convert8888ToR8<2>                             },
+		{ TextureFormat::RGBA32F, TextureFormat::RGBA8,   CONVERT_RGBA(Rgba32F,  128, Rgba8,     32)     },
+		{ TextureFormat::RGBA32F, TextureFormat::BGRA8,   CONVERT_RGBA(Rgba32F,  128, Bgra8,     32)     },
+		{ TextureFormat::RGBA8,   TextureFormat::RGBA32F, CONVERT_RGBA(Rgba8,     32, Rgba32F,  128)     },
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA32F, CONVERT_RGBA(Bgra8,     32, Rgba32F,  128)     },
+		{ TextureFormat::RGBA16F, TextureFormat::RGBA8,   CONVERT_RGBA(Rgba16F,   64, Rgba8,     32)     },
+		{ TextureFormat::RGBA16F, TextureFormat::BGRA8,   CONVERT_RGBA(Rgba16F,   64, Bgra8,     32)     },
+		{ TextureFormat::RGBA8,   TextureFormat::RGBA16F, CONVERT_RGBA(Rgba8,     32, Rgba16F,   64)     },
+		{ TextureFormat::BGRA8,   TextureFormat::RGBA16F, CONVERT_RGBA(Bgra8,     32, Rgba16F,   64)     },
+		{ TextureFormat::RGBA16F, TextureFormat::RGBA32F, CONVERT_RGBA(Rgba16F,   64, Rgba32F,  128)     },
+		{ TextureFormat::RGBA32F, TextureFormat::RGBA16F, CONVERT_RGBA(Rgba32F,  128, Rgba16F,   64)     },
+		{ TextureFormat::RGB10A2, TextureFormat::RGBA8,   CONVERT_RGBA(Rgb10A2,   32, Rgba8,     32)     },
+		{ TextureFormat::RGB10A2, TextureFormat::RGBA16F, CONVERT_RGBA(Rgb10A2,   32, Rgba16F,   64)     },
+		{ TextureFormat::RGB10A2, TextureFormat::RGBA32F, CONVERT_RGBA(Rgb10A2,   32, Rgba32F,  128)     },
+		{ TextureFormat::RGBA8,   TextureFormat::RGB10A2, CONVERT_RGBA(Rgba8,     32, Rgb10A2,   32)     },
+		{ TextureFormat::BGRA8,   TextureFormat::RGB10A2, CONVERT_RGBA(Bgra8,     32, Rgb10A2,   32)     },
+		{ TextureFormat::RGBA16F, TextureFormat::RGB10A2, CONVERT_RGBA(Rgba16F,   64, Rgb10A2,   32)     },
+		{ TextureFormat::RGBA32F, TextureFormat::RGB10A2, CONVERT_RGBA(Rgba32F,  128, Rgb10A2,   32)     },
+		{ TextureFormat::R5G6B5,  TextureFormat::RGBA8,   CONVERT_RGBA(R5G6B5,    16, Rgba8,     32)     },
+		{ TextureFormat::R5G6B5,  TextureFormat::BGRA8,   CONVERT_RGBA(R5G6B5,    16, Bgra8,     32)     },
+		{ TextureFormat::RGBA8,   TextureFormat::R5G6B5,  CONVERT_RGBA(Rgba8,     32, R5G6B5,    16)     },
+		{ TextureFormat::BGRA8,   TextureFormat::R5G6B5,  CONVERT_RGBA(Bgra8,     32, R5G6B5,    16)     },
+		{ TextureFormat::RGBA32F, TextureFormat::R5G6B5,  CONVERT_RGBA(Rgba32F,  128, R5G6B5,    16)     },
+		{ TextureFormat::D32F,    TextureFormat::D16,     CONVERT_R(R32F,         32, R16,       16)     },
+		{ TextureFormat::D32F,    TextureFormat::D24,     CONVERT_R(R32F,         32, R24,       24)     },
+		{ TextureFormat::D32F,    TextureFormat::D24S8,   CONVERT_R(R32F,         32, R24G8,     32)     },
+		{ TextureFormat::D16,     TextureFormat::D32F,    CONVERT_R(R16,          16, R32F,      32)     },
+		{ TextureFormat::D24,     TextureFormat::D32F,    CONVERT_R(R24,          24, R32F,      32)     },
+		{ TextureFormat::R32F,    TextureFormat::D16,     CONVERT_R(R32F,         32, R16,       16)     },
+		{ TextureFormat::R32F,    TextureFormat::D24,     CONVERT_R(R32F,         32, R24,       24)     },
+		{ TextureFormat::R32F,    TextureFormat::D24S8,   CONVERT_R(R32F,         32, R24G8,     32)     },
+	};
+
+#undef CONVERT_RGBA
+#undef CONVERT_R
+
+	static ConvertFn findConvertFast(TextureFormat::Enum _dstFormat, TextureFormat::Enum _srcFormat)
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_convertFast); ++ii)
+		{
+			const ConvertFast& fast = s_convertFast[ii];
+			if (fast.dstFormat == _dstFormat
+			&&  fast.srcFormat == _srcFormat)
+			{
+				return fast.convert;
+			}
+		}
+
+		return NULL;
+	}
+
 	bool imageConvert(bx::AllocatorI* _allocator, void* _dst, TextureFormat::Enum _dstFormat, const void* _src, TextureFormat::Enum _srcFormat, uint32_t _width, uint32_t _height, uint32_t _depth, uint32_t _srcPitch)
 	{
 		UnpackFn unpack = s_packUnpack[_srcFormat].unpack;
@@ -1205,6 +1643,26 @@ namespace bimg
 
 		const uint32_t srcBpp = s_imageBlockInfo[_srcFormat].bitsPerPixel;
 		const uint32_t dstBpp = s_imageBlockInfo[_dstFormat].bitsPerPixel;
+
+		ConvertFn convert = findConvertFast(_dstFormat, _srcFormat);
+		if (NULL != convert)
+		{
+			const uint8_t* src = (const uint8_t*)_src;
+			uint8_t* dst = (uint8_t*)_dst;
+
+			const uint32_t dstPitch = _width * dstBpp / 8;
+
+			for (uint32_t zz = 0; zz < _depth; ++zz)
+			{
+				for (uint32_t yy = 0; yy < _height; ++yy, src += _srcPitch, dst += dstPitch)
+				{
+					convert(dst, src, _width);
+				}
+			}
+
+			return true;
+		}
+
 		imageConvert(_dst, dstBpp, pack, _src, srcBpp, unpack, _width, _height, _depth, _srcPitch);
 
 		return true;
@@ -1473,7 +1931,7 @@ namespace bimg
 	// https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_texture_compression_bptc.txt
 	// https://msdn.microsoft.com/en-us/library/windows/desktop/hh308952(v=vs.85).aspx
 
-	static const uint16_t s_bptcP2[] =
+	const uint16_t g_bptcP2[] =
 	{ //  3210     0000000000   1111111111   2222222222   3333333333
 		0xcccc, // 0, 0, 1, 1,  0, 0, 1, 1,  0, 0, 1, 1,  0, 0, 1, 1
 		0x8888, // 0, 0, 0, 1,  0, 0, 0, 1,  0, 0, 0, 1,  0, 0, 0, 1
@@ -1541,7 +1999,7 @@ namespace bimg
 		0xee22, // 0, 1, 0, 0,  0, 1, 0, 0,  0, 1, 1, 1,  0, 1, 1, 1
 	};
 
-	static const uint32_t s_bptcP3[] =
+	const uint32_t g_bptcP3[] =
 	{ //  76543210     0000   1111   2222   3333   4444   5555   6666   7777
 		0xaa685050, // 0, 0,  1, 1,  0, 0,  1, 1,  0, 2,  2, 1,  2, 2,  2, 2
 		0x6a5a5040,	// 0, 0,  0, 1,  0, 0,  1, 1,  2, 2,  1, 1,  2, 2,  2, 1
@@ -1609,7 +2067,7 @@ namespace bimg
 		0x2a4a5254,	// 0, 1,  1, 1,  2, 0,  1, 1,  2, 2,  0, 1,  2, 2,  2, 0
 	};
 
-	static const uint8_t s_bptcA2[] =
+	const uint8_t g_bptcA2[] =
 	{
 		15, 15, 15, 15, 15, 15, 15, 15,
 		15, 15, 15, 15, 15, 15, 15, 15,
@@ -1621,7 +2079,7 @@ namespace bimg
 		15, 15, 15, 15, 15,  2,  2, 15,
 	};
 
-	static const uint8_t s_bptcA3[2][64] =
+	const uint8_t g_bptcA3[2][64] =
 	{
 		{
 			 3,  3, 15, 15,  8,  3, 15, 15,
@@ -1645,7 +2103,7 @@ namespace bimg
 		},
 	};
 
-	static const uint8_t s_bptcFactors[3][16] =
+	const uint8_t g_bptcFactors[3][16] =
 	{
 		{  0, 21, 43, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
 		{  0,  9, 18, 27, 37, 46, 55, 64,  0,  0,  0,  0,  0,  0,  0,  0 },
@@ -1696,7 +2154,7 @@ namespace bimg
 			}
 
 			const bool sign = !!(_value & 0x8000);
-			_value &= 0x7fff;
+			_value = sign ? -_value : _value;
 
 			uint16_t unq;
 
@@ -1726,7 +2184,7 @@ namespace bimg
 			return 0;
 		}
 
-		if (_value == maxValue)
+		if (_value == (1<<_endpointBits)-1)
 		{
 			return UINT16_MAX;
 		}
@@ -1734,17 +2192,22 @@ namespace bimg
 		return ( (_value<<15) + 0x4000) >> (_endpointBits-1);
 	}
 
-	uint16_t bc6hUnquantizeFinal(uint16_t _value, bool _signed)
+	uint16_t bc6hUnquantizeFinal(int32_t _value, bool _signed)
 	{
 		if (_signed)
 		{
-			const uint16_t sign = _value & 0x8000;
-			_value &= 0x7fff;
-
-			return ( (_value * 31) >> 5) | sign;
+			return _value < 0
+				? uint16_t( ( (-_value * 31) >> 5) | 0x8000)
+				: uint16_t( (  _value * 31) >> 5)
+				;
 		}
 
-		return (_value * 31) >> 6;
+		return uint16_t( (_value * 31) >> 6);
+	}
+
+	inline int32_t bc6hEndpoint(uint16_t _value, bool _signed)
+	{
+		return _signed ? int32_t(int16_t(_value) ) : int32_t(_value);
 	}
 
 	uint16_t signExtend(uint16_t _value, uint8_t _numBits)
@@ -1755,15 +2218,7 @@ namespace bimg
 		return result;
 	}
 
-	struct Bc6hModeInfo
-	{
-		uint8_t transformed;
-		uint8_t partitionBits;
-		uint8_t endpointBits;
-		uint8_t deltaBits[3];
-	};
-
-	static const Bc6hModeInfo s_bc6hModeInfo[] =
+	const Bc6hModeInfo g_bc6hModeInfo[] =
 	{ //  +--------------------------- transformed
 	  //  |  +------------------------ partition bits
 	  //  |  |  +--------------------- endpoint bits
@@ -1813,7 +2268,7 @@ namespace bimg
 			mode |= bit.read(3) << 2;
 		}
 
-		const Bc6hModeInfo& mi = s_bc6hModeInfo[mode];
+		const Bc6hModeInfo& mi = g_bc6hModeInfo[mode];
 		if (0 == mi.endpointBits)
 		{
 			bx::memSet(_dst, 0, 16*3*2);
@@ -2171,7 +2626,7 @@ namespace bimg
 
 		const uint8_t partitionSetIdx = uint8_t(mi.partitionBits ? bit.read(5) : 0);
 		const uint8_t indexBits = mi.partitionBits ? 3 : 4;
-		const uint8_t* factors  = s_bptcFactors[indexBits-2];
+		const uint8_t* factors  = g_bptcFactors[indexBits-2];
 
 		for (uint8_t yy = 0; yy < 4; ++yy)
 		{
@@ -2184,8 +2639,8 @@ namespace bimg
 
 				if (0 != mi.partitionBits)
 				{
-					subsetIndex = (s_bptcP2[partitionSetIdx] >> idx) & 1;
-					indexAnchor = subsetIndex ? s_bptcA2[partitionSetIdx] : 0;
+					subsetIndex = (g_bptcP2[partitionSetIdx] >> idx) & 1;
+					indexAnchor = subsetIndex ? g_bptcA2[partitionSetIdx] : 0;
 				}
 
 				const uint8_t anchor = idx == indexAnchor;
@@ -2197,9 +2652,9 @@ namespace bimg
 				const uint8_t fcb = fc;
 
 				subsetIndex *= 2;
-				uint16_t rr = bc6hUnquantizeFinal( (epR[subsetIndex]*fca + epR[subsetIndex + 1]*fcb + 32) >> 6, _signed);
-				uint16_t gg = bc6hUnquantizeFinal( (epG[subsetIndex]*fca + epG[subsetIndex + 1]*fcb + 32) >> 6, _signed);
-				uint16_t bb = bc6hUnquantizeFinal( (epB[subsetIndex]*fca + epB[subsetIndex + 1]*fcb + 32) >> 6, _signed);
+				uint16_t rr = bc6hUnquantizeFinal( (bc6hEndpoint(epR[subsetIndex], _signed)*fca + bc6hEndpoint(epR[subsetIndex + 1], _signed)*fcb + 32) >> 6, _signed);
+				uint16_t gg = bc6hUnquantizeFinal( (bc6hEndpoint(epG[subsetIndex], _signed)*fca + bc6hEndpoint(epG[subsetIndex + 1], _signed)*fcb + 32) >> 6, _signed);
+				uint16_t bb = bc6hUnquantizeFinal( (bc6hEndpoint(epB[subsetIndex], _signed)*fca + bc6hEndpoint(epB[subsetIndex + 1], _signed)*fcb + 32) >> 6, _signed);
 
 				uint16_t* rgba = &_dst[idx*3];
 				rgba[0] = rr;
@@ -2224,20 +2679,7 @@ namespace bimg
 		}
 	}
 
-	struct Bc7ModeInfo
-	{
-		uint8_t numSubsets;
-		uint8_t partitionBits;
-		uint8_t rotationBits;
-		uint8_t indexSelectionBits;
-		uint8_t colorBits;
-		uint8_t alphaBits;
-		uint8_t endpointPBits;
-		uint8_t sharedPBits;
-		uint8_t indexBits[2];
-	};
-
-	static const Bc7ModeInfo s_bp7ModeInfo[] =
+	const Bc7ModeInfo g_bc7ModeInfo[] =
 	{ //  +---------------------------- num subsets
 	  //  |  +------------------------- partition bits
 	  //  |  |  +---------------------- rotation bits
@@ -2257,6 +2699,12 @@ namespace bimg
 		{ 2, 6, 0, 0, 5, 5, 1, 0, { 2, 0 } }, // 7
 	};
 
+	uint8_t bc7Unquantize(uint32_t _value, uint8_t _bits)
+	{
+		const uint32_t value = _value << (8 - _bits);
+		return uint8_t(value | (value >> _bits) );
+	}
+
 	void decodeBlockBc7(uint8_t _dst[16*4], const uint8_t _src[16])
 	{
 		BitReader bit(_src);
@@ -2272,7 +2720,7 @@ namespace bimg
 			return;
 		}
 
-		const Bc7ModeInfo& mi  = s_bp7ModeInfo[mode];
+		const Bc7ModeInfo& mi  = g_bc7ModeInfo[mode];
 		const uint8_t modePBits = 0 != mi.endpointPBits
 			? mi.endpointPBits
 			: mi.sharedPBits
@@ -2340,12 +2788,12 @@ namespace bimg
 
 		for (uint8_t ii = 0; ii < mi.numSubsets; ++ii)
 		{
-			epR[ii*2+0] = bitRangeConvert(epR[ii*2+0], colorBits, 8);
-			epR[ii*2+1] = bitRangeConvert(epR[ii*2+1], colorBits, 8);
-			epG[ii*2+0] = bitRangeConvert(epG[ii*2+0], colorBits, 8);
-			epG[ii*2+1] = bitRangeConvert(epG[ii*2+1], colorBits, 8);
-			epB[ii*2+0] = bitRangeConvert(epB[ii*2+0], colorBits, 8);
-			epB[ii*2+1] = bitRangeConvert(epB[ii*2+1], colorBits, 8);
+			epR[ii*2+0] = bc7Unquantize(epR[ii*2+0], colorBits);
+			epR[ii*2+1] = bc7Unquantize(epR[ii*2+1], colorBits);
+			epG[ii*2+0] = bc7Unquantize(epG[ii*2+0], colorBits);
+			epG[ii*2+1] = bc7Unquantize(epG[ii*2+1], colorBits);
+			epB[ii*2+0] = bc7Unquantize(epB[ii*2+0], colorBits);
+			epB[ii*2+1] = bc7Unquantize(epB[ii*2+1], colorBits);
 		}
 
 		if (mi.alphaBits)
@@ -2354,8 +2802,8 @@ namespace bimg
 
 			for (uint8_t ii = 0; ii < mi.numSubsets; ++ii)
 			{
-				epA[ii*2+0] = bitRangeConvert(epA[ii*2+0], alphaBits, 8);
-				epA[ii*2+1] = bitRangeConvert(epA[ii*2+1], alphaBits, 8);
+				epA[ii*2+0] = bc7Unquantize(epA[ii*2+0], alphaBits);
+				epA[ii*2+1] = bc7Unquantize(epA[ii*2+1], alphaBits);
 			}
 		}
 
@@ -2363,8 +2811,8 @@ namespace bimg
 
 		const uint8_t* factors[] =
 		{
-			                s_bptcFactors[mi.indexBits[0]-2],
-			hasIndexBits1 ? s_bptcFactors[mi.indexBits[1]-2] : factors[0],
+			                g_bptcFactors[mi.indexBits[0]-2],
+			hasIndexBits1 ? g_bptcFactors[mi.indexBits[1]-2] : factors[0],
 		};
 
 		uint16_t offset[2] =
@@ -2384,13 +2832,13 @@ namespace bimg
 				switch (mi.numSubsets)
 				{
 				case 2:
-					subsetIndex = (s_bptcP2[partitionSetIdx] >> idx) & 1;
-					indexAnchor = 0 != subsetIndex ? s_bptcA2[partitionSetIdx] : 0;
+					subsetIndex = (g_bptcP2[partitionSetIdx] >> idx) & 1;
+					indexAnchor = 0 != subsetIndex ? g_bptcA2[partitionSetIdx] : 0;
 					break;
 
 				case 3:
-					subsetIndex = (s_bptcP3[partitionSetIdx] >> (2*idx) ) & 3;
-					indexAnchor = 0 != subsetIndex ? s_bptcA3[subsetIndex-1][partitionSetIdx] : 0;
+					subsetIndex = (g_bptcP3[partitionSetIdx] >> (2*idx) ) & 3;
+					indexAnchor = 0 != subsetIndex ? g_bptcA3[subsetIndex-1][partitionSetIdx] : 0;
 					break;
 
 				default:
@@ -3171,6 +3619,7 @@ namespace bimg
 		imageContainer->m_ktx         = false;
 		imageContainer->m_ktxLE       = false;
 		imageContainer->m_srgb        = false;
+		imageContainer->m_mapped      = false;
 
 		if (NULL != _data)
 		{
@@ -3182,6 +3631,11 @@ namespace bimg
 
 	void imageFree(ImageContainer* _imageContainer)
 	{
+		if (_imageContainer->m_mapped)
+		{
+			bx::unmapFile(_imageContainer->m_data, _imageContainer->m_size);
+		}
+
 		BX_ALIGNED_FREE(_imageContainer->m_allocator, _imageContainer, 16);
 	}
 
@@ -3623,6 +4077,7 @@ namespace bimg
 		_imageContainer.m_ktx         = false;
 		_imageContainer.m_ktxLE       = false;
 		_imageContainer.m_srgb        = srgb;
+		_imageContainer.m_mapped      = false;
 
 		return true;
 	}
@@ -3968,6 +4423,7 @@ namespace bimg
 		_imageContainer.m_ktx         = true;
 		_imageContainer.m_ktxLE       = fromLittleEndian;
 		_imageContainer.m_srgb        = false;
+		_imageContainer.m_mapped      = false;
 
 		if (TextureFormat::Unknown == format)
 		{
@@ -4133,6 +4589,7 @@ namespace bimg
 		_imageContainer.m_ktx         = false;
 		_imageContainer.m_ktxLE       = false;
 		_imageContainer.m_srgb        = colorSpace > 0;
+		_imageContainer.m_mapped      = false;
 
 		return TextureFormat::Unknown != format;
 	}
@@ -4194,6 +4651,7 @@ namespace bimg
 			_imageContainer.m_ktx       = false;
 			_imageContainer.m_ktxLE     = false;
 			_imageContainer.m_srgb      = false;
+			_imageContainer.m_mapped    = false;
 
 			return _err->isOk();
 		}
@@ -4212,6 +4670,82 @@ namespace bimg
 		return imageParse(_imageContainer, &reader, _err);
 	}
 
+	ImageContainer* imageMapFile(bx::AllocatorI* _allocator, const bx::FilePath& _filePath, bx::Error* _err)
+	{
+		BX_ERROR_SCOPE(_err);
+
+		uint64_t size;
+		const void* data = bx::mapFile(_filePath, size, _err);
+
+		if (NULL == data)
+		{
+			return NULL;
+		}
+
+		if (UINT32_MAX < size)
+		{
+			bx::unmapFile(data, size);
+			BX_ERROR_SET(_err, BIMG_ERROR, "Image file is too large.");
+			return NULL;
+		}
+
+		bx::MemoryReader reader(data, uint32_t(size) );
+
+		uint32_t magic;
+		bx::read(&reader, magic, _err);
+
+		ImageContainer imageContainer;
+		bool ok = false;
+
+		if (DDS_MAGIC == magic)
+		{
+			ok = imageParseDds(imageContainer, &reader, _err);
+		}
+		else if (KTX_MAGIC == magic)
+		{
+			ok = imageParseKtx(imageContainer, &reader, _err);
+		}
+		else if (PVR3_MAGIC == magic)
+		{
+			ok = imageParsePvr3(imageContainer, &reader, _err);
+		}
+		else if (_err->isOk() )
+		{
+			BX_ERROR_SET(_err, BIMG_ERROR, "Only DDS, KTX, and PVR3 files can be mapped.");
+		}
+
+		if (ok)
+		{
+			// Image data of the last side and mip is at the end of file in all formats, and
+			// imageGetRawData fails if any mip before it doesn't fit into the file.
+			const uint16_t numSides = imageContainer.m_numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+
+			ImageMip mip;
+			ok = imageGetRawData(imageContainer, uint16_t(numSides-1), uint8_t(imageContainer.m_numMips-1), data, uint32_t(size), mip);
+
+			if (!ok)
+			{
+				BX_ERROR_SET(_err, BIMG_ERROR, "Image data is truncated.");
+			}
+		}
+
+		if (!ok)
+		{
+			bx::unmapFile(data, size);
+			return NULL;
+		}
+
+		ImageContainer* output = (ImageContainer*)BX_ALIGNED_ALLOC(_allocator, sizeof(ImageContainer), 16);
+		bx::memCopy(output, &imageContainer, sizeof(ImageContainer) );
+
+		output->m_allocator = _allocator;
+		output->m_data      = const_cast<void*>(data);
+		output->m_size      = uint32_t(size);
+		output->m_mapped    = true;
+
+		return output;
+	}
+
 	void imageDecodeToR8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, uint32_t _dstPitch, TextureFormat::Enum _srcFormat)
 	{
 		const uint8_t* src = (const uint8_t*)_src;
@@ -4808,6 +5342,12 @@ namespace bimg
 					BX_TRACE("x");
 				}
 
+				if (offset > _size
+				||  sizeof(uint32_t) > _size - offset)
+				{
+					return false;
+				}
+
 				const uint32_t size = mipSize*numSides;
 				uint32_t imageSize = bx::toHostEndian(*(const uint32_t*)&data[offset], _imageContainer.m_ktxLE);
 				BX_CHECK(size == imageSize, "KTX: Image size mismatch %d (expected %d).", size, imageSize);
@@ -4817,7 +5357,10 @@ namespace bimg
 
 				for (uint16_t side = 0; side < numSides; ++side)
 				{
-					BX_CHECK(offset <= _size, "Reading past size of data buffer! (offset %d, size %d)", offset, _size);
+					if (mipSize > _size - offset)
+					{
+						return false;
+					}
 
 					if (side == _side
 					&&  lod  == _lod)
@@ -4835,8 +5378,6 @@ namespace bimg
 					}
 
 					offset += mipSize;
-
-					BX_UNUSED(_size);
 				}
 
 				width  >>= 1;
@@ -4854,14 +5395,18 @@ namespace bimg
 
 				for (uint8_t lod = 0, num = _imageContainer.m_numMips; lod < num; ++lod)
 				{
-					BX_CHECK(offset <= _size, "Reading past size of data buffer! (offset %d, size %d)", offset, _size);
-
 					width  = bx::max<uint32_t>(blockWidth  * minBlockX, ( (width  + blockWidth  - 1) / blockWidth )*blockWidth);
 					height = bx::max<uint32_t>(blockHeight * minBlockY, ( (height + blockHeight - 1) / blockHeight)*blockHeight);
 					depth  = bx::max<uint32_t>(1, depth);
 
 					uint32_t mipSize = width/blockWidth * height/blockHeight * depth * blockSize;
 
+					if (offset > _size
+					||  mipSize > _size - offset)
+					{
+						return false;
+					}
+
 					if (side == _side
 					&&  lod  == _lod)
 					{
@@ -4879,8 +5424,6 @@ namespace bimg
 
 					offset += mipSize;
 
-					BX_UNUSED(_size);
-
 					width  >>= 1;
 					height >>= 1;
 					depth  >>= 1;
@@ -662,104 +662,92 @@ namespace bimg
 		}
 	}
 
-	struct Sampler
+	/// Cubemap with data pointers of all sides and mips resolved up-front, so that filtering
+	/// doesn't have to walk image container for every texel fetch. Texels are RGBA32F.
+	struct RadianceSource
 	{
-		Sampler(const ImageContainer& _image, uint16_t _side, float _lod, float (*func)(float) )
-		{
-			const float lod = bx::clamp(_lod, 0.0f, float(_image.m_numMips - 1) );
-			imageGetRawData(
-				  _image
-				, _side
-				, uint8_t(func(lod) )
-				, _image.m_data
-				, _image.m_size
-				, mip
-				);
-		}
-
-		ImageMip mip;
+		const uint8_t* m_data[6][16];
+		uint32_t       m_width[16];
+		uint8_t        m_numMips;
 	};
 
-	void texelFetch(float* _rgba, const Sampler& _sampler, uint32_t _u, uint32_t _v)
+	static void radianceSourceInit(RadianceSource& _source, const ImageContainer& _image)
 	{
-		const uint32_t bpp   = _sampler.mip.m_bpp;
-		const uint32_t pitch = _sampler.mip.m_width*bpp/8;
-		const uint8_t* texel = _sampler.mip.m_data + _v*pitch + _u*bpp/8;
+		BX_CHECK(TextureFormat::RGBA32F == _image.m_format, "Radiance source must be RGBA32F.");
+		BX_CHECK(BX_COUNTOF(_source.m_width) >= _image.m_numMips, "Too many mips.");
 
-		UnpackFn unpack = getUnpack(_sampler.mip.m_format);
-		unpack(_rgba, texel);
-	}
+		_source.m_numMips = _image.m_numMips;
 
-	void sampleCubeMap(float* _rgba, const ImageContainer& _image, const float* _dir, float _lod)
-	{
-		float uu, vv;
-		uint8_t side;
-		dirToTexelUv(uu, vv, side, _dir);
+		for (uint8_t side = 0; side < 6; ++side)
+		{
+			for (uint8_t lod = 0; lod < _image.m_numMips; ++lod)
+			{
+				ImageMip mip;
+				imageGetRawData(_image, side, lod, _image.m_data, _image.m_size, mip);
 
-		const float fu = bx::fract(uu);
-		const float fv = bx::fract(vv);
-		const float fl = bx::fract(_lod);
+				_source.m_data[side][lod] = mip.m_data;
+				_source.m_width[lod]      = mip.m_width;
+			}
+		}
+	}
 
-		float rgbaA[4];
-		{
-			Sampler sampler(_image, side, _lod, bx::floor);
-			const uint32_t widthMinusOne = sampler.mip.m_width-1;
+	BX_SIMD_INLINE bx::simd128_t sampleFace(const RadianceSource& _source, uint8_t _side, uint8_t _lod, float _uu, float _vv, bx::simd128_t _fu, bx::simd128_t _fv)
+	{
+		using namespace bx;
 
-			const uint32_t u0 = uint32_t(uu*widthMinusOne+0.5f);
-			const uint32_t v0 = uint32_t(vv*widthMinusOne+0.5f);
-			const uint32_t u1 = bx::min(u0 + 1, widthMinusOne);
-			const uint32_t v1 = bx::min(v0 + 1, widthMinusOne);
+		const uint32_t widthMinusOne = _source.m_width[_lod]-1;
+		const uint32_t pitch         = _source.m_width[_lod]*16;
+		const uint8_t* data          = _source.m_data[_side][_lod];
 
-			float rgba00[4];
-			texelFetch(rgba00, sampler, u0, v0);
+		const uint32_t u0 = uint32_t(_uu*widthMinusOne+0.5f);
+		const uint32_t v0 = uint32_t(_vv*widthMinusOne+0.5f);
+		const uint32_t u1 = bx::min(u0 + 1, widthMinusOne);
+		const uint32_t v1 = bx::min(v0 + 1, widthMinusOne);
 
-			float rgba01[4];
-			texelFetch(rgba01, sampler, u0, v1);
+		// Image container data is 16-byte aligned, and RGBA32F texels are 16 bytes.
+		const simd128_t rgba00 = simd_ld(data + v0*pitch + u0*16);
+		const simd128_t rgba01 = simd_ld(data + v1*pitch + u0*16);
+		const simd128_t rgba10 = simd_ld(data + v0*pitch + u1*16);
+		const simd128_t rgba11 = simd_ld(data + v1*pitch + u1*16);
 
-			float rgba10[4];
-			texelFetch(rgba10, sampler, u1, v0);
+		const simd128_t rgba0 = simd_lerp(rgba00, rgba01, _fv);
+		const simd128_t rgba1 = simd_lerp(rgba10, rgba11, _fv);
 
-			float rgba11[4];
-			texelFetch(rgba11, sampler, u1, v1);
+		return simd_lerp(rgba0, rgba1, _fu);
+	}
 
-			rgbaA[0] = bx::lerp(bx::lerp(rgba00[0], rgba01[0], fv), bx::lerp(rgba10[0], rgba11[0], fv), fu);
-			rgbaA[1] = bx::lerp(bx::lerp(rgba00[1], rgba01[1], fv), bx::lerp(rgba10[1], rgba11[1], fv), fu);
-			rgbaA[2] = bx::lerp(bx::lerp(rgba00[2], rgba01[2], fv), bx::lerp(rgba10[2], rgba11[2], fv), fu);
-			rgbaA[3] = bx::lerp(bx::lerp(rgba00[3], rgba01[3], fv), bx::lerp(rgba10[3], rgba11[3], fv), fu);
-		}
+	BX_SIMD_INLINE bx::simd128_t sampleCubeMap(const RadianceSource& _source, uint8_t _side, float _uu, float _vv, uint8_t _lod0, uint8_t _lod1, float _lodFrac)
+	{
+		using namespace bx;
 
-		float rgbaB[4];
-		{
-			Sampler sampler(_image, side, _lod, bx::ceil);
-			const uint32_t widthMinusOne = sampler.mip.m_width-1;
+		const simd128_t fu = simd_splat(bx::fract(_uu) );
+		const simd128_t fv = simd_splat(bx::fract(_vv) );
 
-			const uint32_t u0 = uint32_t(uu*widthMinusOne+0.5f);
-			const uint32_t v0 = uint32_t(vv*widthMinusOne+0.5f);
-			const uint32_t u1 = bx::min(u0 + 1, widthMinusOne);
-			const uint32_t v1 = bx::min(v0 + 1, widthMinusOne);
+		const simd128_t rgbaA = sampleFace(_source, _side, _lod0, _uu, _vv, fu, fv);
+		const simd128_t rgbaB = sampleFace(_source, _side, _lod1, _uu, _vv, fu, fv);
 
-			float rgba00[4];
-			texelFetch(rgba00, sampler, u0, v0);
+		return simd_lerp(rgbaA, rgbaB, simd_splat(_lodFrac) );
+	}
 
-			float rgba01[4];
-			texelFetch(rgba01, sampler, u0, v1);
+	/// Returns texel of mip 0 at the position of the direction in `_lod` mip. Used when filter
+	/// didn't gather any samples.
+	static void fetchFallback(float* _result, const RadianceSource& _source, uint8_t _lod, const float* _dir)
+	{
+		float uu, vv;
+		uint8_t face;
+		dirToTexelUv(uu, vv, face, _dir);
 
-			float rgba10[4];
-			texelFetch(rgba10, sampler, u1, v0);
+		const float widthMinusOne = float(_source.m_width[_lod]-1);
+		const uint32_t pitch      = _source.m_width[_lod]*16;
 
-			float rgba11[4];
-			texelFetch(rgba11, sampler, u1, v1);
+		const uint32_t xx = uint32_t(uu*widthMinusOne);
+		const uint32_t yy = uint32_t(vv*widthMinusOne);
 
-			rgbaB[0] = bx::lerp(bx::lerp(rgba00[0], rgba01[0], fv), bx::lerp(rgba10[0], rgba11[0], fv), fu);
-			rgbaB[1] = bx::lerp(bx::lerp(rgba00[1], rgba01[1], fv), bx::lerp(rgba10[1], rgba11[1], fv), fu);
-			rgbaB[2] = bx::lerp(bx::lerp(rgba00[2], rgba01[2], fv), bx::lerp(rgba10[2], rgba11[2], fv), fu);
-			rgbaB[3] = bx::lerp(bx::lerp(rgba00[3], rgba01[3], fv), bx::lerp(rgba10[3], rgba11[3], fv), fu);
-		}
+		const float* rgba = (const float*)(_source.m_data[face][0] + yy*pitch + xx*16);
 
-		_rgba[0] = bx::lerp(rgbaA[0], rgbaB[0], fl);
-		_rgba[1] = bx::lerp(rgbaA[1], rgbaB[1], fl);
-		_rgba[2] = bx::lerp(rgbaA[2], rgbaB[2], fl);
-		_rgba[3] = bx::lerp(rgbaA[3], rgbaB[3], fl);
+		_result[0] = rgba[0];
+		_result[1] = rgba[1];
+		_result[2] = rgba[2];
 	}
 
 	void importanceSampleGgx(float* _result, float _u, float _v, float _roughness, const float* _normal, const float* _tangentX, const float* _tangentY)
@@ -790,28 +778,28 @@ namespace bimg
 		return alphaSq/(bx::kPi * denomSq);
 	}
 
-	void processFilterAreaGgx(
-		  float* _result
-		, const ImageContainer& _image
-		, uint8_t _lod
-		, const float* _dir
-		, float _roughness
-		)
-	{
-		ImageMip mip;
-		imageGetRawData(_image, 0, _lod, _image.m_data, _image.m_size, mip);
-
-		const uint32_t bpp = getBitsPerPixel(_image.m_format);
+	constexpr uint32_t kGgxNumSamples = 512;
 
-		constexpr int32_t kNumSamples = 512;
-		const uint32_t pitch      = mip.m_width*bpp/8;
-		const float widthMinusOne = float(mip.m_width-1);
-		const float mipBias       = 0.5f*bx::log2(bx::square(float(_image.m_width) )/float(kNumSamples) );
-
-		UnpackFn unpack = getUnpack(_image.m_format);
+	/// GGX importance samples for single roughness. Light directions are in tangent space
+	/// (x - tangent, y - bitangent, z - normal), and don't depend on the texel being filtered.
+	/// Samples below horizon are discarded, and the rest is padded with zero weight samples
+	/// to multiple of 4.
+	struct GgxSampleTable
+	{
+		BX_ALIGN_DECL_16(float) m_x[kGgxNumSamples];
+		float    m_y[kGgxNumSamples];
+		float    m_z[kGgxNumSamples];
+		float    m_ndotl[kGgxNumSamples];
+		float    m_lodFrac[kGgxNumSamples];
+		uint8_t  m_lod0[kGgxNumSamples];
+		uint8_t  m_lod1[kGgxNumSamples];
+		float    m_totalWeight;
+		uint32_t m_num;
+	};
 
-		float color[3]    = { 0.0f, 0.0f, 0.0f };
-		float totalWeight = 0.0f;
+	static void ggxSampleTableInit(GgxSampleTable& _table, float _roughness, uint32_t _width, uint8_t _numMips)
+	{
+		const float mipBias = 0.5f*bx::log2(bx::square(float(_width) )/float(kGgxNumSamples) );
 
 		// Golden Ratio Sequences for Low-Discrepancy Sampling
 		// https://web.archive.org/web/20180717194847/https://www.graphics.rwth-aachen.de/publication/2/jgt.pdf
@@ -821,30 +809,33 @@ namespace bimg
 		const float kGoldenSection = 0.61803398875f;
 		float offset = kGoldenSection;
 
-		float tangentX[3];
-		float tangentY[3];
-		bx::vec3TangentFrame(_dir, tangentX, tangentY);
+		const float normal[3]   = { 0.0f, 0.0f, 1.0f };
+		const float tangentX[3] = { 1.0f, 0.0f, 0.0f };
+		const float tangentY[3] = { 0.0f, 1.0f, 0.0f };
+
+		uint32_t num = 0;
+		float totalWeight = 0.0f;
 
-		for (uint32_t ii = 0; ii < kNumSamples; ++ii)
+		for (uint32_t ii = 0; ii < kGgxNumSamples; ++ii)
 		{
 			offset += kGoldenSection;
-			const float vv = ii/float(kNumSamples);
+			const float vv = ii/float(kGgxNumSamples);
 
 			float hh[3];
-			importanceSampleGgx(hh, offset, vv, _roughness, _dir, tangentX, tangentY);
+			importanceSampleGgx(hh, offset, vv, _roughness, normal, tangentX, tangentY);
 
-			const float ddoth2 = 2.0f * bx::vec3Dot(_dir, hh);
+			const float ddoth2 = 2.0f * hh[2];
 
 			float ll[3];
-			ll[0] = ddoth2 * hh[0] - _dir[0];
-			ll[1] = ddoth2 * hh[1] - _dir[1];
-			ll[2] = ddoth2 * hh[2] - _dir[2];
+			ll[0] = ddoth2 * hh[0];
+			ll[1] = ddoth2 * hh[1];
+			ll[2] = ddoth2 * hh[2] - 1.0f;
 
-			const float ndotl = bx::clamp(bx::vec3Dot(_dir, ll), 0.0f, 1.0f);
+			const float ndotl = bx::clamp(ll[2], 0.0f, 1.0f);
 
 			if (ndotl > 0.0f)
 			{
-				const float ndoth = bx::clamp(bx::vec3Dot(_dir, hh), 0.0f, 1.0f);
+				const float ndoth = bx::clamp(hh[2], 0.0f, 1.0f);
 				const float vdoth = ndoth;
 
 				// Chapter 20. GPU-Based Importance Sampling
@@ -852,9 +843,131 @@ namespace bimg
 				//
 				const float pdf = normalDistributionGgx(ndoth, _roughness) * ndoth / (4.0f * vdoth);
 				const float lod = bx::max(0.0f, mipBias - 0.5f*bx::log2(pdf));
+				const float mip = bx::clamp(lod, 0.0f, float(_numMips - 1) );
+
+				_table.m_x[num]       = ll[0];
+				_table.m_y[num]       = ll[1];
+				_table.m_z[num]       = ll[2];
+				_table.m_ndotl[num]   = ndotl;
+				_table.m_lodFrac[num] = bx::fract(lod);
+				_table.m_lod0[num]    = uint8_t(bx::floor(mip) );
+				_table.m_lod1[num]    = uint8_t(bx::ceil(mip) );
+				totalWeight += ndotl;
+				++num;
+			}
+		}
+
+		for (; 0 != (num & 3); ++num)
+		{
+			_table.m_x[num]       = 0.0f;
+			_table.m_y[num]       = 0.0f;
+			_table.m_z[num]       = 1.0f;
+			_table.m_ndotl[num]   = 0.0f;
+			_table.m_lodFrac[num] = 0.0f;
+			_table.m_lod0[num]    = 0;
+			_table.m_lod1[num]    = 0;
+		}
 
-				float rgba[4];
-				sampleCubeMap(rgba, _image, ll, lod);
+		_table.m_totalWeight = totalWeight;
+		_table.m_num         = num;
+	}
+
+	static void processFilterAreaGgx(
+		  float* _result
+		, const RadianceSource& _source
+		, const GgxSampleTable& _table
+		, uint8_t _lod
+		, const float* _dir
+		)
+	{
+		using namespace bx;
+
+		float tangentX[3];
+		float tangentY[3];
+		vec3TangentFrame(_dir, tangentX, tangentY);
+
+		const simd128_t tx = simd_splat(tangentX[0]);
+		const simd128_t ty = simd_splat(tangentX[1]);
+		const simd128_t tz = simd_splat(tangentX[2]);
+		const simd128_t sx = simd_splat(tangentY[0]);
+		const simd128_t sy = simd_splat(tangentY[1]);
+		const simd128_t sz = simd_splat(tangentY[2]);
+		const simd128_t nx = simd_splat(_dir[0]);
+		const simd128_t ny = simd_splat(_dir[1]);
+		const simd128_t nz = simd_splat(_dir[2]);
+
+		const simd128_t zero = simd_zero();
+		const simd128_t one  = simd_splat(1.0f);
+		const simd128_t half = simd_splat(0.5f);
+
+		const simd128_t faceNegX = simd_isplat(CubeMapFace::NegativeX);
+		const simd128_t facePosY = simd_isplat(CubeMapFace::PositiveY);
+		const simd128_t faceNegY = simd_isplat(CubeMapFace::NegativeY);
+		const simd128_t facePosZ = simd_isplat(CubeMapFace::PositiveZ);
+		const simd128_t faceNegZ = simd_isplat(CubeMapFace::NegativeZ);
+
+		simd128_t color = simd_zero();
+
+		BX_ALIGN_DECL_16(float)   uu[4];
+		BX_ALIGN_DECL_16(float)   vv[4];
+		BX_ALIGN_DECL_16(int32_t) face[4];
+
+		for (uint32_t ii = 0, num = _table.m_num; ii < num; ii += 4)
+		{
+			// Rotate 4 sample directions from tangent space around the filtered direction.
+			const simd128_t lx = simd_ld(&_table.m_x[ii]);
+			const simd128_t ly = simd_ld(&_table.m_y[ii]);
+			const simd128_t lz = simd_ld(&_table.m_z[ii]);
+
+			const simd128_t dx = simd_madd(nx, lz, simd_madd(sx, ly, simd_mul(tx, lx) ) );
+			const simd128_t dy = simd_madd(ny, lz, simd_madd(sy, ly, simd_mul(ty, lx) ) );
+			const simd128_t dz = simd_madd(nz, lz, simd_madd(sz, ly, simd_mul(tz, lx) ) );
+
+			// Same as dirToTexelUv, for 4 directions at once.
+			const simd128_t ax   = simd_abs(dx);
+			const simd128_t ay   = simd_abs(dy);
+			const simd128_t az   = simd_abs(dz);
+			const simd128_t amax = simd_max(ax, simd_max(ay, az) );
+			const simd128_t inv  = simd_div(one, amax);
+			const simd128_t fx   = simd_mul(dx, inv);
+			const simd128_t fy   = simd_mul(dy, inv);
+			const simd128_t fz   = simd_mul(dz, inv);
+
+			const simd128_t isX  = simd_cmpeq(amax, ax);
+			const simd128_t isY  = simd_andc(simd_cmpeq(amax, ay), isX);
+			const simd128_t posX = simd_cmpge(dx, zero);
+			const simd128_t posY = simd_cmpge(dy, zero);
+			const simd128_t posZ = simd_cmpge(dz, zero);
+
+			const simd128_t uX = simd_selb(posX, simd_neg(fz), fz);
+			const simd128_t uZ = simd_selb(posZ, fx, simd_neg(fx) );
+			const simd128_t vY = simd_selb(posY, fz, simd_neg(fz) );
+			const simd128_t vXZ = simd_neg(fy);
+
+			const simd128_t su = simd_selb(isX, uX, simd_selb(isY, fx, uZ) );
+			const simd128_t sv = simd_selb(isY, vY, vXZ);
+
+			const simd128_t faceX = simd_andc(faceNegX, posX);
+			const simd128_t faceY = simd_selb(posY, facePosY, faceNegY);
+			const simd128_t faceZ = simd_selb(posZ, facePosZ, faceNegZ);
+
+			simd_st(uu,   simd_mul(simd_add(su, one), half) );
+			simd_st(vv,   simd_mul(simd_add(sv, one), half) );
+			simd_st(face, simd_selb(isX, faceX, simd_selb(isY, faceY, faceZ) ) );
+
+			for (uint32_t jj = 0; jj < 4; ++jj)
+			{
+				const uint32_t idx = ii + jj;
+
+				const simd128_t rgba = sampleCubeMap(
+					  _source
+					, uint8_t(face[jj])
+					, uu[jj]
+					, vv[jj]
+					, _table.m_lod0[idx]
+					, _table.m_lod1[idx]
+					, _table.m_lodFrac[idx]
+					);
 
 				// Optimized Reversible Tonemapper for Resolve
 				// https://web.archive.org/web/20180717182019/https://gpuopen.com/optimized-reversible-tonemapper-for-resolve/
@@ -863,54 +976,41 @@ namespace bimg
 				// as a function of how bright they are"
 				// Include ndotl here to "fold the weighting into the tonemap operation"
 				//
-				const float tm = ndotl / (bx::max(rgba[0], rgba[1], rgba[2]) + 1.0f);
+				const simd128_t rgbMax = simd_max(simd_swiz_xxxx(rgba), simd_max(simd_swiz_yyyy(rgba), simd_swiz_zzzz(rgba) ) );
+				const simd128_t tm     = simd_div(simd_splat(_table.m_ndotl[idx]), simd_add(rgbMax, one) );
 
-				color[0] += rgba[0] * tm;
-				color[1] += rgba[1] * tm;
-				color[2] += rgba[2] * tm;
-				totalWeight += ndotl;
+				color = simd_madd(rgba, tm, color);
 			}
 		}
 
-		if (0.0f < totalWeight)
+		if (0.0f < _table.m_totalWeight)
 		{
+			BX_ALIGN_DECL_16(float) rgba[4];
+			simd_st(rgba, color);
+
 			// Optimized Reversible Tonemapper for Resovle
 			// https://web.archive.org/web/20180717182019/https://gpuopen.com/optimized-reversible-tonemapper-for-resolve/
 			// Average, then reverse the tonemapper
 			//
-			const float invWeight = 1.0f/totalWeight;
-			color[0] = color[0] * invWeight;
-			color[1] = color[1] * invWeight;
-			color[2] = color[2] * invWeight;
-
-			const float invTm = 1.0f / (1.0f - bx::max(0.00001f, bx::max(color[0], color[1], color[2])));
-			_result[0] = color[0] * invTm;
-			_result[1] = color[1] * invTm;
-			_result[2] = color[2] * invTm;
+			const float invWeight = 1.0f/_table.m_totalWeight;
+			rgba[0] = rgba[0] * invWeight;
+			rgba[1] = rgba[1] * invWeight;
+			rgba[2] = rgba[2] * invWeight;
+
+			const float invTm = 1.0f / (1.0f - bx::max(0.00001f, bx::max(rgba[0], rgba[1], rgba[2])));
+			_result[0] = rgba[0] * invTm;
+			_result[1] = rgba[1] * invTm;
+			_result[2] = rgba[2] * invTm;
 		}
 		else
 		{
-			float uu, vv;
-			uint8_t face;
-			dirToTexelUv(uu, vv, face, _dir);
-
-			imageGetRawData(_image, face, 0, _image.m_data, _image.m_size, mip);
-
-			const uint32_t xx = uint32_t(uu*widthMinusOne);
-			const uint32_t yy = uint32_t(vv*widthMinusOne);
-
-			float rgba[4];
-			unpack(rgba, mip.m_data + yy*pitch + xx*bpp/8);
-
-			_result[0] = rgba[0];
-			_result[1] = rgba[1];
-			_result[2] = rgba[2];
+			fetchFallback(_result, _source, _lod, _dir);
 		}
 	}
 
-	void processFilterArea(
+	static void processFilterArea(
 		  float* _result
-		, const ImageContainer& _image
+		, const RadianceSource& _source
 		, const ImageContainer& _nsa
 		, uint8_t _lod
 		, const Aabb* _aabb
@@ -919,12 +1019,24 @@ namespace bimg
 		, float _specularAngle
 		)
 	{
-		float color[3]    = { 0.0f, 0.0f, 0.0f };
+		using namespace bx;
+
+		const simd128_t dx            = simd_splat(_dir[0]);
+		const simd128_t dy            = simd_splat(_dir[1]);
+		const simd128_t dz            = simd_splat(_dir[2]);
+		const simd128_t zero          = simd_zero();
+		const simd128_t one           = simd_splat(1.0f);
+		const simd128_t specularPower = simd_splat(_specularPower);
+		const simd128_t specularAngle = simd_splat(_specularAngle);
+		const simd128_t lane          = simd_ild(0, 1, 2, 3);
+
+		simd128_t color   = simd_zero();
 		float totalWeight = 0.0f;
 
-		const uint32_t bpp = getBitsPerPixel(_image.m_format);
+		BX_ALIGN_DECL_16(float) weight[4];
 
-		UnpackFn unpack = getUnpack(_image.m_format);
+		const uint32_t pitch      = _source.m_width[_lod]*16;
+		const float widthMinusOne = float(_source.m_width[_lod]-1);
 
 		for (uint8_t side = 0; side < 6; ++side)
 		{
@@ -936,71 +1048,77 @@ namespace bimg
 			ImageMip nsaMip;
 			imageGetRawData(_nsa, side, 0, _nsa.m_data, _nsa.m_size, nsaMip);
 
-			ImageMip mip;
-			if (imageGetRawData(_image, side, _lod, _image.m_data, _image.m_size, mip) )
-			{
-				const uint32_t pitch      = mip.m_width*bpp/8;
-				const float widthMinusOne = float(mip.m_width-1);
-				const float texelSize     = 1.0f/float(mip.m_width);
-				BX_UNUSED(texelSize);
+			const uint32_t nsaPitch = nsaMip.m_width*16;
+			const uint8_t* data     = _source.m_data[side][_lod];
 
-				const uint32_t minX = uint32_t(_aabb[side].m_min[0] * widthMinusOne);
-				const uint32_t maxX = uint32_t(_aabb[side].m_max[0] * widthMinusOne);
-				const uint32_t minY = uint32_t(_aabb[side].m_min[1] * widthMinusOne);
-				const uint32_t maxY = uint32_t(_aabb[side].m_max[1] * widthMinusOne);
+			const uint32_t minX = uint32_t(_aabb[side].m_min[0] * widthMinusOne);
+			const uint32_t maxX = uint32_t(_aabb[side].m_max[0] * widthMinusOne);
+			const uint32_t minY = uint32_t(_aabb[side].m_min[1] * widthMinusOne);
+			const uint32_t maxY = uint32_t(_aabb[side].m_max[1] * widthMinusOne);
 
-				for (uint32_t yy = minY; yy <= maxY; ++yy)
+			for (uint32_t yy = minY; yy <= maxY; ++yy)
+			{
+				const uint8_t* row    = data + yy*pitch;
+				const uint8_t* nsaRow = nsaMip.m_data + yy*nsaPitch;
+
+				for (uint32_t xx = minX; xx <= maxX; xx += 4)
 				{
-					const uint8_t* row = mip.m_data + yy*pitch;
-					BX_UNUSED(row);
+					// Normal and solid angle of 4 texels, transposed to xxxx, yyyy, zzzz, wwww.
+					const simd128_t n0 = simd_ld(nsaRow + bx::min(xx+0, maxX)*16);
+					const simd128_t n1 = simd_ld(nsaRow + bx::min(xx+1, maxX)*16);
+					const simd128_t n2 = simd_ld(nsaRow + bx::min(xx+2, maxX)*16);
+					const simd128_t n3 = simd_ld(nsaRow + bx::min(xx+3, maxX)*16);
 
-					for (uint32_t xx = minX; xx <= maxX; ++xx)
-					{
-						const float* normal = (const float*)&nsaMip.m_data[(yy*nsaMip.m_width+xx)*(nsaMip.m_bpp/8)];
-						const float solidAngle = normal[3];
-						const float ndotl = bx::clamp(bx::vec3Dot(normal, _dir), 0.0f, 1.0f);
+					const simd128_t t0 = simd_shuf_xAyB(n0, n1);
+					const simd128_t t1 = simd_shuf_zCwD(n0, n1);
+					const simd128_t t2 = simd_shuf_xAyB(n2, n3);
+					const simd128_t t3 = simd_shuf_zCwD(n2, n3);
 
-						if (ndotl >= _specularAngle)
-						{
-							const float weight = solidAngle * bx::pow(ndotl, _specularPower);
-							float rgba[4];
-							unpack(rgba, row + xx*bpp/8);
-
-							color[0] += rgba[0] * weight;
-							color[1] += rgba[1] * weight;
-							color[2] += rgba[2] * weight;
-							totalWeight += weight;
-						}
-					}
-				}
+					const simd128_t nx         = simd_shuf_xyAB(t0, t2);
+					const simd128_t ny         = simd_shuf_zwCD(t0, t2);
+					const simd128_t nz         = simd_shuf_xyAB(t1, t3);
+					const simd128_t solidAngle = simd_shuf_zwCD(t1, t3);
 
-				if (0.0f < totalWeight)
-				{
-					const float invWeight = 1.0f/totalWeight;
-					_result[0] = color[0] * invWeight;
-					_result[1] = color[1] * invWeight;
-					_result[2] = color[2] * invWeight;
-				}
-				else
-				{
-					float uu, vv;
-					uint8_t face;
-					dirToTexelUv(uu, vv, face, _dir);
+					const simd128_t dot   = simd_add(simd_add(simd_mul(nx, dx), simd_mul(ny, dy) ), simd_mul(nz, dz) );
+					const simd128_t ndotl = simd_max(simd_min(dot, one), zero);
 
-					imageGetRawData(_image, face, 0, _image.m_data, _image.m_size, mip);
+					const simd128_t inside = simd_icmplt(lane, simd_isplat(maxX - xx + 1) );
+					const simd128_t mask   = simd_and(simd_cmpge(ndotl, specularAngle), inside);
 
-					const uint32_t xx = uint32_t(uu*widthMinusOne);
-					const uint32_t yy = uint32_t(vv*widthMinusOne);
+					if (!simd_test_any_xyzw(mask) )
+					{
+						continue;
+					}
 
-					float rgba[4];
-					unpack(rgba, mip.m_data + yy*pitch + xx*bpp/8);
+					simd_st(weight, simd_and(simd_mul(solidAngle, simd_pow(ndotl, specularPower) ), mask) );
 
-					_result[0] = rgba[0];
-					_result[1] = rgba[1];
-					_result[2] = rgba[2];
+					for (uint32_t jj = 0; jj < 4; ++jj)
+					{
+						if (0.0f < weight[jj])
+						{
+							const simd128_t rgba = simd_ld(row + (xx+jj)*16);
+							color = simd_madd(rgba, simd_splat(weight[jj]), color);
+							totalWeight += weight[jj];
+						}
+					}
 				}
 			}
 		}
+
+		if (0.0f < totalWeight)
+		{
+			BX_ALIGN_DECL_16(float) rgba[4];
+			simd_st(rgba, color);
+
+			const float invWeight = 1.0f/totalWeight;
+			_result[0] = rgba[0] * invWeight;
+			_result[1] = rgba[1] * invWeight;
+			_result[2] = rgba[2] * invWeight;
+		}
+		else
+		{
+			fetchFallback(_result, _source, _lod, _dir);
+		}
 	}
 
 	ImageContainer* imageGenerateMips(bx::AllocatorI* _allocator, const ImageContainer& _image)
@@ -1104,7 +1222,67 @@ namespace bimg
 		return _specularPower;
 	}
 
-	ImageContainer* imageCubemapRadianceFilter(bx::AllocatorI* _allocator, const ImageContainer& _image, LightingModel::Enum _lightingModel, bx::Error* _err)
+	struct RadianceFilterLod
+	{
+		const GgxSampleTable* m_ggx;
+		ImageContainer*       m_nsa;
+		uint8_t*              m_data[6];
+		uint32_t              m_width;
+		float                 m_filterSize;
+		float                 m_specularPower;
+		float                 m_cosAngle;
+	};
+
+	struct RadianceFilterJob
+	{
+		/// Filters single row of one side of one mip.
+		static void execute(void* _userData, uint32_t _idx)
+		{
+			const RadianceFilterJob& job = *(const RadianceFilterJob*)_userData;
+
+			uint8_t lod = 1;
+			for (; _idx >= job.m_lod[lod].m_width*6; ++lod)
+			{
+				_idx -= job.m_lod[lod].m_width*6;
+			}
+
+			const RadianceFilterLod& filter = job.m_lod[lod];
+
+			const uint32_t dstWidth  = filter.m_width;
+			const uint8_t  side      = uint8_t(_idx / dstWidth);
+			const uint32_t yy        = _idx % dstWidth;
+			const float    texelSize = 1.0f/float(dstWidth);
+
+			float* dstData = (float*)&filter.m_data[side][yy*dstWidth*16];
+
+			for (uint32_t xx = 0; xx < dstWidth; ++xx, dstData += 4)
+			{
+				const float uu = float(xx)*texelSize*2.0f - 1.0f;
+				const float vv = float(yy)*texelSize*2.0f - 1.0f;
+
+				float dir[3];
+				texelUvToDir(dir, side, uu, vv);
+
+				if (LightingModel::Ggx == job.m_lightingModel)
+				{
+					processFilterAreaGgx(dstData, job.m_source, *filter.m_ggx, lod, dir);
+				}
+				else
+				{
+					Aabb aabb[6];
+					calcFilterArea(aabb, dir, filter.m_filterSize);
+
+					processFilterArea(dstData, job.m_source, *filter.m_nsa, lod, aabb, dir, filter.m_specularPower, filter.m_cosAngle);
+				}
+			}
+		}
+
+		RadianceSource      m_source;
+		RadianceFilterLod   m_lod[16];
+		LightingModel::Enum m_lightingModel;
+	};
+
+	ImageContainer* imageCubemapRadianceFilter(bx::AllocatorI* _allocator, const ImageContainer& _image, LightingModel::Enum _lightingModel, bx::Error* _err, bx::JobSchedulerI* _jobScheduler)
 	{
 		if (!_image.m_cubeMap)
 		{
@@ -1139,68 +1317,97 @@ namespace bimg
 		const float glossScale = 10.0f;
 		const float glossBias  = 1.0f;
 
-		for (uint8_t lod = 1, numMips = input->m_numMips; lod < numMips; ++lod)
+		const uint8_t numMips = input->m_numMips;
+
+		RadianceFilterJob job;
+		job.m_lightingModel = _lightingModel;
+		radianceSourceInit(job.m_source, *input);
+
+		GgxSampleTable* ggx = NULL;
+
+		if (LightingModel::Ggx == _lightingModel)
 		{
-			ImageContainer* nsa = NULL;
+			ggx = (GgxSampleTable*)BX_ALIGNED_ALLOC(_allocator, numMips*sizeof(GgxSampleTable), 16);
+		}
 
-			if (LightingModel::Ggx != _lightingModel)
-			{
-				nsa = imageCubemapNormalSolidAngle(_allocator, bx::max<uint32_t>(_image.m_width>>lod, 1) );
-			}
+		// Every mip is filtered from the input only, so all rows of all sides of all mips can be
+		// processed in parallel. Jobs are ordered from the largest mip down.
+		uint32_t numRows = 0;
+
+		for (uint8_t lod = 1; lod < numMips; ++lod)
+		{
+			RadianceFilterLod& filter = job.m_lod[lod];
 
 			for (uint8_t side = 0; side < 6; ++side)
 			{
 				ImageMip mip;
 				imageGetRawData(*output, side, lod, output->m_data, output->m_size, mip);
 
-				const uint32_t dstWidth = mip.m_width;
-				const uint32_t dstPitch = dstWidth*16;
-
-				const float minAngle = bx::atan2(1.0f, float(dstWidth) );
-				const float maxAngle = bx::kPiHalf;
-				const float toFilterSize     = 1.0f/(minAngle*dstWidth*2.0f);
-				const float glossiness       = glossinessFor(lod, float(numMips) );
-				const float roughness        = 1.0f-glossiness;
-				const float specularPowerRef = bx::pow(2.0f, glossiness*glossScale + glossBias);
-				const float specularPower    = applyLightingModel(specularPowerRef, _lightingModel);
-				const float filterAngle      = bx::clamp(cosinePowerFilterAngle(specularPower), minAngle, maxAngle);
-				const float cosAngle   = bx::max(0.0f, bx::cos(filterAngle) );
-				const float texelSize  = 1.0f/float(dstWidth);
-				const float filterSize = bx::max(texelSize, filterAngle * toFilterSize);
-
-				for (uint32_t yy = 0; yy < dstWidth; ++yy)
-				{
-					for (uint32_t xx = 0; xx < dstWidth; ++xx)
-					{
-						float* dstData = (float*)&mip.m_data[yy*dstPitch+xx*16];
-
-						const float uu = float(xx)*texelSize*2.0f - 1.0f;
-						const float vv = float(yy)*texelSize*2.0f - 1.0f;
+				filter.m_data[side] = const_cast<uint8_t*>(mip.m_data);
+				filter.m_width      = mip.m_width;
+			}
 
-						float dir[3];
-						texelUvToDir(dir, side, uu, vv);
+			const uint32_t dstWidth = filter.m_width;
+
+			const float minAngle = bx::atan2(1.0f, float(dstWidth) );
+			const float maxAngle = bx::kPiHalf;
+			const float toFilterSize     = 1.0f/(minAngle*dstWidth*2.0f);
+			const float glossiness       = glossinessFor(lod, float(numMips) );
+			const float roughness        = 1.0f-glossiness;
+			const float specularPowerRef = bx::pow(2.0f, glossiness*glossScale + glossBias);
+			const float specularPower    = applyLightingModel(specularPowerRef, _lightingModel);
+			const float filterAngle      = bx::clamp(cosinePowerFilterAngle(specularPower), minAngle, maxAngle);
+			const float cosAngle   = bx::max(0.0f, bx::cos(filterAngle) );
+			const float texelSize  = 1.0f/float(dstWidth);
+			const float filterSize = bx::max(texelSize, filterAngle * toFilterSize);
+
+			filter.m_ggx           = NULL;
+			filter.m_nsa           = NULL;
+			filter.m_filterSize    = filterSize;
+			filter.m_specularPower = specularPower;
+			filter.m_cosAngle      = cosAngle;
+
+			if (NULL != ggx)
+			{
+				ggxSampleTableInit(ggx[lod], roughness, _image.m_width, numMips);
+				filter.m_ggx = &ggx[lod];
+			}
+			else
+			{
+				filter.m_nsa = imageCubemapNormalSolidAngle(_allocator, bx::max<uint32_t>(_image.m_width>>lod, 1) );
+			}
 
-						if (LightingModel::Ggx == _lightingModel)
-						{
-							processFilterAreaGgx(dstData, *input, lod, dir, roughness);
-						}
-						else
-						{
-							Aabb aabb[6];
-							calcFilterArea(aabb, dir, filterSize);
+			numRows += dstWidth*6;
+		}
 
-							processFilterArea(dstData, *input, *nsa, lod, aabb, dir, specularPower, cosAngle);
-						}
-					}
-				}
+		if (NULL != _jobScheduler
+		&&  1 < _jobScheduler->getNumThreads() )
+		{
+			_jobScheduler->run(RadianceFilterJob::execute, &job, numRows);
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < numRows; ++ii)
+			{
+				RadianceFilterJob::execute(&job, ii);
 			}
+		}
 
-			if (NULL != nsa)
+		for (uint8_t lod = 1; lod < numMips; ++lod)
+		{
+			if (NULL != job.m_lod[lod].m_nsa)
 			{
-				imageFree(nsa);
+				imageFree(job.m_lod[lod].m_nsa);
 			}
 		}
 
+		if (NULL != ggx)
+		{
+			BX_ALIGNED_FREE(_allocator, ggx, 16);
+		}
+
+		imageFree(input);
+
 		return output;
 	}
 
@@ -9,7 +9,6 @@
 #include <libsquish/squish.h>
 #include <etc1/etc1.h>
 #include <etc2/ProcessRGB.hpp>
-#include <nvtt/nvtt.h>
 #include <pvrtc/PvrTcEncoder.h>
 #include <edtaa3/edtaa3func.h>
 #include <astc/astc_lib.h>
@@ -44,128 +43,1636 @@ namespace bimg
     };
     BX_STATIC_ASSERT(Quality::Count == BX_COUNTOF(s_astcQuality));
 
-	void imageEncodeFromRgba8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _format, Quality::Enum _quality, bx::Error* _err)
+	// BC6H, BC7
+	//
+	// Reference:
+	//
+	// https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_texture_compression_bptc.txt
+	// https://msdn.microsoft.com/en-us/library/windows/desktop/hh308952(v=vs.85).aspx
+
+	struct BptcQuality
+	{
+		uint8_t bc7ModeMask;         // BC7 modes that are tried.
+		uint8_t numPartitions;       // Number of best ranked partitions tried by multi-subset modes.
+		uint8_t numRefineIterations; // Least squares endpoint refinement iterations.
+		bool    bc6hTwoSubsets;      // Try BC6H two subset modes.
+		bool    allRotations;        // Try all BC7 mode 4 and 5 channel rotations.
+	};
+
+	static const BptcQuality s_bptcQuality[] =
+	{
+		{ 0xff,  4, 1, true,  true  }, // Default
+		{ 0xff, 64, 2, true,  true  }, // Highest
+		{ 0x42,  1, 0, false, false }, // Fastest
+	};
+	BX_STATIC_ASSERT(Quality::Count == BX_COUNTOF(s_bptcQuality) );
+
+	struct BitWriter
+	{
+		BitWriter(uint8_t* _data)
+			: m_data(_data)
+			, m_bitPos(0)
+		{
+			bx::memSet(m_data, 0, 16);
+		}
+
+		void write(uint32_t _value, uint8_t _numBits)
+		{
+			for (uint8_t ii = 0; ii < _numBits; ++ii, ++m_bitPos)
+			{
+				m_data[m_bitPos/8] |= uint8_t( ( (_value >> ii) & 1) << (m_bitPos & 7) );
+			}
+		}
+
+		uint8_t* m_data;
+		uint16_t m_bitPos;
+	};
+
+	BX_ALIGN_DECL_16(struct) BptcSubset
+	{
+		float    m_value[4][16]; // Channel values, padded to multiple of 4 pixels.
+		uint8_t  m_pixel[16];    // Pixel position within block.
+		uint32_t m_num;
+		uint32_t m_anchor;       // Anchor pixel, index into m_pixel.
+	};
+
+	static uint32_t bptcSubsetIndex(uint32_t _numSubsets, uint32_t _partition, uint32_t _pixel)
+	{
+		switch (_numSubsets)
+		{
+		case 2:  return (g_bptcP2[_partition] >>    _pixel) & 1;
+		case 3:  return (g_bptcP3[_partition] >> (2*_pixel) ) & 3;
+		default: break;
+		}
+
+		return 0;
+	}
+
+	static uint32_t bptcAnchor(uint32_t _numSubsets, uint32_t _partition, uint32_t _subset)
+	{
+		if (0 == _subset)
+		{
+			return 0;
+		}
+
+		return 2 == _numSubsets
+			? g_bptcA2[_partition]
+			: g_bptcA3[_subset-1][_partition]
+			;
+	}
+
+	static void bptcGatherSubsets(BptcSubset* _subset, uint32_t _numSubsets, uint32_t _partition, const float _value[4][16])
+	{
+		for (uint32_t ss = 0; ss < _numSubsets; ++ss)
+		{
+			_subset[ss].m_num    = 0;
+			_subset[ss].m_anchor = 0;
+		}
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			const uint32_t ss = bptcSubsetIndex(_numSubsets, _partition, ii);
+			BptcSubset& subset = _subset[ss];
+
+			const uint32_t num = subset.m_num++;
+			subset.m_pixel[num] = uint8_t(ii);
+			subset.m_value[0][num] = _value[0][ii];
+			subset.m_value[1][num] = _value[1][ii];
+			subset.m_value[2][num] = _value[2][ii];
+			subset.m_value[3][num] = _value[3][ii];
+
+			if (ii == bptcAnchor(_numSubsets, _partition, ss) )
+			{
+				subset.m_anchor = num;
+			}
+		}
+
+		for (uint32_t ss = 0; ss < _numSubsets; ++ss)
+		{
+			BptcSubset& subset = _subset[ss];
+
+			for (uint32_t ii = subset.m_num; 0 != (ii & 3); ++ii)
+			{
+				subset.m_value[0][ii] = subset.m_value[0][0];
+				subset.m_value[1][ii] = subset.m_value[1][0];
+				subset.m_value[2][ii] = subset.m_value[2][0];
+				subset.m_value[3][ii] = subset.m_value[3][0];
+			}
+		}
+	}
+
+	// Finds closest palette entry for each pixel of subset, 4 pixels at the time. Returns
+	// weighted squared error.
+	static float bptcSelectIndices(uint8_t* _outIndex, const BptcSubset& _subset, const float _palette[][4], uint32_t _numEntries, const float _weight[4])
+	{
+		using namespace bx;
+
+		const simd128_t wr = simd_splat(_weight[0]);
+		const simd128_t wg = simd_splat(_weight[1]);
+		const simd128_t wb = simd_splat(_weight[2]);
+		const simd128_t wa = simd_splat(_weight[3]);
+
+		BX_ALIGN_DECL_16(float    error[16]);
+		BX_ALIGN_DECL_16(uint32_t index[16]);
+
+		for (uint32_t ii = 0; ii < _subset.m_num; ii += 4)
+		{
+			const simd128_t rr = simd_ld(&_subset.m_value[0][ii]);
+			const simd128_t gg = simd_ld(&_subset.m_value[1][ii]);
+			const simd128_t bb = simd_ld(&_subset.m_value[2][ii]);
+			const simd128_t aa = simd_ld(&_subset.m_value[3][ii]);
+
+			simd128_t best    = simd_splat(bx::kFloatMax);
+			simd128_t bestIdx = simd_zero();
+
+			for (uint32_t jj = 0; jj < _numEntries; ++jj)
+			{
+				const float* entry = _palette[jj];
+				const simd128_t dr   = simd_sub(rr, simd_splat(entry[0]) );
+				const simd128_t dg   = simd_sub(gg, simd_splat(entry[1]) );
+				const simd128_t db   = simd_sub(bb, simd_splat(entry[2]) );
+				const simd128_t da   = simd_sub(aa, simd_splat(entry[3]) );
+				const simd128_t err0 = simd_mul(simd_mul(dr, dr), wr);
+				const simd128_t err1 = simd_madd(simd_mul(dg, dg), wg, err0);
+				const simd128_t err2 = simd_madd(simd_mul(db, db), wb, err1);
+				const simd128_t err  = simd_madd(simd_mul(da, da), wa, err2);
+				const simd128_t mask = simd_cmplt(err, best);
+
+				best    = simd_selb(mask, err, best);
+				bestIdx = simd_selb(mask, simd_isplat(jj), bestIdx);
+			}
+
+			simd_st(&error[ii], best);
+			simd_st(&index[ii], bestIdx);
+		}
+
+		float total = 0.0f;
+
+		for (uint32_t ii = 0; ii < _subset.m_num; ++ii)
+		{
+			total += error[ii];
+			_outIndex[ii] = uint8_t(index[ii]);
+		}
+
+		return total;
+	}
+
+	// Fits line through subset pixels with principal component analysis. Endpoints are ordered so
+	// that anchor pixel projects onto the first half of the line. Returns squared distance of
+	// pixels from the line, used to rank partitions.
+	static float bptcFitLine(float _e0[4], float _e1[4], const BptcSubset& _subset, uint32_t _firstChannel, uint32_t _numChannels)
+	{
+		const uint32_t num = _subset.m_num;
+		const uint32_t end = _firstChannel + _numChannels;
+
+		float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (uint32_t ch = _firstChannel; ch < end; ++ch)
+		{
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				mean[ch] += _subset.m_value[ch][ii];
+			}
+
+			mean[ch] /= float(num);
+		}
+
+		float cov[4][4] = {};
+		float variance  = 0.0f;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			for (uint32_t aa = _firstChannel; aa < end; ++aa)
+			{
+				const float da = _subset.m_value[aa][ii] - mean[aa];
+				variance += da*da;
+
+				for (uint32_t bb = aa; bb < end; ++bb)
+				{
+					cov[aa][bb] += da*(_subset.m_value[bb][ii] - mean[bb]);
+				}
+			}
+		}
+
+		float axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (uint32_t aa = _firstChannel; aa < end; ++aa)
+		{
+			axis[aa] = 1.0f;
+
+			for (uint32_t bb = _firstChannel; bb < aa; ++bb)
+			{
+				cov[aa][bb] = cov[bb][aa];
+			}
+		}
+
+		// Power iteration converges to eigenvector with the largest eigenvalue.
+		for (uint32_t iter = 0; iter < 8; ++iter)
+		{
+			float tmp[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float len = 0.0f;
+			for (uint32_t aa = _firstChannel; aa < end; ++aa)
+			{
+				for (uint32_t bb = _firstChannel; bb < end; ++bb)
+				{
+					tmp[aa] += cov[aa][bb]*axis[bb];
+				}
+
+				len += tmp[aa]*tmp[aa];
+			}
+
+			if (len < 1e-12f)
+			{
+				break;
+			}
+
+			const float invLen = 1.0f/bx::sqrt(len);
+			for (uint32_t aa = _firstChannel; aa < end; ++aa)
+			{
+				axis[aa] = tmp[aa]*invLen;
+			}
+		}
+
+		float len = 0.0f;
+		for (uint32_t aa = _firstChannel; aa < end; ++aa)
+		{
+			len += axis[aa]*axis[aa];
+		}
+
+		const float invLen = 1.0f/bx::sqrt(len);
+		for (uint32_t aa = _firstChannel; aa < end; ++aa)
+		{
+			axis[aa] *= invLen;
+		}
+
+		float tmin = bx::kFloatMax;
+		float tmax = -bx::kFloatMax;
+		float tanchor  = 0.0f;
+		float projected = 0.0f;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			float tt = 0.0f;
+			for (uint32_t aa = _firstChannel; aa < end; ++aa)
+			{
+				tt += (_subset.m_value[aa][ii] - mean[aa])*axis[aa];
+			}
+
+			tmin = bx::min(tmin, tt);
+			tmax = bx::max(tmax, tt);
+			projected += tt*tt;
+
+			if (ii == _subset.m_anchor)
+			{
+				tanchor = tt;
+			}
+		}
+
+		if (tanchor > (tmin + tmax)*0.5f)
+		{
+			bx::xchg(tmin, tmax);
+		}
+
+		for (uint32_t aa = _firstChannel; aa < end; ++aa)
+		{
+			_e0[aa] = mean[aa] + axis[aa]*tmin;
+			_e1[aa] = mean[aa] + axis[aa]*tmax;
+		}
+
+		return bx::max(variance - projected, 0.0f);
+	}
+
+	// Solves for endpoints that minimize squared error for the given indices.
+	static bool bptcRefineLine(float _e0[4], float _e1[4], const BptcSubset& _subset, const uint8_t* _index, const uint8_t* _factors, uint32_t _firstChannel, uint32_t _numChannels)
+	{
+		const uint32_t end = _firstChannel + _numChannels;
+
+		float aa = 0.0f;
+		float ab = 0.0f;
+		float bb = 0.0f;
+		float x0[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float x1[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		for (uint32_t ii = 0; ii < _subset.m_num; ++ii)
+		{
+			const float ww  = float(_factors[_index[ii] ])/64.0f;
+			const float iww = 1.0f - ww;
+
+			aa += iww*iww;
+			ab += iww*ww;
+			bb += ww*ww;
+
+			for (uint32_t ch = _firstChannel; ch < end; ++ch)
+			{
+				x0[ch] += iww*_subset.m_value[ch][ii];
+				x1[ch] += ww *_subset.m_value[ch][ii];
+			}
+		}
+
+		const float det = aa*bb - ab*ab;
+		if (bx::abs(det) < 1e-6f)
+		{
+			return false;
+		}
+
+		const float invDet = 1.0f/det;
+		for (uint32_t ch = _firstChannel; ch < end; ++ch)
+		{
+			_e0[ch] = (bb*x0[ch] - ab*x1[ch])*invDet;
+			_e1[ch] = (aa*x1[ch] - ab*x0[ch])*invDet;
+		}
+
+		return true;
+	}
+
+	// Returns up to _maxCandidates partitions ordered by estimated error.
+	static uint32_t bptcRankPartitions(uint8_t* _outPartition, uint32_t _maxCandidates, uint32_t _numSubsets, uint32_t _numPartitions, const float _value[4][16], uint32_t _numChannels)
+	{
+		float error[64];
+
+		for (uint32_t pp = 0; pp < _numPartitions; ++pp)
+		{
+			BptcSubset subset[3];
+			bptcGatherSubsets(subset, _numSubsets, pp, _value);
+
+			error[pp] = 0.0f;
+			for (uint32_t ss = 0; ss < _numSubsets; ++ss)
+			{
+				float e0[4];
+				float e1[4];
+				error[pp] += bptcFitLine(e0, e1, subset[ss], 0, _numChannels);
+			}
+		}
+
+		const uint32_t num = bx::min(_maxCandidates, _numPartitions);
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			uint32_t best = 0;
+			for (uint32_t pp = 1; pp < _numPartitions; ++pp)
+			{
+				best = error[pp] < error[best] ? pp : best;
+			}
+
+			_outPartition[ii] = uint8_t(best);
+			error[best] = bx::kFloatMax;
+		}
+
+		return num;
+	}
+
+	struct Bc7Block
+	{
+		uint8_t mode;
+		uint8_t partition;
+		uint8_t rotation;
+		uint8_t indexSelection;
+		uint8_t endpoint[3][2][4]; // [subset][endpoint][channel], without P-bit.
+		uint8_t pbit[3][2];
+		uint8_t index[2][16];
+	};
+
+	struct Bc7Group
+	{
+		uint32_t firstChannel;
+		uint32_t numChannels;
+		uint8_t  bits[4];
+		uint8_t  indexBits;
+		uint8_t  numPBitCombos; // 1 - no P-bits, 2 - shared P-bit, 4 - unique P-bits.
+	};
+
+	static uint8_t bc7Expand(uint32_t _value, uint8_t _bits, int32_t _pbit)
+	{
+		return 0 > _pbit
+			? bc7Unquantize(_value, _bits)
+			: bc7Unquantize( (_value<<1) | _pbit, _bits+1)
+			;
+	}
+
+	static uint8_t bc7Quantize(float _value, uint8_t _bits, int32_t _pbit)
+	{
+		const int32_t max   = (1<<_bits) - 1;
+		const float   value = bx::clamp(_value, 0.0f, 255.0f);
+
+		const int32_t guess = 0 > _pbit
+			? int32_t(value*float(max)/255.0f + 0.5f)
+			: int32_t( (value*float(max*2+1)/255.0f - float(_pbit) )*0.5f + 0.5f)
+			;
+
+		int32_t best      = 0;
+		float   bestError = bx::kFloatMax;
+
+		for (int32_t qq = bx::max(guess-1, 0), end = bx::min(guess+1, max); qq <= end; ++qq)
+		{
+			const float error = bx::abs(float(bc7Expand(qq, _bits, _pbit) ) - value);
+			if (error < bestError)
+			{
+				best      = qq;
+				bestError = error;
+			}
+		}
+
+		return uint8_t(best);
+	}
+
+	// Quantizes endpoints of one index set of a subset, trying all P-bit combinations and refining
+	// endpoints from selected indices.
+	static float bc7EncodeGroup(uint8_t _outEndpoint[2][4], uint8_t _outPBit[2], uint8_t* _outIndex, const BptcSubset& _subset, const Bc7Group& _group, const float _weight[4], uint32_t _numRefineIterations)
+	{
+		const uint32_t end         = _group.firstChannel + _group.numChannels;
+		const uint32_t numEntries  = 1<<_group.indexBits;
+		const uint8_t* factors     = g_bptcFactors[_group.indexBits-2];
+
+		float weight[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (uint32_t ch = _group.firstChannel; ch < end; ++ch)
+		{
+			weight[ch] = _weight[ch];
+		}
+
+		float e0[4];
+		float e1[4];
+		bptcFitLine(e0, e1, _subset, _group.firstChannel, _group.numChannels);
+
+		float bestError = bx::kFloatMax;
+
+		for (uint32_t iter = 0; iter <= _numRefineIterations; ++iter)
+		{
+			uint8_t iterIndex[16] = {};
+			float   iterError = bx::kFloatMax;
+
+			for (uint32_t combo = 0; combo < _group.numPBitCombos; ++combo)
+			{
+				const int32_t pbit0 = 1 == _group.numPBitCombos ? -1 : int32_t(combo & 1);
+				const int32_t pbit1 = 4 == _group.numPBitCombos ? int32_t(combo >> 1) : pbit0;
+
+				uint8_t endpoint[2][4] = {};
+				float   palette[16][4] = {};
+
+				for (uint32_t ch = _group.firstChannel; ch < end; ++ch)
+				{
+					const uint8_t bits = _group.bits[ch];
+					endpoint[0][ch] = bc7Quantize(e0[ch], bits, pbit0);
+					endpoint[1][ch] = bc7Quantize(e1[ch], bits, pbit1);
+
+					const int32_t c0 = bc7Expand(endpoint[0][ch], bits, pbit0);
+					const int32_t c1 = bc7Expand(endpoint[1][ch], bits, pbit1);
+
+					for (uint32_t ii = 0; ii < numEntries; ++ii)
+					{
+						palette[ii][ch] = float( (c0*(64-factors[ii]) + c1*factors[ii] + 32) >> 6);
+					}
+				}
+
+				uint8_t index[16];
+				const float error = bptcSelectIndices(index, _subset, palette, numEntries, weight);
+
+				if (error < iterError)
+				{
+					iterError = error;
+					bx::memCopy(iterIndex, index, sizeof(iterIndex) );
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					bx::memCopy(_outEndpoint, endpoint, sizeof(endpoint) );
+					_outPBit[0] = uint8_t(bx::max(pbit0, 0) );
+					_outPBit[1] = uint8_t(bx::max(pbit1, 0) );
+					bx::memCopy(_outIndex, index, _subset.m_num);
+				}
+			}
+
+			// Nothing to refine from when no P-bit combination produced valid error (NaN input).
+			if (iter == _numRefineIterations
+			||  0.0f == bestError
+			||  bx::kFloatMax == iterError
+			||  !bptcRefineLine(e0, e1, _subset, iterIndex, factors, _group.firstChannel, _group.numChannels) )
+			{
+				break;
+			}
+		}
+
+		return bestError;
+	}
+
+	static float bc7EncodeMode(Bc7Block& _out, const float _value[4][16], uint32_t _mode, uint32_t _partition, uint32_t _rotation, uint32_t _indexSelection, const BptcQuality& _quality)
+	{
+		const Bc7ModeInfo& mi = g_bc7ModeInfo[_mode];
+		const float weight[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		_out.mode           = uint8_t(_mode);
+		_out.partition      = uint8_t(_partition);
+		_out.rotation       = uint8_t(_rotation);
+		_out.indexSelection = uint8_t(_indexSelection);
+		bx::memSet(_out.endpoint, 0, sizeof(_out.endpoint) );
+		bx::memSet(_out.pbit,     0, sizeof(_out.pbit) );
+
+		BptcSubset subset[3];
+		bptcGatherSubsets(subset, mi.numSubsets, _partition, _value);
+
+		float error = 0.0f;
+
+		for (uint32_t ss = 0; ss < mi.numSubsets; ++ss)
+		{
+			uint8_t index[2][16];
+
+			if (0 == mi.rotationBits)
+			{
+				const Bc7Group group =
+				{
+					0,
+					0 != mi.alphaBits ? 4u : 3u,
+					{ mi.colorBits, mi.colorBits, mi.colorBits, mi.alphaBits },
+					mi.indexBits[0],
+					uint8_t(0 != mi.endpointPBits ? 4 : 0 != mi.sharedPBits ? 2 : 1),
+				};
+
+				error += bc7EncodeGroup(_out.endpoint[ss], _out.pbit[ss], index[0], subset[ss], group, weight, _quality.numRefineIterations);
+
+				for (uint32_t ii = 0; ii < subset[ss].m_num; ++ii)
+				{
+					_out.index[0][subset[ss].m_pixel[ii] ] = index[0][ii];
+				}
+			}
+			else
+			{
+				const Bc7Group color =
+				{
+					0,
+					3,
+					{ mi.colorBits, mi.colorBits, mi.colorBits, 0 },
+					mi.indexBits[_indexSelection],
+					1,
+				};
+
+				const Bc7Group alpha =
+				{
+					3,
+					1,
+					{ 0, 0, 0, mi.alphaBits },
+					mi.indexBits[!_indexSelection],
+					1,
+				};
+
+				uint8_t endpoint[2][4];
+				uint8_t pbit[2];
+				error += bc7EncodeGroup(_out.endpoint[ss], pbit, index[ _indexSelection], subset[ss], color, weight, _quality.numRefineIterations);
+				error += bc7EncodeGroup(endpoint,          pbit, index[!_indexSelection], subset[ss], alpha, weight, _quality.numRefineIterations);
+				_out.endpoint[ss][0][3] = endpoint[0][3];
+				_out.endpoint[ss][1][3] = endpoint[1][3];
+
+				bx::memCopy(_out.index, index, sizeof(index) );
+			}
+		}
+
+		return error;
+	}
+
+	// Anchor index most significant bit is implicitly zero, flip endpoints where it's not.
+	static void bc7FixAnchors(Bc7Block& _block)
+	{
+		const Bc7ModeInfo& mi = g_bc7ModeInfo[_block.mode];
+		const uint32_t numStreams = 0 != mi.indexBits[1] ? 2 : 1;
+
+		for (uint32_t stream = 0; stream < numStreams; ++stream)
+		{
+			const uint8_t indexBits = mi.indexBits[stream];
+			const uint8_t maxIndex  = uint8_t( (1<<indexBits) - 1);
+
+			uint32_t firstChannel = 0;
+			uint32_t numChannels  = 4;
+
+			if (0 != mi.rotationBits)
+			{
+				const bool color = stream == _block.indexSelection;
+				firstChannel = color ? 0 : 3;
+				numChannels  = color ? 3 : 1;
+			}
+
+			for (uint32_t ss = 0; ss < mi.numSubsets; ++ss)
+			{
+				const uint32_t anchor = bptcAnchor(mi.numSubsets, _block.partition, ss);
+				if (0 == (_block.index[stream][anchor] >> (indexBits-1) ) )
+				{
+					continue;
+				}
+
+				for (uint32_t ii = 0; ii < 16; ++ii)
+				{
+					if (ss == bptcSubsetIndex(mi.numSubsets, _block.partition, ii) )
+					{
+						_block.index[stream][ii] = maxIndex - _block.index[stream][ii];
+					}
+				}
+
+				for (uint32_t ch = firstChannel, end = firstChannel + numChannels; ch < end; ++ch)
+				{
+					bx::xchg(_block.endpoint[ss][0][ch], _block.endpoint[ss][1][ch]);
+				}
+
+				bx::xchg(_block.pbit[ss][0], _block.pbit[ss][1]);
+			}
+		}
+	}
+
+	static void bc7Write(uint8_t _dst[16], const Bc7Block& _block)
+	{
+		const Bc7ModeInfo& mi = g_bc7ModeInfo[_block.mode];
+
+		BitWriter bit(_dst);
+		bit.write(1<<_block.mode, _block.mode+1);
+		bit.write(_block.partition,      mi.partitionBits);
+		bit.write(_block.rotation,       mi.rotationBits);
+		bit.write(_block.indexSelection, mi.indexSelectionBits);
+
+		for (uint32_t ch = 0; ch < 3; ++ch)
+		{
+			for (uint32_t ss = 0; ss < mi.numSubsets; ++ss)
+			{
+				bit.write(_block.endpoint[ss][0][ch], mi.colorBits);
+				bit.write(_block.endpoint[ss][1][ch], mi.colorBits);
+			}
+		}
+
+		for (uint32_t ss = 0; ss < mi.numSubsets; ++ss)
+		{
+			bit.write(_block.endpoint[ss][0][3], mi.alphaBits);
+			bit.write(_block.endpoint[ss][1][3], mi.alphaBits);
+		}
+
+		for (uint32_t ss = 0; ss < mi.numSubsets; ++ss)
+		{
+			bit.write(_block.pbit[ss][0], mi.endpointPBits | mi.sharedPBits);
+			bit.write(_block.pbit[ss][1], mi.endpointPBits);
+		}
+
+		for (uint32_t stream = 0, numStreams = 0 != mi.indexBits[1] ? 2 : 1; stream < numStreams; ++stream)
+		{
+			for (uint32_t ii = 0; ii < 16; ++ii)
+			{
+				const uint32_t ss     = bptcSubsetIndex(mi.numSubsets, _block.partition, ii);
+				const uint8_t  anchor = ii == bptcAnchor(mi.numSubsets, _block.partition, ss);
+				bit.write(_block.index[stream][ii], mi.indexBits[stream] - anchor);
+			}
+		}
+	}
+
+	static void encodeBlockBc7(uint8_t _dst[16], const uint8_t _src[16*4], Quality::Enum _quality)
+	{
+		const BptcQuality& quality = s_bptcQuality[_quality];
+
+		BX_ALIGN_DECL_16(float value[4][16]);
+		bool opaque = true;
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			value[0][ii] = float(_src[ii*4+0]);
+			value[1][ii] = float(_src[ii*4+1]);
+			value[2][ii] = float(_src[ii*4+2]);
+			value[3][ii] = float(_src[ii*4+3]);
+			opaque &= 255 == _src[ii*4+3];
+		}
+
+		Bc7Block best;
+		bx::memSet(&best, 0, sizeof(best) );
+		float bestError = bx::kFloatMax;
+
+		Bc7Block block;
+		float error;
+
+#define BC7_ENCODE_MODE(_value, _mode, _partition, _rotation, _indexSelection)                  \
+			error = bc7EncodeMode(block, _value, _mode, _partition, _rotation, _indexSelection, quality); \
+			if (error < bestError)                                                               \
+			{                                                                                    \
+				best      = block;                                                               \
+				bestError = error;                                                               \
+			}
+
+		if (0 != (quality.bc7ModeMask & (1<<6) ) )
+		{
+			BC7_ENCODE_MODE(value, 6, 0, 0, 0);
+		}
+
+		if (0 != (quality.bc7ModeMask & ((1<<4)|(1<<5) ) ) )
+		{
+			for (uint32_t rotation = 0, num = quality.allRotations ? 4 : 1; rotation < num && 0.0f < bestError; ++rotation)
+			{
+				BX_ALIGN_DECL_16(float rotated[4][16]);
+				bx::memCopy(rotated, value, sizeof(rotated) );
+
+				if (0 != rotation)
+				{
+					bx::memCopy(rotated[3],          value[rotation-1], sizeof(rotated[3]) );
+					bx::memCopy(rotated[rotation-1], value[3],          sizeof(rotated[3]) );
+				}
+
+				if (0 != (quality.bc7ModeMask & (1<<5) ) )
+				{
+					BC7_ENCODE_MODE(rotated, 5, 0, rotation, 0);
+				}
+
+				if (0 != (quality.bc7ModeMask & (1<<4) ) )
+				{
+					BC7_ENCODE_MODE(rotated, 4, 0, rotation, 0);
+					BC7_ENCODE_MODE(rotated, 4, 0, rotation, 1);
+				}
+			}
+		}
+
+		uint8_t partition[64];
+
+		if (0.0f < bestError
+		&&  0 != (quality.bc7ModeMask & (opaque ? (1<<1)|(1<<3) : (1<<7) ) ) )
+		{
+			const uint32_t num = bptcRankPartitions(partition, quality.numPartitions, 2, 64, value, opaque ? 3 : 4);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				if (opaque)
+				{
+					if (0 != (quality.bc7ModeMask & (1<<1) ) )
+					{
+						BC7_ENCODE_MODE(value, 1, partition[ii], 0, 0);
+					}
+
+					if (0 != (quality.bc7ModeMask & (1<<3) ) )
+					{
+						BC7_ENCODE_MODE(value, 3, partition[ii], 0, 0);
+					}
+				}
+				else
+				{
+					BC7_ENCODE_MODE(value, 7, partition[ii], 0, 0);
+				}
+			}
+		}
+
+		if (opaque
+		&&  0.0f < bestError)
+		{
+			if (0 != (quality.bc7ModeMask & (1<<0) ) )
+			{
+				const uint32_t num = bptcRankPartitions(partition, quality.numPartitions, 3, 16, value, 3);
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					BC7_ENCODE_MODE(value, 0, partition[ii], 0, 0);
+				}
+			}
+
+			if (0 != (quality.bc7ModeMask & (1<<2) ) )
+			{
+				const uint32_t num = bptcRankPartitions(partition, quality.numPartitions, 3, 64, value, 3);
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					BC7_ENCODE_MODE(value, 2, partition[ii], 0, 0);
+				}
+			}
+		}
+
+#undef BC7_ENCODE_MODE
+
+		bc7FixAnchors(best);
+		bc7Write(_dst, best);
+	}
+
+	struct Bc6hField
+	{
+		uint8_t channel;
+		uint8_t endpoint;
+		uint8_t numBits;
+		uint8_t shift;
+	};
+
+	// Endpoint bit layout of each mode, in the order bits are stored in block.
+	static const Bc6hField s_bc6hFields0[] =
+	{
+		{ 1, 2,  1,  4 }, { 2, 2,  1,  4 }, { 2, 3,  1,  4 }, { 0, 0, 10,  0 },
+		{ 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  5,  0 }, { 1, 3,  1,  4 },
+		{ 1, 2,  4,  0 }, { 1, 1,  5,  0 }, { 2, 3,  1,  0 }, { 1, 3,  4,  0 },
+		{ 2, 1,  5,  0 }, { 2, 3,  1,  1 }, { 2, 2,  4,  0 }, { 0, 2,  5,  0 },
+		{ 2, 3,  1,  2 }, { 0, 3,  5,  0 }, { 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields1[] =
+	{
+		{ 1, 2,  1,  5 }, { 1, 3,  1,  4 }, { 1, 3,  1,  5 }, { 0, 0,  7,  0 },
+		{ 2, 3,  1,  0 }, { 2, 3,  1,  1 }, { 2, 2,  1,  4 }, { 1, 0,  7,  0 },
+		{ 2, 2,  1,  5 }, { 2, 3,  1,  2 }, { 1, 2,  1,  4 }, { 2, 0,  7,  0 },
+		{ 2, 3,  1,  3 }, { 2, 3,  1,  5 }, { 2, 3,  1,  4 }, { 0, 1,  6,  0 },
+		{ 1, 2,  4,  0 }, { 1, 1,  6,  0 }, { 1, 3,  4,  0 }, { 2, 1,  6,  0 },
+		{ 2, 2,  4,  0 }, { 0, 2,  6,  0 }, { 0, 3,  6,  0 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields2[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  5,  0 },
+		{ 0, 0,  1, 10 }, { 1, 2,  4,  0 }, { 1, 1,  4,  0 }, { 1, 0,  1, 10 },
+		{ 2, 3,  1,  0 }, { 1, 3,  4,  0 }, { 2, 1,  4,  0 }, { 2, 0,  1, 10 },
+		{ 2, 3,  1,  1 }, { 2, 2,  4,  0 }, { 0, 2,  5,  0 }, { 2, 3,  1,  2 },
+		{ 0, 3,  5,  0 }, { 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields3[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1, 10,  0 },
+		{ 1, 1, 10,  0 }, { 2, 1, 10,  0 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields6[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  4,  0 },
+		{ 0, 0,  1, 10 }, { 1, 3,  1,  4 }, { 1, 2,  4,  0 }, { 1, 1,  5,  0 },
+		{ 1, 0,  1, 10 }, { 1, 3,  4,  0 }, { 2, 1,  4,  0 }, { 2, 0,  1, 10 },
+		{ 2, 3,  1,  1 }, { 2, 2,  4,  0 }, { 0, 2,  4,  0 }, { 2, 3,  1,  0 },
+		{ 2, 3,  1,  2 }, { 0, 3,  4,  0 }, { 1, 2,  1,  4 }, { 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields7[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  9,  0 },
+		{ 0, 0,  1, 10 }, { 1, 1,  9,  0 }, { 1, 0,  1, 10 }, { 2, 1,  9,  0 },
+		{ 2, 0,  1, 10 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields10[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  4,  0 },
+		{ 0, 0,  1, 10 }, { 2, 2,  1,  4 }, { 1, 2,  4,  0 }, { 1, 1,  4,  0 },
+		{ 1, 0,  1, 10 }, { 2, 3,  1,  0 }, { 1, 3,  4,  0 }, { 2, 1,  5,  0 },
+		{ 2, 0,  1, 10 }, { 2, 2,  4,  0 }, { 0, 2,  4,  0 }, { 2, 3,  1,  1 },
+		{ 2, 3,  1,  2 }, { 0, 3,  4,  0 }, { 2, 3,  1,  4 }, { 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields11[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  8,  0 },
+		{ 0, 0,  1, 11 }, { 0, 0,  1, 10 }, { 1, 1,  8,  0 }, { 1, 0,  1, 11 },
+		{ 1, 0,  1, 10 }, { 2, 1,  8,  0 }, { 2, 0,  1, 11 }, { 2, 0,  1, 10 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields14[] =
+	{
+		{ 0, 0,  9,  0 }, { 2, 2,  1,  4 }, { 1, 0,  9,  0 }, { 1, 2,  1,  4 },
+		{ 2, 0,  9,  0 }, { 2, 3,  1,  4 }, { 0, 1,  5,  0 }, { 1, 3,  1,  4 },
+		{ 1, 2,  4,  0 }, { 1, 1,  5,  0 }, { 2, 3,  1,  0 }, { 1, 3,  4,  0 },
+		{ 2, 1,  5,  0 }, { 2, 3,  1,  1 }, { 2, 2,  4,  0 }, { 0, 2,  5,  0 },
+		{ 2, 3,  1,  2 }, { 0, 3,  5,  0 }, { 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields15[] =
+	{
+		{ 0, 0, 10,  0 }, { 1, 0, 10,  0 }, { 2, 0, 10,  0 }, { 0, 1,  4,  0 },
+		{ 0, 0,  1, 15 }, { 0, 0,  1, 14 }, { 0, 0,  1, 13 }, { 0, 0,  1, 12 },
+		{ 0, 0,  1, 11 }, { 0, 0,  1, 10 }, { 1, 1,  4,  0 }, { 1, 0,  1, 15 },
+		{ 1, 0,  1, 14 }, { 1, 0,  1, 13 }, { 1, 0,  1, 12 }, { 1, 0,  1, 11 },
+		{ 1, 0,  1, 10 }, { 2, 1,  4,  0 }, { 2, 0,  1, 15 }, { 2, 0,  1, 14 },
+		{ 2, 0,  1, 13 }, { 2, 0,  1, 12 }, { 2, 0,  1, 11 }, { 2, 0,  1, 10 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields18[] =
+	{
+		{ 0, 0,  8,  0 }, { 1, 3,  1,  4 }, { 2, 2,  1,  4 }, { 1, 0,  8,  0 },
+		{ 2, 3,  1,  2 }, { 1, 2,  1,  4 }, { 2, 0,  8,  0 }, { 2, 3,  1,  3 },
+		{ 2, 3,  1,  4 }, { 0, 1,  6,  0 }, { 1, 2,  4,  0 }, { 1, 1,  5,  0 },
+		{ 2, 3,  1,  0 }, { 1, 3,  4,  0 }, { 2, 1,  5,  0 }, { 2, 3,  1,  1 },
+		{ 2, 2,  4,  0 }, { 0, 2,  6,  0 }, { 0, 3,  6,  0 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields22[] =
+	{
+		{ 0, 0,  8,  0 }, { 2, 3,  1,  0 }, { 2, 2,  1,  4 }, { 1, 0,  8,  0 },
+		{ 1, 2,  1,  5 }, { 1, 2,  1,  4 }, { 2, 0,  8,  0 }, { 1, 3,  1,  5 },
+		{ 2, 3,  1,  4 }, { 0, 1,  5,  0 }, { 1, 3,  1,  4 }, { 1, 2,  4,  0 },
+		{ 1, 1,  6,  0 }, { 1, 3,  4,  0 }, { 2, 1,  5,  0 }, { 2, 3,  1,  1 },
+		{ 2, 2,  4,  0 }, { 0, 2,  5,  0 }, { 2, 3,  1,  2 }, { 0, 3,  5,  0 },
+		{ 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields26[] =
+	{
+		{ 0, 0,  8,  0 }, { 2, 3,  1,  1 }, { 2, 2,  1,  4 }, { 1, 0,  8,  0 },
+		{ 2, 2,  1,  5 }, { 1, 2,  1,  4 }, { 2, 0,  8,  0 }, { 2, 3,  1,  5 },
+		{ 2, 3,  1,  4 }, { 0, 1,  5,  0 }, { 1, 3,  1,  4 }, { 1, 2,  4,  0 },
+		{ 1, 1,  5,  0 }, { 2, 3,  1,  0 }, { 1, 3,  4,  0 }, { 2, 1,  6,  0 },
+		{ 2, 2,  4,  0 }, { 0, 2,  5,  0 }, { 2, 3,  1,  2 }, { 0, 3,  5,  0 },
+		{ 2, 3,  1,  3 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField s_bc6hFields30[] =
+	{
+		{ 0, 0,  6,  0 }, { 1, 3,  1,  4 }, { 2, 3,  1,  0 }, { 2, 3,  1,  1 },
+		{ 2, 2,  1,  4 }, { 1, 0,  6,  0 }, { 1, 2,  1,  5 }, { 2, 2,  1,  5 },
+		{ 2, 3,  1,  2 }, { 1, 2,  1,  4 }, { 2, 0,  6,  0 }, { 1, 3,  1,  5 },
+		{ 2, 3,  1,  3 }, { 2, 3,  1,  5 }, { 2, 3,  1,  4 }, { 0, 1,  6,  0 },
+		{ 1, 2,  4,  0 }, { 1, 1,  6,  0 }, { 1, 3,  4,  0 }, { 2, 1,  6,  0 },
+		{ 2, 2,  4,  0 }, { 0, 2,  6,  0 }, { 0, 3,  6,  0 },
+		{ 0, 0,  0,  0 },
+	};
+
+	static const Bc6hField* s_bc6hFields[32] =
+	{
+		s_bc6hFields0,  s_bc6hFields1,  s_bc6hFields2,  s_bc6hFields3,
+		NULL,           NULL,           s_bc6hFields6,  s_bc6hFields7,
+		NULL,           NULL,           s_bc6hFields10, s_bc6hFields11,
+		NULL,           NULL,           s_bc6hFields14, s_bc6hFields15,
+		NULL,           NULL,           s_bc6hFields18, NULL,
+		NULL,           NULL,           s_bc6hFields22, NULL,
+		NULL,           NULL,           s_bc6hFields26, NULL,
+		NULL,           NULL,           s_bc6hFields30, NULL,
+	};
+
+	struct Bc6hBlock
+	{
+		uint8_t mode;
+		uint8_t partition;
+		int32_t endpoint[2][2][3]; // [subset][endpoint][channel], quantized and not delta encoded.
+		uint8_t index[16];
+	};
+
+	inline float bc6hHalfToValue(uint16_t _half)
+	{
+		return 0 != (_half & 0x8000)
+			? -float(_half & 0x7fff)
+			:  float(_half)
+			;
+	}
+
+	static int32_t bc6hUnquantizeEndpoint(int32_t _value, uint8_t _bits, bool _signed)
+	{
+		const uint16_t unq = bc6hUnquantize(uint16_t(_value), _signed, _bits);
+
+		return _signed
+			? int32_t(int16_t(unq) )
+			: int32_t(unq)
+			;
+	}
+
+	// Finds quantized endpoint value closest to the value in half float bits.
+	static int32_t bc6hQuantize(float _value, uint8_t _bits, bool _signed)
+	{
+		const float   magnitude = bx::abs(_value);
+		const int32_t max       = _signed
+			? (1<<(_bits-1) ) - 1
+			: (1<<_bits) - 1
+			;
+
+		const float   unq   = magnitude*(_signed ? 32.0f : 64.0f)/31.0f;
+		const int32_t guess = _bits >= (_signed ? 16 : 15)
+			? int32_t(unq + 0.5f)
+			: int32_t(unq*float(1<<_bits)/65536.0f)
+			;
+
+		int32_t best      = 0;
+		float   bestError = bx::kFloatMax;
+
+		for (int32_t qq = bx::max(guess-1, 0), end = bx::min(guess+1, max); qq <= end; ++qq)
+		{
+			const int32_t value = bc6hUnquantizeEndpoint(qq, _bits, _signed);
+			const float   error = bx::abs(bc6hHalfToValue(bc6hUnquantizeFinal(value, _signed) ) - magnitude);
+			if (error < bestError)
+			{
+				best      = qq;
+				bestError = error;
+			}
+		}
+
+		return 0.0f > _value ? -best : best;
+	}
+
+	static bool bc6hDeltaFits(const Bc6hBlock& _block, const Bc6hModeInfo& _mi, uint32_t _numSubsets)
+	{
+		for (uint32_t ch = 0; ch < 3; ++ch)
+		{
+			const int32_t base = _block.endpoint[0][0][ch];
+			const int32_t min  = -(1<<(_mi.deltaBits[ch]-1) );
+			const int32_t max  =  (1<<(_mi.deltaBits[ch]-1) ) - 1;
+
+			for (uint32_t ii = 1, num = _numSubsets*2; ii < num; ++ii)
+			{
+				const int32_t delta = _block.endpoint[ii/2][ii%2][ch] - base;
+				if (delta < min
+				||  delta > max)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	static void bc6hClampDelta(Bc6hBlock& _block, const Bc6hModeInfo& _mi, uint32_t _numSubsets, bool _signed)
+	{
+		const int32_t maxValue = _signed
+			? (1<<(_mi.endpointBits-1) ) - 1
+			: (1<<_mi.endpointBits) - 1
+			;
+		const int32_t minValue = _signed ? -maxValue : 0;
+
+		for (uint32_t ch = 0; ch < 3; ++ch)
+		{
+			const int32_t base = _block.endpoint[0][0][ch];
+			const int32_t min  = -(1<<(_mi.deltaBits[ch]-1) );
+			const int32_t max  =  (1<<(_mi.deltaBits[ch]-1) ) - 1;
+
+			for (uint32_t ii = 1, num = _numSubsets*2; ii < num; ++ii)
+			{
+				int32_t& endpoint = _block.endpoint[ii/2][ii%2][ch];
+				endpoint = bx::clamp(base + bx::clamp(endpoint - base, min, max), minValue, maxValue);
+			}
+		}
+	}
+
+	static float bc6hEncodeMode(Bc6hBlock& _out, const float _value[4][16], uint32_t _mode, uint32_t _partition, bool _signed, const BptcQuality& _quality)
+	{
+		const Bc6hModeInfo& mi = g_bc6hModeInfo[_mode];
+		const uint32_t numSubsets = 0 != mi.partitionBits ? 2 : 1;
+		const uint8_t  indexBits  = 0 != mi.partitionBits ? 3 : 4;
+		const uint32_t numEntries = 1<<indexBits;
+		const uint8_t* factors    = g_bptcFactors[indexBits-2];
+		const float    weight[4]  = { 1.0f, 1.0f, 1.0f, 0.0f };
+
+		BptcSubset subset[2];
+		bptcGatherSubsets(subset, numSubsets, _partition, _value);
+
+		float endpoint[2][2][4];
+		for (uint32_t ss = 0; ss < numSubsets; ++ss)
+		{
+			bptcFitLine(endpoint[ss][0], endpoint[ss][1], subset[ss], 0, 3);
+		}
+
+		Bc6hBlock block;
+		block.mode      = uint8_t(_mode);
+		block.partition = uint8_t(_partition);
+		bx::memSet(block.endpoint, 0, sizeof(block.endpoint) );
+
+		float bestError = bx::kFloatMax;
+
+		for (uint32_t iter = 0; iter <= _quality.numRefineIterations; ++iter)
+		{
+			for (uint32_t ss = 0; ss < numSubsets; ++ss)
+			{
+				for (uint32_t ch = 0; ch < 3; ++ch)
+				{
+					block.endpoint[ss][0][ch] = bc6hQuantize(endpoint[ss][0][ch], mi.endpointBits, _signed);
+					block.endpoint[ss][1][ch] = bc6hQuantize(endpoint[ss][1][ch], mi.endpointBits, _signed);
+				}
+			}
+
+			if (0 != mi.transformed)
+			{
+				bc6hClampDelta(block, mi, numSubsets, _signed);
+			}
+
+			uint8_t index[2][16];
+			float error = 0.0f;
+
+			for (uint32_t ss = 0; ss < numSubsets; ++ss)
+			{
+				float palette[16][4] = {};
+
+				for (uint32_t ch = 0; ch < 3; ++ch)
+				{
+					const int32_t e0 = bc6hUnquantizeEndpoint(block.endpoint[ss][0][ch], mi.endpointBits, _signed);
+					const int32_t e1 = bc6hUnquantizeEndpoint(block.endpoint[ss][1][ch], mi.endpointBits, _signed);
+
+					for (uint32_t ii = 0; ii < numEntries; ++ii)
+					{
+						const int32_t value = (e0*(64-factors[ii]) + e1*factors[ii] + 32) >> 6;
+						palette[ii][ch] = bc6hHalfToValue(bc6hUnquantizeFinal(value, _signed) );
+					}
+				}
+
+				error += bptcSelectIndices(index[ss], subset[ss], palette, numEntries, weight);
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				bx::memCopy(_out.endpoint, block.endpoint, sizeof(block.endpoint) );
+
+				for (uint32_t ss = 0; ss < numSubsets; ++ss)
+				{
+					for (uint32_t ii = 0; ii < subset[ss].m_num; ++ii)
+					{
+						_out.index[subset[ss].m_pixel[ii] ] = index[ss][ii];
+					}
+				}
+			}
+
+			if (iter == _quality.numRefineIterations
+			||  0.0f == bestError)
+			{
+				break;
+			}
+
+			for (uint32_t ss = 0; ss < numSubsets; ++ss)
+			{
+				bptcRefineLine(endpoint[ss][0], endpoint[ss][1], subset[ss], index[ss], factors, 0, 3);
+			}
+		}
+
+		_out.mode      = uint8_t(_mode);
+		_out.partition = uint8_t(_partition);
+
+		// Anchor index most significant bit is implicitly zero, flip endpoints where it's not.
+		bool flipped = false;
+
+		for (uint32_t ss = 0; ss < numSubsets; ++ss)
+		{
+			const uint32_t anchor = bptcAnchor(numSubsets, _partition, ss);
+			if (0 == (_out.index[anchor] >> (indexBits-1) ) )
+			{
+				continue;
+			}
+
+			for (uint32_t ii = 0; ii < 16; ++ii)
+			{
+				if (ss == bptcSubsetIndex(numSubsets, _partition, ii) )
+				{
+					_out.index[ii] = uint8_t(numEntries - 1 - _out.index[ii]);
+				}
+			}
+
+			for (uint32_t ch = 0; ch < 3; ++ch)
+			{
+				bx::xchg(_out.endpoint[ss][0][ch], _out.endpoint[ss][1][ch]);
+			}
+
+			flipped = true;
+		}
+
+		if (flipped
+		&&  0 != mi.transformed
+		&&  !bc6hDeltaFits(_out, mi, numSubsets) )
+		{
+			return bx::kFloatMax;
+		}
+
+		return bestError;
+	}
+
+	static void bc6hWrite(uint8_t _dst[16], const Bc6hBlock& _block)
+	{
+		const Bc6hModeInfo& mi = g_bc6hModeInfo[_block.mode];
+		const uint32_t numSubsets = 0 != mi.partitionBits ? 2 : 1;
+		const uint8_t  indexBits  = 0 != mi.partitionBits ? 3 : 4;
+
+		uint32_t endpoint[3][4] = {};
+
+		for (uint32_t ch = 0; ch < 3; ++ch)
+		{
+			const int32_t base = _block.endpoint[0][0][ch];
+			endpoint[ch][0] = uint32_t(base);
+
+			for (uint32_t ii = 1, num = numSubsets*2; ii < num; ++ii)
+			{
+				const int32_t value = _block.endpoint[ii/2][ii%2][ch];
+				endpoint[ch][ii] = uint32_t(0 != mi.transformed ? value - base : value);
+			}
+		}
+
+		BitWriter bit(_dst);
+		bit.write(_block.mode, 2 > _block.mode ? 2 : 5);
+
+		for (const Bc6hField* field = s_bc6hFields[_block.mode]; 0 != field->numBits; ++field)
+		{
+			bit.write(endpoint[field->channel][field->endpoint] >> field->shift, field->numBits);
+		}
+
+		bit.write(_block.partition, mi.partitionBits);
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			const uint32_t ss     = bptcSubsetIndex(numSubsets, _block.partition, ii);
+			const uint8_t  anchor = ii == bptcAnchor(numSubsets, _block.partition, ss);
+			bit.write(_block.index[ii], indexBits - anchor);
+		}
+	}
+
+	static void encodeBlockBc6h(uint8_t _dst[16], const float _src[16*4], bool _signed, Quality::Enum _quality)
+	{
+		const BptcQuality& quality = s_bptcQuality[_quality];
+
+		BX_ALIGN_DECL_16(float value[4][16]);
+
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			for (uint32_t ch = 0; ch < 3; ++ch)
+			{
+				const float clamped = bx::clamp(_src[ii*4+ch], _signed ? -65504.0f : 0.0f, 65504.0f);
+				value[ch][ii] = bc6hHalfToValue(bx::halfFromFloat(clamped) );
+			}
+
+			value[3][ii] = 0.0f;
+		}
+
+		Bc6hBlock best;
+		bx::memSet(&best, 0, sizeof(best) );
+		float bestError = bx::kFloatMax;
+
+		Bc6hBlock block;
+		float error;
+
+		static const uint8_t s_oneSubsetModes[] = { 3, 7, 11, 15 };
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_oneSubsetModes); ++ii)
+		{
+			error = bc6hEncodeMode(block, value, s_oneSubsetModes[ii], 0, _signed, quality);
+			if (error < bestError)
+			{
+				best      = block;
+				bestError = error;
+			}
+		}
+
+		if (quality.bc6hTwoSubsets
+		&&  0.0f < bestError)
+		{
+			static const uint8_t s_twoSubsetModes[] = { 0, 1, 2, 6, 10, 14, 18, 22, 26, 30 };
+
+			uint8_t partition[32];
+			const uint32_t num = bptcRankPartitions(partition, quality.numPartitions, 2, 32, value, 3);
+
+			for (uint32_t ii = 0; ii < num; ++ii)
+			{
+				for (uint32_t jj = 0; jj < BX_COUNTOF(s_twoSubsetModes); ++jj)
+				{
+					error = bc6hEncodeMode(block, value, s_twoSubsetModes[jj], partition[ii], _signed, quality);
+					if (error < bestError)
+					{
+						best      = block;
+						bestError = error;
+					}
+				}
+			}
+		}
+
+		bc6hWrite(_dst, best);
+	}
+
+	static void encodeRgba8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, TextureFormat::Enum _format, Quality::Enum _quality)
 	{
 		const uint8_t* src = (const uint8_t*)_src;
 		uint8_t* dst = (uint8_t*)_dst;
 
 		const uint32_t srcPitch = _width*4;
-		const uint32_t srcSlice = _height*srcPitch;
-		const uint32_t dstBpp   = getBitsPerPixel(_format);
-		const uint32_t dstPitch = _width*dstBpp/8;
-		const uint32_t dstSlice = _height*dstPitch;
+		const uint32_t dstPitch = _width*getBitsPerPixel(_format)/8;
 
-		for (uint32_t zz = 0; zz < _depth && _err->isOk(); ++zz, src += srcSlice, dst += dstSlice)
+		switch (_format)
 		{
-			switch (_format)
+		case TextureFormat::BC1:
+		case TextureFormat::BC2:
+		case TextureFormat::BC3:
+		case TextureFormat::BC4:
+		case TextureFormat::BC5:
+			squish::CompressImage(src, _width, _height, dst
+				, s_squishQuality[_quality]
+				| (_format == TextureFormat::BC2 ? squish::kDxt3
+				:  _format == TextureFormat::BC3 ? squish::kDxt5
+				:  _format == TextureFormat::BC4 ? squish::kBc4
+				:  _format == TextureFormat::BC5 ? squish::kBc5
+				:                                  squish::kDxt1)
+				);
+			break;
+
+		case TextureFormat::ETC1:
+			etc1_encode_image(src, _width, _height, 4, srcPitch, dst);
+			break;
+
+		case TextureFormat::ETC2:
 			{
-			case TextureFormat::BC1:
-			case TextureFormat::BC2:
-			case TextureFormat::BC3:
-			case TextureFormat::BC4:
-			case TextureFormat::BC5:
-				squish::CompressImage(src, _width, _height, dst
-					, s_squishQuality[_quality]
-					| (_format == TextureFormat::BC2 ? squish::kDxt3
-					:  _format == TextureFormat::BC3 ? squish::kDxt5
-					:  _format == TextureFormat::BC4 ? squish::kBc4
-					:  _format == TextureFormat::BC5 ? squish::kBc5
-					:                                  squish::kDxt1)
-					);
-				break;
+				const uint32_t blockWidth  = (_width +3)/4;
+				const uint32_t blockHeight = (_height+3)/4;
+				uint64_t* dstBlock = (uint64_t*)dst;
+				for (uint32_t yy = 0; yy < blockHeight; ++yy)
+				{
+					for (uint32_t xx = 0; xx < blockWidth; ++xx)
+					{
+						uint8_t block[4*4*4];
+
+						for (uint32_t ii = 0; ii < 16; ++ii)
+						{ // BGRx
+							// Clamp to edge, partial blocks must not read outside of the slice.
+							const uint32_t px = bx::min(xx*4 + ii/4, _width -1);
+							const uint32_t py = bx::min(yy*4 + ii%4, _height-1);
+							bx::memCopy(&block[ii*4], &src[py*srcPitch + px*4], 4);
+							bx::xchg(block[ii*4+0], block[ii*4+2]);
+						}
 
-			case TextureFormat::BC6H:
-			case TextureFormat::BC7:
-				BX_ERROR_SET(_err, BIMG_ERROR, "Unable to convert between input/output formats!");
-				break;
+						*dstBlock++ = ProcessRGB_ETC2(block);
+					}
+				}
+			}
+			break;
 
-			case TextureFormat::ETC1:
-				etc1_encode_image(src, _width, _height, 4, _width*4, dst);
-				break;
+		case TextureFormat::PTC14:
+			{
+				using namespace Javelin;
+				RgbaBitmap bmp;
+				bmp.width  = _width;
+				bmp.height = _height;
+				bmp.data   = const_cast<uint8_t*>(src);
+				PvrTcEncoder::EncodeRgb4Bpp(dst, bmp);
+				bmp.data = NULL;
+			}
+			break;
 
-			case TextureFormat::ETC2:
+		case TextureFormat::PTC14A:
+			{
+				using namespace Javelin;
+				RgbaBitmap bmp;
+				bmp.width  = _width;
+				bmp.height = _height;
+				bmp.data   = const_cast<uint8_t*>(src);
+				PvrTcEncoder::EncodeRgba4Bpp(dst, bmp);
+				bmp.data = NULL;
+			}
+			break;
+
+		case TextureFormat::ASTC4x4:
+		case TextureFormat::ASTC5x5:
+		case TextureFormat::ASTC6x6:
+		case TextureFormat::ASTC8x5:
+		case TextureFormat::ASTC8x6:
+		case TextureFormat::ASTC10x5:
+			{
+				const bimg::ImageBlockInfo& astcBlockInfo = bimg::getBlockInfo(_format);
+
+				ASTC_COMPRESS_MODE  compress_mode = s_astcQuality[_quality];
+				ASTC_DECODE_MODE    decode_mode   = ASTC_DECODE_LDR_LINEAR;
+
+				astc_compress(_width, _height, src, ASTC_RGBA, srcPitch, astcBlockInfo.blockWidth, astcBlockInfo.blockHeight, compress_mode, decode_mode, dst);
+			}
+			break;
+
+		case TextureFormat::BC6H:
+		case TextureFormat::BC7:
+			{
+				const uint32_t blockWidth  = (_width +3)/4;
+				const uint32_t blockHeight = (_height+3)/4;
+				for (uint32_t yy = 0; yy < blockHeight; ++yy)
 				{
-					const uint32_t blockWidth  = (_width +3)/4;
-					const uint32_t blockHeight = (_height+3)/4;
-					uint64_t* dstBlock = (uint64_t*)dst;
-					for (uint32_t yy = 0; yy < blockHeight; ++yy)
+					for (uint32_t xx = 0; xx < blockWidth; ++xx)
 					{
-						for (uint32_t xx = 0; xx < blockWidth; ++xx)
+						uint8_t block[16*4];
+
+						for (uint32_t ii = 0; ii < 16; ++ii)
 						{
-							uint8_t block[4*4*4];
-							const uint8_t* ptr = &src[(yy*srcPitch+xx*4)*4];
+							const uint32_t px = bx::min(xx*4 + ii%4, _width -1);
+							const uint32_t py = bx::min(yy*4 + ii/4, _height-1);
+							bx::memCopy(&block[ii*4], &src[py*srcPitch + px*4], 4);
+						}
 
-							for (uint32_t ii = 0; ii < 16; ++ii)
-							{ // BGRx
-								bx::memCopy(&block[ii*4], &ptr[(ii%4)*srcPitch + (ii&~3)], 4);
-								bx::xchg(block[ii*4+0], block[ii*4+2]);
+						if (TextureFormat::BC7 == _format)
+						{
+							encodeBlockBc7(dst, block, _quality);
+						}
+						else
+						{
+							float rgba[16*4];
+							for (uint32_t ii = 0; ii < 16*4; ++ii)
+							{
+								rgba[ii] = float(block[ii])/255.0f;
 							}
 
-							*dstBlock++ = ProcessRGB_ETC2(block);
+							encodeBlockBc6h(dst, rgba, true, _quality);
 						}
+
+						dst += 16;
 					}
 				}
-				break;
+			}
+			break;
 
-			case TextureFormat::PTC14:
+		case TextureFormat::BGRA8:
+			imageSwizzleBgra8(dst, dstPitch, _width, _height, src, srcPitch);
+			break;
+
+		case TextureFormat::RGBA8:
+			bx::memCopy(dst, src, srcPitch, _height, srcPitch, dstPitch);
+			break;
+
+		default:
+			{
+				const bool ok = imageConvert(_allocator, dst, _format, src, TextureFormat::RGBA8, _width, _height, 1);
+				BX_CHECK(ok, "Format conversion must be validated before encoding.");
+				BX_UNUSED(ok);
+			}
+			break;
+		}
+	}
+
+	static void encodeRgba32f(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, TextureFormat::Enum _format, Quality::Enum _quality)
+	{
+		BX_UNUSED(_allocator);
+		BX_CHECK(TextureFormat::BC6H == _format || TextureFormat::BC7 == _format, "Only BC6H and BC7 are encoded from RGBA32F directly.");
+
+		const float* src = (const float*)_src;
+		uint8_t* dst = (uint8_t*)_dst;
+
+		const uint32_t blockWidth  = (_width +3)/4;
+		const uint32_t blockHeight = (_height+3)/4;
+		for (uint32_t yy = 0; yy < blockHeight; ++yy)
+		{
+			for (uint32_t xx = 0; xx < blockWidth; ++xx)
+			{
+				float rgba[16*4];
+
+				for (uint32_t ii = 0; ii < 16; ++ii)
 				{
-					using namespace Javelin;
-					RgbaBitmap bmp;
-					bmp.width  = _width;
-					bmp.height = _height;
-					bmp.data   = const_cast<uint8_t*>(src);
-					PvrTcEncoder::EncodeRgb4Bpp(dst, bmp);
-					bmp.data = NULL;
+					const uint32_t px = bx::min(xx*4 + ii%4, _width -1);
+					const uint32_t py = bx::min(yy*4 + ii/4, _height-1);
+					bx::memCopy(&rgba[ii*4], &src[(py*_width + px)*4], 16);
 				}
-				break;
 
-			case TextureFormat::PTC14A:
+				if (TextureFormat::BC6H == _format)
 				{
-					using namespace Javelin;
-					RgbaBitmap bmp;
-					bmp.width  = _width;
-					bmp.height = _height;
-					bmp.data   = const_cast<uint8_t*>(src);
-					PvrTcEncoder::EncodeRgba4Bpp(dst, bmp);
-					bmp.data = NULL;
+					encodeBlockBc6h(dst, rgba, true, _quality);
 				}
-				break;
-
-			case TextureFormat::ASTC4x4:
-			case TextureFormat::ASTC5x5:
-			case TextureFormat::ASTC6x6:
-			case TextureFormat::ASTC8x5:
-			case TextureFormat::ASTC8x6:
-			case TextureFormat::ASTC10x5:
+				else
 				{
-                    const bimg::ImageBlockInfo& astcBlockInfo = bimg::getBlockInfo(_format);
-
-                    ASTC_COMPRESS_MODE  compress_mode = s_astcQuality[_quality];
-					ASTC_DECODE_MODE    decode_mode   = ASTC_DECODE_LDR_LINEAR;
+					uint8_t block[16*4];
+					for (uint32_t ii = 0; ii < 16*4; ++ii)
+					{
+						block[ii] = uint8_t(bx::clamp(rgba[ii], 0.0f, 1.0f)*255.0f + 0.5f);
+					}
 
-                    astc_compress(_width, _height, src, ASTC_RGBA, srcPitch, astcBlockInfo.blockWidth, astcBlockInfo.blockHeight, compress_mode, decode_mode, dst);
+					encodeBlockBc7(dst, block, _quality);
 				}
-				break;
 
-			case TextureFormat::BGRA8:
-				imageSwizzleBgra8(dst, dstPitch, _width, _height, src, srcPitch);
-				break;
+				dst += 16;
+			}
+		}
+	}
 
-			case TextureFormat::RGBA8:
-				bx::memCopy(_dst, _src, srcPitch, _height, srcPitch, dstPitch);
-				break;
+	typedef void (*EncodeFn)(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, TextureFormat::Enum _format, Quality::Enum _quality);
 
-			default:
-				if (!imageConvert(_allocator, dst, _format, src, TextureFormat::RGBA8, _width, _height, 1) )
-				{
-					BX_ERROR_SET(_err, BIMG_ERROR, "Unable to convert between input/output formats!");
-				}
-				break;
+	struct EncodeJob
+	{
+		static void execute(void* _userData, uint32_t _idx)
+		{
+			EncodeJob& job = *(EncodeJob*)_userData;
+
+			const uint32_t idx    = job.m_first + _idx;
+			const uint32_t zz     = idx / job.m_numStrips;
+			const uint32_t strip  = idx % job.m_numStrips;
+			const uint32_t yy     = strip*job.m_stripHeight;
+			const uint32_t height = bx::min(job.m_stripHeight, job.m_height - yy);
+
+			job.m_encode(
+				  job.m_allocator
+				, job.m_dst + zz*job.m_dstSlice + yy/job.m_blockHeight*job.m_dstBlockRowPitch
+				, job.m_src + zz*job.m_srcSlice + yy*job.m_width*job.m_srcBytesPerPixel
+				, job.m_width
+				, height
+				, job.m_format
+				, job.m_quality
+				);
+		}
+
+		EncodeFn            m_encode;
+		bx::AllocatorI*     m_allocator;
+		uint8_t*            m_dst;
+		const uint8_t*      m_src;
+		uint32_t            m_width;
+		uint32_t            m_height;
+		uint32_t            m_srcBytesPerPixel;
+		uint32_t            m_srcSlice;
+		uint32_t            m_dstSlice;
+		uint32_t            m_dstBlockRowPitch;
+		uint32_t            m_blockHeight;
+		uint32_t            m_stripHeight;
+		uint32_t            m_numStrips;
+		uint32_t            m_first;
+		TextureFormat::Enum m_format;
+		Quality::Enum       m_quality;
+	};
+
+	static void encodeParallel(EncodeFn _encode, uint32_t _srcBytesPerPixel, bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _format, Quality::Enum _quality, bx::JobSchedulerI* _jobScheduler)
+	{
+		const ImageBlockInfo& blockInfo = getBlockInfo(_format);
+		const bool compressed = isCompressed(_format);
+
+		EncodeJob job;
+		job.m_encode           = _encode;
+		job.m_allocator        = _allocator;
+		job.m_dst              = (uint8_t*)_dst;
+		job.m_src              = (const uint8_t*)_src;
+		job.m_width            = _width;
+		job.m_height           = _height;
+		job.m_srcBytesPerPixel = _srcBytesPerPixel;
+		job.m_srcSlice         = _height*_width*_srcBytesPerPixel;
+		job.m_dstBlockRowPitch = compressed
+			? (_width + blockInfo.blockWidth - 1)/blockInfo.blockWidth*blockInfo.blockSize
+			: _width*blockInfo.bitsPerPixel/8
+			;
+		job.m_blockHeight      = compressed ? blockInfo.blockHeight : 1;
+		job.m_dstSlice         = (_height + job.m_blockHeight - 1)/job.m_blockHeight*job.m_dstBlockRowPitch;
+		job.m_stripHeight      = _height;
+		job.m_numStrips        = 1;
+		job.m_first            = 0;
+		job.m_format           = _format;
+		job.m_quality          = _quality;
+
+		const uint32_t numThreads = NULL != _jobScheduler
+			? _jobScheduler->getNumThreads()
+			: 1
+			;
+
+		// PVRTC blocks interpolate colors from their neighbours, so the whole slice must be
+		// encoded at once. Everything else is split into horizontal strips of block rows.
+		const bool splittable = true
+			&& 1 < numThreads
+			&& TextureFormat::PTC14  != _format
+			&& TextureFormat::PTC14A != _format
+			;
+
+		if (splittable)
+		{
+			const uint32_t numBlockRows   = (_height + job.m_blockHeight - 1)/job.m_blockHeight;
+			const uint32_t numTiles       = numThreads*4;
+			const uint32_t stripBlockRows = bx::max<uint32_t>(1, (numBlockRows*_depth + numTiles - 1)/numTiles);
+			job.m_stripHeight = bx::min(stripBlockRows*job.m_blockHeight, _height);
+			job.m_numStrips   = (_height + job.m_stripHeight - 1)/job.m_stripHeight;
+		}
+
+		const uint32_t num = job.m_numStrips*_depth;
+
+		if (1 < job.m_numStrips
+		&&  TextureFormat::ASTC4x4  <= _format
+		&&  TextureFormat::ASTC10x5 >= _format)
+		{
+			// ASTC encoder lazily builds global lookup tables on first use of a block size,
+			// encode the first strip on the calling thread before fanning out.
+			EncodeJob::execute(&job, 0);
+			job.m_first = 1;
+		}
+
+		if (1 < numThreads)
+		{
+			_jobScheduler->run(EncodeJob::execute, &job, num - job.m_first);
+		}
+		else
+		{
+			for (uint32_t ii = 0, numJobs = num - job.m_first; ii < numJobs; ++ii)
+			{
+				EncodeJob::execute(&job, ii);
+			}
+		}
+	}
+
+	void imageEncodeFromRgba8(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _format, Quality::Enum _quality, bx::Error* _err, bx::JobSchedulerI* _jobScheduler)
+	{
+		BX_ERROR_SCOPE(_err);
+
+		switch (_format)
+		{
+		case TextureFormat::BC1:
+		case TextureFormat::BC2:
+		case TextureFormat::BC3:
+		case TextureFormat::BC4:
+		case TextureFormat::BC5:
+		case TextureFormat::ETC1:
+		case TextureFormat::ETC2:
+		case TextureFormat::PTC14:
+		case TextureFormat::PTC14A:
+		case TextureFormat::ASTC4x4:
+		case TextureFormat::ASTC5x5:
+		case TextureFormat::ASTC6x6:
+		case TextureFormat::ASTC8x5:
+		case TextureFormat::ASTC8x6:
+		case TextureFormat::ASTC10x5:
+		case TextureFormat::BC6H:
+		case TextureFormat::BC7:
+		case TextureFormat::BGRA8:
+		case TextureFormat::RGBA8:
+			break;
+
+		default:
+			if (!imageConvert(_format, TextureFormat::RGBA8) )
+			{
+				BX_ERROR_SET(_err, BIMG_ERROR, "Unable to convert between input/output formats!");
+				return;
 			}
+			break;
 		}
+
+		encodeParallel(encodeRgba8, 4, _allocator, _dst, _src, _width, _height, _depth, _format, _quality, _jobScheduler);
 	}
 
-	void imageEncodeFromRgba32f(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _dstFormat, Quality::Enum _quality, bx::Error* _err)
+	void imageEncodeFromRgba32f(bx::AllocatorI* _allocator, void* _dst, const void* _src, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _dstFormat, Quality::Enum _quality, bx::Error* _err, bx::JobSchedulerI* _jobScheduler)
 	{
 		BX_ERROR_SCOPE(_err);
 
@@ -174,11 +1681,8 @@ namespace bimg
 		switch (_dstFormat)
 		{
 		case TextureFormat::BC6H:
-			nvtt::compressBC6H(src, _width, _height, _width*16, _dst);
-			break;
-
 		case TextureFormat::BC7:
-			nvtt::compressBC7(src, _width, _height, _width*16, _dst);
+			encodeParallel(encodeRgba32f, 16, _allocator, _dst, _src, _width, _height, _depth, _dstFormat, _quality, _jobScheduler);
 			break;
 
 		default:
@@ -208,7 +1712,7 @@ namespace bimg
 						}
 					}
 
-					imageEncodeFromRgba8(_allocator, _dst, temp, _width, _height, _depth, _dstFormat, _quality, _err);
+					imageEncodeFromRgba8(_allocator, _dst, temp, _width, _height, _depth, _dstFormat, _quality, _err, _jobScheduler);
 				}
 				else
 				{
@@ -221,7 +1725,7 @@ namespace bimg
 		}
 	}
 
-	void imageEncode(bx::AllocatorI* _allocator, void* _dst, const void* _src, TextureFormat::Enum _srcFormat, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _dstFormat, Quality::Enum _quality, bx::Error* _err)
+	void imageEncode(bx::AllocatorI* _allocator, void* _dst, const void* _src, TextureFormat::Enum _srcFormat, uint32_t _width, uint32_t _height, uint32_t _depth, TextureFormat::Enum _dstFormat, Quality::Enum _quality, bx::Error* _err, bx::JobSchedulerI* _jobScheduler)
 	{
 		switch (_dstFormat)
 		{
@@ -243,7 +1747,7 @@ namespace bimg
 				{
 					uint8_t* temp = (uint8_t*)BX_ALLOC(_allocator, _width*_height*_depth*4);
 					imageDecodeToRgba8(_allocator, temp, _src, _width, _height, _width*4, _srcFormat);
-					imageEncodeFromRgba8(_allocator, _dst, temp, _width, _height, _depth, _dstFormat, _quality, _err);
+					imageEncodeFromRgba8(_allocator, _dst, temp, _width, _height, _depth, _dstFormat, _quality, _err, _jobScheduler);
 					BX_FREE(_allocator, temp);
 				}
 				break;
@@ -253,7 +1757,7 @@ namespace bimg
 				{
 					uint8_t* temp = (uint8_t*)BX_ALLOC(_allocator, _width*_height*_depth*16);
 					imageDecodeToRgba32f(_allocator, temp, _src, _width, _height, _depth, _width*16, _srcFormat);
-					imageEncodeFromRgba32f(_allocator, _dst, temp, _width, _height, _depth, _dstFormat, _quality, _err);
+					imageEncodeFromRgba32f(_allocator, _dst, temp, _width, _height, _depth, _dstFormat, _quality, _err, _jobScheduler);
 					BX_FREE(_allocator, temp);
 				}
 				break;
@@ -267,7 +1771,7 @@ namespace bimg
 		}
 	}
 
-	ImageContainer* imageEncode(bx::AllocatorI* _allocator, TextureFormat::Enum _dstFormat, Quality::Enum _quality, const ImageContainer& _input)
+	ImageContainer* imageEncode(bx::AllocatorI* _allocator, TextureFormat::Enum _dstFormat, Quality::Enum _quality, const ImageContainer& _input, bx::JobSchedulerI* _jobScheduler)
 	{
 		ImageContainer* output = imageAlloc(_allocator
 			, _dstFormat
@@ -305,6 +1809,7 @@ namespace bimg
 						, _dstFormat
 						, _quality
 						, &err
+						, _jobScheduler
 						);
 				}
 			}
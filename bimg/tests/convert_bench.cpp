@@ -0,0 +1,161 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bimg#license-bsd-2-clause
+ */
+
+#include <bimg/bimg.h>
+#include <bx/allocator.h>
+#include <bx/file.h>
+#include <bx/rng.h>
+#include <bx/timer.h>
+#include <bx/uint32_t.h>
+
+struct ConvertPair
+{
+	bimg::TextureFormat::Enum dstFormat;
+	bimg::TextureFormat::Enum srcFormat;
+};
+
+static const ConvertPair s_convertPairs[] =
+{
+	{ bimg::TextureFormat::BGRA8,   bimg::TextureFormat::RGBA8   },
+	{ bimg::TextureFormat::RGBA8,   bimg::TextureFormat::BGRA8   },
+	{ bimg::TextureFormat::RGBA8,   bimg::TextureFormat::R8      },
+	{ bimg::TextureFormat::BGRA8,   bimg::TextureFormat::R8      },
+	{ bimg::TextureFormat::R8,      bimg::TextureFormat::RGBA8   },
+	{ bimg::TextureFormat::R8,      bimg::TextureFormat::BGRA8   },
+	{ bimg::TextureFormat::RGBA32F, bimg::TextureFormat::RGBA8   },
+	{ bimg::TextureFormat::RGBA32F, bimg::TextureFormat::BGRA8   },
+	{ bimg::TextureFormat::RGBA8,   bimg::TextureFormat::RGBA32F },
+	{ bimg::TextureFormat::BGRA8,   bimg::TextureFormat::RGBA32F },
+	{ bimg::TextureFormat::RGBA16F, bimg::TextureFormat::RGBA8   },
+	{ bimg::TextureFormat::RGBA16F, bimg::TextureFormat::BGRA8   },
+	{ bimg::TextureFormat::RGBA8,   bimg::TextureFormat::RGBA16F },
+	{ bimg::TextureFormat::BGRA8,   bimg::TextureFormat::RGBA16F },
+	{ bimg::TextureFormat::RGBA16F, bimg::TextureFormat::RGBA32F },
+	{ bimg::TextureFormat::RGBA32F, bimg::TextureFormat::RGBA16F },
+	{ bimg::TextureFormat::RGB10A2, bimg::TextureFormat::RGBA8   },
+	{ bimg::TextureFormat::RGB10A2, bimg::TextureFormat::RGBA16F },
+	{ bimg::TextureFormat::RGB10A2, bimg::TextureFormat::RGBA32F },
+	{ bimg::TextureFormat::RGBA8,   bimg::TextureFormat::RGB10A2 },
+	{ bimg::TextureFormat::BGRA8,   bimg::TextureFormat::RGB10A2 },
+	{ bimg::TextureFormat::RGBA16F, bimg::TextureFormat::RGB10A2 },
+	{ bimg::TextureFormat::RGBA32F, bimg::TextureFormat::RGB10A2 },
+	{ bimg::TextureFormat::R5G6B5,  bimg::TextureFormat::RGBA8   },
+	{ bimg::TextureFormat::R5G6B5,  bimg::TextureFormat::BGRA8   },
+	{ bimg::TextureFormat::RGBA8,   bimg::TextureFormat::R5G6B5  },
+	{ bimg::TextureFormat::BGRA8,   bimg::TextureFormat::R5G6B5  },
+	{ bimg::TextureFormat::RGBA32F, bimg::TextureFormat::R5G6B5  },
+	{ bimg::TextureFormat::D32F,    bimg::TextureFormat::D16     },
+	{ bimg::TextureFormat::D32F,    bimg::TextureFormat::D24     },
+	{ bimg::TextureFormat::D32F,    bimg::TextureFormat::D24S8   },
+	{ bimg::TextureFormat::D16,     bimg::TextureFormat::D32F    },
+	{ bimg::TextureFormat::D24,     bimg::TextureFormat::D32F    },
+	{ bimg::TextureFormat::R32F,    bimg::TextureFormat::D16     },
+	{ bimg::TextureFormat::R32F,    bimg::TextureFormat::D24     },
+	{ bimg::TextureFormat::R32F,    bimg::TextureFormat::D24S8   },
+};
+
+// Compares generic per-pixel unpack/pack conversion against imageConvert, which picks specialized
+// path for format pair when available. Float sources are filled with values slightly outside of
+// [0, 1] range to exercise clamping, everything else with random bits.
+static void convertTest(const ConvertPair& _pair, uint32_t _width, uint32_t _height)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::DefaultAllocator allocator;
+
+	const uint32_t srcBpp   = bimg::getBitsPerPixel(_pair.srcFormat);
+	const uint32_t dstBpp   = bimg::getBitsPerPixel(_pair.dstFormat);
+	const uint32_t srcSize  = _width*_height*srcBpp/8;
+	const uint32_t dstSize  = _width*_height*dstBpp/8;
+
+	uint8_t* src     = (uint8_t*)BX_ALLOC(&allocator, srcSize);
+	uint8_t* dstRef  = (uint8_t*)BX_ALLOC(&allocator, dstSize);
+	uint8_t* dstFast = (uint8_t*)BX_ALLOC(&allocator, dstSize);
+
+	bx::RngMwc rng;
+
+	switch (_pair.srcFormat)
+	{
+	case bimg::TextureFormat::RGBA16F:
+		for (uint32_t ii = 0, num = srcSize/2; ii < num; ++ii)
+		{
+			( (uint16_t*)src)[ii] = bx::halfFromFloat(bx::frnd(&rng)*1.5f - 0.25f);
+		}
+		break;
+
+	case bimg::TextureFormat::RGBA32F:
+	case bimg::TextureFormat::D32F:
+		for (uint32_t ii = 0, num = srcSize/4; ii < num; ++ii)
+		{
+			( (float*)src)[ii] = bx::frnd(&rng)*1.5f - 0.25f;
+		}
+		break;
+
+	default:
+		for (uint32_t ii = 0; ii < srcSize; ++ii)
+		{
+			src[ii] = uint8_t(rng.gen() );
+		}
+		break;
+	}
+
+	const uint32_t numIterations = 8;
+
+	int64_t elapsedRef = -bx::getHPCounter();
+	for (uint32_t ii = 0; ii < numIterations; ++ii)
+	{
+		bimg::imageConvert(
+			  dstRef
+			, dstBpp
+			, bimg::getPack(_pair.dstFormat)
+			, src
+			, srcBpp
+			, bimg::getUnpack(_pair.srcFormat)
+			, _width
+			, _height
+			, 1
+			, _width*srcBpp/8
+			);
+	}
+	elapsedRef += bx::getHPCounter();
+
+	int64_t elapsedFast = -bx::getHPCounter();
+	for (uint32_t ii = 0; ii < numIterations; ++ii)
+	{
+		bimg::imageConvert(&allocator, dstFast, _pair.dstFormat, src, _pair.srcFormat, _width, _height, 1);
+	}
+	elapsedFast += bx::getHPCounter();
+
+	const bool same = 0 == bx::memCmp(dstRef, dstFast, dstSize);
+
+	const double freq = double(bx::getHPFrequency() );
+	bx::writePrintf(writer, "%-8s -> %-8s: %10.3fms %10.3fms %6.2fx %s\n"
+		, bimg::getName(_pair.srcFormat)
+		, bimg::getName(_pair.dstFormat)
+		, double(elapsedRef )*1000.0/freq/numIterations
+		, double(elapsedFast)*1000.0/freq/numIterations
+		, double(elapsedRef)/double(bx::max<int64_t>(elapsedFast, 1) )
+		, same ? "" : "MISMATCH!"
+		);
+
+	BX_FREE(&allocator, src);
+	BX_FREE(&allocator, dstRef);
+	BX_FREE(&allocator, dstFast);
+}
+
+int main()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::writePrintf(writer, "imageConvert bench\n\n");
+	bx::writePrintf(writer, "%-20s  %12s %12s\n", "", "generic", "fast");
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(s_convertPairs); ++ii)
+	{
+		convertTest(s_convertPairs[ii], 1023, 1024);
+	}
+
+	bx::writePrintf(writer, "\n");
+
+	return bx::kExitSuccess;
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bimg#license-bsd-2-clause
+ */
+
+#include "test.h"
+#include <bimg/encode.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/math.h>
+#include <bx/rng.h>
+#include <bx/thread.h>
+
+namespace
+{
+	struct Size
+	{
+		uint16_t width;
+		uint16_t height;
+		uint16_t depth;
+	};
+
+	// Sizes that aren't multiple of block size, and volumes, are split into strips with
+	// partial block rows and multiple slices.
+	static const Size s_sizes[] =
+	{
+		{  64, 64, 1 },
+		{  96, 90, 2 },
+		{  37, 23, 3 },
+	};
+
+	static const bimg::TextureFormat::Enum s_formats[] =
+	{
+		bimg::TextureFormat::BC1,
+		bimg::TextureFormat::BC3,
+		bimg::TextureFormat::BC7,
+		bimg::TextureFormat::ETC1,
+		bimg::TextureFormat::ETC2,
+		bimg::TextureFormat::ASTC4x4,
+		bimg::TextureFormat::ASTC6x6,
+		bimg::TextureFormat::RGBA4,
+	};
+
+	const uint32_t kGuardSize = 64;
+	const uint8_t  kGuard     = 0xcd;
+
+	void fillNoise(uint8_t* _data, uint32_t _size, uint32_t _seed)
+	{
+		bx::RngMwc rng(_seed);
+		for (uint32_t ii = 0; ii < _size; ++ii)
+		{
+			_data[ii] = uint8_t(rng.gen() );
+		}
+	}
+
+	bool isGuardIntact(const uint8_t* _data)
+	{
+		for (uint32_t ii = 0; ii < kGuardSize; ++ii)
+		{
+			if (kGuard != _data[ii])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Smooth gradients with a bit of noise, closer to real content than pure noise.
+	void fillGradient(float* _data, uint32_t _width, uint32_t _height, float _scale)
+	{
+		bx::RngMwc rng;
+		for (uint32_t yy = 0; yy < _height; ++yy)
+		{
+			for (uint32_t xx = 0; xx < _width; ++xx)
+			{
+				const float fx = float(xx)/float(_width -1);
+				const float fy = float(yy)/float(_height-1);
+				const float noise = bx::frnd(&rng)*0.05f;
+
+				float* dst = &_data[(yy*_width + xx)*4];
+				dst[0] = bx::clamp(fx + noise,                0.0f, 1.0f)*_scale;
+				dst[1] = bx::clamp(fy + noise,                0.0f, 1.0f)*_scale;
+				dst[2] = bx::clamp(0.5f*(fx + fy),            0.0f, 1.0f)*_scale;
+				dst[3] = bx::clamp(1.0f - 0.5f*fx + noise,    0.0f, 1.0f);
+			}
+		}
+	}
+
+	float psnr(const float* _a, const float* _b, uint32_t _num, uint32_t _numChannels, float _peak)
+	{
+		double sum = 0.0;
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			for (uint32_t ch = 0; ch < _numChannels; ++ch)
+			{
+				const double diff = double(_a[ii*4+ch]) - double(_b[ii*4+ch]);
+				sum += diff*diff;
+			}
+		}
+
+		const double mse = sum / double(_num*_numChannels);
+		return 0.0 == mse
+			? bx::kFloatMax
+			: 10.0f*bx::log(float(double(_peak)*double(_peak)/mse) )/bx::kLogNat10
+			;
+	}
+}
+
+TEST_CASE("Parallel encode is bit identical to serial encode", "")
+{
+	bx::DefaultAllocator allocator;
+
+	bx::JobScheduler jobScheduler;
+	jobScheduler.init(4);
+
+	for (uint32_t ss = 0; ss < BX_COUNTOF(s_sizes); ++ss)
+	{
+		const Size& size = s_sizes[ss];
+
+		const uint32_t srcSize = size.width*size.height*size.depth*4;
+		uint8_t* src = (uint8_t*)BX_ALLOC(&allocator, srcSize);
+		fillNoise(src, srcSize, 1337+ss);
+
+		for (uint32_t ff = 0; ff < BX_COUNTOF(s_formats); ++ff)
+		{
+			const bimg::TextureFormat::Enum format = s_formats[ff];
+
+			INFO(bimg::getName(format) << " " << size.width << "x" << size.height << "x" << size.depth);
+
+			const uint32_t sliceSize = bimg::imageGetSize(NULL, size.width, size.height, 1, false, false, 1, format);
+			const uint32_t dstSize   = sliceSize*size.depth;
+
+			uint8_t* serial   = (uint8_t*)BX_ALLOC(&allocator, dstSize + kGuardSize);
+			uint8_t* parallel = (uint8_t*)BX_ALLOC(&allocator, dstSize + kGuardSize);
+			uint8_t* slices   = (uint8_t*)BX_ALLOC(&allocator, dstSize);
+			bx::memSet(serial,   kGuard, dstSize + kGuardSize);
+			bx::memSet(parallel, kGuard, dstSize + kGuardSize);
+
+			bx::Error err;
+			bimg::imageEncodeFromRgba8(&allocator, serial, src, size.width, size.height, size.depth, format, bimg::Quality::Fastest, &err);
+			REQUIRE(err.isOk() );
+
+			bimg::imageEncodeFromRgba8(&allocator, parallel, src, size.width, size.height, size.depth, format, bimg::Quality::Fastest, &err, &jobScheduler);
+			REQUIRE(err.isOk() );
+
+			// Volume slices are laid out back to back, same as if encoded one by one.
+			for (uint32_t zz = 0; zz < size.depth; ++zz)
+			{
+				bimg::imageEncodeFromRgba8(
+					  &allocator
+					, &slices[zz*sliceSize]
+					, &src[zz*size.width*size.height*4]
+					, size.width
+					, size.height
+					, 1
+					, format
+					, bimg::Quality::Fastest
+					, &err
+					);
+				REQUIRE(err.isOk() );
+			}
+
+			REQUIRE(isGuardIntact(&serial[dstSize]) );
+			REQUIRE(isGuardIntact(&parallel[dstSize]) );
+			REQUIRE(0 == bx::memCmp(serial,   slices, dstSize) );
+			REQUIRE(0 == bx::memCmp(parallel, slices, dstSize) );
+
+			BX_FREE(&allocator, slices);
+			BX_FREE(&allocator, parallel);
+			BX_FREE(&allocator, serial);
+		}
+
+		BX_FREE(&allocator, src);
+	}
+
+	jobScheduler.shutdown();
+}
+
+TEST_CASE("BC7 encode quality", "")
+{
+	bx::DefaultAllocator allocator;
+
+	const uint32_t width  = 64;
+	const uint32_t height = 64;
+	const uint32_t num    = width*height;
+
+	float* ref = (float*)BX_ALLOC(&allocator, num*16);
+	fillGradient(ref, width, height, 1.0f);
+
+	uint8_t* src = (uint8_t*)BX_ALLOC(&allocator, num*4);
+	for (uint32_t ii = 0; ii < num*4; ++ii)
+	{
+		src[ii] = uint8_t(ref[ii]*255.0f + 0.5f);
+		ref[ii] = float(src[ii]);
+	}
+
+	const uint32_t dstSize = bimg::imageGetSize(NULL, width, height, 1, false, false, 1, bimg::TextureFormat::BC7);
+	uint8_t* dst  = (uint8_t*)BX_ALLOC(&allocator, dstSize);
+	uint8_t* rgba = (uint8_t*)BX_ALLOC(&allocator, num*4);
+	float* decoded = (float*)BX_ALLOC(&allocator, num*16);
+
+	static const bimg::Quality::Enum s_quality[] =
+	{
+		bimg::Quality::Fastest,
+		bimg::Quality::Default,
+		bimg::Quality::Highest,
+	};
+
+	for (uint32_t qq = 0; qq < BX_COUNTOF(s_quality); ++qq)
+	{
+		bx::Error err;
+		bimg::imageEncodeFromRgba8(&allocator, dst, src, width, height, 1, bimg::TextureFormat::BC7, s_quality[qq], &err);
+		REQUIRE(err.isOk() );
+
+		bimg::imageDecodeToRgba8(&allocator, rgba, dst, width, height, width*4, bimg::TextureFormat::BC7);
+		for (uint32_t ii = 0; ii < num*4; ++ii)
+		{
+			decoded[ii] = float(rgba[ii]);
+		}
+
+		INFO("quality " << qq);
+		REQUIRE(36.0f < psnr(ref, decoded, num, 4, 255.0f) );
+	}
+
+	BX_FREE(&allocator, decoded);
+	BX_FREE(&allocator, rgba);
+	BX_FREE(&allocator, dst);
+	BX_FREE(&allocator, src);
+	BX_FREE(&allocator, ref);
+}
+
+TEST_CASE("BC6H encode quality", "")
+{
+	bx::DefaultAllocator allocator;
+
+	const uint32_t width  = 64;
+	const uint32_t height = 64;
+	const uint32_t num    = width*height;
+
+	const float peak = 4.0f;
+
+	float* src = (float*)BX_ALLOC(&allocator, num*16);
+	fillGradient(src, width, height, peak);
+
+	const uint32_t dstSize = bimg::imageGetSize(NULL, width, height, 1, false, false, 1, bimg::TextureFormat::BC6H);
+	uint8_t* dst = (uint8_t*)BX_ALLOC(&allocator, dstSize);
+	float* decoded = (float*)BX_ALLOC(&allocator, num*16);
+
+	bx::Error err;
+	bimg::imageEncodeFromRgba32f(&allocator, dst, src, width, height, 1, bimg::TextureFormat::BC6H, bimg::Quality::Default, &err);
+	REQUIRE(err.isOk() );
+
+	bimg::imageDecodeToRgba32f(&allocator, decoded, dst, width, height, 1, width*16, bimg::TextureFormat::BC6H);
+
+	// BC6H has no alpha, compare RGB only.
+	REQUIRE(36.0f < psnr(src, decoded, num, 3, peak) );
+
+	BX_FREE(&allocator, decoded);
+	BX_FREE(&allocator, dst);
+	BX_FREE(&allocator, src);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bimg#license-bsd-2-clause
+ */
+
+#include "test.h"
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/file.h>
+
+namespace
+{
+	uint32_t writeKtx(bx::MemoryBlock* _mb, uint32_t _width, uint32_t _height)
+	{
+		bx::DefaultAllocator allocator;
+
+		const uint32_t size = bimg::imageGetSize(NULL, uint16_t(_width), uint16_t(_height), 1, false, true, 1, bimg::TextureFormat::RGBA8);
+		uint8_t* src = (uint8_t*)BX_ALLOC(&allocator, size);
+		for (uint32_t ii = 0; ii < size; ++ii)
+		{
+			src[ii] = uint8_t(ii);
+		}
+
+		const uint8_t numMips = bimg::imageGetNumMips(bimg::TextureFormat::RGBA8, uint16_t(_width), uint16_t(_height) );
+
+		bx::MemoryWriter writer(_mb);
+		bimg::imageWriteKtx(&writer, bimg::TextureFormat::RGBA8, false, _width, _height, 1, numMips, 1, src);
+
+		BX_FREE(&allocator, src);
+
+		return uint32_t(bx::seek(&writer) );
+	}
+
+	bool writeFile(const bx::FilePath& _filePath, const void* _data, uint32_t _size)
+	{
+		bx::FileWriter writer;
+		if (!bx::open(&writer, _filePath) )
+		{
+			return false;
+		}
+
+		bx::write(&writer, _data, _size);
+		bx::close(&writer);
+		return true;
+	}
+}
+
+TEST_CASE("imageGetRawData rejects truncated KTX", "")
+{
+	bx::DefaultAllocator allocator;
+
+	bx::MemoryBlock mb(&allocator);
+	const uint32_t size = writeKtx(&mb, 64, 64);
+	const uint8_t* data = (const uint8_t*)mb.more();
+
+	bimg::ImageContainer imageContainer;
+	REQUIRE(bimg::imageParse(imageContainer, data, size) );
+	REQUIRE(7 == imageContainer.m_numMips);
+
+	bimg::ImageMip mip;
+	for (uint8_t lod = 0; lod < imageContainer.m_numMips; ++lod)
+	{
+		REQUIRE(bimg::imageGetRawData(imageContainer, 0, lod, data, size, mip) );
+		REQUIRE(mip.m_data + mip.m_size <= data + size);
+	}
+
+	// Truncated inside of mip data, and inside of next lod image size field.
+	const uint32_t lod1 = imageContainer.m_offset + sizeof(uint32_t) + 64*64*4;
+	const uint32_t truncated[] = { 12288, lod1 + 2, size - 1 };
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(truncated); ++ii)
+	{
+		INFO("truncated to " << truncated[ii]);
+
+		bimg::ImageContainer tc;
+		REQUIRE(bimg::imageParse(tc, data, truncated[ii]) );
+		REQUIRE(!bimg::imageGetRawData(tc, 0, tc.m_numMips-1, data, truncated[ii], mip) );
+	}
+}
+
+TEST_CASE("imageMapFile rejects truncated KTX", "")
+{
+	bx::DefaultAllocator allocator;
+
+	bx::MemoryBlock mb(&allocator);
+	const uint32_t size = writeKtx(&mb, 64, 64);
+	const uint8_t* data = (const uint8_t*)mb.more();
+
+	bx::FilePath filePath;
+	filePath.set(bx::Dir::Temp);
+	filePath.join("bimg-truncated.ktx");
+
+	REQUIRE(writeFile(filePath, data, size) );
+
+	bx::Error err;
+	bimg::ImageContainer* imageContainer = bimg::imageMapFile(&allocator, filePath, &err);
+	REQUIRE(err.isOk() );
+	REQUIRE(NULL != imageContainer);
+	bimg::imageFree(imageContainer);
+
+	REQUIRE(writeFile(filePath, data, 12288) );
+
+	imageContainer = bimg::imageMapFile(&allocator, filePath, &err);
+	REQUIRE(!err.isOk() );
+	REQUIRE(NULL == imageContainer);
+
+	bx::remove(filePath);
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright 2011-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bimg#license-bsd-2-clause
+ */
+
+#ifndef BIMG_TEST_H_HEADER_GUARD
+#define BIMG_TEST_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+BX_PRAGMA_DIAGNOSTIC_PUSH();
+BX_PRAGMA_DIAGNOSTIC_IGNORED_MSVC(4312); // warning C4312 : 'reinterpret_cast' : conversion from 'int' to 'const char *' of greater size
+#include <catch/catch.hpp>
+BX_PRAGMA_DIAGNOSTIC_POP();
+
+#include <bimg/bimg.h>
+
+#endif // BIMG_TEST_H_HEADER_GUARD
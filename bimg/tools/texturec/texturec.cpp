@@ -25,7 +25,7 @@
 #include <string>
 
 #define BIMG_TEXTUREC_VERSION_MAJOR 1
-#define BIMG_TEXTUREC_VERSION_MINOR 18
+#define BIMG_TEXTUREC_VERSION_MINOR 19
 
 BX_ERROR_RESULT(TEXTRUREC_ERROR, BX_MAKEFOURCC('t', 'c', 0, 0) );
 
@@ -36,6 +36,7 @@ struct Options
 		DBG("Options:\n"
 			"\t  maxSize: %d\n"
 			"\t  mipSkip: %d\n"
+			"\t     jobs: %d\n"
 			"\t     edge: %f\n"
 			"\t   format: %s\n"
 			"\t     mips: %s\n"
@@ -49,6 +50,7 @@ struct Options
 			"\t   linear: %s\n"
 			, maxSize
 			, mipSkip
+			, jobs
 			, edge
 			, bimg::getName(format)
 			, mips      ? "true" : "false"
@@ -65,6 +67,7 @@ struct Options
 
 	uint32_t maxSize = UINT32_MAX;
 	uint32_t mipSkip = 0;
+	uint32_t jobs    = 1;
 	float edge       = 0.0f;
 	bimg::TextureFormat::Enum format   = bimg::TextureFormat::Count;
 	bimg::Quality::Enum quality        = bimg::Quality::Default;
@@ -129,7 +132,7 @@ void imagePremultiplyAlpha(void* _inOut, uint32_t _width, uint32_t _height, uint
 	}
 }
 
-bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData, uint32_t _inputSize, const Options& _options, bx::Error* _err)
+bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData, uint32_t _inputSize, const Options& _options, bx::JobSchedulerI* _jobScheduler, bx::Error* _err)
 {
 	BX_ERROR_SCOPE(_err);
 
@@ -311,7 +314,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 			if (inputFormat != outputFormat
 			&&  bimg::isCompressed(outputFormat) )
 			{
-				output = bimg::imageEncode(_allocator, outputFormat, _options.quality, *input);
+				output = bimg::imageEncode(_allocator, outputFormat, _options.quality, *input, _jobScheduler);
 			}
 			else
 			{
@@ -352,7 +355,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 
 		if (bimg::LightingModel::Count != _options.radiance)
 		{
-			output = bimg::imageCubemapRadianceFilter(_allocator, *input, _options.radiance, _err);
+			output = bimg::imageCubemapRadianceFilter(_allocator, *input, _options.radiance, _err, _jobScheduler);
 
 			if (!_err->isOk() )
 			{
@@ -361,7 +364,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 
 			if (bimg::TextureFormat::RGBA32F != outputFormat)
 			{
-				bimg::ImageContainer* temp = bimg::imageEncode(_allocator, outputFormat, _options.quality, *output);
+				bimg::ImageContainer* temp = bimg::imageEncode(_allocator, outputFormat, _options.quality, *output, _jobScheduler);
 				bimg::imageFree(output);
 
 				output = temp;
@@ -463,6 +466,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 						, outputFormat
 						, _options.quality
 						, _err
+						, _jobScheduler
 						);
 
 					for (uint8_t lod = 1; lod < numMips && _err->isOk(); ++lod)
@@ -495,6 +499,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 							, outputFormat
 							, _options.quality
 							, _err
+							, _jobScheduler
 							);
 					}
 
@@ -550,6 +555,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 						, outputFormat
 						, _options.quality
 						, _err
+						, _jobScheduler
 						);
 
 					if (1 < numMips
@@ -604,6 +610,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 								, outputFormat
 								, _options.quality
 								, _err
+								, _jobScheduler
 								);
 						}
 					}
@@ -716,6 +723,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 						, outputFormat
 						, _options.quality
 						, _err
+						, _jobScheduler
 						);
 
 					for (uint8_t lod = 1; lod < numMips && _err->isOk(); ++lod)
@@ -765,6 +773,7 @@ bimg::ImageContainer* convert(bx::AllocatorI* _allocator, const void* _inputData
 							, outputFormat
 							, _options.quality
 							, _err
+							, _jobScheduler
 							);
 					}
 
@@ -868,6 +877,7 @@ void help(const char* _error = NULL, bool _showHelp = true)
 		  "      --linear             Input and output texture is linear color space (gamma correction won't be applied).\n"
 		  "      --max <max size>     Maximum width/height (image will be scaled down and\n"
 		  "                           aspect ratio will be preserved.\n"
+		  "      --jobs <N>           Number of threads used for texture compression.\n"
 		  "      --radiance <model>   Radiance cubemap filter. (Lighting model: Phong, PhongBrdf, Blinn, BlinnBrdf, GGX)\n"
 		  "      --as <extension>     Save as.\n"
           "      --formats            List all supported formats.\n"
@@ -1030,6 +1040,17 @@ int main(int _argc, const char* _argv[])
 		}
 	}
 
+	const char* jobs = cmdLine.findOption("jobs");
+	if (NULL != jobs)
+	{
+		if (!bx::fromString(&options.jobs, jobs)
+		||  0 == options.jobs)
+		{
+			help("Parsing `--jobs` failed.");
+			return bx::kExitFailure;
+		}
+	}
+
 	options.format = bimg::TextureFormat::Count;
 	const char* type = cmdLine.findOption('t');
 	if (NULL != type)
@@ -1128,7 +1149,12 @@ int main(int _argc, const char* _argv[])
 		return bx::kExitFailure;
 	}
 
-	bimg::ImageContainer* output = convert(&allocator, inputData, inputSize, options, &err);
+	bx::JobScheduler jobScheduler;
+	jobScheduler.init(options.jobs);
+
+	bimg::ImageContainer* output = convert(&allocator, inputData, inputSize, options, &jobScheduler, &err);
+
+	jobScheduler.shutdown();
 
 	BX_FREE(&allocator, inputData);
 
@@ -18,4 +18,8 @@
 			)
 #endif // BX_CONFIG_SUPPORTS_THREADING
 
+#ifndef BX_CONFIG_JOB_SCHEDULER_MAX_THREADS
+#	define BX_CONFIG_JOB_SCHEDULER_MAX_THREADS 16
+#endif // BX_CONFIG_JOB_SCHEDULER_MAX_THREADS
+
 #endif // BX_CONFIG_H_HEADER_GUARD
@@ -93,6 +93,15 @@ namespace bx
 	///
 	bool stat(const FilePath& _filePath, FileInfo& _outFileInfo);
 
+	/// Maps whole file into memory as read-only. Returns pointer to file content and its size in
+	/// `_outSize`, or NULL if file can't be mapped. Pages are loaded on first access.
+	///
+	const void* mapFile(const FilePath& _filePath, uint64_t& _outSize, Error* _err = NULL);
+
+	/// Releases mapping returned by `mapFile`.
+	///
+	void unmapFile(const void* _data, uint64_t _size);
+
 } // namespace bx
 
 #endif // BX_FILE_H_HEADER_GUARD
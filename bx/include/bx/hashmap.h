@@ -0,0 +1,111 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#ifndef BX_HASHMAP_H_HEADER_GUARD
+#define BX_HASHMAP_H_HEADER_GUARD
+
+#include "bx.h"
+#include "allocator.h"
+#include "uint32_t.h"
+
+namespace bx
+{
+	/// Open addressing hash map with linear probing. Keys and values are stored inline in
+	/// single power of two sized table, map grows when it's more than 3/4 full. Removal shifts
+	/// following entries back, so there are no tombstones and lookup cost doesn't degrade.
+	///
+	/// @remarks Key must be integer type, key and value must be POD types. Pointers to values
+	///   are valid until next insert or remove.
+	///
+	template <typename KeyT, typename ValueT>
+	class HashMapT
+	{
+		BX_CLASS(HashMapT
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		///
+		HashMapT(AllocatorI* _allocator);
+
+		///
+		~HashMapT();
+
+		/// Inserts key, or replaces value of existing key. Returns true if key was inserted.
+		bool insert(KeyT _key, const ValueT& _value);
+
+		/// Returns true if key was removed.
+		bool remove(KeyT _key);
+
+		/// Returns NULL if key is not found.
+		ValueT* find(KeyT _key);
+
+		///
+		const ValueT* find(KeyT _key) const;
+
+		/// Grows table so that `_num` elements can be inserted without growing.
+		void reserve(uint32_t _num);
+
+		/// Removes all elements, table memory is kept.
+		void reset();
+
+		///
+		uint32_t getNumElements() const;
+
+		///
+		uint32_t getCapacity() const;
+
+		///
+		struct Iterator
+		{
+			KeyT    key;
+			ValueT* value;
+
+		private:
+			friend class HashMapT<KeyT, ValueT>;
+			uint32_t pos;
+		};
+
+		/// Iterates over elements:
+		///
+		///     for (Iterator it = map.first(); map.next(it); ) { ... }
+		///
+		Iterator first() const;
+
+		///
+		bool next(Iterator& _it) const;
+
+	private:
+		struct Entry
+		{
+			KeyT   m_key;
+			ValueT m_value;
+		};
+
+		///
+		uint32_t findIndex(KeyT _key) const;
+
+		///
+		ValueT* getValue(uint32_t _idx) const;
+
+		///
+		uint32_t getHomeIndex(KeyT _key) const;
+
+		///
+		void grow(uint32_t _capacity);
+
+		AllocatorI* m_allocator;
+		Entry*   m_entry;
+		uint8_t* m_used;
+		uint32_t m_mask;
+		uint32_t m_numElements;
+	};
+
+} // namespace bx
+
+#include "inline/hashmap.inl"
+
+#endif // BX_HASHMAP_H_HEADER_GUARD
@@ -0,0 +1,245 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#ifndef BX_HASHMAP_H_HEADER_GUARD
+#	error "Must be included from bx/hashmap.h!"
+#endif // BX_HASHMAP_H_HEADER_GUARD
+
+namespace bx
+{
+	template <typename KeyT, typename ValueT>
+	inline HashMapT<KeyT, ValueT>::HashMapT(AllocatorI* _allocator)
+		: m_allocator(_allocator)
+		, m_entry(NULL)
+		, m_used(NULL)
+		, m_mask(0)
+		, m_numElements(0)
+	{
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline HashMapT<KeyT, ValueT>::~HashMapT()
+	{
+		if (NULL != m_entry)
+		{
+			BX_ALIGNED_FREE(m_allocator, m_entry, BX_ALIGNOF(Entry) );
+		}
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline bool HashMapT<KeyT, ValueT>::insert(KeyT _key, const ValueT& _value)
+	{
+		if (NULL == m_entry)
+		{
+			grow(16);
+		}
+
+		uint32_t idx = getHomeIndex(_key);
+		for (; 0 != m_used[idx]; idx = (idx + 1) & m_mask)
+		{
+			if (m_entry[idx].m_key == _key)
+			{
+				m_entry[idx].m_value = _value;
+				return false;
+			}
+		}
+
+		if ( (m_numElements + 1) * 4 > (m_mask + 1) * 3)
+		{
+			grow( (m_mask + 1) * 2);
+
+			for (idx = getHomeIndex(_key); 0 != m_used[idx]; idx = (idx + 1) & m_mask)
+			{
+			}
+		}
+
+		m_entry[idx].m_key   = _key;
+		m_entry[idx].m_value = _value;
+		m_used[idx] = 1;
+		++m_numElements;
+
+		return true;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline bool HashMapT<KeyT, ValueT>::remove(KeyT _key)
+	{
+		uint32_t idx = findIndex(_key);
+		if (UINT32_MAX == idx)
+		{
+			return false;
+		}
+
+		// Backward shift deletion. Entry that follows in the same cluster is moved into the hole,
+		// unless its home slot is cyclically in (hole, entry].
+		for (uint32_t next = (idx + 1) & m_mask; 0 != m_used[next]; next = (next + 1) & m_mask)
+		{
+			const uint32_t home = getHomeIndex(m_entry[next].m_key);
+			const bool inPlace = idx <= next
+				? idx < home && home <= next
+				: idx < home || home <= next
+				;
+
+			if (!inPlace)
+			{
+				m_entry[idx] = m_entry[next];
+				idx = next;
+			}
+		}
+
+		m_used[idx] = 0;
+		--m_numElements;
+
+		return true;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline ValueT* HashMapT<KeyT, ValueT>::find(KeyT _key)
+	{
+		const uint32_t idx = findIndex(_key);
+		return UINT32_MAX == idx ? NULL : getValue(idx);
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline const ValueT* HashMapT<KeyT, ValueT>::find(KeyT _key) const
+	{
+		const uint32_t idx = findIndex(_key);
+		return UINT32_MAX == idx ? NULL : getValue(idx);
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline void HashMapT<KeyT, ValueT>::reserve(uint32_t _num)
+	{
+		uint32_t capacity = 16;
+		while (_num * 4 > capacity * 3)
+		{
+			capacity *= 2;
+		}
+
+		if (capacity > getCapacity() )
+		{
+			grow(capacity);
+		}
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline void HashMapT<KeyT, ValueT>::reset()
+	{
+		if (NULL != m_used)
+		{
+			memSet(m_used, 0, m_mask + 1);
+		}
+
+		m_numElements = 0;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline uint32_t HashMapT<KeyT, ValueT>::getNumElements() const
+	{
+		return m_numElements;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline uint32_t HashMapT<KeyT, ValueT>::getCapacity() const
+	{
+		return NULL == m_entry ? 0 : m_mask + 1;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline typename HashMapT<KeyT, ValueT>::Iterator HashMapT<KeyT, ValueT>::first() const
+	{
+		Iterator it;
+		it.value = NULL;
+		it.pos   = 0;
+		return it;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline bool HashMapT<KeyT, ValueT>::next(Iterator& _it) const
+	{
+		for (uint32_t num = getCapacity(); _it.pos < num; ++_it.pos)
+		{
+			if (0 != m_used[_it.pos])
+			{
+				_it.key   = m_entry[_it.pos].m_key;
+				_it.value = getValue(_it.pos);
+				++_it.pos;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline uint32_t HashMapT<KeyT, ValueT>::findIndex(KeyT _key) const
+	{
+		if (0 == m_numElements)
+		{
+			return UINT32_MAX;
+		}
+
+		for (uint32_t idx = getHomeIndex(_key); 0 != m_used[idx]; idx = (idx + 1) & m_mask)
+		{
+			if (m_entry[idx].m_key == _key)
+			{
+				return idx;
+			}
+		}
+
+		return UINT32_MAX;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline ValueT* HashMapT<KeyT, ValueT>::getValue(uint32_t _idx) const
+	{
+		// Value type might overload operator&.
+		return reinterpret_cast<ValueT*>(&reinterpret_cast<uint8_t&>(m_entry[_idx].m_value) );
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline uint32_t HashMapT<KeyT, ValueT>::getHomeIndex(KeyT _key) const
+	{
+		const uint64_t tmp0 = uint64_mul(uint64_t(_key), UINT64_C(14029467366897019727) );
+		const uint64_t tmp1 = uint64_rol(tmp0, 31);
+		const uint64_t hash = uint64_mul(tmp1, UINT64_C(11400714785074694791) );
+		return uint32_t(hash >> 32) & m_mask;
+	}
+
+	template <typename KeyT, typename ValueT>
+	inline void HashMapT<KeyT, ValueT>::grow(uint32_t _capacity)
+	{
+		BX_CHECK(isPowerOf2(_capacity), "Capacity must be power of 2.");
+
+		Entry*   entry = m_entry;
+		uint8_t* used  = m_used;
+		const uint32_t num = getCapacity();
+
+		m_entry = (Entry*)BX_ALIGNED_ALLOC(m_allocator, _capacity * (sizeof(Entry) + 1), BX_ALIGNOF(Entry) );
+		m_used  = (uint8_t*)&m_entry[_capacity];
+		m_mask  = _capacity - 1;
+		memSet(m_used, 0, _capacity);
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			if (0 != used[ii])
+			{
+				uint32_t idx = getHomeIndex(entry[ii].m_key);
+				for (; 0 != m_used[idx]; idx = (idx + 1) & m_mask)
+				{
+				}
+
+				m_entry[idx] = entry[ii];
+				m_used[idx]  = 1;
+			}
+		}
+
+		if (NULL != entry)
+		{
+			BX_ALIGNED_FREE(m_allocator, entry, BX_ALIGNOF(Entry) );
+		}
+	}
+
+} // namespace bx
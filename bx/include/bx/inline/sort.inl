@@ -281,6 +281,191 @@ done:
 		}
 	}
 
+#define BX_RADIXSORT_MAX_JOBS 8
+#define BX_RADIXSORT_MIN_KEYS_PER_JOB 4096
+
+	template <typename KeyT, typename Ty>
+	struct RadixSortJobs
+	{
+		uint32_t begin(uint32_t _job) const
+		{
+			return uint32_t(uint64_t(m_size)*_job/m_numJobs);
+		}
+
+		static void histogram(void* _userData, uint32_t _job)
+		{
+			RadixSortJobs* rs = (RadixSortJobs*)_userData;
+			const uint32_t begin = rs->begin(_job);
+			const uint32_t end   = rs->begin(_job+1);
+			const uint32_t shift = rs->m_shift;
+			const KeyT* keys = rs->m_keys;
+
+			uint32_t* histogram = rs->m_histogram[_job];
+			memSet(histogram, 0, sizeof(uint32_t)*BX_RADIXSORT_HISTOGRAM_SIZE);
+
+			bool sorted = true;
+			{
+				KeyT key = keys[begin];
+				KeyT prevKey = key;
+				for (uint32_t ii = begin; ii < end; ++ii, prevKey = key)
+				{
+					key = keys[ii];
+					uint16_t index = (key>>shift)&BX_RADIXSORT_BIT_MASK;
+					++histogram[index];
+					sorted &= prevKey <= key;
+				}
+			}
+
+			rs->m_sorted[_job] = sorted;
+		}
+
+		static void scatter(void* _userData, uint32_t _job)
+		{
+			RadixSortJobs* rs = (RadixSortJobs*)_userData;
+			const uint32_t begin = rs->begin(_job);
+			const uint32_t end   = rs->begin(_job+1);
+			const uint32_t shift = rs->m_shift;
+			const KeyT* keys   = rs->m_keys;
+			KeyT* tempKeys     = rs->m_tempKeys;
+			const Ty* values   = rs->m_values;
+			Ty* tempValues     = rs->m_tempValues;
+
+			uint32_t* histogram = rs->m_histogram[_job];
+
+			for (uint32_t ii = begin; ii < end; ++ii)
+			{
+				KeyT key = keys[ii];
+				uint16_t index = (key>>shift)&BX_RADIXSORT_BIT_MASK;
+				uint32_t dest = histogram[index]++;
+				tempKeys[dest] = key;
+				tempValues[dest] = values[ii];
+			}
+		}
+
+		void sort(uint32_t _numPasses, JobSchedulerI* _scheduler)
+		{
+			KeyT* keys = m_keys;
+			Ty* values = m_values;
+
+			m_shift = 0;
+			for (uint32_t pass = 0; pass < _numPasses; ++pass, m_shift += BX_RADIXSORT_BITS)
+			{
+				_scheduler->run(histogram, this, m_numJobs);
+
+				bool sorted = m_sorted[0];
+				for (uint32_t jj = 1; jj < m_numJobs; ++jj)
+				{
+					const uint32_t first = begin(jj);
+					sorted &= m_sorted[jj] && m_keys[first-1] <= m_keys[first];
+				}
+
+				if (sorted)
+				{
+					break;
+				}
+
+				// Per job prefix sum, keys from job N are placed after keys from
+				// job N-1 within the same bucket, so that sort remains stable.
+				bool skip = false;
+				uint32_t offset = 0;
+				for (uint32_t ii = 0; ii < BX_RADIXSORT_HISTOGRAM_SIZE; ++ii)
+				{
+					const uint32_t bucketBegin = offset;
+					for (uint32_t jj = 0; jj < m_numJobs; ++jj)
+					{
+						uint32_t count = m_histogram[jj][ii];
+						m_histogram[jj][ii] = offset;
+						offset += count;
+					}
+
+					skip |= offset-bucketBegin == m_size;
+				}
+
+				if (skip)
+				{
+					// All keys are in the same bucket, scatter wouldn't move anything.
+					continue;
+				}
+
+				_scheduler->run(scatter, this, m_numJobs);
+
+				KeyT* swapKeys = m_tempKeys;
+				m_tempKeys = m_keys;
+				m_keys = swapKeys;
+
+				Ty* swapValues = m_tempValues;
+				m_tempValues = m_values;
+				m_values = swapValues;
+			}
+
+			if (keys != m_keys)
+			{
+				memCopy(keys, m_keys, m_size*sizeof(KeyT) );
+				for (uint32_t ii = 0; ii < m_size; ++ii)
+				{
+					values[ii] = m_values[ii];
+				}
+			}
+		}
+
+		KeyT* m_keys;
+		KeyT* m_tempKeys;
+		Ty* m_values;
+		Ty* m_tempValues;
+		uint32_t m_size;
+		uint32_t m_numJobs;
+		uint32_t m_shift;
+		bool m_sorted[BX_RADIXSORT_MAX_JOBS];
+		uint32_t m_histogram[BX_RADIXSORT_MAX_JOBS][BX_RADIXSORT_HISTOGRAM_SIZE];
+	};
+
+	inline uint32_t radixSortNumJobs(uint32_t _size, JobSchedulerI* _scheduler)
+	{
+		const uint32_t numThreads = NULL == _scheduler ? 1 : _scheduler->getNumThreads();
+		return min<uint32_t>(numThreads, BX_RADIXSORT_MAX_JOBS, _size/BX_RADIXSORT_MIN_KEYS_PER_JOB);
+	}
+
+	template <typename KeyT, typename Ty>
+	inline void radixSortParallel(KeyT* _keys, KeyT* _tempKeys, Ty* _values, Ty* _tempValues, uint32_t _size, uint32_t _numJobs, uint32_t _numPasses, JobSchedulerI* _scheduler)
+	{
+		RadixSortJobs<KeyT, Ty> rs;
+		rs.m_keys       = _keys;
+		rs.m_tempKeys   = _tempKeys;
+		rs.m_values     = _values;
+		rs.m_tempValues = _tempValues;
+		rs.m_size       = _size;
+		rs.m_numJobs    = _numJobs;
+		rs.sort(_numPasses, _scheduler);
+	}
+
+	template <typename Ty>
+	inline void radixSort(uint32_t* _keys, uint32_t* _tempKeys, Ty* _values, Ty* _tempValues, uint32_t _size, JobSchedulerI* _scheduler)
+	{
+		const uint32_t numJobs = radixSortNumJobs(_size, _scheduler);
+		if (1 >= numJobs)
+		{
+			radixSort(_keys, _tempKeys, _values, _tempValues, _size);
+			return;
+		}
+
+		radixSortParallel<uint32_t, Ty>(_keys, _tempKeys, _values, _tempValues, _size, numJobs, 3, _scheduler);
+	}
+
+	template <typename Ty>
+	inline void radixSort(uint64_t* _keys, uint64_t* _tempKeys, Ty* _values, Ty* _tempValues, uint32_t _size, JobSchedulerI* _scheduler)
+	{
+		const uint32_t numJobs = radixSortNumJobs(_size, _scheduler);
+		if (1 >= numJobs)
+		{
+			radixSort(_keys, _tempKeys, _values, _tempValues, _size);
+			return;
+		}
+
+		radixSortParallel<uint64_t, Ty>(_keys, _tempKeys, _values, _tempValues, _size, numJobs, 6, _scheduler);
+	}
+
+#undef BX_RADIXSORT_MAX_JOBS
+#undef BX_RADIXSORT_MIN_KEYS_PER_JOB
 #undef BX_RADIXSORT_BITS
 #undef BX_RADIXSORT_HISTOGRAM_SIZE
 #undef BX_RADIXSORT_BIT_MASK
@@ -0,0 +1,16 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#ifndef BX_THREAD_H_HEADER_GUARD
+#	error "Must be included from bx/thread.h!"
+#endif // BX_THREAD_H_HEADER_GUARD
+
+namespace bx
+{
+	inline JobSchedulerI::~JobSchedulerI()
+	{
+	}
+
+} // namespace bx
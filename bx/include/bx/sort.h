@@ -7,6 +7,7 @@
 #define BX_SORT_H_HEADER_GUARD
 
 #include "bx.h"
+#include "thread.h"
 
 namespace bx
 {
@@ -55,6 +56,30 @@ namespace bx
 		, uint32_t _size
 		);
 
+	/// Parallel radix sort. Histogram and scatter of each pass are split
+	/// into jobs executed by `_scheduler`.
+	template <typename Ty>
+	void radixSort(
+		  uint32_t* _keys
+		, uint32_t* _tempKeys
+		, Ty* _values
+		, Ty* _tempValues
+		, uint32_t _size
+		, JobSchedulerI* _scheduler
+		);
+
+	/// Parallel radix sort. Histogram and scatter of each pass are split
+	/// into jobs executed by `_scheduler`.
+	template <typename Ty>
+	void radixSort(
+		  uint64_t* _keys
+		, uint64_t* _tempKeys
+		, Ty* _values
+		, Ty* _tempValues
+		, uint32_t _size
+		, JobSchedulerI* _scheduler
+		);
+
 } // namespace bx
 
 #include "inline/sort.inl"
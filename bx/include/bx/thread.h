@@ -85,6 +85,69 @@ namespace bx
 		BX_ALIGN_DECL(16, uint8_t) m_internal[64];
 	};
 
+	///
+	typedef void (*JobFn)(void* _userData, uint32_t _idx);
+
+	/// Job scheduler interface.
+	struct BX_NO_VTABLE JobSchedulerI
+	{
+		///
+		virtual ~JobSchedulerI() = 0;
+
+		/// Returns maximum number of jobs that can execute concurrently.
+		virtual uint32_t getNumThreads() const = 0;
+
+		/// Invokes `_fn` for every job index in [0, `_num`) range, and returns
+		/// once all jobs are done.
+		virtual void run(JobFn _fn, void* _userData, uint32_t _num) = 0;
+	};
+
+	/// Job scheduler executing jobs on worker threads. Thread calling `run`
+	/// executes jobs too.
+	class JobScheduler : public JobSchedulerI
+	{
+		BX_CLASS(JobScheduler
+			, NO_COPY
+			, NO_ASSIGNMENT
+			);
+
+	public:
+		///
+		JobScheduler();
+
+		///
+		virtual ~JobScheduler();
+
+		/// Starts `_numThreads-1` worker threads.
+		void init(uint32_t _numThreads);
+
+		///
+		void shutdown();
+
+		///
+		virtual uint32_t getNumThreads() const override;
+
+		///
+		virtual void run(JobFn _fn, void* _userData, uint32_t _num) override;
+
+	private:
+		static int32_t threadFunc(Thread* _thread, void* _userData);
+		void execute();
+
+		Thread    m_thread[BX_CONFIG_JOB_SCHEDULER_MAX_THREADS-1];
+		Semaphore m_start;
+		Semaphore m_done;
+
+		JobFn    m_fn;
+		void*    m_userData;
+		uint32_t m_num;
+		uint32_t m_next;
+		uint32_t m_numThreads;
+		bool     m_exit;
+	};
+
 } // namespace bx
 
+#include "inline/thread.inl"
+
 #endif // BX_THREAD_H_HEADER_GUARD
@@ -13,6 +13,23 @@
 #	include <sys/stat.h>
 #endif // !BX_CRT_NONE
 
+#ifndef BX_CONFIG_FILE_MAPPING
+#	define BX_CONFIG_FILE_MAPPING (!BX_CRT_NONE && (0 \
+			|| BX_PLATFORM_WINDOWS                   \
+			|| (BX_PLATFORM_POSIX && !BX_PLATFORM_PS4) \
+			) )
+#endif // BX_CONFIG_FILE_MAPPING
+
+#if BX_CONFIG_FILE_MAPPING
+#	if BX_PLATFORM_WINDOWS
+#		include <windows.h>
+#	else
+#		include <fcntl.h>    // open
+#		include <sys/mman.h> // mmap
+#		include <unistd.h>   // close
+#	endif // BX_PLATFORM_WINDOWS
+#endif // BX_CONFIG_FILE_MAPPING
+
 #ifndef BX_CONFIG_CRT_FILE_READER_WRITER
 #	define BX_CONFIG_CRT_FILE_READER_WRITER !(0 \
 			|| BX_CRT_NONE                      \
@@ -603,4 +620,112 @@ namespace bx
 #endif // BX_CRT_NONE
 	}
 
+	const void* mapFile(const FilePath& _filePath, uint64_t& _outSize, Error* _err)
+	{
+		BX_ERROR_SCOPE(_err);
+
+		_outSize = 0;
+
+#if BX_CONFIG_FILE_MAPPING
+#	if BX_PLATFORM_WINDOWS
+		HANDLE file = ::CreateFileA(
+			  _filePath.get()
+			, GENERIC_READ
+			, FILE_SHARE_READ
+			, NULL
+			, OPEN_EXISTING
+			, FILE_ATTRIBUTE_NORMAL
+			, NULL
+			);
+
+		if (INVALID_HANDLE_VALUE == file)
+		{
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_OPEN, "mapFile: Failed to open file.");
+			return NULL;
+		}
+
+		LARGE_INTEGER size;
+		if (!::GetFileSizeEx(file, &size)
+		||  0 == size.QuadPart)
+		{
+			::CloseHandle(file);
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_READ, "mapFile: File is empty.");
+			return NULL;
+		}
+
+		// View keeps the mapping, and the mapping keeps the file open.
+		HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		::CloseHandle(file);
+
+		if (NULL == mapping)
+		{
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_READ, "mapFile: Failed to map file.");
+			return NULL;
+		}
+
+		void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		::CloseHandle(mapping);
+
+		if (NULL == data)
+		{
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_READ, "mapFile: Failed to map file.");
+			return NULL;
+		}
+
+		_outSize = uint64_t(size.QuadPart);
+
+		return data;
+#	else
+		const int32_t fd = ::open(_filePath.get(), O_RDONLY);
+
+		if (-1 == fd)
+		{
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_OPEN, "mapFile: Failed to open file.");
+			return NULL;
+		}
+
+		struct ::stat st;
+		if (0 != ::fstat(fd, &st)
+		||  0 >= st.st_size)
+		{
+			::close(fd);
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_READ, "mapFile: File is empty.");
+			return NULL;
+		}
+
+		// Mapping stays valid after the file descriptor is closed.
+		void* data = ::mmap(NULL, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+
+		if (MAP_FAILED == data)
+		{
+			BX_ERROR_SET(_err, BX_ERROR_READERWRITER_READ, "mapFile: Failed to map file.");
+			return NULL;
+		}
+
+		_outSize = uint64_t(st.st_size);
+
+		return data;
+#	endif // BX_PLATFORM_WINDOWS
+#else
+		BX_UNUSED(_filePath);
+		BX_ERROR_SET(_err, BX_ERROR_READERWRITER_OPEN, "mapFile: Not supported.");
+		return NULL;
+#endif // BX_CONFIG_FILE_MAPPING
+	}
+
+	void unmapFile(const void* _data, uint64_t _size)
+	{
+#if BX_CONFIG_FILE_MAPPING
+#	if BX_PLATFORM_WINDOWS
+		BX_UNUSED(_size);
+		::UnmapViewOfFile(_data);
+#	else
+		::munmap(const_cast<void*>(_data), size_t(_size) );
+#	endif // BX_PLATFORM_WINDOWS
+#else
+		BX_UNUSED(_data, _size);
+#endif // BX_CONFIG_FILE_MAPPING
+	}
+
 } // namespace bx
@@ -4,6 +4,7 @@
  */
 
 #include "bx_p.h"
+#include <bx/cpu.h>
 #include <bx/thread.h>
 
 #if BX_CONFIG_SUPPORTS_THREADING
@@ -393,6 +394,112 @@ namespace bx
 	}
 #endif // BX_PLATFORM_*
 
+	JobScheduler::JobScheduler()
+		: m_fn(NULL)
+		, m_userData(NULL)
+		, m_num(0)
+		, m_next(0)
+		, m_numThreads(1)
+		, m_exit(false)
+	{
+	}
+
+	JobScheduler::~JobScheduler()
+	{
+		if (1 < m_numThreads)
+		{
+			shutdown();
+		}
+	}
+
+	void JobScheduler::init(uint32_t _numThreads)
+	{
+		BX_CHECK(1 == m_numThreads, "Already initialized!");
+
+		m_numThreads = clamp<uint32_t>(_numThreads, 1, BX_CONFIG_JOB_SCHEDULER_MAX_THREADS);
+		m_exit = false;
+
+		for (uint32_t ii = 0, num = m_numThreads-1; ii < num; ++ii)
+		{
+			m_thread[ii].init(threadFunc, this, 0, "bx/JobScheduler");
+		}
+	}
+
+	void JobScheduler::shutdown()
+	{
+		const uint32_t numWorkers = m_numThreads-1;
+
+		m_exit = true;
+		m_start.post(numWorkers);
+
+		for (uint32_t ii = 0; ii < numWorkers; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+
+		m_numThreads = 1;
+	}
+
+	uint32_t JobScheduler::getNumThreads() const
+	{
+		return m_numThreads;
+	}
+
+	void JobScheduler::run(JobFn _fn, void* _userData, uint32_t _num)
+	{
+		const uint32_t numWorkers = min(m_numThreads, _num)-1;
+
+		m_fn       = _fn;
+		m_userData = _userData;
+		m_num      = _num;
+		m_next     = 0;
+
+		if (0 < numWorkers)
+		{
+			m_start.post(numWorkers);
+		}
+
+		execute();
+
+		for (uint32_t ii = 0; ii < numWorkers; ++ii)
+		{
+			m_done.wait();
+		}
+	}
+
+	int32_t JobScheduler::threadFunc(Thread* _thread, void* _userData)
+	{
+		BX_UNUSED(_thread);
+
+		JobScheduler* scheduler = (JobScheduler*)_userData;
+
+		for (;;)
+		{
+			scheduler->m_start.wait();
+
+			if (scheduler->m_exit)
+			{
+				break;
+			}
+
+			scheduler->execute();
+			scheduler->m_done.post();
+		}
+
+		return kExitSuccess;
+	}
+
+	void JobScheduler::execute()
+	{
+		for (uint32_t idx = atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			; idx < m_num
+			; idx = atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			)
+		{
+			m_fn(m_userData, idx);
+		}
+	}
+
 } // namespace bx
 
 #endif // BX_CONFIG_SUPPORTS_THREADING
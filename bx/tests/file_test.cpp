@@ -0,0 +1,38 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#include "test.h"
+#include <bx/file.h>
+
+TEST_CASE("mapFile", "")
+{
+	bx::FilePath filePath;
+	filePath.set(bx::Dir::Temp);
+	filePath.join("mapfile.bin");
+
+	uint8_t data[4099];
+	for (uint32_t ii = 0; ii < BX_COUNTOF(data); ++ii)
+	{
+		data[ii] = uint8_t(ii*7);
+	}
+
+	bx::FileWriter writer;
+	REQUIRE(bx::open(&writer, filePath) );
+	bx::write(&writer, data, sizeof(data) );
+	bx::close(&writer);
+
+	uint64_t size;
+	const void* mapped = bx::mapFile(filePath, size);
+	REQUIRE(NULL != mapped);
+	REQUIRE(sizeof(data) == size);
+	REQUIRE(0 == bx::memCmp(mapped, data, sizeof(data) ) );
+	bx::unmapFile(mapped, size);
+
+	bx::Error err;
+	filePath.join("does-not-exist");
+	REQUIRE(NULL == bx::mapFile(filePath, size, &err) );
+	REQUIRE(!err.isOk() );
+	REQUIRE(0 == size);
+}
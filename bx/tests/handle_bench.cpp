@@ -109,5 +109,11 @@ int main()
 	extern void math_bench();
 	math_bench();
 
+	extern void sort_bench();
+	sort_bench();
+
+	extern void hashmap_bench();
+	hashmap_bench();
+
 	return bx::kExitSuccess;
 }
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#include <bx/hashmap.h>
+#include <bx/timer.h>
+#include <bx/file.h>
+#include <bx/rng.h>
+
+#include <tinystl/allocator.h>
+#include <tinystl/unordered_map.h>
+
+#include <unordered_map>
+
+// Mimics renderer state cache: small set of hashed 64-bit keys, every lookup is followed by
+// insert on miss, and most lookups hit.
+static void hashMapTest(uint32_t _numKeys)
+{
+	bx::WriterI* writer = bx::getStdOut();
+
+	const uint32_t numLookups = 1<<20;
+
+	uint64_t* keys   = new uint64_t[_numKeys];
+	uint32_t* lookup = new uint32_t[numLookups];
+
+	bx::RngMwc rng;
+	for (uint32_t ii = 0; ii < _numKeys; ++ii)
+	{
+		keys[ii] = uint64_t(rng.gen() )<<32 | rng.gen();
+	}
+
+	for (uint32_t ii = 0; ii < numLookups; ++ii)
+	{
+		lookup[ii] = rng.gen() % _numKeys;
+	}
+
+	uint32_t sum = 0;
+
+	{
+		typedef tinystl::unordered_map<uint64_t, uint16_t> TinyStlUnorderedMap;
+		TinyStlUnorderedMap map;
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < numLookups; ++ii)
+		{
+			const uint64_t key = keys[lookup[ii] ];
+			TinyStlUnorderedMap::const_iterator it = map.find(key);
+			if (it == map.end() )
+			{
+				map.insert(tinystl::make_pair(key, uint16_t(ii) ) );
+			}
+			else
+			{
+				sum += it->second;
+			}
+		}
+
+		elapsed += bx::getHPCounter();
+		bx::writePrintf(writer, "%6d %-20s: %15f\n", _numKeys, "tinystl", double(elapsed) );
+	}
+
+	{
+		typedef std::unordered_map<uint64_t, uint16_t> StdUnorderedMap;
+		StdUnorderedMap map;
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < numLookups; ++ii)
+		{
+			const uint64_t key = keys[lookup[ii] ];
+			StdUnorderedMap::const_iterator it = map.find(key);
+			if (it == map.end() )
+			{
+				map.insert(std::make_pair(key, uint16_t(ii) ) );
+			}
+			else
+			{
+				sum += it->second;
+			}
+		}
+
+		elapsed += bx::getHPCounter();
+		bx::writePrintf(writer, "%6d %-20s: %15f\n", _numKeys, "std", double(elapsed) );
+	}
+
+	{
+		bx::DefaultAllocator allocator;
+		bx::HashMapT<uint64_t, uint16_t> map(&allocator);
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < numLookups; ++ii)
+		{
+			const uint64_t key = keys[lookup[ii] ];
+			const uint16_t* value = map.find(key);
+			if (NULL == value)
+			{
+				map.insert(key, uint16_t(ii) );
+			}
+			else
+			{
+				sum += *value;
+			}
+		}
+
+		elapsed += bx::getHPCounter();
+		bx::writePrintf(writer, "%6d %-20s: %15f\n", _numKeys, "bx::HashMapT", double(elapsed) );
+	}
+
+	BX_UNUSED(sum);
+
+	delete [] keys;
+	delete [] lookup;
+}
+
+void hashmap_bench()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::writePrintf(writer, "HashMap bench\n\n");
+
+	hashMapTest(  256);
+	hashMapTest( 4<<10);
+	hashMapTest(64<<10);
+
+	bx::writePrintf(writer, "\n");
+}
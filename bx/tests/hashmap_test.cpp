@@ -0,0 +1,107 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#include "test.h"
+#include <bx/hashmap.h>
+#include <bx/rng.h>
+
+#include <unordered_map>
+
+TEST_CASE("HashMapT", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::HashMapT<uint64_t, uint16_t> map(&allocator);
+
+	REQUIRE(NULL == map.find(0) );
+	REQUIRE(!map.remove(0) );
+
+	REQUIRE( map.insert(0, 1) );
+	REQUIRE(!map.insert(0, 2) );
+	REQUIRE(1 == map.getNumElements() );
+	REQUIRE(2 == *map.find(0) );
+
+	const uint32_t num = 10000;
+	for (uint64_t ii = 1; ii < num; ++ii)
+	{
+		REQUIRE(map.insert(ii<<32, uint16_t(ii) ) );
+	}
+
+	REQUIRE(num == map.getNumElements() );
+	REQUIRE(map.getNumElements()*4 <= map.getCapacity()*3);
+
+	for (uint64_t ii = 1; ii < num; ++ii)
+	{
+		REQUIRE(NULL != map.find(ii<<32) );
+		REQUIRE(uint16_t(ii) == *map.find(ii<<32) );
+	}
+
+	for (uint64_t ii = 1; ii < num; ii += 2)
+	{
+		REQUIRE( map.remove(ii<<32) );
+		REQUIRE(!map.remove(ii<<32) );
+	}
+
+	for (uint64_t ii = 1; ii < num; ++ii)
+	{
+		REQUIRE( (0 == (ii&1) ) == (NULL != map.find(ii<<32) ) );
+	}
+
+	uint32_t count = 0;
+	for (bx::HashMapT<uint64_t, uint16_t>::Iterator it = map.first(); map.next(it); ++count)
+	{
+		REQUIRE(*it.value == uint16_t(it.key>>32) + (0 == it.key ? 2 : 0) );
+	}
+
+	REQUIRE(count == map.getNumElements() );
+
+	const uint32_t capacity = map.getCapacity();
+	map.reset();
+	REQUIRE(0 == map.getNumElements() );
+	REQUIRE(capacity == map.getCapacity() );
+	REQUIRE(NULL == map.find(0) );
+
+	bx::HashMapT<uint64_t, uint16_t>::Iterator it = map.first();
+	REQUIRE(!map.next(it) );
+}
+
+TEST_CASE("HashMapT random", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::HashMapT<uint32_t, uint32_t> map(&allocator);
+	std::unordered_map<uint32_t, uint32_t> ref;
+
+	bx::RngMwc rng;
+
+	for (uint32_t ii = 0; ii < 100000; ++ii)
+	{
+		// Small key range, so that inserts and removes hit the same clusters.
+		const uint32_t key = rng.gen() % 1024;
+
+		if (0 == rng.gen() % 3)
+		{
+			REQUIRE(map.remove(key) == (0 != ref.erase(key) ) );
+		}
+		else
+		{
+			REQUIRE(map.insert(key, ii) == ref.insert(std::make_pair(key, ii) ).second);
+			ref[key] = ii;
+		}
+	}
+
+	REQUIRE(map.getNumElements() == ref.size() );
+
+	for (uint32_t key = 0; key < 1024; ++key)
+	{
+		const uint32_t* value = map.find(key);
+		std::unordered_map<uint32_t, uint32_t>::const_iterator it = ref.find(key);
+
+		REQUIRE( (NULL != value) == (it != ref.end() ) );
+
+		if (NULL != value)
+		{
+			REQUIRE(*value == it->second);
+		}
+	}
+}
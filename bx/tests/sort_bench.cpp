@@ -0,0 +1,77 @@
+/*
+ * Copyright 2010-2018 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx#license-bsd-2-clause
+ */
+
+#include <bx/sort.h>
+#include <bx/timer.h>
+#include <bx/file.h>
+#include <bx/rng.h>
+
+static void radixSortTest(uint32_t _size, bx::JobScheduler* _scheduler)
+{
+	bx::WriterI* writer = bx::getStdOut();
+
+	const uint32_t numIterations = 32;
+
+	uint64_t* src        = new uint64_t[_size];
+	uint64_t* keys       = new uint64_t[_size];
+	uint64_t* tempKeys   = new uint64_t[_size];
+	uint32_t* values     = new uint32_t[_size];
+	uint32_t* tempValues = new uint32_t[_size];
+
+	bx::RngMwc rng;
+	for (uint32_t ii = 0; ii < _size; ++ii)
+	{
+		src[ii] = uint64_t(rng.gen() )<<32 | rng.gen();
+	}
+
+	int64_t elapsed = 0;
+	for (uint32_t ii = 0; ii < numIterations; ++ii)
+	{
+		bx::memCopy(keys, src, _size*sizeof(uint64_t) );
+
+		elapsed -= bx::getHPCounter();
+		bx::radixSort(keys, tempKeys, values, tempValues, _size);
+		elapsed += bx::getHPCounter();
+	}
+
+	bx::writePrintf(writer, "%6dK %-20s: %15f\n", _size>>10, "bx::radixSort", double(elapsed) );
+
+	elapsed = 0;
+	for (uint32_t ii = 0; ii < numIterations; ++ii)
+	{
+		bx::memCopy(keys, src, _size*sizeof(uint64_t) );
+
+		elapsed -= bx::getHPCounter();
+		bx::radixSort(keys, tempKeys, values, tempValues, _size, _scheduler);
+		elapsed += bx::getHPCounter();
+	}
+
+	char name[32];
+	bx::snprintf(name, BX_COUNTOF(name), "bx::radixSort (%d)", _scheduler->getNumThreads() );
+	bx::writePrintf(writer, "%6dK %-20s: %15f\n", _size>>10, name, double(elapsed) );
+
+	delete [] src;
+	delete [] keys;
+	delete [] tempKeys;
+	delete [] values;
+	delete [] tempValues;
+}
+
+void sort_bench()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::writePrintf(writer, "Sort bench\n\n");
+
+	bx::JobScheduler scheduler;
+	scheduler.init(4);
+
+	radixSortTest( 1<<10, &scheduler);
+	radixSortTest(16<<10, &scheduler);
+	radixSortTest(64<<10, &scheduler);
+
+	scheduler.shutdown();
+
+	bx::writePrintf(writer, "\n");
+}
@@ -51,3 +51,51 @@ TEST_CASE("quickSort", "")
 		REQUIRE(byte[ii-1] <= byte[ii]);
 	}
 }
+
+TEST_CASE("radixSort parallel", "")
+{
+	const uint32_t size = 64<<10;
+	uint64_t* keys       = new uint64_t[size];
+	uint64_t* tempKeys   = new uint64_t[size];
+	uint64_t* refKeys    = new uint64_t[size];
+	uint32_t* values     = new uint32_t[size];
+	uint32_t* tempValues = new uint32_t[size];
+	uint32_t* refValues  = new uint32_t[size];
+
+	bx::JobScheduler scheduler;
+	scheduler.init(4);
+
+	bx::RngMwc rng;
+	for (uint32_t ii = 0; ii < size; ++ii)
+	{
+		// Only few distinct keys, to test sort is stable.
+		keys[ii]   = uint64_t(rng.gen()&0xff)<<40 | (rng.gen()&0x3);
+		values[ii] = ii;
+	}
+
+	bx::memCopy(refKeys, keys, size*sizeof(uint64_t) );
+	bx::memCopy(refValues, values, size*sizeof(uint32_t) );
+
+	bx::radixSort(refKeys, tempKeys, refValues, tempValues, size);
+	bx::radixSort(keys, tempKeys, values, tempValues, size, &scheduler);
+
+	REQUIRE(0 == bx::memCmp(refKeys, keys, size*sizeof(uint64_t) ) );
+	REQUIRE(0 == bx::memCmp(refValues, values, size*sizeof(uint32_t) ) );
+
+	bool stable = true;
+	for (uint32_t ii = 1; ii < size; ++ii)
+	{
+		stable &= keys[ii-1] < keys[ii] || values[ii-1] < values[ii];
+	}
+
+	REQUIRE(stable);
+
+	scheduler.shutdown();
+
+	delete [] keys;
+	delete [] tempKeys;
+	delete [] refKeys;
+	delete [] values;
+	delete [] tempValues;
+	delete [] refValues;
+}
@@ -0,0 +1,367 @@
+#include "mygfx/mygfx.h"
+
+#pragma comment(lib, "mygfx.lib")
+
+#include <bx/commandline.h>
+#include <bx/math.h>
+#include <bx/readerwriter.h>
+#include <bx/semaphore.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+
+// Headless draw submission benchmark. Runs on the noop renderer and reports, per frame,
+// time spent submitting draws from M encoders, sorting them and executing them in the
+// renderer. With --scaling it sweeps encoder count from 1 to caps limit, reports submit
+// speedup and fails if any submitted draw didn't reach the renderer.
+//
+// Usage: drawbench [--draws N] [--encoders M] [--frames F] [--programs P] [--scaling]
+
+namespace
+{
+	struct PosVertex
+	{
+		float m_x;
+		float m_y;
+		float m_z;
+	};
+
+	static const PosVertex s_cubeVertices[8] =
+	{
+		{-1.0f,  1.0f,  1.0f },
+		{ 1.0f,  1.0f,  1.0f },
+		{-1.0f, -1.0f,  1.0f },
+		{ 1.0f, -1.0f,  1.0f },
+		{-1.0f,  1.0f, -1.0f },
+		{ 1.0f,  1.0f, -1.0f },
+		{-1.0f, -1.0f, -1.0f },
+		{ 1.0f, -1.0f, -1.0f },
+	};
+
+	static const uint16_t s_cubeIndices[36] =
+	{
+		0, 1, 2, 1, 3, 2,
+		4, 6, 5, 5, 6, 7,
+		0, 2, 4, 4, 2, 6,
+		1, 5, 3, 5, 7, 3,
+		0, 4, 1, 4, 5, 1,
+		2, 3, 6, 6, 3, 7,
+	};
+
+	static const uint64_t s_states[4] =
+	{
+		MYGFX_STATE_DEFAULT,
+		MYGFX_STATE_DEFAULT | MYGFX_STATE_BLEND_ALPHA,
+		MYGFX_STATE_WRITE_RGB | MYGFX_STATE_DEPTH_TEST_LESS | MYGFX_STATE_CULL_CW,
+		MYGFX_STATE_WRITE_RGB | MYGFX_STATE_WRITE_A | MYGFX_STATE_PT_TRISTRIP,
+	};
+
+	static const mygfx::ViewMode::Enum s_viewModes[4] =
+	{
+		mygfx::ViewMode::Default,
+		mygfx::ViewMode::Sequential,
+		mygfx::ViewMode::DepthAscending,
+		mygfx::ViewMode::DepthDescending,
+	};
+
+	const uint16_t kNumViews    = BX_COUNTOF(s_viewModes);
+	const uint32_t kMaxPrograms = 64;
+
+	// Builds minimal shader binary accepted by createShader. Noop renderer never looks at
+	// bytecode, only header and uniform table are parsed.
+	mygfx::ShaderHandle createDummyShader(char _type, uint32_t _hash)
+	{
+		const mygfx::Memory* mem = mygfx::alloc(sizeof(uint32_t)*3 + sizeof(uint16_t) );
+
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		bx::write(&writer, BX_MAKEFOURCC(_type, 'S', 'H', 5) );
+		bx::write(&writer, _hash);
+		bx::write(&writer, uint16_t(0) );
+		bx::write(&writer, uint32_t(0) );
+
+		return mygfx::createShader(mem);
+	}
+
+	struct Scene
+	{
+		mygfx::VertexBufferHandle m_vbh;
+		mygfx::IndexBufferHandle  m_ibh;
+		mygfx::ProgramHandle      m_program[kMaxPrograms];
+		uint32_t m_numPrograms;
+		uint32_t m_numDraws;
+		uint32_t m_frame;
+	};
+
+	void submitRange(mygfx::Encoder* _encoder, const Scene& _scene, uint32_t _begin, uint32_t _end)
+	{
+		float mtx[16];
+		bx::mtxIdentity(mtx);
+
+		for (uint32_t ii = _begin; ii < _end; ++ii)
+		{
+			const uint32_t hash = ii * 0x9e3779b1u + _scene.m_frame;
+
+			mtx[12] = float(ii % 64);
+			mtx[13] = float( (ii / 64) % 64);
+			mtx[14] = float(ii / 4096);
+			_encoder->setTransform(mtx);
+
+			_encoder->setVertexBuffer(0, _scene.m_vbh);
+			_encoder->setIndexBuffer(_scene.m_ibh);
+			_encoder->setState(s_states[(hash >> 8) % BX_COUNTOF(s_states)]);
+
+			const mygfx::ViewId view = mygfx::ViewId(ii % kNumViews);
+			_encoder->submit(view, _scene.m_program[(hash >> 16) % _scene.m_numPrograms], hash >> 8);
+		}
+	}
+
+	struct SubmitThread
+	{
+		static int32_t threadFunc(bx::Thread* _thread, void* _userData)
+		{
+			BX_UNUSED(_thread);
+
+			SubmitThread* self = (SubmitThread*)_userData;
+			for (;;)
+			{
+				self->m_start.wait();
+				if (self->m_exit)
+				{
+					break;
+				}
+
+				mygfx::Encoder* encoder = mygfx::begin(true);
+				if (NULL != encoder)
+				{
+					submitRange(encoder, *self->m_scene, self->m_begin, self->m_end);
+					mygfx::end(encoder);
+				}
+
+				self->m_done.post();
+			}
+
+			return 0;
+		}
+
+		bx::Thread    m_thread;
+		bx::Semaphore m_start;
+		bx::Semaphore m_done;
+		const Scene*  m_scene;
+		uint32_t      m_begin;
+		uint32_t      m_end;
+		bool          m_exit;
+	};
+
+	struct BenchResult
+	{
+		int64_t  m_submit;
+		int64_t  m_sort;
+		int64_t  m_execute;
+		int64_t  m_frame;
+		uint32_t m_draws;
+		uint32_t m_minDraws;
+	};
+
+	void submitFrame(Scene& _scene, SubmitThread* _threads, uint32_t _numEncoders)
+	{
+		const uint32_t numDraws = _scene.m_numDraws;
+		const uint32_t drawsPerEncoder = (numDraws + _numEncoders - 1) / _numEncoders;
+
+		for (uint32_t ii = 0; ii < _numEncoders - 1; ++ii)
+		{
+			SubmitThread& st = _threads[ii];
+			st.m_begin = bx::min(numDraws, (ii + 1) * drawsPerEncoder);
+			st.m_end   = bx::min(numDraws, (ii + 2) * drawsPerEncoder);
+			st.m_start.post();
+		}
+
+		mygfx::Encoder* encoder = mygfx::begin();
+		submitRange(encoder, _scene, 0, bx::min(numDraws, drawsPerEncoder) );
+		mygfx::end(encoder);
+
+		for (uint32_t ii = 0; ii < _numEncoders - 1; ++ii)
+		{
+			_threads[ii].m_done.wait();
+		}
+	}
+
+	void runFrames(BenchResult& _result, Scene& _scene, SubmitThread* _threads, uint32_t _numEncoders, uint32_t _numFrames)
+	{
+		bx::memSet(&_result, 0, sizeof(_result) );
+		_result.m_minDraws = UINT32_MAX;
+
+		// With multithreaded renderer stats returned by frame() belong to previous frame,
+		// submit one frame up front so that every measured frame reports full work.
+		submitFrame(_scene, _threads, _numEncoders);
+		mygfx::frame();
+
+		for (uint32_t frame = 0; frame < _numFrames; ++frame)
+		{
+			_scene.m_frame = frame;
+
+			const int64_t submitBegin = bx::getHPCounter();
+			submitFrame(_scene, _threads, _numEncoders);
+			const int64_t submitEnd = bx::getHPCounter();
+
+			mygfx::frame();
+
+			const int64_t frameEnd = bx::getHPCounter();
+
+			const mygfx::Stats* stats = mygfx::getStats();
+			const int64_t render = stats->cpuTimeEnd - stats->cpuTimeBegin;
+
+			_result.m_submit   += submitEnd - submitBegin;
+			_result.m_sort     += stats->cpuTimeSort;
+			_result.m_execute  += render - stats->cpuTimeSort;
+			_result.m_frame    += frameEnd - submitBegin;
+			_result.m_draws    += stats->numDraw;
+			_result.m_minDraws  = bx::min(_result.m_minDraws, stats->numDraw);
+		}
+	}
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	uint32_t numDraws    = 10000;
+	uint32_t numEncoders = 1;
+	uint32_t numFrames   = 100;
+	uint32_t numPrograms = 16;
+	cmdLine.hasArg(numDraws,    'n', "draws");
+	cmdLine.hasArg(numEncoders, 'e', "encoders");
+	cmdLine.hasArg(numFrames,   'f', "frames");
+	cmdLine.hasArg(numPrograms, 'p', "programs");
+	const bool scaling = cmdLine.hasArg('s', "scaling");
+
+	mygfx::Init init;
+	init.type = mygfx::RendererType::Noop;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+	init.limits.maxEncoders = uint16_t(bx::clamp<uint32_t>(numEncoders, init.limits.maxEncoders, 128) );
+	init.limits.maxDrawCalls = bx::max<uint32_t>(numDraws+1, init.limits.maxDrawCalls);
+	if (!mygfx::init(init) )
+	{
+		fprintf(stderr, "Failed to initialize noop renderer.\n");
+		return EXIT_FAILURE;
+	}
+
+	const mygfx::Caps* caps = mygfx::getCaps();
+	numEncoders = bx::clamp<uint32_t>(numEncoders, 1, caps->limits.maxEncoders);
+	numPrograms = bx::clamp<uint32_t>(numPrograms, 1, kMaxPrograms);
+	numFrames   = bx::max<uint32_t>(numFrames, 1);
+	numDraws    = bx::min<uint32_t>(numDraws, caps->limits.maxDrawCalls - 1);
+
+	for (uint16_t ii = 0; ii < kNumViews; ++ii)
+	{
+		mygfx::setViewRect(ii, 0, 0, uint16_t(init.resolution.width), uint16_t(init.resolution.height) );
+		mygfx::setViewMode(ii, s_viewModes[ii]);
+	}
+
+	mygfx::VertexDecl decl;
+	decl
+		.begin()
+		.add(mygfx::Attrib::Position, 3, mygfx::AttribType::Float)
+		.end();
+
+	Scene scene;
+	scene.m_vbh = mygfx::createVertexBuffer(mygfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) ), decl);
+	scene.m_ibh = mygfx::createIndexBuffer(mygfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) ) );
+	scene.m_numPrograms = numPrograms;
+	scene.m_numDraws    = numDraws;
+	scene.m_frame       = 0;
+
+	for (uint32_t ii = 0; ii < numPrograms; ++ii)
+	{
+		mygfx::ShaderHandle vsh = createDummyShader('V', ii);
+		mygfx::ShaderHandle fsh = createDummyShader('F', ii);
+		scene.m_program[ii] = mygfx::createProgram(vsh, fsh, true);
+	}
+
+	const uint32_t maxEncoders = scaling ? caps->limits.maxEncoders : numEncoders;
+
+	SubmitThread* threads = new SubmitThread[maxEncoders - 1];
+	for (uint32_t ii = 0; ii < maxEncoders - 1; ++ii)
+	{
+		SubmitThread& st = threads[ii];
+		st.m_scene = &scene;
+		st.m_exit  = false;
+		st.m_thread.init(SubmitThread::threadFunc, &st, 0, "drawbench");
+	}
+
+	// Flush resource creation before timing anything.
+	mygfx::frame();
+
+	const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+	bool ok = true;
+
+	if (scaling)
+	{
+		printf("draws %u, programs %u, frames %u\n", numDraws, numPrograms, numFrames);
+		printf("  encoders     submit (ms)   speedup\n");
+
+		double baseline = 0.0;
+		for (uint32_t num = 1; num <= maxEncoders; ++num)
+		{
+			BenchResult result;
+			runFrames(result, scene, threads, num, numFrames);
+
+			const double submit = double(result.m_submit)*toMs/double(numFrames);
+			baseline = 1 == num ? submit : baseline;
+
+			const bool valid = result.m_minDraws == numDraws;
+			ok &= valid;
+
+			printf("  %8u  %12.3f  %8.2fx%s\n"
+				, num
+				, submit
+				, baseline/submit
+				, valid ? "" : "  (dropped draws!)"
+				);
+		}
+	}
+	else
+	{
+		BenchResult result;
+		runFrames(result, scene, threads, numEncoders, numFrames);
+		ok = result.m_minDraws == numDraws;
+
+		const double invFrames = 1.0/double(numFrames);
+
+		printf("draws %u, encoders %u, programs %u, frames %u\n", numDraws, numEncoders, numPrograms, numFrames);
+		printf("  rendered %10.1f draws/frame\n", double(result.m_draws)*invFrames);
+		printf("  submit   %10.3f ms/frame\n", double(result.m_submit )*toMs*invFrames);
+		printf("  sort     %10.3f ms/frame\n", double(result.m_sort   )*toMs*invFrames);
+		printf("  execute  %10.3f ms/frame\n", double(result.m_execute)*toMs*invFrames);
+		printf("  frame    %10.3f ms/frame\n", double(result.m_frame  )*toMs*invFrames);
+	}
+
+	for (uint32_t ii = 0; ii < maxEncoders - 1; ++ii)
+	{
+		SubmitThread& st = threads[ii];
+		st.m_exit = true;
+		st.m_start.post();
+		st.m_thread.shutdown();
+	}
+
+	delete [] threads;
+
+	for (uint32_t ii = 0; ii < numPrograms; ++ii)
+	{
+		mygfx::destroy(scene.m_program[ii]);
+	}
+
+	mygfx::destroy(scene.m_ibh);
+	mygfx::destroy(scene.m_vbh);
+
+	mygfx::shutdown();
+
+	if (!ok)
+	{
+		fprintf(stderr, "Renderer didn't receive all submitted draws.\n");
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
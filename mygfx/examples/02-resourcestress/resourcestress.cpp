@@ -0,0 +1,244 @@
+#include "mygfx/mygfx.h"
+
+#pragma comment(lib, "mygfx.lib")
+
+#include <bx/commandline.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+
+#include <stdio.h>
+
+// Headless resource creation stress test. Runs on the noop renderer, creates N resources
+// (vertex, index and dynamic buffers, named textures) in a single frame, then destroys all
+// of them in the next one. Command buffers have to grow well past a single page to hold
+// this. Every resource is created from memory reference with release
+// callback, test fails if any of them wasn't released exactly once by the renderer, which
+// means its create command didn't make it through command buffer intact.
+//
+// Usage: resourcestress [--resources N] [--frames F]
+
+namespace
+{
+	struct Type
+	{
+		enum Enum
+		{
+			VertexBuffer,
+			IndexBuffer,
+			DynamicVertexBuffer,
+			DynamicIndexBuffer,
+			Texture,
+
+			Count
+		};
+	};
+
+	struct Resource
+	{
+		Type::Enum m_type;
+		uint16_t   m_idx;
+		uint32_t   m_released;
+	};
+
+	static const uint16_t s_data[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+	void releaseFn(void* _ptr, void* _userData)
+	{
+		BX_UNUSED(_ptr);
+		Resource* resource = (Resource*)_userData;
+		++resource->m_released;
+	}
+
+	uint32_t getMaxResources(const mygfx::Caps* _caps, Type::Enum _type)
+	{
+		switch (_type)
+		{
+		case Type::VertexBuffer:        return _caps->limits.maxVertexBuffers;
+		case Type::IndexBuffer:         return _caps->limits.maxIndexBuffers;
+		case Type::DynamicVertexBuffer: return _caps->limits.maxDynamicVertexBuffers;
+		case Type::DynamicIndexBuffer:  return _caps->limits.maxDynamicIndexBuffers;
+		case Type::Texture:             return _caps->limits.maxTextures;
+		default:                        break;
+		}
+
+		return 0;
+	}
+
+	void createResource(Resource& _resource, const mygfx::VertexDecl& _decl, uint32_t _index)
+	{
+		const mygfx::Memory* mem = mygfx::makeRef(s_data, sizeof(s_data), releaseFn, &_resource);
+		_resource.m_released = 0;
+
+		switch (_resource.m_type)
+		{
+		case Type::VertexBuffer:
+			{
+				mygfx::VertexBufferHandle handle = mygfx::createVertexBuffer(mem, _decl);
+				_resource.m_idx = handle.idx;
+			}
+			break;
+
+		case Type::IndexBuffer:
+			{
+				mygfx::IndexBufferHandle handle = mygfx::createIndexBuffer(mem);
+				_resource.m_idx = handle.idx;
+			}
+			break;
+
+		case Type::DynamicVertexBuffer:
+			{
+				mygfx::DynamicVertexBufferHandle handle = mygfx::createDynamicVertexBuffer(mem, _decl);
+				_resource.m_idx = handle.idx;
+			}
+			break;
+
+		case Type::DynamicIndexBuffer:
+			{
+				mygfx::DynamicIndexBufferHandle handle = mygfx::createDynamicIndexBuffer(mem);
+				_resource.m_idx = handle.idx;
+			}
+			break;
+
+		case Type::Texture:
+			{
+				char name[64];
+				bx::snprintf(name, BX_COUNTOF(name), "resourcestress/%u", _index);
+
+				mygfx::TextureHandle handle = mygfx::createTexture2D(2, 2, false, 1, mygfx::TextureFormat::RGBA8, MYGFX_TEXTURE_NONE, mem);
+				mygfx::setName(handle, name);
+				_resource.m_idx = handle.idx;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	void destroyResource(const Resource& _resource)
+	{
+		switch (_resource.m_type)
+		{
+		case Type::VertexBuffer:        { mygfx::VertexBufferHandle        handle = { _resource.m_idx }; mygfx::destroy(handle); } break;
+		case Type::IndexBuffer:         { mygfx::IndexBufferHandle         handle = { _resource.m_idx }; mygfx::destroy(handle); } break;
+		case Type::DynamicVertexBuffer: { mygfx::DynamicVertexBufferHandle handle = { _resource.m_idx }; mygfx::destroy(handle); } break;
+		case Type::DynamicIndexBuffer:  { mygfx::DynamicIndexBufferHandle  handle = { _resource.m_idx }; mygfx::destroy(handle); } break;
+		case Type::Texture:             { mygfx::TextureHandle             handle = { _resource.m_idx }; mygfx::destroy(handle); } break;
+		default:                        break;
+		}
+	}
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	uint32_t numResources = 20000;
+	uint32_t numFrames    = 4;
+	cmdLine.hasArg(numResources, 'n', "resources");
+	cmdLine.hasArg(numFrames,    'f', "frames");
+
+	mygfx::Init init;
+	init.type = mygfx::RendererType::Noop;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+	if (!mygfx::init(init) )
+	{
+		fprintf(stderr, "Failed to initialize noop renderer.\n");
+		return EXIT_FAILURE;
+	}
+
+	const mygfx::Caps* caps = mygfx::getCaps();
+
+	// Resources are spread across types round robin, each type is capped by its handle limit.
+	uint32_t maxResources = 0;
+	for (uint32_t ii = 0; ii < Type::Count; ++ii)
+	{
+		maxResources += getMaxResources(caps, Type::Enum(ii) );
+	}
+
+	numResources = bx::min(numResources, maxResources);
+	numFrames    = bx::max<uint32_t>(numFrames, 1);
+
+	Resource* resources = new Resource[numResources];
+	{
+		uint32_t count[Type::Count] = {};
+		uint32_t type = 0;
+		for (uint32_t ii = 0; ii < numResources; ++ii)
+		{
+			while (count[type] == getMaxResources(caps, Type::Enum(type) ) )
+			{
+				type = (type + 1) % Type::Count;
+			}
+
+			resources[ii].m_type = Type::Enum(type);
+			++count[type];
+			type = (type + 1) % Type::Count;
+		}
+	}
+
+	mygfx::VertexDecl decl;
+	decl
+		.begin()
+		.add(mygfx::Attrib::Position, 2, mygfx::AttribType::Int16)
+		.end();
+
+	const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+	bool ok = true;
+
+	printf("resources %u, frames %u\n", numResources, numFrames);
+	printf("  frame      create (ms)  destroy (ms)  released\n");
+
+	for (uint32_t frame = 0; frame < numFrames; ++frame)
+	{
+		const int64_t createBegin = bx::getHPCounter();
+		for (uint32_t ii = 0; ii < numResources; ++ii)
+		{
+			createResource(resources[ii], decl, ii);
+		}
+
+		mygfx::frame();
+		const int64_t createEnd = bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < numResources; ++ii)
+		{
+			destroyResource(resources[ii]);
+		}
+
+		mygfx::frame();
+		const int64_t destroyEnd = bx::getHPCounter();
+
+		// With multithreaded renderer create commands are executed while API thread is
+		// already in the next frame, this makes sure both frames were fully processed.
+		mygfx::frame();
+
+		uint32_t numReleased = 0;
+		for (uint32_t ii = 0; ii < numResources; ++ii)
+		{
+			numReleased += 1 == resources[ii].m_released;
+		}
+
+		const bool valid = numReleased == numResources;
+		ok &= valid;
+
+		printf("  %5u  %14.3f  %12.3f  %8u%s\n"
+			, frame
+			, double(createEnd  - createBegin)*toMs
+			, double(destroyEnd - createEnd  )*toMs
+			, numReleased
+			, valid ? "" : "  (lost commands!)"
+			);
+	}
+
+	delete [] resources;
+
+	mygfx::shutdown();
+
+	if (!ok)
+	{
+		fprintf(stderr, "Renderer didn't execute all create commands.\n");
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,7 +6,7 @@
 #ifndef MYGFX_DEFINES_H_HEADER_GUARD
 #define MYGFX_DEFINES_H_HEADER_GUARD
 
-#define MYGFX_API_VERSION UINT32_C(89)
+#define MYGFX_API_VERSION UINT32_C(90)
 
 /// Color RGB/alpha/depth write. When it's not specified write will be disabled.
 #define MYGFX_STATE_WRITE_R                 UINT64_C(0x0000000000000001) //!< Enable R write.
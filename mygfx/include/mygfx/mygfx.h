@@ -345,6 +345,10 @@ namespace mygfx
 		) = 0;
 	};
 
+	inline CallbackI::~CallbackI()
+	{
+	}
+
 	struct PlatformData
 	{
 		PlatformData();
@@ -388,6 +392,7 @@ namespace mygfx
 			uint16_t maxEncoders;     //!< Maximum number of encoder threads.
 			uint32_t transientVbSize; //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize; //!< Maximum transient index buffer size.
+			uint32_t maxDrawCalls;    //!< Maximum number of draw calls per frame.
 		};
 
 		Limits limits;
@@ -405,7 +410,7 @@ namespace mygfx
 
 	struct Caps
 	{
-		RendererType rendererType;
+		RendererType::Enum rendererType;
 
 		uint64_t supported;
 
@@ -549,6 +554,7 @@ namespace mygfx
 		int64_t waitRender;                 //!< Time spent waiting for render backend thread to finish issuing
 											//!  draw commands to underlying graphics API.
 		int64_t waitSubmit;                 //!< Time spent waiting for submit thread to advance to next frame.
+		int64_t cpuTimeSort;                //!< Render thread CPU time spent sorting draw calls.
 
 		uint32_t numDraw;                   //!< Number of draw calls submitted.
 		uint32_t numCompute;                //!< Number of compute calls submitted.
@@ -701,6 +707,10 @@ namespace mygfx
 			, uint32_t _numVertices
 		);
 
+		/// Set number of vertices for auto generated vertices use in conjuction
+		/// with gl_VertexID.
+		void setVertexCount(uint32_t _numVertices);
+
 		void setTexture(
 			uint8_t _stage
 			, UniformHandle _sampler
@@ -731,32 +741,32 @@ namespace mygfx
 		void setBuffer(
 			uint8_t _stage
 			, IndexBufferHandle _handle
-			, Access _access
+			, Access::Enum _access
 		);
 
 		void setBuffer(
 			uint8_t _stage
 			, VertexBufferHandle _handle
-			, Access _access
+			, Access::Enum _access
 		);
 
 		void setBuffer(
 			uint8_t _stage
 			, DynamicIndexBufferHandle _handle
-			, Access _access
+			, Access::Enum _access
 		);
 
 		void setBuffer(
 			uint8_t _stage
 			, DynamicVertexBufferHandle _handle
-			, Access _access
+			, Access::Enum _access
 		);
 
 		void setImage(
 			uint8_t _stage
 			, TextureHandle _handle
 			, uint8_t _mip
-			, Access _access
+			, Access::Enum _access
 			, TextureFormat::Enum _format = TextureFormat::Enum::Count
 		);
 
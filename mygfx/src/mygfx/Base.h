@@ -115,12 +115,12 @@ namespace mygfx
 #if MYGFX_CONFIG_MULTITHREADED
 #	define MYGFX_CHECK_API_THREAD()                                  \
 		BX_CHECK(NULL != s_ctx, "Library is not initialized yet."); \
-		BX_CHECK(BGFX_API_THREAD_MAGIC == s_threadIndex, "Must be called from main thread.")
+		BX_CHECK(MYGFX_API_THREAD_MAGIC == s_threadIndex, "Must be called from main thread.")
 #	define MYGFX_CHECK_RENDER_THREAD() BX_CHECK(~MYGFX_API_THREAD_MAGIC == s_threadIndex, "Must be called from render thread.")
 #else
 #	define MYGFX_CHECK_API_THREAD()
 #	define MYGFX_CHECK_RENDER_THREAD()
-#endif // BGFX_CONFIG_MULTITHREADED
+#endif // MYGFX_CONFIG_MULTITHREADED
 
 #define MYGFX_CHECK_CAPS(_caps, _msg)                                                   \
 	BX_CHECK(0 != (g_caps.supported & (_caps) )                                        \
@@ -205,11 +205,7 @@ namespace stl = std;
 
 namespace mygfx
 {
-#if MYGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
-	typedef uint16_t RenderItemCount;
-#else
 	typedef uint32_t RenderItemCount;
-#endif // BGFX_CONFIG_MAX_DRAW_CALLS < (64<<10)
 
 	struct Condition
 	{
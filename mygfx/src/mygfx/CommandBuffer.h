@@ -14,9 +14,10 @@ namespace mygfx
 	public:
 		CommandBuffer()
 			: m_pos(0)
-			, m_size(MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE)
+			, m_size(0)
+			, m_page(NULL)
+			, m_numPages(0)
 		{
-			finish();
 		}
 
 		enum Enum
@@ -56,12 +57,25 @@ namespace mygfx
 			RequestScreenShot,
 		};
 
+		void destroy()
+		{
+			for (uint32_t ii = 0; ii < m_numPages; ++ii)
+			{
+				BX_FREE(g_allocator, m_page[ii]);
+			}
+
+			BX_FREE(g_allocator, m_page);
+			m_page = NULL;
+			m_numPages = 0;
+			m_pos = 0;
+			m_size = 0;
+		}
+
 		void write(const void* _data, uint32_t _size)
 		{
-			BX_CHECK(m_size == MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE, "Called write outside start/finish?");
-			BX_CHECK(m_pos < m_size, "CommandBuffer::write error (pos: %d, size: %d).", m_pos, m_size);
-			bx::memCopy(&m_buffer[m_pos], _data, _size);
-			m_pos += _size;
+			BX_CHECK(m_size == UINT32_MAX, "Called write outside start/finish?");
+			uint8_t* data = reserve(_size);
+			bx::memCopy(data, _data, _size);
 		}
 
 		template<typename Type>
@@ -74,8 +88,7 @@ namespace mygfx
 		void read(void* _data, uint32_t _size)
 		{
 			BX_CHECK(m_pos < m_size, "CommandBuffer::read error (pos: %d, size: %d).", m_pos, m_size);
-			bx::memCopy(_data, &m_buffer[m_pos], _size);
-			m_pos += _size;
+			bx::memCopy(_data, reserve(_size), _size);
 		}
 
 		template<typename Type>
@@ -88,9 +101,7 @@ namespace mygfx
 		const uint8_t* skip(uint32_t _size)
 		{
 			BX_CHECK(m_pos < m_size, "CommandBuffer::skip error (pos: %d, size: %d).", m_pos, m_size);
-			const uint8_t* result = &m_buffer[m_pos];
-			m_pos += _size;
-			return result;
+			return reserve(_size);
 		}
 
 		template<typename Type>
@@ -115,7 +126,7 @@ namespace mygfx
 		void start()
 		{
 			m_pos = 0;
-			m_size = MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			m_size = UINT32_MAX;
 		}
 
 		void finish()
@@ -128,6 +139,44 @@ namespace mygfx
 
 		uint32_t m_pos;
 		uint32_t m_size;
-		uint8_t m_buffer[MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE];
+
+	private:
+		// Returns _size contiguous bytes at current position and advances past them. Data that
+		// doesn't fit into the rest of current page starts at the next page. Reader makes the
+		// same decision as writer, so both stay in sync. Pages are allocated on first write and
+		// kept for following frames.
+		uint8_t* reserve(uint32_t _size)
+		{
+			BX_CHECK(_size <= MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+				, "CommandBuffer command is larger than page (size: %d, page size: %d)."
+				, _size
+				, MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+			);
+
+			const uint32_t offset = m_pos % MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE;
+			if (offset + _size > MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE)
+			{
+				m_pos += MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE - offset;
+			}
+
+			const uint32_t page = m_pos / MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE;
+			if (page == m_numPages)
+			{
+				BX_CHECK(m_size == UINT32_MAX, "CommandBuffer read past end (pos: %d, size: %d).", m_pos, m_size);
+
+				m_page = (uint8_t**)BX_REALLOC(g_allocator, m_page, (m_numPages + 1)*sizeof(uint8_t*));
+				m_page[m_numPages] = (uint8_t*)BX_ALLOC(g_allocator, MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE);
+				++m_numPages;
+			}
+
+			uint8_t* result = &m_page[page][m_pos % MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE];
+			m_pos += _size;
+			return result;
+		}
+
+		uint8_t** m_page;
+		uint32_t m_numPages;
 	};
+
+	BX_STATIC_ASSERT(bx::isPowerOf2(MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE));
 }
@@ -4,6 +4,9 @@ namespace mygfx
 {
 	Context::Context() : m_render(&m_frame[0])
 		, m_submit(&m_frame[MYGFX_CONFIG_MULTITHREADED ? 1 : 0])
+		, m_tempKeys(NULL)
+		, m_tempValues(NULL)
+		, m_tempCapacity(0)
 		, m_numFreeDynamicIndexBufferHandles(0)
 		, m_numFreeDynamicVertexBufferHandles(0)
 		, m_numFreeOcclusionQueryHandles(0)
@@ -204,7 +207,7 @@ namespace mygfx
 			VertexDeclHandle declHandle = findVertexDecl(_decl);
 			if (!isValid(declHandle))
 			{
-				BX_TRACE("WARNING: Failed to allocate vertex decl handle (BGFX_CONFIG_MAX_VERTEX_DECLS, max: %d).", MYGFX_CONFIG_MAX_VERTEX_DECLS);
+				BX_TRACE("WARNING: Failed to allocate vertex decl handle (MYGFX_CONFIG_MAX_VERTEX_DECLS, max: %d).", MYGFX_CONFIG_MAX_VERTEX_DECLS);
 				m_vertexBufferHandle.free(handle.idx);
 				return MYGFX_INVALID_HANDLE;
 			}
@@ -224,7 +227,7 @@ namespace mygfx
 			return handle;
 		}
 
-		BX_TRACE("WARNING: Failed to allocate vertex buffer handle (BGFX_CONFIG_MAX_VERTEX_BUFFERS, max: %d).", BGFX_CONFIG_MAX_VERTEX_BUFFERS);
+		BX_TRACE("WARNING: Failed to allocate vertex buffer handle (MYGFX_CONFIG_MAX_VERTEX_BUFFERS, max: %d).", MYGFX_CONFIG_MAX_VERTEX_BUFFERS);
 		release(_mem);
 
 		return MYGFX_INVALID_HANDLE;
@@ -364,14 +367,14 @@ namespace mygfx
 		VertexDeclHandle declHandle = findVertexDecl(_decl);
 		if (!isValid(declHandle))
 		{
-			BX_TRACE("WARNING: Failed to allocate vertex decl handle (BGFX_CONFIG_MAX_VERTEX_DECLS, max: %d).", MYGFX_CONFIG_MAX_VERTEX_DECLS);
+			BX_TRACE("WARNING: Failed to allocate vertex decl handle (MYGFX_CONFIG_MAX_VERTEX_DECLS, max: %d).", MYGFX_CONFIG_MAX_VERTEX_DECLS);
 			return MYGFX_INVALID_HANDLE;
 		}
 
 		DynamicVertexBufferHandle handle = { m_dynamicVertexBufferHandle.alloc() };
 		if (!isValid(handle))
 		{
-			BX_TRACE("WARNING: Failed to allocate dynamic vertex buffer handle (BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS, max: %d).", BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS);
+			BX_TRACE("WARNING: Failed to allocate dynamic vertex buffer handle (MYGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS, max: %d).", MYGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS);
 			return MYGFX_INVALID_HANDLE;
 		}
 
@@ -384,7 +387,7 @@ namespace mygfx
 			if (!isValid(vertexBufferHandle))
 			{
 				m_dynamicVertexBufferHandle.free(handle.idx);
-				BX_TRACE("WARNING: Failed to allocate vertex buffer handle (BGFX_CONFIG_MAX_VERTEX_BUFFERS, max: %d).", BGFX_CONFIG_MAX_VERTEX_BUFFERS);
+				BX_TRACE("WARNING: Failed to allocate vertex buffer handle (MYGFX_CONFIG_MAX_VERTEX_BUFFERS, max: %d).", MYGFX_CONFIG_MAX_VERTEX_BUFFERS);
 				return MYGFX_INVALID_HANDLE;
 			}
 
@@ -1651,4 +1654,1387 @@ namespace mygfx
 		return ptr;
 	}
 
-}
\ No newline at end of file
+	static TextureFormat::Enum s_emulatedFormats[] =
+	{
+		TextureFormat::BC1,
+		TextureFormat::BC2,
+		TextureFormat::BC3,
+		TextureFormat::BC4,
+		TextureFormat::BC5,
+		TextureFormat::ETC1,
+		TextureFormat::ETC2,
+		TextureFormat::ETC2A,
+		TextureFormat::ETC2A1,
+		TextureFormat::PTC12,
+		TextureFormat::PTC14,
+		TextureFormat::PTC12A,
+		TextureFormat::PTC14A,
+		TextureFormat::PTC22,
+		TextureFormat::PTC24,
+		TextureFormat::ATC,
+		TextureFormat::ATCE,
+		TextureFormat::ATCI,
+		TextureFormat::ASTC4x4,
+		TextureFormat::ASTC5x5,
+		TextureFormat::ASTC6x6,
+		TextureFormat::ASTC8x5,
+		TextureFormat::ASTC8x6,
+		TextureFormat::ASTC10x5,
+		TextureFormat::BGRA8, // GL doesn't support BGRA8 without extensions.
+		TextureFormat::RGBA8, // D3D9 doesn't support RGBA8
+	};
+
+	bool Context::init(const Init& _init)
+	{
+		BX_CHECK(!m_rendererInitialized, "Already initialized?");
+
+		m_init = _init;
+		m_init.resolution.reset &= ~MYGFX_RESET_INTERNAL_FORCE;
+
+		if (g_platformData.ndt          == NULL
+		&&  g_platformData.nwh          == NULL
+		&&  g_platformData.context      == NULL
+		&&  g_platformData.backBuffer   == NULL
+		&&  g_platformData.backBufferDS == NULL)
+		{
+			bx::memCopy(&g_platformData, &m_init.platformData, sizeof(PlatformData) );
+		}
+		else
+		{
+			bx::memCopy(&m_init.platformData, &g_platformData, sizeof(PlatformData) );
+		}
+
+		m_exit    = false;
+		m_flipped = true;
+		m_frames  = 0;
+		m_debug   = MYGFX_DEBUG_NONE;
+		m_frameTimeLast = bx::getHPCounter();
+
+		m_submit->create();
+
+#if MYGFX_CONFIG_MULTITHREADED
+		m_render->create();
+
+		if (s_renderFrameCalled)
+		{
+			// When mygfx::renderFrame is called before init render thread
+			// should not be created.
+			BX_TRACE("Application called mygfx::renderFrame directly, not creating render thread.");
+			m_singleThreaded = true
+				&& ~MYGFX_API_THREAD_MAGIC == s_threadIndex
+				;
+		}
+		else
+		{
+			BX_TRACE("Creating rendering thread.");
+			m_thread.init(renderThread, this, 0, "mygfx - renderer backend thread");
+			m_singleThreaded = false;
+		}
+#else
+		BX_TRACE("Multithreaded renderer is disabled.");
+		m_singleThreaded = true;
+#endif // MYGFX_CONFIG_MULTITHREADED
+
+		BX_TRACE("Running in %s-threaded mode", m_singleThreaded ? "single" : "multi");
+
+		s_threadIndex = MYGFX_API_THREAD_MAGIC;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_viewRemap); ++ii)
+		{
+			m_viewRemap[ii] = ViewId(ii);
+		}
+
+		for (uint32_t ii = 0; ii < MYGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			resetView(ViewId(ii) );
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_clearColor); ++ii)
+		{
+			m_clearColor[ii][0] = 0.0f;
+			m_clearColor[ii][1] = 0.0f;
+			m_clearColor[ii][2] = 0.0f;
+			m_clearColor[ii][3] = 1.0f;
+		}
+
+		m_declRef.init();
+
+		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
+		cmdbuf.write(_init);
+
+		frameNoRenderWait();
+
+		m_encoderHandle = bx::createHandleAlloc(g_allocator, _init.limits.maxEncoders);
+		m_encoder       = (EncoderImpl*)BX_ALLOC(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders);
+		m_encoderStats  = (EncoderStats*)BX_ALLOC(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
+		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
+		{
+			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
+		}
+
+		uint16_t idx = m_encoderHandle->alloc();
+		BX_CHECK(0 == idx, "Internal encoder handle is not 0 (idx %d).", idx); BX_UNUSED(idx);
+		m_encoder[0].begin(m_submit, 0);
+		m_encoder0 = reinterpret_cast<Encoder*>(&m_encoder[0]);
+
+		// Make sure renderer init is called from render thread.
+		// g_caps is initialized and available after this point.
+		frame();
+
+		if (!m_rendererInitialized)
+		{
+			getCommandBuffer(CommandBuffer::RendererShutdownEnd);
+			frame();
+			frame();
+			m_declRef.shutdown(m_vertexDeclHandle);
+			m_submit->destroy();
+#if MYGFX_CONFIG_MULTITHREADED
+			m_render->destroy();
+#endif // MYGFX_CONFIG_MULTITHREADED
+			freeTempKeys();
+			return false;
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(s_emulatedFormats); ++ii)
+		{
+			const uint32_t fmt = s_emulatedFormats[ii];
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & MYGFX_CAPS_FORMAT_TEXTURE_2D  ) ? MYGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & MYGFX_CAPS_FORMAT_TEXTURE_3D  ) ? MYGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
+			g_caps.formats[fmt] |= 0 == (g_caps.formats[fmt] & MYGFX_CAPS_FORMAT_TEXTURE_CUBE) ? MYGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+		}
+
+		for (uint32_t ii = 0; ii < TextureFormat::UnknownDepth; ++ii)
+		{
+			bool convertable = bimg::imageConvert(bimg::TextureFormat::BGRA8, bimg::TextureFormat::Enum(ii) );
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & MYGFX_CAPS_FORMAT_TEXTURE_2D  ) && convertable ? MYGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED   : 0;
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & MYGFX_CAPS_FORMAT_TEXTURE_3D  ) && convertable ? MYGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED   : 0;
+			g_caps.formats[ii] |= 0 == (g_caps.formats[ii] & MYGFX_CAPS_FORMAT_TEXTURE_CUBE) && convertable ? MYGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED : 0;
+		}
+
+		g_caps.rendererType = m_renderCtx->getRendererType();
+		initAttribTypeSizeTable(g_caps.rendererType);
+
+		g_caps.supported |= 0
+			| (BX_ENABLED(MYGFX_CONFIG_MULTITHREADED) && !m_singleThreaded ? MYGFX_CAPS_RENDERER_MULTITHREADED : 0)
+			| (isGraphicsDebuggerPresent() ? MYGFX_CAPS_GRAPHICS_DEBUGGER : 0)
+			;
+
+		m_textVideoMemBlitter.init();
+		m_clearQuad.init();
+
+		m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
+		m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+		frame();
+
+		if (BX_ENABLED(MYGFX_CONFIG_MULTITHREADED) )
+		{
+			m_submit->m_transientVb = createTransientVertexBuffer(_init.limits.transientVbSize);
+			m_submit->m_transientIb = createTransientIndexBuffer(_init.limits.transientIbSize);
+			frame();
+		}
+
+		g_internalData.caps = getCaps();
+
+		return true;
+	}
+
+	void Context::shutdown()
+	{
+		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
+		frame();
+
+		destroyTransientVertexBuffer(m_submit->m_transientVb);
+		destroyTransientIndexBuffer(m_submit->m_transientIb);
+		m_textVideoMemBlitter.shutdown();
+		m_clearQuad.shutdown();
+		frame();
+
+		if (BX_ENABLED(MYGFX_CONFIG_MULTITHREADED) )
+		{
+			destroyTransientVertexBuffer(m_submit->m_transientVb);
+			destroyTransientIndexBuffer(m_submit->m_transientIb);
+			frame();
+		}
+
+		frame(); // If any VertexDecls needs to be destroyed.
+
+		getCommandBuffer(CommandBuffer::RendererShutdownEnd);
+		frame();
+
+		m_encoder[0].end(true);
+		m_encoderHandle->free(0);
+		bx::destroyHandleAlloc(g_allocator, m_encoderHandle);
+		m_encoderHandle = NULL;
+
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+		{
+			m_encoder[ii].~EncoderImpl();
+		}
+		BX_FREE(g_allocator, m_encoder);
+		BX_FREE(g_allocator, m_encoderStats);
+
+		m_dynVertexBufferAllocator.compact();
+		m_dynIndexBufferAllocator.compact();
+
+		BX_CHECK(m_vertexDeclHandle.getNumHandles() == m_declRef.m_vertexDeclMap.getNumElements()
+				, "VertexDeclRef mismatch, num handles %d, handles in hash map %d."
+				, m_vertexDeclHandle.getNumHandles()
+				, m_declRef.m_vertexDeclMap.getNumElements()
+				);
+
+		m_declRef.shutdown(m_vertexDeclHandle);
+
+#if MYGFX_CONFIG_MULTITHREADED
+		// Render thread shutdown sequence.
+		renderSemWait(); // Wait for previous frame.
+		apiSemPost();   // OK to set context to NULL.
+		// s_ctx is NULL here.
+		renderSemWait(); // In RenderFrame::Exiting state.
+
+		if (m_thread.isRunning() )
+		{
+			m_thread.shutdown();
+		}
+
+		m_render->destroy();
+#endif // MYGFX_CONFIG_MULTITHREADED
+
+		bx::memSet(&g_internalData, 0, sizeof(InternalData) );
+		s_ctx = NULL;
+
+		m_submit->destroy();
+		freeTempKeys();
+
+		if (BX_ENABLED(MYGFX_CONFIG_DEBUG) )
+		{
+#define CHECK_HANDLE_LEAK(_handleAlloc)                                               \
+	BX_MACRO_BLOCK_BEGIN                                                              \
+		if (0 != _handleAlloc.getNumHandles() )                                       \
+		{                                                                             \
+			BX_TRACE("LEAK: " #_handleAlloc " %d (max: %d)"                           \
+				, _handleAlloc.getNumHandles()                                        \
+				, _handleAlloc.getMaxHandles()                                        \
+				);                                                                    \
+			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
+			{                                                                         \
+				BX_TRACE("\t%3d: %4d", ii, _handleAlloc.getHandleAt(ii) );            \
+			}                                                                         \
+		}                                                                             \
+	BX_MACRO_BLOCK_END
+
+#define CHECK_HANDLE_LEAK_NAME(_handleAlloc, _type, _ref)                             \
+	BX_MACRO_BLOCK_BEGIN                                                              \
+		if (0 != _handleAlloc.getNumHandles() )                                       \
+		{                                                                             \
+			BX_TRACE("LEAK: " #_handleAlloc " %d (max: %d)"                           \
+				, _handleAlloc.getNumHandles()                                        \
+				, _handleAlloc.getMaxHandles()                                        \
+				);                                                                    \
+			for (uint16_t ii = 0, num = _handleAlloc.getNumHandles(); ii < num; ++ii) \
+			{                                                                         \
+				uint16_t idx = _handleAlloc.getHandleAt(ii);                          \
+				const _type& ref = _ref[idx]; BX_UNUSED(ref);                         \
+				BX_TRACE("\t%3d: %4d %s (count %d)"                                   \
+						, ii                                                          \
+						, idx                                                         \
+						, ref.m_name.getPtr()                                         \
+						, ref.m_refCount                                              \
+						);                                                            \
+			}                                                                         \
+		}                                                                             \
+	BX_MACRO_BLOCK_END
+
+			CHECK_HANDLE_LEAK     (m_dynamicIndexBufferHandle                          );
+			CHECK_HANDLE_LEAK     (m_dynamicVertexBufferHandle                         );
+			CHECK_HANDLE_LEAK     (m_indexBufferHandle                                 );
+			CHECK_HANDLE_LEAK     (m_vertexDeclHandle                                  );
+			CHECK_HANDLE_LEAK     (m_vertexBufferHandle                                );
+			CHECK_HANDLE_LEAK_NAME(m_shaderHandle,             ShaderRef,  m_shaderRef );
+			CHECK_HANDLE_LEAK     (m_programHandle                                     );
+			CHECK_HANDLE_LEAK_NAME(m_textureHandle,            TextureRef, m_textureRef);
+			CHECK_HANDLE_LEAK     (m_frameBufferHandle                                 );
+			CHECK_HANDLE_LEAK_NAME(m_uniformHandle,            UniformRef, m_uniformRef);
+			CHECK_HANDLE_LEAK     (m_occlusionQueryHandle                              );
+#undef CHECK_HANDLE_LEAK
+#undef CHECK_HANDLE_LEAK_NAME
+		}
+	}
+
+	void Context::freeDynamicBuffers()
+	{
+		for (uint16_t ii = 0, num = m_numFreeDynamicIndexBufferHandles; ii < num; ++ii)
+		{
+			destroyDynamicIndexBufferInternal(m_freeDynamicIndexBufferHandle[ii]);
+		}
+		m_numFreeDynamicIndexBufferHandles = 0;
+
+		for (uint16_t ii = 0, num = m_numFreeDynamicVertexBufferHandles; ii < num; ++ii)
+		{
+			destroyDynamicVertexBufferInternal(m_freeDynamicVertexBufferHandle[ii]);
+		}
+		m_numFreeDynamicVertexBufferHandles = 0;
+
+		for (uint16_t ii = 0, num = m_numFreeOcclusionQueryHandles; ii < num; ++ii)
+		{
+			m_occlusionQueryHandle.free(m_freeOcclusionQueryHandle[ii].idx);
+		}
+		m_numFreeOcclusionQueryHandles = 0;
+	}
+
+	void Context::freeAllHandles(Frame* _frame)
+	{
+		for (uint16_t ii = 0, num = _frame->m_freeIndexBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			m_indexBufferHandle.free(_frame->m_freeIndexBuffer.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeVertexBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			destroyVertexBufferInternal(_frame->m_freeVertexBuffer.get(ii));
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeVertexDecl.getNumQueued(); ii < num; ++ii)
+		{
+			m_vertexDeclHandle.free(_frame->m_freeVertexDecl.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeShader.getNumQueued(); ii < num; ++ii)
+		{
+			m_shaderHandle.free(_frame->m_freeShader.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeProgram.getNumQueued(); ii < num; ++ii)
+		{
+			m_programHandle.free(_frame->m_freeProgram.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeTexture.getNumQueued(); ii < num; ++ii)
+		{
+			m_textureHandle.free(_frame->m_freeTexture.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeFrameBuffer.getNumQueued(); ii < num; ++ii)
+		{
+			m_frameBufferHandle.free(_frame->m_freeFrameBuffer.get(ii).idx);
+		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeUniform.getNumQueued(); ii < num; ++ii)
+		{
+			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
+		}
+	}
+
+	Encoder* Context::begin(bool _forThread)
+	{
+		EncoderImpl* encoder = &m_encoder[0];
+
+#if MYGFX_CONFIG_MULTITHREADED
+		if (_forThread || MYGFX_API_THREAD_MAGIC != s_threadIndex)
+		{
+			bx::MutexScope scopeLock(m_encoderApiLock);
+
+			uint16_t idx = m_encoderHandle->alloc();
+			if (kInvalidHandle == idx)
+			{
+				return NULL;
+			}
+
+			encoder = &m_encoder[idx];
+			encoder->begin(m_submit, uint8_t(idx) );
+		}
+#else
+		BX_UNUSED(_forThread);
+#endif // MYGFX_CONFIG_MULTITHREADED
+
+		return reinterpret_cast<Encoder*>(encoder);
+	}
+
+	void Context::end(Encoder* _encoder)
+	{
+#if MYGFX_CONFIG_MULTITHREADED
+		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
+		if (encoder != &m_encoder[0])
+		{
+			encoder->end(true);
+			m_encoderEndSem.post();
+		}
+#else
+		BX_UNUSED(_encoder);
+#endif // MYGFX_CONFIG_MULTITHREADED
+	}
+
+	uint32_t Context::frame(bool _capture)
+	{
+		m_encoder[0].end(true);
+
+#if MYGFX_CONFIG_MULTITHREADED
+		bx::MutexScope resourceApiScope(m_resourceApiLock);
+
+		encoderApiWait();
+		bx::MutexScope encoderApiScope(m_encoderApiLock);
+#else
+		encoderApiWait();
+#endif // MYGFX_CONFIG_MULTITHREADED
+
+		m_submit->m_capture = _capture;
+
+		MYGFX_PROFILER_SCOPE("mygfx/API thread frame", 0xff2040ff);
+		// wait for render thread to finish
+		renderSemWait();
+		frameNoRenderWait();
+
+		m_encoder[0].begin(m_submit, 0);
+
+		return m_frames;
+	}
+
+	void Context::frameNoRenderWait()
+	{
+		swap();
+
+		// release render thread
+		apiSemPost();
+	}
+
+	void Context::swap()
+	{
+		freeDynamicBuffers();
+		m_submit->m_resolution = m_init.resolution;
+		m_init.resolution.reset &= ~MYGFX_RESET_INTERNAL_FORCE;
+		m_submit->m_debug = m_debug;
+		m_submit->m_perfStats.numViews = 0;
+
+		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
+		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
+
+		if (m_colorPaletteDirty > 0)
+		{
+			--m_colorPaletteDirty;
+			bx::memCopy(m_submit->m_colorPalette, m_clearColor, sizeof(m_clearColor) );
+		}
+
+		freeAllHandles(m_submit);
+		m_submit->resetFreeHandles();
+
+		m_submit->finish();
+
+		bx::xchg(m_render, m_submit);
+
+		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
+
+		if (!BX_ENABLED(MYGFX_CONFIG_MULTITHREADED)
+		||  m_singleThreaded)
+		{
+			renderFrame();
+		}
+
+		m_frames++;
+		m_submit->start();
+
+		bx::memSet(m_seq, 0, sizeof(m_seq) );
+
+		m_submit->m_textVideoMem->resize(
+			  m_render->m_textVideoMem->m_small
+			, m_init.resolution.width
+			, m_init.resolution.height
+			);
+
+		int64_t now = bx::getHPCounter();
+		m_submit->m_perfStats.cpuTimeFrame = now - m_frameTimeLast;
+		m_frameTimeLast = now;
+	}
+
+	RendererContextI* rendererCreate(const Init& _init);
+
+	void rendererDestroy(RendererContextI* _renderCtx);
+
+	void Context::flip()
+	{
+		if (m_rendererInitialized
+		&& !m_flipped)
+		{
+			m_renderCtx->flip();
+			m_flipped = true;
+
+			if (m_renderCtx->isDeviceRemoved() )
+			{
+				// Something horribly went wrong, fallback to noop renderer.
+				rendererDestroy(m_renderCtx);
+
+				Init init;
+				init.type = RendererType::Noop;
+				m_renderCtx = rendererCreate(init);
+				g_caps.rendererType = RendererType::Noop;
+			}
+		}
+	}
+
+	RenderFrame::Enum Context::renderFrame(int32_t _msecs)
+	{
+		MYGFX_PROFILER_SCOPE("mygfx::renderFrame", 0xff2040ff);
+
+		if (!m_flipAfterRender)
+		{
+			MYGFX_PROFILER_SCOPE("mygfx/flip", 0xff2040ff);
+			flip();
+		}
+
+		if (apiSemWait(_msecs) )
+		{
+			{
+				MYGFX_PROFILER_SCOPE("mygfx/Exec commands pre", 0xff2040ff);
+				rendererExecCommands(m_render->m_cmdPre);
+			}
+
+			if (m_rendererInitialized)
+			{
+				MYGFX_PROFILER_SCOPE("mygfx/Render submit", 0xff2040ff);
+				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
+				m_flipped = false;
+			}
+
+			{
+				MYGFX_PROFILER_SCOPE("mygfx/Exec commands post", 0xff2040ff);
+				rendererExecCommands(m_render->m_cmdPost);
+			}
+
+			renderSemPost();
+
+			if (m_flipAfterRender)
+			{
+				MYGFX_PROFILER_SCOPE("mygfx/flip", 0xff2040ff);
+				flip();
+			}
+		}
+		else
+		{
+			return RenderFrame::Timeout;
+		}
+
+		return m_exit
+			? RenderFrame::Exiting
+			: RenderFrame::Render
+			;
+	}
+
+	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	{
+		_uniformBuffer->reset(_begin);
+		while (_uniformBuffer->getPos() < _end)
+		{
+			uint32_t opcode = _uniformBuffer->read();
+
+			if (UniformType::End == opcode)
+			{
+				break;
+			}
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			uint32_t size = g_uniformTypeSize[type]*num;
+			const char* data = _uniformBuffer->read(size);
+			if (UniformType::Count > type)
+			{
+				if (copy)
+				{
+					_renderCtx->updateUniform(loc, data, size);
+				}
+				else
+				{
+					_renderCtx->updateUniform(loc, *(const char**)(data), size);
+				}
+			}
+			else
+			{
+				_renderCtx->setMarker(data, size);
+			}
+		}
+	}
+
+	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
+	{
+		if (m_textureUpdateBatch.sort() )
+		{
+			const uint32_t pos = _cmdbuf.m_pos;
+
+			uint32_t currentKey = UINT32_MAX;
+
+			for (uint32_t ii = 0, num = m_textureUpdateBatch.m_num; ii < num; ++ii)
+			{
+				_cmdbuf.m_pos = m_textureUpdateBatch.m_values[ii];
+
+				TextureHandle handle;
+				_cmdbuf.read(handle);
+
+				uint8_t side;
+				_cmdbuf.read(side);
+
+				uint8_t mip;
+				_cmdbuf.read(mip);
+
+				Rect rect;
+				_cmdbuf.read(rect);
+
+				uint16_t zz;
+				_cmdbuf.read(zz);
+
+				uint16_t depth;
+				_cmdbuf.read(depth);
+
+				uint16_t pitch;
+				_cmdbuf.read(pitch);
+
+				const Memory* mem;
+				_cmdbuf.read(mem);
+
+				uint32_t key = m_textureUpdateBatch.m_keys[ii];
+				if (key != currentKey)
+				{
+					if (currentKey != UINT32_MAX)
+					{
+						m_renderCtx->updateTextureEnd();
+					}
+					currentKey = key;
+					m_renderCtx->updateTextureBegin(handle, side, mip);
+				}
+
+				m_renderCtx->updateTexture(handle, side, mip, rect, zz, depth, pitch, mem);
+
+				release(mem);
+			}
+
+			if (currentKey != UINT32_MAX)
+			{
+				m_renderCtx->updateTextureEnd();
+			}
+
+			m_textureUpdateBatch.reset();
+
+			_cmdbuf.m_pos = pos;
+		}
+	}
+
+	typedef RendererContextI* (*RendererCreateFn)(const Init& _init);
+	typedef void (*RendererDestroyFn)();
+
+#define MYGFX_RENDERER_CONTEXT(_namespace)                           \
+	namespace _namespace                                            \
+	{                                                               \
+		extern RendererContextI* rendererCreate(const Init& _init); \
+		extern void rendererDestroy();                              \
+	}
+
+	MYGFX_RENDERER_CONTEXT(noop);
+
+#undef MYGFX_RENDERER_CONTEXT
+
+	struct RendererCreator
+	{
+		RendererCreateFn  createFn;
+		RendererDestroyFn destroyFn;
+		const char* name;
+		bool supported;
+	};
+
+	// Only the noop renderer is ported so far, remaining backends are listed
+	// as unsupported until their RendererContextI implementation lands.
+	static RendererCreator s_rendererCreator[] =
+	{
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_NOOP_NAME,       true  }, // Noop
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_DIRECT3D9_NAME,  false }, // Direct3D9
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_DIRECT3D11_NAME, false }, // Direct3D11
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_DIRECT3D12_NAME, false }, // Direct3D12
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_METAL_NAME,      false }, // Metal
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_OPENGL_NAME,     false }, // OpenGLES
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_OPENGL_NAME,     false }, // OpenGL
+		{ noop::rendererCreate,  noop::rendererDestroy,  MYGFX_RENDERER_VULKAN_NAME,     false }, // Vulkan
+	};
+	BX_STATIC_ASSERT(BX_COUNTOF(s_rendererCreator) == RendererType::Count);
+
+	static int32_t compareDescending(const void* _lhs, const void* _rhs)
+	{
+		return *(const int32_t*)_rhs - *(const int32_t*)_lhs;
+	}
+
+	RendererContextI* rendererCreate(const Init& _init)
+	{
+		int32_t scores[RendererType::Count];
+		uint32_t numScores = 0;
+
+		for (uint32_t ii = 0; ii < RendererType::Count; ++ii)
+		{
+			RendererType::Enum renderer = RendererType::Enum(ii);
+			if (s_rendererCreator[ii].supported)
+			{
+				int32_t score = 0;
+				if (_init.type == renderer)
+				{
+					score += 1000;
+				}
+
+				score += RendererType::Noop != renderer ? 1 : 0;
+
+				if (BX_ENABLED(BX_PLATFORM_WINDOWS) )
+				{
+					if (windowsVersionIs(Condition::GreaterEqual, 0x0602) )
+					{
+						score += RendererType::Direct3D11 == renderer ? 20 : 0;
+						score += RendererType::Direct3D12 == renderer ? 10 : 0;
+					}
+					else if (windowsVersionIs(Condition::GreaterEqual, 0x0601) )
+					{
+						score += RendererType::Direct3D11 == renderer ?   20 : 0;
+						score += RendererType::Direct3D9  == renderer ?   10 : 0;
+						score += RendererType::Direct3D12 == renderer ? -100 : 0;
+					}
+					else
+					{
+						score += RendererType::Direct3D12 == renderer ? -100 : 0;
+					}
+				}
+				else if (BX_ENABLED(BX_PLATFORM_LINUX) )
+				{
+					score += RendererType::OpenGL   == renderer ? 20 : 0;
+					score += RendererType::OpenGLES == renderer ? 10 : 0;
+				}
+				else if (BX_ENABLED(BX_PLATFORM_OSX) )
+				{
+					score += RendererType::Metal    == renderer ? 20 : 0;
+					score += RendererType::OpenGL   == renderer ? 10 : 0;
+				}
+				else if (BX_ENABLED(BX_PLATFORM_IOS) )
+				{
+					score += RendererType::Metal    == renderer ? 20 : 0;
+					score += RendererType::OpenGLES == renderer ? 10 : 0;
+				}
+				else if (BX_ENABLED(0
+					 ||  BX_PLATFORM_ANDROID
+					 ||  BX_PLATFORM_EMSCRIPTEN
+					 ||  BX_PLATFORM_RPI
+					 ) )
+				{
+					score += RendererType::OpenGLES == renderer ? 20 : 0;
+				}
+				else if (BX_ENABLED(0
+					 ||  BX_PLATFORM_XBOXONE
+					 ||  BX_PLATFORM_WINRT
+					 ) )
+				{
+					score += RendererType::Direct3D12 == renderer ? 20 : 0;
+					score += RendererType::Direct3D11 == renderer ? 10 : 0;
+				}
+
+				scores[numScores++] = (score<<8) | uint8_t(renderer);
+			}
+		}
+
+		bx::quickSort(scores, numScores, sizeof(int32_t), compareDescending);
+
+		RendererContextI* renderCtx = NULL;
+		for (uint32_t ii = 0; ii < numScores; ++ii)
+		{
+			RendererType::Enum renderer = RendererType::Enum(scores[ii] & 0xff);
+			renderCtx = s_rendererCreator[renderer].createFn(_init);
+			if (NULL != renderCtx)
+			{
+				break;
+			}
+
+			s_rendererCreator[renderer].supported = false;
+		}
+
+		return renderCtx;
+	}
+
+	void rendererDestroy(RendererContextI* _renderCtx)
+	{
+		if (NULL != _renderCtx)
+		{
+			s_rendererCreator[_renderCtx->getRendererType()].destroyFn();
+		}
+	}
+
+	uint8_t getSupportedRenderers(uint8_t _max, RendererType::Enum* _enum)
+	{
+		_enum = _max == 0 ? NULL : _enum;
+
+		uint8_t num = 0;
+		for (uint8_t ii = 0; ii < RendererType::Count; ++ii)
+		{
+			if ( (RendererType::Direct3D11 == ii || RendererType::Direct3D12 == ii)
+			&&  windowsVersionIs(Condition::LessEqual, 0x0502) )
+			{
+				continue;
+			}
+
+			if (NULL == _enum)
+			{
+				num++;
+			}
+			else
+			{
+				if (num < _max
+				&&  s_rendererCreator[ii].supported)
+				{
+					_enum[num++] = RendererType::Enum(ii);
+				}
+			}
+		}
+
+		return num;
+	}
+
+	const char* getRendererName(RendererType::Enum _type)
+	{
+		BX_CHECK(_type < RendererType::Count, "Invalid renderer type %d.", _type);
+		return s_rendererCreator[_type].name;
+	}
+
+	void Context::rendererExecCommands(CommandBuffer& _cmdbuf)
+	{
+		_cmdbuf.reset();
+
+		bool end = false;
+
+		if (NULL == m_renderCtx)
+		{
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			switch (command)
+			{
+			case CommandBuffer::RendererShutdownEnd:
+				m_exit = true;
+				return;
+
+			case CommandBuffer::End:
+				return;
+
+			default:
+				{
+					BX_CHECK(CommandBuffer::RendererInit == command
+						, "RendererInit must be the first command in command buffer before initialization. Unexpected command %d?"
+						, command
+						);
+					BX_CHECK(!m_rendererInitialized, "This shouldn't happen! Bad synchronization?");
+
+					Init init;
+					_cmdbuf.read(init);
+
+					m_renderCtx = rendererCreate(init);
+
+					m_rendererInitialized = NULL != m_renderCtx;
+
+					if (!m_rendererInitialized)
+					{
+						_cmdbuf.read(command);
+						BX_CHECK(CommandBuffer::End == command, "Unexpected command %d?"
+							, command
+							);
+						return;
+					}
+				}
+				break;
+			}
+		}
+
+		do
+		{
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			switch (command)
+			{
+			case CommandBuffer::RendererShutdownBegin:
+				{
+					BX_CHECK(m_rendererInitialized, "This shouldn't happen! Bad synchronization?");
+					m_rendererInitialized = false;
+				}
+				break;
+
+			case CommandBuffer::RendererShutdownEnd:
+				{
+					BX_CHECK(!m_rendererInitialized && !m_exit, "This shouldn't happen! Bad synchronization?");
+
+					rendererDestroy(m_renderCtx);
+					m_renderCtx = NULL;
+
+					m_exit = true;
+				}
+				BX_FALLTHROUGH;
+
+			case CommandBuffer::End:
+				end = true;
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					m_renderCtx->createIndexBuffer(handle, mem, flags);
+
+					release(mem);
+				}
+				break;
+
+			case CommandBuffer::DestroyIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyIndexBuffer(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateVertexDecl:
+				{
+					VertexDeclHandle handle;
+					_cmdbuf.read(handle);
+
+					VertexDecl decl;
+					_cmdbuf.read(decl);
+
+					m_renderCtx->createVertexDecl(handle, decl);
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexDecl:
+				{
+					VertexDeclHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyVertexDecl(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					VertexDeclHandle declHandle;
+					_cmdbuf.read(declHandle);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					m_renderCtx->createVertexBuffer(handle, mem, declHandle, flags);
+
+					release(mem);
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyVertexBuffer(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					m_renderCtx->createDynamicIndexBuffer(handle, size, flags);
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					uint32_t offset;
+					_cmdbuf.read(offset);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					m_renderCtx->updateDynamicIndexBuffer(handle, offset, size, mem);
+
+					release(mem);
+				}
+				break;
+
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyDynamicIndexBuffer(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					uint16_t flags;
+					_cmdbuf.read(flags);
+
+					m_renderCtx->createDynamicVertexBuffer(handle, size, flags);
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					uint32_t offset;
+					_cmdbuf.read(offset);
+
+					uint32_t size;
+					_cmdbuf.read(size);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					m_renderCtx->updateDynamicVertexBuffer(handle, offset, size, mem);
+
+					release(mem);
+				}
+				break;
+
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyDynamicVertexBuffer(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					ShaderHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					m_renderCtx->createShader(handle, mem);
+
+					release(mem);
+				}
+				break;
+
+			case CommandBuffer::DestroyShader:
+				{
+					ShaderHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyShader(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				{
+					ProgramHandle handle;
+					_cmdbuf.read(handle);
+
+					ShaderHandle vsh;
+					_cmdbuf.read(vsh);
+
+					ShaderHandle fsh;
+					_cmdbuf.read(fsh);
+
+					m_renderCtx->createProgram(handle, vsh, fsh);
+				}
+				break;
+
+			case CommandBuffer::DestroyProgram:
+				{
+					ProgramHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyProgram(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					const Memory* mem;
+					_cmdbuf.read(mem);
+
+					uint64_t flags;
+					_cmdbuf.read(flags);
+
+					uint8_t skip;
+					_cmdbuf.read(skip);
+
+					void* ptr = m_renderCtx->createTexture(handle, mem, flags, skip);
+					if (NULL != ptr)
+					{
+						setDirectAccessPtr(handle, ptr);
+					}
+
+					bx::MemoryReader reader(mem->data, mem->size);
+
+					uint32_t magic;
+					bx::read(&reader, magic);
+
+					if (MYGFX_CHUNK_MAGIC_TEX == magic)
+					{
+						TextureCreate tc;
+						bx::read(&reader, tc);
+
+						if (NULL != tc.m_mem)
+						{
+							release(tc.m_mem);
+						}
+					}
+
+					release(mem);
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					if (m_textureUpdateBatch.isFull() )
+					{
+						flushTextureUpdateBatch(_cmdbuf);
+					}
+
+					uint32_t value = _cmdbuf.m_pos;
+
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint8_t side;
+					_cmdbuf.read(side);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+
+					_cmdbuf.skip<Rect>();
+					_cmdbuf.skip<uint16_t>();
+					_cmdbuf.skip<uint16_t>();
+					_cmdbuf.skip<uint16_t>();
+					_cmdbuf.skip<Memory*>();
+
+					uint32_t key = (handle.idx<<16)
+						| (side<<8)
+						| mip
+						;
+
+					m_textureUpdateBatch.add(key, value);
+				}
+				break;
+
+			case CommandBuffer::ReadTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					void* data;
+					_cmdbuf.read(data);
+
+					uint8_t mip;
+					_cmdbuf.read(mip);
+
+					m_renderCtx->readTexture(handle, data, mip);
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t width;
+					_cmdbuf.read(width);
+
+					uint16_t height;
+					_cmdbuf.read(height);
+
+					uint8_t numMips;
+					_cmdbuf.read(numMips);
+
+					uint16_t numLayers;
+					_cmdbuf.read(numLayers);
+
+					m_renderCtx->resizeTexture(handle, width, height, numMips, numLayers);
+				}
+				break;
+
+			case CommandBuffer::DestroyTexture:
+				{
+					TextureHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyTexture(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					bool window;
+					_cmdbuf.read(window);
+
+					if (window)
+					{
+						void* nwh;
+						_cmdbuf.read(nwh);
+
+						uint16_t width;
+						_cmdbuf.read(width);
+
+						uint16_t height;
+						_cmdbuf.read(height);
+
+						TextureFormat::Enum format;
+						_cmdbuf.read(format);
+
+						TextureFormat::Enum depthFormat;
+						_cmdbuf.read(depthFormat);
+
+						m_renderCtx->createFrameBuffer(handle, nwh, width, height, format, depthFormat);
+					}
+					else
+					{
+						uint8_t num;
+						_cmdbuf.read(num);
+
+						Attachment attachment[MYGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+						_cmdbuf.read(attachment, sizeof(Attachment) * num);
+
+						m_renderCtx->createFrameBuffer(handle, num, attachment);
+					}
+				}
+				break;
+
+			case CommandBuffer::DestroyFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyFrameBuffer(handle);
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					UniformHandle handle;
+					_cmdbuf.read(handle);
+
+					UniformType::Enum type;
+					_cmdbuf.read(type);
+
+					uint16_t num;
+					_cmdbuf.read(num);
+
+					uint8_t len;
+					_cmdbuf.read(len);
+
+					const char* name = (const char*)_cmdbuf.skip(len);
+
+					m_renderCtx->createUniform(handle, type, num, name);
+				}
+				break;
+
+			case CommandBuffer::DestroyUniform:
+				{
+					UniformHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->destroyUniform(handle);
+				}
+				break;
+
+			case CommandBuffer::RequestScreenShot:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					const char* filePath = (const char*)_cmdbuf.skip(len);
+
+					m_renderCtx->requestScreenShot(handle, filePath);
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					ViewId id;
+					_cmdbuf.read(id);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					const char* name = (const char*)_cmdbuf.skip(len);
+
+					m_renderCtx->updateViewName(id, name);
+				}
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+				{
+					OcclusionQueryHandle handle;
+					_cmdbuf.read(handle);
+
+					m_renderCtx->invalidateOcclusionQuery(handle);
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					Handle handle;
+					_cmdbuf.read(handle);
+
+					uint16_t len;
+					_cmdbuf.read(len);
+
+					const char* name = (const char*)_cmdbuf.skip(len);
+
+					m_renderCtx->setName(handle, name);
+				}
+				break;
+
+			default:
+				BX_CHECK(false, "Invalid command: %d", command);
+				break;
+			}
+		} while (!end);
+
+		flushTextureUpdateBatch(_cmdbuf);
+	}
+}
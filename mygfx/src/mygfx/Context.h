@@ -22,6 +22,15 @@ namespace mygfx
 		bool init(const Init& _init);
 		void shutdown();
 
+		void freeTempKeys()
+		{
+			BX_FREE(g_allocator, m_tempKeys);
+			BX_FREE(g_allocator, m_tempValues);
+			m_tempKeys = NULL;
+			m_tempValues = NULL;
+			m_tempCapacity = 0;
+		}
+
 		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd);
 
 		void reset(uint32_t _width, uint32_t _height, uint32_t _flags, TextureFormat::Enum _format);
@@ -340,7 +349,7 @@ namespace mygfx
 				return true;
 			}
 
-			MYGFX_PROFILER_SCOPE("bgfx/API thread wait", 0xff2040ff);
+			MYGFX_PROFILER_SCOPE("mygfx/API thread wait", 0xff2040ff);
 			int64_t start = bx::getHPCounter();
 			bool ok = m_apiSem.wait(_msecs);
 			if (ok)
@@ -365,7 +374,7 @@ namespace mygfx
 		{
 			if (!m_singleThreaded)
 			{
-				MYGFX_PROFILER_SCOPE("bgfx/Render thread wait", 0xff2040ff);
+				MYGFX_PROFILER_SCOPE("mygfx/Render thread wait", 0xff2040ff);
 				int64_t start = bx::getHPCounter();
 				bool ok = m_renderSem.wait();
 				BX_CHECK(ok, "Semaphore wait failed."); BX_UNUSED(ok);
@@ -440,8 +449,10 @@ namespace mygfx
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[MYGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[MYGFX_CONFIG_MAX_DRAW_CALLS];
+		// Radix sort scratch, grown by Frame::reserveSortKeys.
+		uint64_t* m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t m_tempCapacity;
 
 		IndexBuffer  m_indexBuffers[MYGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[MYGFX_CONFIG_MAX_VERTEX_BUFFERS];
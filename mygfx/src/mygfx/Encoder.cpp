@@ -0,0 +1,208 @@
+#include "mygfx_p.h"
+
+namespace mygfx
+{
+	uint32_t EncoderImpl::allocRenderItem()
+	{
+		const uint32_t max = g_caps.limits.maxDrawCalls - 1;
+		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, max);
+		if (max <= renderItemIdx)
+		{
+			return UINT32_MAX;
+		}
+
+		m_frame->allocRenderItemChunk(renderItemIdx);
+
+		return renderItemIdx;
+	}
+
+	void EncoderImpl::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState)
+	{
+		if (BX_ENABLED(MYGFX_CONFIG_DEBUG_UNIFORM)
+			&& !_preserveState)
+		{
+			m_uniformSet.clear();
+		}
+
+		if (BX_ENABLED(MYGFX_CONFIG_DEBUG_OCCLUSION)
+			&& isValid(_occlusionQuery))
+		{
+			BX_CHECK(m_occlusionQuerySet.end() == m_occlusionQuerySet.find(_occlusionQuery.idx)
+				, "OcclusionQuery %d was already used for this frame."
+				, _occlusionQuery.idx
+			);
+			m_occlusionQuerySet.insert(_occlusionQuery.idx);
+		}
+
+		if (m_discard)
+		{
+			discard();
+			return;
+		}
+
+		if (0 == m_draw.m_numVertices
+			&& 0 == m_draw.m_numIndices)
+		{
+			discard();
+			++m_numDropped;
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard();
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_key.m_program = kInvalidHandle == _program.idx
+			? 0
+			: _program.idx
+			;
+
+		m_key.m_view = _id;
+
+		SortKey::Enum type = SortKey::SortProgram;
+		switch (s_ctx->m_view[_id].m_mode)
+		{
+		case ViewMode::Sequential:      m_key.m_seq = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
+		case ViewMode::DepthAscending:  m_key.m_depth = _depth;               type = SortKey::SortDepth;    break;
+		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX - _depth;  type = SortKey::SortDepth;    break;
+		default: break;
+		}
+
+		uint64_t key = m_key.encodeDraw(type);
+
+		m_frame->getSortKey(renderItemIdx) = key;
+
+		m_draw.m_uniformIdx = m_uniformIdx;
+		m_draw.m_uniformBegin = m_uniformBegin;
+		m_draw.m_uniformEnd = m_uniformEnd;
+
+		if (UINT8_MAX != m_draw.m_streamMask)
+		{
+			uint32_t numVertices = UINT32_MAX;
+			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask, ntz = bx::uint32_cnttz(streamMask)
+				; 0 != streamMask
+				; streamMask >>= 1, idx += 1, ntz = bx::uint32_cnttz(streamMask)
+				)
+			{
+				streamMask >>= ntz;
+				idx += ntz;
+				numVertices = bx::min(numVertices, m_numVertices[idx]);
+			}
+
+			m_draw.m_numVertices = numVertices;
+		}
+		else
+		{
+			m_draw.m_numVertices = m_numVertices[0];
+		}
+
+		if (isValid(_occlusionQuery))
+		{
+			m_draw.m_stateFlags |= MYGFX_STATE_INTERNAL_OCCLUSION_QUERY;
+			m_draw.m_occlusionQuery = _occlusionQuery;
+		}
+
+		m_frame->getRenderItem(renderItemIdx).draw = m_draw;
+		m_frame->getRenderItemBind(renderItemIdx) = m_bind;
+
+		if (!_preserveState)
+		{
+			m_draw.clear();
+			m_bind.clear();
+			m_uniformBegin = m_uniformEnd;
+		}
+	}
+
+	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ, uint8_t _flags)
+	{
+		if (BX_ENABLED(MYGFX_CONFIG_DEBUG_UNIFORM))
+		{
+			m_uniformSet.clear();
+		}
+
+		if (m_discard)
+		{
+			discard();
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard();
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_compute.m_startMatrix = m_draw.m_startMatrix;
+		m_compute.m_numMatrices = m_draw.m_numMatrices;
+		m_compute.m_numX = bx::max(_numX, 1u);
+		m_compute.m_numY = bx::max(_numY, 1u);
+		m_compute.m_numZ = bx::max(_numZ, 1u);
+		m_compute.m_submitFlags = _flags;
+
+		m_key.m_program = _handle.idx;
+		m_key.m_depth = 0;
+		m_key.m_view = _id;
+		m_key.m_seq = s_ctx->getSeqIncr(_id);
+
+		uint64_t key = m_key.encodeCompute();
+		m_frame->getSortKey(renderItemIdx) = key;
+
+		m_compute.m_uniformIdx = m_uniformIdx;
+		m_compute.m_uniformBegin = m_uniformBegin;
+		m_compute.m_uniformEnd = m_uniformEnd;
+		m_frame->getRenderItem(renderItemIdx).compute = m_compute;
+		m_frame->getRenderItemBind(renderItemIdx) = m_bind;
+
+		m_compute.clear();
+		m_bind.clear();
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	{
+		BX_WARN(m_frame->m_numBlitItems < MYGFX_CONFIG_MAX_BLIT_ITEMS
+			, "Exceed number of available blit items per frame. MYGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
+			, MYGFX_CONFIG_MAX_BLIT_ITEMS
+		);
+		if (m_frame->m_numBlitItems < MYGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			uint16_t item = m_frame->m_numBlitItems++;
+
+			BlitItem& bi = m_frame->m_blitItem[item];
+			bi.m_srcX = _srcX;
+			bi.m_srcY = _srcY;
+			bi.m_srcZ = _srcZ;
+			bi.m_dstX = _dstX;
+			bi.m_dstY = _dstY;
+			bi.m_dstZ = _dstZ;
+			bi.m_width = _width;
+			bi.m_height = _height;
+			bi.m_depth = _depth;
+			bi.m_srcMip = _srcMip;
+			bi.m_dstMip = _dstMip;
+			bi.m_src = _src;
+			bi.m_dst = _dst;
+
+			BlitKey key;
+			key.m_view = _id;
+			key.m_item = item;
+			m_frame->m_blitKeys[item] = key.encode();
+		}
+	}
+}
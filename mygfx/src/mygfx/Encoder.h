@@ -108,7 +108,27 @@ namespace mygfx
 
 		uint32_t setTransform(const void* _mtx, uint16_t _num)
 		{
-			m_draw.m_startMatrix = m_frame->m_frameCache.m_matrixCache.add(_mtx, _num);
+			if (NULL != _mtx)
+			{
+				MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+				const uint32_t first = matrixCache.reserve(&_num);
+				if (UINT32_MAX == first)
+				{
+					BX_WARN(false, "Matrix cache overflow, draw is dropped. (max: %d)", matrixCache.m_max);
+					m_discard = true;
+					m_draw.m_startMatrix = 0;
+					m_draw.m_numMatrices = 0;
+					return UINT32_MAX;
+				}
+
+				bx::memCopy(matrixCache.toPtr(first), _mtx, sizeof(Matrix4)*_num);
+				m_draw.m_startMatrix = first;
+			}
+			else
+			{
+				m_draw.m_startMatrix = 0;
+			}
+
 			m_draw.m_numMatrices = _num;
 
 			return m_draw.m_startMatrix;
@@ -116,8 +136,17 @@ namespace mygfx
 
 		uint32_t allocTransform(Transform* _transform, uint16_t _num)
 		{
-			uint32_t first = m_frame->m_frameCache.m_matrixCache.reserve(&_num);
-			_transform->data = m_frame->m_frameCache.m_matrixCache.toPtr(first);
+			MatrixCache& matrixCache = m_frame->m_frameCache.m_matrixCache;
+			const uint32_t first = matrixCache.reserve(&_num);
+			if (UINT32_MAX == first)
+			{
+				BX_WARN(false, "Matrix cache overflow, transform is not allocated. (max: %d)", matrixCache.m_max);
+				_transform->data = NULL;
+				_transform->num = 0;
+				return UINT32_MAX;
+			}
+
+			_transform->data = matrixCache.toPtr(first);
 			_transform->num = _num;
 
 			return first;
@@ -125,12 +154,22 @@ namespace mygfx
 
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
-			BX_CHECK(_cache < MYGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			if (UINT32_MAX == _cache)
+			{
+				// Transform allocation failed, draw using it is dropped.
+				m_discard = true;
+				m_draw.m_startMatrix = 0;
+				m_draw.m_numMatrices = 0;
+				return;
+			}
+
+			const uint32_t max = m_frame->m_frameCache.m_matrixCache.m_max;
+			BX_CHECK(_cache < max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
-				, MYGFX_CONFIG_MAX_MATRIX_CACHE
+				, max
 			);
 			m_draw.m_startMatrix = _cache;
-			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache + _num, MYGFX_CONFIG_MAX_MATRIX_CACHE - 1) - _cache);
+			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache + _num, max) - _cache);
 		}
 
 		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
@@ -291,6 +330,9 @@ namespace mygfx
 			m_bind.clear();
 		}
 
+		/// Returns index of new render item, or UINT32_MAX when frame is full.
+		uint32_t allocRenderItem();
+
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState);
 
 		// 		void submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState)
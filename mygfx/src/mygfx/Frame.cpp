@@ -0,0 +1,65 @@
+#include "mygfx_p.h"
+
+namespace mygfx
+{
+	void Frame::reserveSortKeys(uint32_t _num)
+	{
+		// One extra entry for terminator key.
+		if (m_sortCapacity < _num + 1)
+		{
+			m_sortCapacity = bx::min(bx::max(_num + 1, m_sortCapacity + m_sortCapacity/2), g_caps.limits.maxDrawCalls + 1);
+			m_sortKeys = (uint64_t*)BX_REALLOC(g_allocator, m_sortKeys, m_sortCapacity*sizeof(uint64_t) );
+			m_sortValues = (RenderItemCount*)BX_REALLOC(g_allocator, m_sortValues, m_sortCapacity*sizeof(RenderItemCount) );
+		}
+
+		// Temp keys are also used for sorting blit keys.
+		const uint32_t numTemp = bx::max<uint32_t>(m_sortCapacity, MYGFX_CONFIG_MAX_BLIT_ITEMS);
+		if (s_ctx->m_tempCapacity < numTemp)
+		{
+			s_ctx->m_tempCapacity = numTemp;
+			s_ctx->m_tempKeys = (uint64_t*)BX_REALLOC(g_allocator, s_ctx->m_tempKeys, s_ctx->m_tempCapacity*sizeof(uint64_t) );
+			s_ctx->m_tempValues = (RenderItemCount*)BX_REALLOC(g_allocator, s_ctx->m_tempValues, s_ctx->m_tempCapacity*sizeof(RenderItemCount) );
+		}
+	}
+
+	void Frame::sort()
+	{
+		MYGFX_PROFILER_SCOPE("mygfx/Sort", 0xff2040ff);
+
+		ViewId viewRemap[MYGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < MYGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+		}
+
+		const uint32_t numRenderItems = m_numRenderItems;
+		reserveSortKeys(numRenderItems);
+
+		// Copy sort keys out of render item chunks into contiguous array.
+		for (uint32_t ii = 0; ii < numRenderItems; ii += MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+		{
+			const RenderItemChunk& chunk = m_renderItemChunk[ii / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+			const uint32_t size = bx::min<uint32_t>(numRenderItems - ii, MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+
+			for (uint32_t jj = 0; jj < size; ++jj)
+			{
+				m_sortKeys[ii + jj] = SortKey::remapView(chunk.m_sortKey[jj], viewRemap);
+				m_sortValues[ii + jj] = RenderItemCount(ii + jj);
+			}
+		}
+
+		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, numRenderItems);
+
+		SortKey term;
+		term.reset();
+		term.m_program = kInvalidHandle;
+		m_sortKeys[numRenderItems] = term.encodeDraw(SortKey::SortProgram);
+		m_sortValues[numRenderItems] = RenderItemCount(numRenderItems);
+
+		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		{
+			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+		}
+		bx::radixSort(m_blitKeys, (uint32_t*)s_ctx->m_tempKeys, m_numBlitItems);
+	}
+}
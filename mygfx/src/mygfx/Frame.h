@@ -98,12 +98,98 @@ namespace mygfx
 		uint8_t m_flags;
 	};
 
+	/// Array of fixed size chunks allocated on first use. Chunks never move, so that
+	/// encoders can write into allocated chunks while other encoder allocates new one.
+	template<typename Ty>
+	struct ChunkArray
+	{
+		ChunkArray()
+			: m_chunk(NULL)
+			, m_maxChunks(0)
+		{
+		}
+
+		void create(uint32_t _maxChunks)
+		{
+			m_maxChunks = _maxChunks;
+			m_chunk = (Ty**)BX_ALLOC(g_allocator, sizeof(Ty*)*m_maxChunks);
+			bx::memSet(m_chunk, 0, sizeof(Ty*)*m_maxChunks);
+		}
+
+		void destroy()
+		{
+			for (uint32_t ii = 0; ii < m_maxChunks; ++ii)
+			{
+				if (NULL != m_chunk[ii])
+				{
+					BX_ALIGNED_FREE(g_allocator, m_chunk[ii], BX_CACHE_LINE_SIZE);
+				}
+			}
+
+			BX_FREE(g_allocator, m_chunk);
+			m_chunk = NULL;
+			m_maxChunks = 0;
+		}
+
+		Ty* alloc(uint32_t _chunk)
+		{
+			BX_CHECK(_chunk < m_maxChunks, "Chunk out of bounds %d (max: %d).", _chunk, m_maxChunks);
+
+			Ty* chunk = *(Ty* volatile*)&m_chunk[_chunk];
+			if (NULL == chunk)
+			{
+				bx::MutexScope lock(m_lock);
+
+				chunk = m_chunk[_chunk];
+				if (NULL == chunk)
+				{
+					chunk = (Ty*)BX_ALIGNED_ALLOC(g_allocator, sizeof(Ty), BX_CACHE_LINE_SIZE);
+					bx::writeBarrier();
+					m_chunk[_chunk] = chunk;
+				}
+			}
+
+			return chunk;
+		}
+
+		Ty& operator[](uint32_t _chunk)
+		{
+			return *m_chunk[_chunk];
+		}
+
+		const Ty& operator[](uint32_t _chunk) const
+		{
+			return *m_chunk[_chunk];
+		}
+
+		Ty** m_chunk;
+		uint32_t m_maxChunks;
+		bx::Mutex m_lock;
+	};
+
+	struct MatrixCacheChunk
+	{
+		Matrix4 m_matrix[MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+	};
+
 	struct MatrixCache
 	{
 		MatrixCache()
 			: m_num(1)
+			, m_max(0)
 		{
-			m_cache[0].setIdentity();
+		}
+
+		void create(uint32_t _max)
+		{
+			m_max = _max;
+			m_chunk.create( (m_max + MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE - 1) / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+			m_chunk.alloc(0)->m_matrix[0].setIdentity();
+		}
+
+		void destroy()
+		{
+			m_chunk.destroy();
 		}
 
 		void reset()
@@ -111,44 +197,57 @@ namespace mygfx
 			m_num = 1;
 		}
 
+		/// Returns index of first of `*_num` contiguous matrices, or UINT32_MAX when cache
+		/// doesn't have enough space left.
 		uint32_t reserve(uint16_t* _num)
 		{
-			uint32_t num = *_num;
-			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, MYGFX_CONFIG_MAX_MATRIX_CACHE - 1);
-			BX_WARN(first + num < MYGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache overflow. %d (max: %d)", first + num, MYGFX_CONFIG_MAX_MATRIX_CACHE);
-			num = bx::min(num, MYGFX_CONFIG_MAX_MATRIX_CACHE - 1 - first);
-			*_num = (uint16_t)num;
-			return first;
-		}
+			const uint32_t num = bx::min<uint32_t>(*_num, MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
 
-		uint32_t add(const void* _mtx, uint16_t _num)
-		{
-			if (NULL != _mtx)
+			uint32_t first;
+			for (uint32_t old = m_num;;)
 			{
-				uint32_t first = reserve(&_num);
-				bx::memCopy(&m_cache[first], _mtx, sizeof(Matrix4)*_num);
-				return first;
+				// Matrices must be contiguous, skip rest of the chunk when they don't fit.
+				first = old;
+				if (first%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE + num > MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE)
+				{
+					first = bx::strideAlign(first, MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				}
+
+				const uint32_t end = first + num;
+				if (end > m_max)
+				{
+					*_num = 0;
+					return UINT32_MAX;
+				}
+
+				const uint32_t cur = bx::atomicCompareAndSwap<uint32_t>(&m_num, old, end);
+				if (cur == old)
+				{
+					break;
+				}
+
+				old = cur;
 			}
 
-			return 0;
+			*_num = uint16_t(num);
+
+			m_chunk.alloc(first / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+
+			return first;
 		}
 
 		float* toPtr(uint32_t _cacheIdx)
 		{
-			BX_CHECK(_cacheIdx < MYGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
+			BX_CHECK(_cacheIdx < m_max, "Matrix cache out of bounds index %d (max: %d)"
 				, _cacheIdx
-				, MYGFX_CONFIG_MAX_MATRIX_CACHE
+				, m_max
 			);
-			return m_cache[_cacheIdx].un.val;
-		}
-
-		uint32_t fromPtr(const void* _ptr) const
-		{
-			return uint32_t((const Matrix4*)_ptr - m_cache);
+			return m_chunk[_cacheIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_matrix[_cacheIdx%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].un.val;
 		}
 
-		Matrix4 m_cache[MYGFX_CONFIG_MAX_MATRIX_CACHE];
+		ChunkArray<MatrixCacheChunk> m_chunk;
 		uint32_t m_num;
+		uint32_t m_max;
 	};
 
 	struct RectCache
@@ -184,6 +283,16 @@ namespace mygfx
 
 	struct FrameCache
 	{
+		void create(uint32_t _maxMatrices)
+		{
+			m_matrixCache.create(_maxMatrices);
+		}
+
+		void destroy()
+		{
+			m_matrixCache.destroy();
+		}
+
 		void reset()
 		{
 			m_matrixCache.reset();
@@ -206,18 +315,25 @@ namespace mygfx
 		RectCache m_rectCache;
 	};
 
+	struct RenderItemChunk
+	{
+		uint64_t   m_sortKey[MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		RenderItem m_renderItem[MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		RenderBind m_renderItemBind[MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+	};
+
+	BX_STATIC_ASSERT(bx::isPowerOf2(MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE) );
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
-			: m_waitSubmit(0)
+			: m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_sortCapacity(0)
+			, m_waitSubmit(0)
 			, m_waitRender(0)
 			, m_capture(false)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = kInvalidHandle;
-			m_sortKeys[MYGFX_CONFIG_MAX_DRAW_CALLS] = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[MYGFX_CONFIG_MAX_DRAW_CALLS] = MYGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion));
 
 			m_perfStats.viewStats = m_viewStats;
@@ -240,6 +356,15 @@ namespace mygfx
 				}
 			}
 
+			{
+				// Render items are allocated in chunks once encoders submit them, only
+				// array of chunk pointers is sized for maximum number of draw calls.
+				const uint32_t num = g_caps.limits.maxDrawCalls;
+
+				m_renderItemChunk.create( (num + MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE - 1) / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+				m_frameCache.create(num + 1);
+			}
+
 			reset();
 			start();
 			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
@@ -254,6 +379,18 @@ namespace mygfx
 
 			BX_FREE(g_allocator, m_uniformBuffer);
 			BX_DELETE(g_allocator, m_textVideoMem);
+
+			m_renderItemChunk.destroy();
+			m_frameCache.destroy();
+
+			BX_FREE(g_allocator, m_sortKeys);
+			BX_FREE(g_allocator, m_sortValues);
+			m_sortKeys = NULL;
+			m_sortValues = NULL;
+			m_sortCapacity = 0;
+
+			m_cmdPre.destroy();
+			m_cmdPost.destroy();
 		}
 
 		void reset()
@@ -295,6 +432,39 @@ namespace mygfx
 
 		void sort();
 
+		RenderItemChunk* allocRenderItemChunk(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk.alloc(_renderItemIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE);
+		}
+
+		/// Sort key as submitted by encoder, before frame is sorted.
+		uint64_t& getSortKey(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_sortKey[_renderItemIdx%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		RenderItem& getRenderItem(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItem[_renderItemIdx%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		const RenderItem& getRenderItem(uint32_t _renderItemIdx) const
+		{
+			return m_renderItemChunk[_renderItemIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItem[_renderItemIdx%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		RenderBind& getRenderItemBind(uint32_t _renderItemIdx)
+		{
+			return m_renderItemChunk[_renderItemIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItemBind[_renderItemIdx%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		const RenderBind& getRenderItemBind(uint32_t _renderItemIdx) const
+		{
+			return m_renderItemChunk[_renderItemIdx / MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE].m_renderItemBind[_renderItemIdx%MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE];
+		}
+
+		void reserveSortKeys(uint32_t _num);
+
 		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
 		{
 			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t));
@@ -449,10 +619,12 @@ namespace mygfx
 
 		int32_t m_occlusion[MYGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[MYGFX_CONFIG_MAX_DRAW_CALLS + 1];
-		RenderItemCount m_sortValues[MYGFX_CONFIG_MAX_DRAW_CALLS + 1];
-		RenderItem m_renderItem[MYGFX_CONFIG_MAX_DRAW_CALLS + 1];
-		RenderBind m_renderItemBind[MYGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		ChunkArray<RenderItemChunk> m_renderItemChunk;
+
+		// Sorted keys and render item indices, valid after sort. Grown on demand.
+		uint64_t* m_sortKeys;
+		RenderItemCount* m_sortValues;
+		uint32_t m_sortCapacity;
 
 		uint32_t m_blitKeys[MYGFX_CONFIG_MAX_BLIT_ITEMS + 1];
 		BlitItem m_blitItem[MYGFX_CONFIG_MAX_BLIT_ITEMS + 1];
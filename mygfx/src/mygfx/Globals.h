@@ -3,6 +3,9 @@
 #include "mygfx/mygfx.h"
 #include "mygfx/platform.h"
 #include <bx/allocator.h>
+#include <bx/thread.h>
+
+#include "config.h"
 
 namespace mygfx
 {
@@ -18,7 +21,7 @@ namespace mygfx
 	extern bx::AllocatorI* g_allocator;
 	extern Caps g_caps;
 
-	static Context* s_ctx = NULL;
+	extern Context* s_ctx;
 
 #if MYGFX_CONFIG_MULTITHREADED && !defined(BX_THREAD_LOCAL)
 	class ThreadData
@@ -59,10 +62,12 @@ namespace mygfx
 		bx::TlsData m_tls;
 	};
 
-	static ThreadData s_threadIndex(0);
+	extern ThreadData s_threadIndex;
 #elif !MYGFX_CONFIG_MULTITHREADED
-	static uint32_t s_threadIndex(0);
+	extern uint32_t s_threadIndex;
 #else
-	static BX_THREAD_LOCAL uint32_t s_threadIndex(0);
+	extern BX_THREAD_LOCAL uint32_t s_threadIndex;
 #endif
+
+	extern bool s_renderFrameCalled;
 }
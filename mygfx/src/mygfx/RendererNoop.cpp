@@ -0,0 +1,401 @@
+#include "mygfx_p.h"
+
+namespace mygfx { namespace noop
+{
+	struct PrimInfo
+	{
+		uint32_t m_min;
+		uint32_t m_div;
+		uint32_t m_sub;
+	};
+
+	static const PrimInfo s_primInfo[] =
+	{
+		{ 3, 3, 0 }, // TriList
+		{ 3, 1, 2 }, // TriStrip
+		{ 2, 2, 0 }, // LineList
+		{ 2, 1, 1 }, // LineStrip
+		{ 1, 1, 0 }, // PointList
+		{ 0, 0, 0 },
+	};
+	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_primInfo)-1);
+
+	struct BufferNOOP
+	{
+		uint32_t m_size;
+		uint16_t m_flags;
+		VertexDeclHandle m_decl;
+	};
+
+	struct RendererContextNOOP : public RendererContextI
+	{
+		RendererContextNOOP()
+		{
+			// Pretend all features are available.
+			g_caps.supported = 0
+				| MYGFX_CAPS_ALPHA_TO_COVERAGE
+				| MYGFX_CAPS_BLEND_INDEPENDENT
+				| MYGFX_CAPS_COMPUTE
+				| MYGFX_CAPS_CONSERVATIVE_RASTER
+				| MYGFX_CAPS_DRAW_INDIRECT
+				| MYGFX_CAPS_FRAGMENT_DEPTH
+				| MYGFX_CAPS_FRAGMENT_ORDERING
+				| MYGFX_CAPS_GRAPHICS_DEBUGGER
+				| MYGFX_CAPS_HIDPI
+				| MYGFX_CAPS_INDEX32
+				| MYGFX_CAPS_INSTANCING
+				| MYGFX_CAPS_OCCLUSION_QUERY
+				| MYGFX_CAPS_RENDERER_MULTITHREADED
+				| MYGFX_CAPS_SWAP_CHAIN
+				| MYGFX_CAPS_TEXTURE_2D_ARRAY
+				| MYGFX_CAPS_TEXTURE_3D
+				| MYGFX_CAPS_TEXTURE_BLIT
+				| MYGFX_CAPS_TEXTURE_COMPARE_ALL
+				| MYGFX_CAPS_TEXTURE_COMPARE_LEQUAL
+				| MYGFX_CAPS_TEXTURE_CUBE_ARRAY
+				| MYGFX_CAPS_TEXTURE_READ_BACK
+				| MYGFX_CAPS_VERTEX_ATTRIB_HALF
+				| MYGFX_CAPS_VERTEX_ATTRIB_UINT10
+				;
+
+			// Pretend all features are available for all texture formats.
+			for (uint32_t formatIdx = 0; formatIdx < TextureFormat::Count; ++formatIdx)
+			{
+				g_caps.formats[formatIdx] = 0
+					| MYGFX_CAPS_FORMAT_TEXTURE_NONE
+					| MYGFX_CAPS_FORMAT_TEXTURE_2D
+					| MYGFX_CAPS_FORMAT_TEXTURE_2D_SRGB
+					| MYGFX_CAPS_FORMAT_TEXTURE_2D_EMULATED
+					| MYGFX_CAPS_FORMAT_TEXTURE_3D
+					| MYGFX_CAPS_FORMAT_TEXTURE_3D_SRGB
+					| MYGFX_CAPS_FORMAT_TEXTURE_3D_EMULATED
+					| MYGFX_CAPS_FORMAT_TEXTURE_CUBE
+					| MYGFX_CAPS_FORMAT_TEXTURE_CUBE_SRGB
+					| MYGFX_CAPS_FORMAT_TEXTURE_CUBE_EMULATED
+					| MYGFX_CAPS_FORMAT_TEXTURE_VERTEX
+					| MYGFX_CAPS_FORMAT_TEXTURE_IMAGE
+					| MYGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER
+					| MYGFX_CAPS_FORMAT_TEXTURE_FRAMEBUFFER_MSAA
+					| MYGFX_CAPS_FORMAT_TEXTURE_MSAA
+					| MYGFX_CAPS_FORMAT_TEXTURE_MIP_AUTOGEN
+					;
+			}
+
+			// Pretend we have no limits
+			g_caps.limits.maxTextureSize     = 16384;
+			g_caps.limits.maxTextureLayers   = 2048;
+			g_caps.limits.maxComputeBindings = g_caps.limits.maxTextureSamplers;
+			g_caps.limits.maxFBAttachments   = MYGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS;
+			g_caps.limits.maxVertexStreams   = MYGFX_CONFIG_MAX_VERTEX_STREAMS;
+
+			bx::memSet(m_indexBuffers,  0, sizeof(m_indexBuffers) );
+			bx::memSet(m_vertexBuffers, 0, sizeof(m_vertexBuffers) );
+			bx::memSet(m_declStride,    0, sizeof(m_declStride) );
+		}
+
+		~RendererContextNOOP()
+		{
+		}
+
+		RendererType::Enum getRendererType() const override
+		{
+			return RendererType::Noop;
+		}
+
+		const char* getRendererName() const override
+		{
+			return MYGFX_RENDERER_NOOP_NAME;
+		}
+
+		bool isDeviceRemoved() override
+		{
+			return false;
+		}
+
+		void flip() override
+		{
+		}
+
+		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) override
+		{
+			BufferNOOP& ib = m_indexBuffers[_handle.idx];
+			ib.m_size  = _mem->size;
+			ib.m_flags = _flags;
+		}
+
+		void destroyIndexBuffer(IndexBufferHandle _handle) override
+		{
+			m_indexBuffers[_handle.idx].m_size = 0;
+		}
+
+		void createVertexDecl(VertexDeclHandle _handle, const VertexDecl& _decl) override
+		{
+			m_declStride[_handle.idx] = _decl.m_stride;
+		}
+
+		void destroyVertexDecl(VertexDeclHandle _handle) override
+		{
+			m_declStride[_handle.idx] = 0;
+		}
+
+		void createVertexBuffer(VertexBufferHandle _handle, const Memory* _mem, VertexDeclHandle _declHandle, uint16_t _flags) override
+		{
+			BufferNOOP& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size  = _mem->size;
+			vb.m_flags = _flags;
+			vb.m_decl  = _declHandle;
+		}
+
+		void destroyVertexBuffer(VertexBufferHandle _handle) override
+		{
+			m_vertexBuffers[_handle.idx].m_size = 0;
+		}
+
+		void createDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
+		{
+			BufferNOOP& ib = m_indexBuffers[_handle.idx];
+			ib.m_size  = _size;
+			ib.m_flags = _flags;
+		}
+
+		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
+		{
+		}
+
+		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
+		{
+			m_indexBuffers[_handle.idx].m_size = 0;
+		}
+
+		void createDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
+		{
+			BufferNOOP& vb = m_vertexBuffers[_handle.idx];
+			vb.m_size     = _size;
+			vb.m_flags    = _flags;
+			vb.m_decl.idx = kInvalidHandle;
+		}
+
+		void updateDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
+		{
+		}
+
+		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
+		{
+			m_vertexBuffers[_handle.idx].m_size = 0;
+		}
+
+		void createShader(ShaderHandle /*_handle*/, const Memory* /*_mem*/) override
+		{
+		}
+
+		void destroyShader(ShaderHandle /*_handle*/) override
+		{
+		}
+
+		void createProgram(ProgramHandle /*_handle*/, ShaderHandle /*_vsh*/, ShaderHandle /*_fsh*/) override
+		{
+		}
+
+		void destroyProgram(ProgramHandle /*_handle*/) override
+		{
+		}
+
+		void* createTexture(TextureHandle /*_handle*/, const Memory* /*_mem*/, uint64_t /*_flags*/, uint8_t /*_skip*/) override
+		{
+			return NULL;
+		}
+
+		void updateTextureBegin(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/) override
+		{
+		}
+
+		void updateTexture(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/, const Rect& /*_rect*/, uint16_t /*_z*/, uint16_t /*_depth*/, uint16_t /*_pitch*/, const Memory* /*_mem*/) override
+		{
+		}
+
+		void updateTextureEnd() override
+		{
+		}
+
+		void readTexture(TextureHandle /*_handle*/, void* /*_data*/, uint8_t /*_mip*/) override
+		{
+		}
+
+		void resizeTexture(TextureHandle /*_handle*/, uint16_t /*_width*/, uint16_t /*_height*/, uint8_t /*_numMips*/, uint16_t /*_numLayers*/) override
+		{
+		}
+
+		void overrideInternal(TextureHandle /*_handle*/, uintptr_t /*_ptr*/) override
+		{
+		}
+
+		uintptr_t getInternal(TextureHandle /*_handle*/) override
+		{
+			return 0;
+		}
+
+		void destroyTexture(TextureHandle /*_handle*/) override
+		{
+		}
+
+		void createFrameBuffer(FrameBufferHandle /*_handle*/, uint8_t /*_num*/, const Attachment* /*_attachment*/) override
+		{
+		}
+
+		void createFrameBuffer(FrameBufferHandle /*_handle*/, void* /*_nwh*/, uint32_t /*_width*/, uint32_t /*_height*/, TextureFormat::Enum /*_format*/, TextureFormat::Enum /*_depthFormat*/) override
+		{
+		}
+
+		void destroyFrameBuffer(FrameBufferHandle /*_handle*/) override
+		{
+		}
+
+		void createUniform(UniformHandle /*_handle*/, UniformType::Enum /*_type*/, uint16_t /*_num*/, const char* /*_name*/) override
+		{
+		}
+
+		void destroyUniform(UniformHandle /*_handle*/) override
+		{
+		}
+
+		void requestScreenShot(FrameBufferHandle /*_handle*/, const char* /*_filePath*/) override
+		{
+		}
+
+		void updateViewName(ViewId /*_id*/, const char* /*_name*/) override
+		{
+		}
+
+		void updateUniform(uint16_t /*_loc*/, const void* /*_data*/, uint32_t /*_size*/) override
+		{
+		}
+
+		void setMarker(const char* /*_marker*/, uint32_t /*_size*/) override
+		{
+		}
+
+		void invalidateOcclusionQuery(OcclusionQueryHandle /*_handle*/) override
+		{
+		}
+
+		virtual void setName(Handle /*_handle*/, const char* /*_name*/) override
+		{
+		}
+
+		// Walks sorted frame the same way GPU backends do, minus API calls, so
+		// front-end cost (sort, key decode, uniform replay) can be measured
+		// without GPU.
+		void submit(Frame* _render, ClearQuad& /*_clearQuad*/, TextVideoMemBlitter& /*_textVideoMemBlitter*/) override
+		{
+			const int64_t timerFreq = bx::getHPFrequency();
+			const int64_t timeBegin = bx::getHPCounter();
+
+			_render->sort();
+
+			const int64_t timeSort = bx::getHPCounter();
+
+			uint32_t statsKeyType[2] = {};
+			uint32_t statsNumPrimsRendered[Topology::Count] = {};
+
+			SortKey key;
+
+			for (uint32_t item = 0, numItems = _render->m_numRenderItems; item < numItems; ++item)
+			{
+				const uint64_t encodedKey = _render->m_sortKeys[item];
+				const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
+				statsKeyType[isCompute]++;
+
+				const uint32_t itemIdx       = _render->m_sortValues[item];
+				const RenderItem& renderItem = _render->getRenderItem(itemIdx);
+
+				if (isCompute)
+				{
+					const RenderCompute& compute = renderItem.compute;
+					rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+					continue;
+				}
+
+				const RenderDraw& draw = renderItem.draw;
+
+				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+
+				const uint8_t primIndex = uint8_t( (draw.m_stateFlags&MYGFX_STATE_PT_MASK) >> MYGFX_STATE_PT_SHIFT);
+				const PrimInfo& prim = s_primInfo[primIndex];
+
+				uint32_t numVertices = draw.m_numVertices;
+				if (UINT32_MAX == numVertices)
+				{
+					const BufferNOOP& vb = m_vertexBuffers[draw.m_stream[0].m_handle.idx];
+					const VertexDeclHandle decl = isValid(draw.m_stream[0].m_decl) ? draw.m_stream[0].m_decl : vb.m_decl;
+					const uint16_t stride = isValid(decl) ? m_declStride[decl.idx] : 0;
+					numVertices = 0 != stride ? vb.m_size/stride : 0;
+				}
+
+				uint32_t numIndices = numVertices;
+				if (isValid(draw.m_indexBuffer) )
+				{
+					const BufferNOOP& ib = m_indexBuffers[draw.m_indexBuffer.idx];
+					const uint32_t indexSize = 0 == (ib.m_flags & MYGFX_BUFFER_INDEX32) ? 2 : 4;
+					numIndices = UINT32_MAX == draw.m_numIndices
+						? ib.m_size/indexSize
+						: draw.m_numIndices
+						;
+				}
+
+				if (prim.m_min <= numIndices)
+				{
+					const uint32_t numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
+					statsNumPrimsRendered[primIndex] += numPrimsSubmitted*draw.m_numInstances;
+				}
+			}
+
+			const int64_t timeEnd = bx::getHPCounter();
+
+			Stats& perfStats = _render->m_perfStats;
+			perfStats.cpuTimeBegin  = timeBegin;
+			perfStats.cpuTimeEnd    = timeEnd;
+			perfStats.cpuTimerFreq  = timerFreq;
+			perfStats.cpuTimeSort   = timeSort - timeBegin;
+
+			perfStats.gpuTimeBegin  = 0;
+			perfStats.gpuTimeEnd    = 0;
+			perfStats.gpuTimerFreq  = 1000000000;
+
+			perfStats.numDraw       = statsKeyType[0];
+			perfStats.numCompute    = statsKeyType[1];
+			perfStats.numBlit       = _render->m_numBlitItems;
+			perfStats.maxGpuLatency = 0;
+			bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
+
+			perfStats.gpuMemoryMax  = -INT64_MAX;
+			perfStats.gpuMemoryUsed = -INT64_MAX;
+		}
+
+		void blitSetup(TextVideoMemBlitter& /*_blitter*/) override
+		{
+		}
+
+		void blitRender(TextVideoMemBlitter& /*_blitter*/, uint32_t /*_numIndices*/) override
+		{
+		}
+
+		BufferNOOP m_indexBuffers[MYGFX_CONFIG_MAX_INDEX_BUFFERS];
+		BufferNOOP m_vertexBuffers[MYGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		uint16_t   m_declStride[MYGFX_CONFIG_MAX_VERTEX_DECLS];
+	};
+
+	static RendererContextNOOP* s_renderNOOP;
+
+	RendererContextI* rendererCreate(const Init& _init)
+	{
+		BX_UNUSED(_init);
+		s_renderNOOP = BX_NEW(g_allocator, RendererContextNOOP);
+		return s_renderNOOP;
+	}
+
+	void rendererDestroy()
+	{
+		BX_DELETE(g_allocator, s_renderNOOP);
+		s_renderNOOP = NULL;
+	}
+} /* namespace noop */ } // namespace mygfx
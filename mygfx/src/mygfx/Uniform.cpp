@@ -0,0 +1,91 @@
+#include "mygfx_p.h"
+
+namespace mygfx
+{
+	const char* s_uniformTypeName[] =
+	{
+		"int1",
+		NULL,
+		"vec4",
+		"mat3",
+		"mat4",
+	};
+	BX_STATIC_ASSERT(UniformType::Count == BX_COUNTOF(s_uniformTypeName) );
+
+	const char* getUniformTypeName(UniformType::Enum _enum)
+	{
+		BX_CHECK(_enum < UniformType::Count, "%d < UniformType::Count %d", _enum, UniformType::Count);
+		return s_uniformTypeName[_enum];
+	}
+
+	UniformType::Enum nameToUniformTypeEnum(const char* _name)
+	{
+		for (uint32_t ii = 0; ii < UniformType::Count; ++ii)
+		{
+			if (NULL != s_uniformTypeName[ii]
+			&&  0 == bx::strCmp(_name, s_uniformTypeName[ii]) )
+			{
+				return UniformType::Enum(ii);
+			}
+		}
+
+		return UniformType::Count;
+	}
+
+	static const char* s_predefinedName[PredefinedUniform::Count] =
+	{
+		"u_viewRect",
+		"u_viewTexel",
+		"u_view",
+		"u_invView",
+		"u_proj",
+		"u_invProj",
+		"u_viewProj",
+		"u_invViewProj",
+		"u_model",
+		"u_modelView",
+		"u_modelViewProj",
+		"u_alphaRef4",
+	};
+
+	const char* getPredefinedUniformName(PredefinedUniform::Enum _enum)
+	{
+		return s_predefinedName[_enum];
+	}
+
+	PredefinedUniform::Enum nameToPredefinedUniformEnum(const char* _name)
+	{
+		for (uint32_t ii = 0; ii < PredefinedUniform::Count; ++ii)
+		{
+			if (0 == bx::strCmp(_name, s_predefinedName[ii]) )
+			{
+				return PredefinedUniform::Enum(ii);
+			}
+		}
+
+		return PredefinedUniform::Count;
+	}
+
+
+	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
+		write(opcode);
+		write(_value, g_uniformTypeSize[_type]*_num);
+	}
+
+	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(&_handle, sizeof(UniformHandle) );
+	}
+
+	void UniformBuffer::writeMarker(const char* _marker)
+	{
+		uint16_t num = (uint16_t)bx::strLen(_marker)+1;
+		uint32_t opcode = encodeOpcode(UniformType::Count, 0, num, true);
+		write(opcode);
+		write(_marker, num);
+	}
+}
@@ -155,22 +155,24 @@
 #endif // MYGFX_CONFIG_DEBUG_OCCLUSION
 
 #ifndef MYGFX_CONFIG_MULTITHREADED
-//#	define MYGFX_CONFIG_MULTITHREADED ( (0 == BX_PLATFORM_EMSCRIPTEN) ? 1 : 0)
-#	define MYGFX_CONFIG_MULTITHREADED 0 
+#	define MYGFX_CONFIG_MULTITHREADED ( (0 == BX_PLATFORM_EMSCRIPTEN) ? 1 : 0)
 #endif // MYGFX_CONFIG_MULTITHREADED
 
+/// Default for `Init::limits.maxDrawCalls`.
 #ifndef MYGFX_CONFIG_MAX_DRAW_CALLS
 #	define MYGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // MYGFX_CONFIG_MAX_DRAW_CALLS
 
+/// Number of render items, and matrix cache entries, frame storage grows by
+/// once more draw calls are submitted. Must be power of two.
+#ifndef MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+#	define MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE (16<<10)
+#endif // MYGFX_CONFIG_RENDER_ITEM_CHUNK_SIZE
+
 #ifndef MYGFX_CONFIG_MAX_BLIT_ITEMS
 #	define MYGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // MYGFX_CONFIG_MAX_BLIT_ITEMS
 
-#ifndef MYGFX_CONFIG_MAX_MATRIX_CACHE
-#	define MYGFX_CONFIG_MAX_MATRIX_CACHE (MYGFX_CONFIG_MAX_DRAW_CALLS+1)
-#endif // MYGFX_CONFIG_MAX_MATRIX_CACHE
-
 #ifndef MYGFX_CONFIG_MAX_RECT_CACHE
 #	define MYGFX_CONFIG_MAX_RECT_CACHE (4<<10)
 #endif //  MYGFX_CONFIG_MAX_RECT_CACHE
@@ -262,9 +264,11 @@ BX_STATIC_ASSERT(bx::isPowerOf2(MYGFX_CONFIG_MAX_VIEWS), "MYGFX_CONFIG_MAX_VIEWS
 #	define MYGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // MYGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
-#ifndef MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
-#	define MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE (64<<10)
-#endif // MYGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
+/// Command buffers grow by chaining pages of this size. Pages are kept and reused between
+/// frames. Single command must fit into one page.
+#ifndef MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
+#	define MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE (64<<10)
+#endif // MYGFX_CONFIG_COMMAND_BUFFER_PAGE_SIZE
 
 #ifndef MYGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 #	define MYGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
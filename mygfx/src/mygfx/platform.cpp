@@ -9,7 +9,32 @@ namespace mygfx
 	{
 		if (BX_ENABLED(MYGFX_CONFIG_MULTITHREADED))
 		{
-			//TODO
+			if (s_renderFrameCalled)
+			{
+				MYGFX_CHECK_RENDER_THREAD();
+			}
+
+			if (NULL == s_ctx)
+			{
+				s_renderFrameCalled = true;
+				s_threadIndex = ~MYGFX_API_THREAD_MAGIC;
+				return RenderFrame::NoContext;
+			}
+
+			int32_t msecs = -1 == _msecs
+				? MYGFX_CONFIG_API_SEMAPHORE_TIMEOUT
+				: _msecs
+				;
+			RenderFrame::Enum result = s_ctx->renderFrame(msecs);
+			if (RenderFrame::Exiting == result)
+			{
+				Context* ctx = s_ctx;
+				ctx->apiSemWait();
+				s_ctx = NULL;
+				ctx->renderSemPost();
+			}
+
+			return result;
 		}
 
 		BX_CHECK(false, "This call only makes sense if used with multi-threaded renderer.");